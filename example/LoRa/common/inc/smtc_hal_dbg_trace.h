@@ -47,6 +47,7 @@ extern "C" {
 
 #include "smtc_hal_options.h"
 #include "smtc_hal_mcu.h"
+#include "smtc_hal_dbg_trace_deferred.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -75,7 +76,49 @@ extern "C" {
 #define HAL_DBG_TRACE_COLOR_DEFAULT ""
 #endif
 
-#if( HAL_DBG_TRACE ) && !defined( PERF_TEST_ENABLED )
+#if( HAL_DBG_TRACE ) && !defined( PERF_TEST_ENABLED ) && ( HAL_DBG_TRACE_DEFERRED == HAL_FEATURE_ON )
+
+/*
+ * Deferred mode: each call site sends the address of its format string and the raw arguments, the text is rebuilt on
+ * the host by tools/trace_decoder. The format strings are named objects so that the decoder finds them in the image
+ * symbol table - they must be string literals.
+ */
+#define HAL_DBG_TRACE_DEFERRED_RECORD( level, fmt, ... )                   \
+    do                                                                     \
+    {                                                                      \
+        static const char hal_dbg_trace_fmt[] = fmt;                       \
+        hal_mcu_trace_deferred( level, hal_dbg_trace_fmt, ##__VA_ARGS__ ); \
+    } while( 0 )
+
+#define HAL_DBG_TRACE_DEFERRED_RECORD_ARRAY( level, msg, array, len )                             \
+    do                                                                                            \
+    {                                                                                             \
+        static const char hal_dbg_trace_fmt[] = msg;                                              \
+        hal_mcu_trace_deferred_array( level, hal_dbg_trace_fmt, ( array ), ( uint32_t )( len ) ); \
+    } while( 0 )
+
+#define HAL_DBG_TRACE_PRINTF( ... ) HAL_DBG_TRACE_DEFERRED_RECORD( HAL_DBG_TRACE_DEFERRED_LEVEL_PRINTF, __VA_ARGS__ )
+
+#define HAL_DBG_TRACE_MSG( msg ) \
+    HAL_DBG_TRACE_DEFERRED_RECORD( HAL_DBG_TRACE_DEFERRED_LEVEL_PRINTF, HAL_DBG_TRACE_COLOR_DEFAULT msg );
+
+#define HAL_DBG_TRACE_MSG_COLOR( msg, color ) \
+    HAL_DBG_TRACE_DEFERRED_RECORD( HAL_DBG_TRACE_DEFERRED_LEVEL_PRINTF, color msg HAL_DBG_TRACE_COLOR_DEFAULT );
+
+#define HAL_DBG_TRACE_INFO( ... ) HAL_DBG_TRACE_DEFERRED_RECORD( HAL_DBG_TRACE_DEFERRED_LEVEL_INFO, __VA_ARGS__ );
+
+#define HAL_DBG_TRACE_WARNING( ... ) \
+    HAL_DBG_TRACE_DEFERRED_RECORD( HAL_DBG_TRACE_DEFERRED_LEVEL_WARNING, __VA_ARGS__ );
+
+#define HAL_DBG_TRACE_ERROR( ... ) HAL_DBG_TRACE_DEFERRED_RECORD( HAL_DBG_TRACE_DEFERRED_LEVEL_ERROR, __VA_ARGS__ );
+
+#define HAL_DBG_TRACE_ARRAY( msg, array, len ) \
+    HAL_DBG_TRACE_DEFERRED_RECORD_ARRAY( HAL_DBG_TRACE_DEFERRED_LEVEL_ARRAY, msg, array, len );
+
+#define HAL_DBG_TRACE_PACKARRAY( msg, array, len ) \
+    HAL_DBG_TRACE_DEFERRED_RECORD_ARRAY( HAL_DBG_TRACE_DEFERRED_LEVEL_PACKARRAY, msg, array, len );
+
+#elif( HAL_DBG_TRACE ) && !defined( PERF_TEST_ENABLED )
 
 #define HAL_DBG_TRACE_PRINTF( ... ) hal_mcu_trace_print( __VA_ARGS__ )
 
@@ -183,6 +226,25 @@ extern "C" {
  */
 void hal_mcu_trace_print( const char* fmt, ... );
 
+/**
+ * @brief Send a formatted message as a deferred trace record
+ *
+ * @param [in] level Record level, PRINTF to ERROR
+ * @param [in] fmt Format string, found by its address in the string table of the decoder
+ */
+void hal_mcu_trace_deferred( hal_dbg_trace_deferred_level_t level, const char* fmt, ... );
+
+/**
+ * @brief Send an array as a deferred trace record
+ *
+ * @param [in] level Record level, ARRAY or PACKARRAY
+ * @param [in] msg Message, found by its address in the string table of the decoder
+ * @param [in] array Array to send
+ * @param [in] length Array length in bytes
+ */
+void hal_mcu_trace_deferred_array( hal_dbg_trace_deferred_level_t level, const char* msg, const uint8_t* array,
+                                   uint32_t length );
+
 #ifdef __cplusplus
 }
 #endif
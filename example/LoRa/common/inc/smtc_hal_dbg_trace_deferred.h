@@ -0,0 +1,150 @@
+/*!
+ * @file      smtc_hal_dbg_trace_deferred.h
+ *
+ * @brief     Compact binary records for deferred formatting of debug traces
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMTC_HAL_DBG_TRACE_DEFERRED_H
+#define SMTC_HAL_DBG_TRACE_DEFERRED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdarg.h>
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief First byte of a record, the lower nibble holds the level
+ */
+#define HAL_DBG_TRACE_DEFERRED_TAG 0xA0
+#define HAL_DBG_TRACE_DEFERRED_TAG_MASK 0xF0
+
+/**
+ * @brief Record header length: tag, format string address (32-bit little endian), payload length
+ */
+#define HAL_DBG_TRACE_DEFERRED_HEADER_LENGTH 6
+
+/**
+ * @brief Maximum payload length of a record - arguments that do not fit are left out
+ */
+#define HAL_DBG_TRACE_DEFERRED_PAYLOAD_LENGTH_MAX 255
+
+/**
+ * @brief Maximum length of a record
+ */
+#define HAL_DBG_TRACE_DEFERRED_RECORD_LENGTH_MAX \
+    ( HAL_DBG_TRACE_DEFERRED_HEADER_LENGTH + HAL_DBG_TRACE_DEFERRED_PAYLOAD_LENGTH_MAX )
+
+/**
+ * @brief Name prefix of the objects holding the format strings, used to build the string table from the image
+ */
+#define HAL_DBG_TRACE_DEFERRED_FMT_SYMBOL "hal_dbg_trace_fmt"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Record levels
+ *
+ * The payload of a PRINTF to ERROR record holds the arguments of the format string, in order:
+ * - integers, characters and pointers on 4 bytes, little endian - 8 bytes with the ll and j length modifiers
+ * - floating point values as 8-byte doubles
+ * - strings as their characters followed by a null character
+ *
+ * The format string of an ARRAY or PACKARRAY record is the message, and the payload the array itself.
+ */
+typedef enum hal_dbg_trace_deferred_level_e
+{
+    HAL_DBG_TRACE_DEFERRED_LEVEL_PRINTF    = 0,
+    HAL_DBG_TRACE_DEFERRED_LEVEL_INFO      = 1,
+    HAL_DBG_TRACE_DEFERRED_LEVEL_WARNING   = 2,
+    HAL_DBG_TRACE_DEFERRED_LEVEL_ERROR     = 3,
+    HAL_DBG_TRACE_DEFERRED_LEVEL_ARRAY     = 4,
+    HAL_DBG_TRACE_DEFERRED_LEVEL_PACKARRAY = 5,
+} hal_dbg_trace_deferred_level_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Encode a formatted message as a record, without formatting it
+ *
+ * @param [out] record Buffer of at least HAL_DBG_TRACE_DEFERRED_RECORD_LENGTH_MAX bytes
+ * @param [in] level Record level, PRINTF to ERROR
+ * @param [in] fmt Format string - its address identifies it in the string table
+ * @param [in] argp Arguments of the format string
+ *
+ * @returns Record length in bytes
+ */
+uint16_t hal_dbg_trace_deferred_encode( uint8_t* record, hal_dbg_trace_deferred_level_t level, const char* fmt,
+                                        va_list argp );
+
+/**
+ * @brief Encode an array as a record
+ *
+ * @param [out] record Buffer of at least HAL_DBG_TRACE_DEFERRED_RECORD_LENGTH_MAX bytes
+ * @param [in] level Record level, ARRAY or PACKARRAY
+ * @param [in] msg Message - its address identifies it in the string table
+ * @param [in] array Array to encode - truncated to HAL_DBG_TRACE_DEFERRED_PAYLOAD_LENGTH_MAX bytes
+ * @param [in] length Array length in bytes
+ *
+ * @returns Record length in bytes
+ */
+uint16_t hal_dbg_trace_deferred_encode_array( uint8_t* record, hal_dbg_trace_deferred_level_t level, const char* msg,
+                                              const uint8_t* array, uint32_t length );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // SMTC_HAL_DBG_TRACE_DEFERRED_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -64,6 +64,11 @@ extern "C" {
 #endif // HAL_DBG_TRACE
 #define HAL_DBG_TRACE_COLOR                         HAL_FEATURE_ON
 
+/* HAL_FEATURE_ON to send binary records decoded on the host by tools/trace_decoder instead of formatted text */
+#ifndef HAL_DBG_TRACE_DEFERRED
+#define HAL_DBG_TRACE_DEFERRED                      HAL_FEATURE_OFF
+#endif // HAL_DBG_TRACE_DEFERRED
+
 /* HAL_FEATURE_ON to activate sleep mode */
 
 /* HAL_FEATURE_OFF to deactivate sleep mode */
@@ -73,6 +78,11 @@ extern "C" {
 #define HAL_HW_DEBUG_PROBE                          HAL_FEATURE_OFF
 
 #define HAL_USE_PRINTF_UART                         HAL_FEATURE_ON
+
+/* Baud rate of the UART receiving the printf output */
+#ifndef HAL_PRINTF_UART_BAUDRATE
+#define HAL_PRINTF_UART_BAUDRATE                    921600
+#endif // HAL_PRINTF_UART_BAUDRATE
 #define HAL_PRINT_BUFFER_SIZE                       255
 
 /* HAL_FEATURE_OFF to not use watchdog */
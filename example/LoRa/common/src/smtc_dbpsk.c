@@ -43,6 +43,52 @@
 
 #include "smtc_dbpsk.h"
 
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*!
+ * \brief Differential encoding of one byte, starting from phase state 0
+ *
+ * Output bit 7-j is the phase state after the j first input bits (MSB first): the state flips on every 0 input bit.
+ * When starting from phase state 1, the output byte is inverted. The phase state after the whole byte is bit 0 of the
+ * output, flipped if bit 0 of the input is 0.
+ */
+static const uint8_t smtc_dbpsk_byte_lut[256] = {
+    0x55, 0x55, 0x54, 0x54, 0x56, 0x56, 0x57, 0x57, 0x52, 0x52, 0x53, 0x53, 0x51, 0x51, 0x50, 0x50,
+    0x5A, 0x5A, 0x5B, 0x5B, 0x59, 0x59, 0x58, 0x58, 0x5D, 0x5D, 0x5C, 0x5C, 0x5E, 0x5E, 0x5F, 0x5F,
+    0x4A, 0x4A, 0x4B, 0x4B, 0x49, 0x49, 0x48, 0x48, 0x4D, 0x4D, 0x4C, 0x4C, 0x4E, 0x4E, 0x4F, 0x4F,
+    0x45, 0x45, 0x44, 0x44, 0x46, 0x46, 0x47, 0x47, 0x42, 0x42, 0x43, 0x43, 0x41, 0x41, 0x40, 0x40,
+    0x6A, 0x6A, 0x6B, 0x6B, 0x69, 0x69, 0x68, 0x68, 0x6D, 0x6D, 0x6C, 0x6C, 0x6E, 0x6E, 0x6F, 0x6F,
+    0x65, 0x65, 0x64, 0x64, 0x66, 0x66, 0x67, 0x67, 0x62, 0x62, 0x63, 0x63, 0x61, 0x61, 0x60, 0x60,
+    0x75, 0x75, 0x74, 0x74, 0x76, 0x76, 0x77, 0x77, 0x72, 0x72, 0x73, 0x73, 0x71, 0x71, 0x70, 0x70,
+    0x7A, 0x7A, 0x7B, 0x7B, 0x79, 0x79, 0x78, 0x78, 0x7D, 0x7D, 0x7C, 0x7C, 0x7E, 0x7E, 0x7F, 0x7F,
+    0x2A, 0x2A, 0x2B, 0x2B, 0x29, 0x29, 0x28, 0x28, 0x2D, 0x2D, 0x2C, 0x2C, 0x2E, 0x2E, 0x2F, 0x2F,
+    0x25, 0x25, 0x24, 0x24, 0x26, 0x26, 0x27, 0x27, 0x22, 0x22, 0x23, 0x23, 0x21, 0x21, 0x20, 0x20,
+    0x35, 0x35, 0x34, 0x34, 0x36, 0x36, 0x37, 0x37, 0x32, 0x32, 0x33, 0x33, 0x31, 0x31, 0x30, 0x30,
+    0x3A, 0x3A, 0x3B, 0x3B, 0x39, 0x39, 0x38, 0x38, 0x3D, 0x3D, 0x3C, 0x3C, 0x3E, 0x3E, 0x3F, 0x3F,
+    0x15, 0x15, 0x14, 0x14, 0x16, 0x16, 0x17, 0x17, 0x12, 0x12, 0x13, 0x13, 0x11, 0x11, 0x10, 0x10,
+    0x1A, 0x1A, 0x1B, 0x1B, 0x19, 0x19, 0x18, 0x18, 0x1D, 0x1D, 0x1C, 0x1C, 0x1E, 0x1E, 0x1F, 0x1F,
+    0x0A, 0x0A, 0x0B, 0x0B, 0x09, 0x09, 0x08, 0x08, 0x0D, 0x0D, 0x0C, 0x0C, 0x0E, 0x0E, 0x0F, 0x0F,
+    0x05, 0x05, 0x04, 0x04, 0x06, 0x06, 0x07, 0x07, 0x02, 0x02, 0x03, 0x03, 0x01, 0x01, 0x00, 0x00,
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTION PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * \brief Perform differential encoding of a 32-bit word, MSB first
+ *
+ * \param [in]     word  Input word
+ * \param [in,out] state Phase state before the word, updated to the phase state after the word (0 or 1)
+ *
+ * \returns              Encoded word
+ */
+static inline uint32_t smtc_dbpsk_encode_word( uint32_t word, uint8_t* state );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTION DEFINITIONS ---------------------------------------------
@@ -50,51 +96,75 @@
 
 void smtc_dbpsk_encode_buffer( const uint8_t* data_in, int bpsk_pld_len_in_bits, uint8_t* data_out )
 {
+    int     data_in_bytecount = bpsk_pld_len_in_bits >> 3;
+    int     nb_remaining_bits = bpsk_pld_len_in_bits & 7;
+    uint8_t state             = 0;
     uint8_t in_byte;
     uint8_t out_byte;
 
-    int data_in_bytecount = bpsk_pld_len_in_bits >> 3;
-    in_byte               = *data_in++;
+    // Process full words - the input word is read before the output word is written, so data_out can be data_in
+    for( ; data_in_bytecount >= 4; data_in_bytecount -= 4 )
+    {
+        const uint32_t in_word = ( ( uint32_t ) data_in[0] << 24 ) | ( ( uint32_t ) data_in[1] << 16 ) |
+                                 ( ( uint32_t ) data_in[2] << 8 ) | ( ( uint32_t ) data_in[3] << 0 );
+        const uint32_t out_word = smtc_dbpsk_encode_word( in_word, &state );
 
-    uint8_t current = 0;
+        data_out[0] = ( uint8_t ) ( out_word >> 24 );
+        data_out[1] = ( uint8_t ) ( out_word >> 16 );
+        data_out[2] = ( uint8_t ) ( out_word >> 8 );
+        data_out[3] = ( uint8_t ) ( out_word >> 0 );
+        data_in += 4;
+        data_out += 4;
+    }
 
-    // Process full bytes
+    // Process remaining full bytes
     while( --data_in_bytecount >= 0 )
     {
-        for( int i = 0; i < 8; ++i )
-        {
-            out_byte = ( out_byte << 1 ) | current;
-            if( ( in_byte & 0x80 ) == 0 )
-            {
-                current = current ^ 0x01;
-            }
-            in_byte <<= 1;
-        }
         in_byte     = *data_in++;
+        out_byte    = smtc_dbpsk_byte_lut[in_byte] ^ ( uint8_t ) ( -state );
+        state       = ( out_byte ^ ~in_byte ) & 0x01;
         *data_out++ = out_byte;
     }
 
-    // Process remaining bits
-    for( int i = 0; i < ( bpsk_pld_len_in_bits & 7 ); ++i )
-    {
-        out_byte = ( out_byte << 1 ) | current;
-        if( ( in_byte & 0x80 ) == 0 )
-        {
-            current = current ^ 0x01;
-        }
-        in_byte <<= 1;
-    }
+    // Process remaining bits and last data bit: output bit 7-nb_remaining_bits is the final phase state
+    in_byte  = ( nb_remaining_bits != 0 ) ? *data_in : 0xFF;
+    out_byte = smtc_dbpsk_byte_lut[in_byte] ^ ( uint8_t ) ( -state );
+    state    = ( out_byte >> ( 7 - nb_remaining_bits ) ) & 0x01;
+    out_byte &= ( uint8_t ) ( 0xFF00 >> ( nb_remaining_bits + 1 ) );
 
-    // Process last data bit
-    out_byte = ( out_byte << 1 ) | current;
-    if( ( bpsk_pld_len_in_bits & 7 ) == 7 )
+    // Add duplicate bit and store
+    if( nb_remaining_bits == 7 )
     {
         *data_out++ = out_byte;
+        *data_out   = ( uint8_t ) ( state << 7 );
+    }
+    else
+    {
+        *data_out = out_byte | ( uint8_t ) ( state << ( 6 - nb_remaining_bits ) );
     }
+}
 
-    // Add duplicate bit and store
-    out_byte  = ( out_byte << 1 ) | current;
-    *data_out = out_byte << ( 7 - ( ( bpsk_pld_len_in_bits + 1 ) & 7 ) );
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTION DEFINITIONS --------------------------------------------
+ */
+
+static inline uint32_t smtc_dbpsk_encode_word( uint32_t word, uint8_t* state )
+{
+    // Prefix XOR of the inverted input: bit 31-j is the phase flip after the j+1 first input bits
+    uint32_t flips = ~word;
+
+    flips ^= flips >> 1;
+    flips ^= flips >> 2;
+    flips ^= flips >> 4;
+    flips ^= flips >> 8;
+    flips ^= flips >> 16;
+
+    const uint32_t out_word = ( flips >> 1 ) ^ ( uint32_t ) ( -( int32_t ) *state );
+
+    *state ^= ( uint8_t ) ( flips & 0x01 );
+
+    return out_word;
 }
 
 /* --- EOF ------------------------------------------------------------------ */
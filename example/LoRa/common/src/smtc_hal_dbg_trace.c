@@ -42,6 +42,7 @@
 #include <stdio.h>
 
 #include "uart_init.h"
+#include "smtc_hal_dbg_trace.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -81,6 +82,26 @@ void hal_mcu_trace_print( const char* fmt, ... )
     va_end( argp );
 }
 
+void hal_mcu_trace_deferred( hal_dbg_trace_deferred_level_t level, const char* fmt, ... )
+{
+    uint8_t record[HAL_DBG_TRACE_DEFERRED_RECORD_LENGTH_MAX];
+    va_list argp;
+
+    va_start( argp, fmt );
+    const uint16_t length = hal_dbg_trace_deferred_encode( record, level, fmt, argp );
+    va_end( argp );
+
+    uart_write( record, length );
+}
+
+void hal_mcu_trace_deferred_array( hal_dbg_trace_deferred_level_t level, const char* msg, const uint8_t* array,
+                                   uint32_t length )
+{
+    uint8_t record[HAL_DBG_TRACE_DEFERRED_RECORD_LENGTH_MAX];
+
+    uart_write( record, hal_dbg_trace_deferred_encode_array( record, level, msg, array, length ) );
+}
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
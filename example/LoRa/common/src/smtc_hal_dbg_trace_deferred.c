@@ -0,0 +1,294 @@
+/*!
+ * @file      smtc_hal_dbg_trace_deferred.c
+ *
+ * @brief     Compact binary records for deferred formatting of debug traces
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include "smtc_hal_dbg_trace_deferred.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief Payload being built
+ */
+typedef struct hal_dbg_trace_deferred_payload_s
+{
+    uint8_t* buffer;
+    uint16_t length;
+    bool     is_full;  //!< An argument did not fit, the following ones are left out
+} hal_dbg_trace_deferred_payload_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Write the record header
+ *
+ * @param [out] record Record buffer
+ * @param [in] level Record level
+ * @param [in] fmt Format string
+ * @param [in] payload_length Payload length in bytes
+ *
+ * @returns Record length in bytes
+ */
+static uint16_t hal_dbg_trace_deferred_put_header( uint8_t* record, hal_dbg_trace_deferred_level_t level,
+                                                   const char* fmt, uint16_t payload_length );
+
+/**
+ * @brief Append bytes to the payload, unless they do not fit
+ *
+ * @param [in,out] payload Payload being built
+ * @param [in] data Bytes to append
+ * @param [in] length Number of bytes
+ */
+static void hal_dbg_trace_deferred_put( hal_dbg_trace_deferred_payload_t* payload, const void* data, uint16_t length );
+
+/**
+ * @brief Append an integer to the payload, little endian
+ *
+ * @param [in,out] payload Payload being built
+ * @param [in] value Integer value
+ * @param [in] length Number of bytes, 4 or 8
+ */
+static void hal_dbg_trace_deferred_put_int( hal_dbg_trace_deferred_payload_t* payload, uint64_t value,
+                                            uint16_t length );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+uint16_t hal_dbg_trace_deferred_encode( uint8_t* record, hal_dbg_trace_deferred_level_t level, const char* fmt,
+                                        va_list argp )
+{
+    hal_dbg_trace_deferred_payload_t payload = {
+        .buffer  = &record[HAL_DBG_TRACE_DEFERRED_HEADER_LENGTH],
+        .length  = 0,
+        .is_full = false,
+    };
+
+    // Only the conversion specifications are looked at, to know the size of each argument
+    for( const char* p = fmt; ( *p != '\0' ) && ( payload.is_full == false ); p++ )
+    {
+        uint8_t nb_long = 0;
+
+        if( ( *p != '%' ) || ( *( ++p ) == '%' ) )
+        {
+            continue;
+        }
+
+        while( ( *p == '-' ) || ( *p == '+' ) || ( *p == ' ' ) || ( *p == '#' ) || ( *p == '0' ) )
+        {
+            p++;
+        }
+
+        // Width and precision given as arguments are sent like integer arguments
+        if( *p == '*' )
+        {
+            hal_dbg_trace_deferred_put_int( &payload, ( uint32_t ) va_arg( argp, int ), 4 );
+            p++;
+        }
+        while( ( *p >= '0' ) && ( *p <= '9' ) )
+        {
+            p++;
+        }
+        if( *p == '.' )
+        {
+            p++;
+            if( *p == '*' )
+            {
+                hal_dbg_trace_deferred_put_int( &payload, ( uint32_t ) va_arg( argp, int ), 4 );
+                p++;
+            }
+            while( ( *p >= '0' ) && ( *p <= '9' ) )
+            {
+                p++;
+            }
+        }
+
+        while( ( *p == 'h' ) || ( *p == 'l' ) || ( *p == 'L' ) || ( *p == 'j' ) || ( *p == 'z' ) || ( *p == 't' ) )
+        {
+            nb_long += ( *p == 'l' ) ? 1 : ( ( *p == 'j' ) ? 2 : 0 );
+            p++;
+        }
+
+        switch( *p )
+        {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+        case 'c':
+            if( nb_long >= 2 )
+            {
+                hal_dbg_trace_deferred_put_int( &payload, ( uint64_t ) va_arg( argp, long long ), 8 );
+            }
+            else if( nb_long == 1 )
+            {
+                hal_dbg_trace_deferred_put_int( &payload, ( uint32_t ) va_arg( argp, long ), 4 );
+            }
+            else
+            {
+                hal_dbg_trace_deferred_put_int( &payload, ( uint32_t ) va_arg( argp, int ), 4 );
+            }
+            break;
+        case 'p':
+            hal_dbg_trace_deferred_put_int( &payload, ( uint32_t ) ( uintptr_t ) va_arg( argp, void* ), 4 );
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+        {
+            const double value = va_arg( argp, double );
+
+            hal_dbg_trace_deferred_put( &payload, &value, sizeof( value ) );
+            break;
+        }
+        case 's':
+        {
+            const char* string = va_arg( argp, const char* );
+
+            if( string == NULL )
+            {
+                string = "(null)";
+            }
+            hal_dbg_trace_deferred_put( &payload, string, ( uint16_t ) ( strlen( string ) + 1 ) );
+            break;
+        }
+        case 'n':
+            ( void ) va_arg( argp, void* );
+            break;
+        case '\0':
+            // Incomplete specification at the end of the string
+            p--;
+            break;
+        default:
+            break;
+        }
+    }
+
+    return hal_dbg_trace_deferred_put_header( record, level, fmt, payload.length );
+}
+
+uint16_t hal_dbg_trace_deferred_encode_array( uint8_t* record, hal_dbg_trace_deferred_level_t level, const char* msg,
+                                              const uint8_t* array, uint32_t length )
+{
+    if( length > HAL_DBG_TRACE_DEFERRED_PAYLOAD_LENGTH_MAX )
+    {
+        length = HAL_DBG_TRACE_DEFERRED_PAYLOAD_LENGTH_MAX;
+    }
+
+    memcpy( &record[HAL_DBG_TRACE_DEFERRED_HEADER_LENGTH], array, length );
+
+    return hal_dbg_trace_deferred_put_header( record, level, msg, ( uint16_t ) length );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static uint16_t hal_dbg_trace_deferred_put_header( uint8_t* record, hal_dbg_trace_deferred_level_t level,
+                                                   const char* fmt, uint16_t payload_length )
+{
+    const uint32_t address = ( uint32_t ) ( uintptr_t ) fmt;
+
+    record[0] = ( uint8_t ) ( HAL_DBG_TRACE_DEFERRED_TAG | level );
+    record[1] = ( uint8_t ) ( address >> 0 );
+    record[2] = ( uint8_t ) ( address >> 8 );
+    record[3] = ( uint8_t ) ( address >> 16 );
+    record[4] = ( uint8_t ) ( address >> 24 );
+    record[5] = ( uint8_t ) payload_length;
+
+    return HAL_DBG_TRACE_DEFERRED_HEADER_LENGTH + payload_length;
+}
+
+static void hal_dbg_trace_deferred_put( hal_dbg_trace_deferred_payload_t* payload, const void* data, uint16_t length )
+{
+    if( ( payload->is_full == true ) || ( length > ( HAL_DBG_TRACE_DEFERRED_PAYLOAD_LENGTH_MAX - payload->length ) ) )
+    {
+        payload->is_full = true;
+        return;
+    }
+
+    memcpy( &payload->buffer[payload->length], data, length );
+    payload->length += length;
+}
+
+static void hal_dbg_trace_deferred_put_int( hal_dbg_trace_deferred_payload_t* payload, uint64_t value,
+                                            uint16_t length )
+{
+    uint8_t bytes[8];
+
+    for( uint16_t i = 0; i < length; i++ )
+    {
+        bytes[i] = ( uint8_t ) ( value >> ( 8 * i ) );
+    }
+
+    hal_dbg_trace_deferred_put( payload, bytes, length );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -505,6 +505,24 @@ smtc_hal_mcu_status_t smtc_hal_mcu_gpio_disable_irq( smtc_hal_mcu_gpio_inst_t in
     return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
 }
 
+smtc_hal_mcu_status_t smtc_hal_mcu_gpio_clear_irq( smtc_hal_mcu_gpio_inst_t inst )
+{
+    if( smtc_hal_mcu_gpio_stm32l4_is_real_inst( inst ) == false )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( inst->is_irq_cfged == true )
+    {
+        // A NVIC pending bit left behind is harmless: the EXTI handlers only call back on a set EXTI flag
+        LL_EXTI_ClearFlag_0_31( inst->irq_cfg.exti_cfg.exti_line );
+
+        return SMTC_HAL_MCU_STATUS_OK;
+    }
+
+    return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+}
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
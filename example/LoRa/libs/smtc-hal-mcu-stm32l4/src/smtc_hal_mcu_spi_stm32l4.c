@@ -39,6 +39,7 @@
 
 #include "stm32l4xx.h"
 #include "stm32l4xx_ll_spi.h"
+#include "stm32l4xx_ll_dma.h"
 #include "stm32l4xx_ll_gpio.h"
 #include "stm32l4xx_ll_bus.h"
 #include "stm32l4xx_ll_system.h"
@@ -59,6 +60,34 @@
 #define SMTC_HAL_MCU_SPI_STM32L4_N_INSTANCES_MAX 4
 #endif
 
+/**
+ * @brief SPI clock prescaler - SYSCLK being 80MHz, DIV8 gives a 10MHz SPI clock
+ */
+#ifndef SMTC_HAL_MCU_SPI_STM32L4_BAUDRATE_PRESCALER
+#define SMTC_HAL_MCU_SPI_STM32L4_BAUDRATE_PRESCALER LL_SPI_BAUDRATEPRESCALER_DIV8
+#endif
+
+/**
+ * @brief Segments shorter than this length are exchanged by polling instead of DMA
+ *
+ * @remark Below a few bytes, the DMA channel programming takes longer than the transfer itself
+ */
+#ifndef SMTC_HAL_MCU_SPI_STM32L4_DMA_MIN_LENGTH
+#define SMTC_HAL_MCU_SPI_STM32L4_DMA_MIN_LENGTH 4
+#endif
+
+/**
+ * @brief NVIC priority of the DMA reception channel interrupt
+ */
+#ifndef SMTC_HAL_MCU_SPI_STM32L4_DMA_IRQ_PRIORITY
+#define SMTC_HAL_MCU_SPI_STM32L4_DMA_IRQ_PRIORITY 0
+#endif
+
+/**
+ * @brief Get the DMA interrupt flags of a channel, shifted to the channel 1 position
+ */
+#define SMTC_HAL_MCU_SPI_STM32L4_DMA_FLAGS( dma, channel ) ( ( ( dma )->ISR >> ( ( channel ) * 4U ) ) & 0x0FU )
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE CONSTANTS -------------------------------------------------------
@@ -69,6 +98,18 @@
  * --- PRIVATE TYPES -----------------------------------------------------------
  */
 
+/**
+ * @brief Structure defining the DMA resources attached to a SPI peripheral
+ */
+typedef struct smtc_hal_mcu_spi_stm32l4_dma_cfg_s
+{
+    DMA_TypeDef* dma;
+    uint32_t     rx_channel;
+    uint32_t     tx_channel;
+    uint32_t     request;
+    IRQn_Type    rx_irq_number;
+} smtc_hal_mcu_spi_stm32l4_dma_cfg_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE VARIABLES -------------------------------------------------------
@@ -79,8 +120,15 @@
  */
 struct smtc_hal_mcu_spi_inst_s
 {
-    bool         is_cfged;
-    SPI_TypeDef* spi;
+    bool                               is_cfged;
+    SPI_TypeDef*                       spi;
+    smtc_hal_mcu_spi_stm32l4_dma_cfg_t dma_cfg;
+    volatile bool                      is_busy;
+    const smtc_hal_mcu_spi_segment_t*  segments;
+    uint8_t                            nb_segments;
+    uint8_t                            segment_index;
+    smtc_hal_mcu_spi_done_callback_t   callback;
+    void*                              context;
 };
 
 /**
@@ -88,6 +136,16 @@ struct smtc_hal_mcu_spi_inst_s
  */
 static struct smtc_hal_mcu_spi_inst_s spi_inst_array[SMTC_HAL_MCU_SPI_STM32L4_N_INSTANCES_MAX];
 
+/**
+ * @brief Byte sent by DMA when a segment has no data to send
+ */
+static const uint8_t spi_dma_tx_dummy = 0x00;
+
+/**
+ * @brief Byte written by DMA when a segment has no buffer to store the received data
+ */
+static uint8_t spi_dma_rx_dummy;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -110,6 +168,57 @@ static struct smtc_hal_mcu_spi_inst_s* smtc_hal_mcu_spi_stm32l4_get_free_slot( v
  */
 static bool smtc_hal_mcu_spi_stm32l4_is_real_inst( smtc_hal_mcu_spi_inst_t inst );
 
+/**
+ * @brief Get the DMA resources attached to a SPI peripheral and configure them
+ *
+ * @param [in] inst SPI instance
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK The DMA channels are configured
+ * @retval SMTC_HAL_MCU_STATUS_BAD_PARAMETERS No DMA channel is available for this SPI peripheral
+ */
+static smtc_hal_mcu_status_t smtc_hal_mcu_spi_stm32l4_dma_init( smtc_hal_mcu_spi_inst_t inst );
+
+/**
+ * @brief Program both DMA channels for a segment and start the exchange
+ *
+ * @param [in] inst SPI instance
+ * @param [in] segment Segment to be exchanged
+ * @param [in] enable_irq Raise an interrupt on reception completion if true, the caller polls the flags otherwise
+ */
+static void smtc_hal_mcu_spi_stm32l4_dma_start( smtc_hal_mcu_spi_inst_t inst, const smtc_hal_mcu_spi_segment_t* segment,
+                                                bool enable_irq );
+
+/**
+ * @brief Stop both DMA channels and release the DMA requests of the SPI peripheral
+ *
+ * @param [in] inst SPI instance
+ */
+static void smtc_hal_mcu_spi_stm32l4_dma_stop( smtc_hal_mcu_spi_inst_t inst );
+
+/**
+ * @brief Exchange the remaining segments of an asynchronous transfer until one needs to wait for the DMA
+ *
+ * @remark Call the completion callback when all segments are exchanged
+ *
+ * @param [in] inst SPI instance
+ */
+static void smtc_hal_mcu_spi_stm32l4_async_continue( smtc_hal_mcu_spi_inst_t inst );
+
+/**
+ * @brief Terminate an asynchronous transfer and call the completion callback
+ *
+ * @param [in] inst SPI instance
+ * @param [in] status Status given to the completion callback
+ */
+static void smtc_hal_mcu_spi_stm32l4_async_complete( smtc_hal_mcu_spi_inst_t inst, smtc_hal_mcu_status_t status );
+
+/**
+ * @brief Handle the DMA reception channel interrupt of a SPI peripheral
+ *
+ * @param [in] spi SPI peripheral
+ */
+static void smtc_hal_mcu_spi_stm32l4_dma_irq_handler( SPI_TypeDef* spi );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -176,7 +285,7 @@ smtc_hal_mcu_status_t smtc_hal_mcu_spi_init( smtc_hal_mcu_spi_cfg_t cfg, smtc_ha
     }
 
     LL_SPI_InitTypeDef SPI_InitStruct = {
-        .BaudRate          = LL_SPI_BAUDRATEPRESCALER_DIV16,
+        .BaudRate          = SMTC_HAL_MCU_SPI_STM32L4_BAUDRATE_PRESCALER,
         .TransferDirection = LL_SPI_FULL_DUPLEX,
         .Mode              = LL_SPI_MODE_MASTER,
         .DataWidth         = LL_SPI_DATAWIDTH_8BIT,
@@ -197,10 +306,16 @@ smtc_hal_mcu_status_t smtc_hal_mcu_spi_init( smtc_hal_mcu_spi_cfg_t cfg, smtc_ha
     LL_SPI_SetStandard( spi_cfg_slot->spi, LL_SPI_PROTOCOL_MOTOROLA );
     LL_SPI_DisableNSSPulseMgt( spi_cfg_slot->spi );
 
+    if( smtc_hal_mcu_spi_stm32l4_dma_init( spi_cfg_slot ) != SMTC_HAL_MCU_STATUS_OK )
+    {
+        return SMTC_HAL_MCU_STATUS_ERROR;
+    }
+
     LL_SPI_Enable( spi_cfg_slot->spi );
     while( LL_SPI_IsEnabled( spi_cfg_slot->spi ) == 0 )
         ;
 
+    spi_cfg_slot->is_busy  = false;
     spi_cfg_slot->is_cfged = true;
 
     *inst = spi_cfg_slot;
@@ -222,8 +337,15 @@ smtc_hal_mcu_status_t smtc_hal_mcu_spi_deinit( smtc_hal_mcu_spi_inst_t* inst )
         return SMTC_HAL_MCU_STATUS_NOT_INIT;
     }
 
+    if( inst_local->is_busy == true )
+    {
+        return SMTC_HAL_MCU_STATUS_ERROR;
+    }
+
     if( inst_local->spi == SPI1 )
     {
+        NVIC_DisableIRQ( inst_local->dma_cfg.rx_irq_number );
+
         if( LL_SPI_DeInit( inst_local->spi ) != SUCCESS )
         {
             return SMTC_HAL_MCU_STATUS_ERROR;
@@ -298,6 +420,106 @@ smtc_hal_mcu_status_t smtc_hal_mcu_spi_rw_buffer( smtc_hal_mcu_spi_inst_t inst,
     return SMTC_HAL_MCU_STATUS_OK;
 }
 
+smtc_hal_mcu_status_t smtc_hal_mcu_spi_rw_segments( smtc_hal_mcu_spi_inst_t inst, const smtc_hal_mcu_spi_segment_t* segments,
+                                                    uint8_t nb_segments )
+{
+    if( ( smtc_hal_mcu_spi_stm32l4_is_real_inst( inst ) == false ) || ( ( segments == NULL ) && ( nb_segments > 0 ) ) )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( inst->is_cfged == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    if( inst->is_busy == true )
+    {
+        return SMTC_HAL_MCU_STATUS_ERROR;
+    }
+
+    for( uint8_t i = 0; i < nb_segments; i++ )
+    {
+        const smtc_hal_mcu_spi_segment_t* segment = &segments[i];
+
+        if( segment->data_length < SMTC_HAL_MCU_SPI_STM32L4_DMA_MIN_LENGTH )
+        {
+            smtc_hal_mcu_spi_rw_buffer( inst, segment->data_out, segment->data_in, segment->data_length );
+            continue;
+        }
+
+        smtc_hal_mcu_spi_stm32l4_dma_start( inst, segment, false );
+
+        uint32_t flags;
+        do
+        {
+            flags = SMTC_HAL_MCU_SPI_STM32L4_DMA_FLAGS( inst->dma_cfg.dma, inst->dma_cfg.rx_channel );
+        } while( ( flags & ( DMA_ISR_TCIF1 | DMA_ISR_TEIF1 ) ) == 0 );
+
+        smtc_hal_mcu_spi_stm32l4_dma_stop( inst );
+
+        if( ( flags & DMA_ISR_TEIF1 ) != 0 )
+        {
+            return SMTC_HAL_MCU_STATUS_ERROR;
+        }
+    }
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_spi_rw_segments_async( smtc_hal_mcu_spi_inst_t           inst,
+                                                          const smtc_hal_mcu_spi_segment_t* segments,
+                                                          uint8_t nb_segments, smtc_hal_mcu_spi_done_callback_t callback,
+                                                          void* context )
+{
+    if( ( smtc_hal_mcu_spi_stm32l4_is_real_inst( inst ) == false ) || ( ( segments == NULL ) && ( nb_segments > 0 ) ) ||
+        ( callback == NULL ) )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( inst->is_cfged == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    if( inst->is_busy == true )
+    {
+        return SMTC_HAL_MCU_STATUS_ERROR;
+    }
+
+    inst->segments      = segments;
+    inst->nb_segments   = nb_segments;
+    inst->segment_index = 0;
+    inst->callback      = callback;
+    inst->context       = context;
+    inst->is_busy       = true;
+
+    smtc_hal_mcu_spi_stm32l4_async_continue( inst );
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+bool smtc_hal_mcu_spi_is_busy( smtc_hal_mcu_spi_inst_t inst )
+{
+    if( smtc_hal_mcu_spi_stm32l4_is_real_inst( inst ) == false )
+    {
+        return false;
+    }
+
+    return inst->is_busy;
+}
+
+void DMA1_Channel2_IRQHandler( void )
+{
+    smtc_hal_mcu_spi_stm32l4_dma_irq_handler( SPI1 );
+}
+
+void DMA2_Channel1_IRQHandler( void )
+{
+    smtc_hal_mcu_spi_stm32l4_dma_irq_handler( SPI3 );
+}
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
@@ -329,4 +551,180 @@ static bool smtc_hal_mcu_spi_stm32l4_is_real_inst( smtc_hal_mcu_spi_inst_t inst
     return false;
 }
 
+static smtc_hal_mcu_status_t smtc_hal_mcu_spi_stm32l4_dma_init( smtc_hal_mcu_spi_inst_t inst )
+{
+    smtc_hal_mcu_spi_stm32l4_dma_cfg_t* dma_cfg = &inst->dma_cfg;
+
+    if( inst->spi == SPI1 )
+    {
+        LL_AHB1_GRP1_EnableClock( LL_AHB1_GRP1_PERIPH_DMA1 );
+
+        dma_cfg->dma           = DMA1;
+        dma_cfg->rx_channel    = LL_DMA_CHANNEL_2;
+        dma_cfg->tx_channel    = LL_DMA_CHANNEL_3;
+        dma_cfg->request       = LL_DMA_REQUEST_1;
+        dma_cfg->rx_irq_number = DMA1_Channel2_IRQn;
+    }
+    else if( inst->spi == SPI3 )
+    {
+        LL_AHB1_GRP1_EnableClock( LL_AHB1_GRP1_PERIPH_DMA2 );
+
+        dma_cfg->dma           = DMA2;
+        dma_cfg->rx_channel    = LL_DMA_CHANNEL_1;
+        dma_cfg->tx_channel    = LL_DMA_CHANNEL_2;
+        dma_cfg->request       = LL_DMA_REQUEST_3;
+        dma_cfg->rx_irq_number = DMA2_Channel1_IRQn;
+    }
+    else
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    LL_DMA_ConfigTransfer( dma_cfg->dma, dma_cfg->rx_channel,
+                           LL_DMA_DIRECTION_PERIPH_TO_MEMORY | LL_DMA_PRIORITY_HIGH | LL_DMA_MODE_NORMAL |
+                               LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT | LL_DMA_PDATAALIGN_BYTE |
+                               LL_DMA_MDATAALIGN_BYTE );
+    LL_DMA_SetPeriphAddress( dma_cfg->dma, dma_cfg->rx_channel, LL_SPI_DMA_GetRegAddr( inst->spi ) );
+    LL_DMA_SetPeriphRequest( dma_cfg->dma, dma_cfg->rx_channel, dma_cfg->request );
+
+    LL_DMA_ConfigTransfer( dma_cfg->dma, dma_cfg->tx_channel,
+                           LL_DMA_DIRECTION_MEMORY_TO_PERIPH | LL_DMA_PRIORITY_MEDIUM | LL_DMA_MODE_NORMAL |
+                               LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT | LL_DMA_PDATAALIGN_BYTE |
+                               LL_DMA_MDATAALIGN_BYTE );
+    LL_DMA_SetPeriphAddress( dma_cfg->dma, dma_cfg->tx_channel, LL_SPI_DMA_GetRegAddr( inst->spi ) );
+    LL_DMA_SetPeriphRequest( dma_cfg->dma, dma_cfg->tx_channel, dma_cfg->request );
+
+    NVIC_SetPriority( dma_cfg->rx_irq_number, SMTC_HAL_MCU_SPI_STM32L4_DMA_IRQ_PRIORITY );
+    NVIC_EnableIRQ( dma_cfg->rx_irq_number );
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+static void smtc_hal_mcu_spi_stm32l4_dma_start( smtc_hal_mcu_spi_inst_t inst, const smtc_hal_mcu_spi_segment_t* segment,
+                                                bool enable_irq )
+{
+    DMA_TypeDef*   dma        = inst->dma_cfg.dma;
+    const uint32_t rx_channel = inst->dma_cfg.rx_channel;
+    const uint32_t tx_channel = inst->dma_cfg.tx_channel;
+
+    WRITE_REG( dma->IFCR, ( DMA_IFCR_CGIF1 << ( rx_channel * 4U ) ) | ( DMA_IFCR_CGIF1 << ( tx_channel * 4U ) ) );
+
+    if( segment->data_in != NULL )
+    {
+        LL_DMA_SetMemoryAddress( dma, rx_channel, ( uint32_t ) segment->data_in );
+        LL_DMA_SetMemoryIncMode( dma, rx_channel, LL_DMA_MEMORY_INCREMENT );
+    }
+    else
+    {
+        LL_DMA_SetMemoryAddress( dma, rx_channel, ( uint32_t ) &spi_dma_rx_dummy );
+        LL_DMA_SetMemoryIncMode( dma, rx_channel, LL_DMA_MEMORY_NOINCREMENT );
+    }
+
+    if( segment->data_out != NULL )
+    {
+        LL_DMA_SetMemoryAddress( dma, tx_channel, ( uint32_t ) segment->data_out );
+        LL_DMA_SetMemoryIncMode( dma, tx_channel, LL_DMA_MEMORY_INCREMENT );
+    }
+    else
+    {
+        LL_DMA_SetMemoryAddress( dma, tx_channel, ( uint32_t ) &spi_dma_tx_dummy );
+        LL_DMA_SetMemoryIncMode( dma, tx_channel, LL_DMA_MEMORY_NOINCREMENT );
+    }
+
+    LL_DMA_SetDataLength( dma, rx_channel, segment->data_length );
+    LL_DMA_SetDataLength( dma, tx_channel, segment->data_length );
+
+    if( enable_irq == true )
+    {
+        LL_DMA_EnableIT_TC( dma, rx_channel );
+        LL_DMA_EnableIT_TE( dma, rx_channel );
+    }
+    else
+    {
+        LL_DMA_DisableIT_TC( dma, rx_channel );
+        LL_DMA_DisableIT_TE( dma, rx_channel );
+    }
+
+    // Sequence from the reference manual: reception request first, then channels, then transmission request
+    LL_SPI_EnableDMAReq_RX( inst->spi );
+    LL_DMA_EnableChannel( dma, rx_channel );
+    LL_DMA_EnableChannel( dma, tx_channel );
+    LL_SPI_EnableDMAReq_TX( inst->spi );
+}
+
+static void smtc_hal_mcu_spi_stm32l4_dma_stop( smtc_hal_mcu_spi_inst_t inst )
+{
+    DMA_TypeDef* dma = inst->dma_cfg.dma;
+
+    LL_SPI_DisableDMAReq_TX( inst->spi );
+    LL_DMA_DisableChannel( dma, inst->dma_cfg.tx_channel );
+    LL_DMA_DisableChannel( dma, inst->dma_cfg.rx_channel );
+    LL_SPI_DisableDMAReq_RX( inst->spi );
+
+    WRITE_REG( dma->IFCR, ( DMA_IFCR_CGIF1 << ( inst->dma_cfg.rx_channel * 4U ) ) |
+                              ( DMA_IFCR_CGIF1 << ( inst->dma_cfg.tx_channel * 4U ) ) );
+}
+
+static void smtc_hal_mcu_spi_stm32l4_async_continue( smtc_hal_mcu_spi_inst_t inst )
+{
+    while( inst->segment_index < inst->nb_segments )
+    {
+        const smtc_hal_mcu_spi_segment_t* segment = &inst->segments[inst->segment_index];
+
+        if( segment->data_length >= SMTC_HAL_MCU_SPI_STM32L4_DMA_MIN_LENGTH )
+        {
+            // The DMA interrupt resumes the transfer once this segment is over
+            smtc_hal_mcu_spi_stm32l4_dma_start( inst, segment, true );
+            return;
+        }
+
+        smtc_hal_mcu_spi_rw_buffer( inst, segment->data_out, segment->data_in, segment->data_length );
+        inst->segment_index++;
+    }
+
+    smtc_hal_mcu_spi_stm32l4_async_complete( inst, SMTC_HAL_MCU_STATUS_OK );
+}
+
+static void smtc_hal_mcu_spi_stm32l4_async_complete( smtc_hal_mcu_spi_inst_t inst, smtc_hal_mcu_status_t status )
+{
+    smtc_hal_mcu_spi_done_callback_t callback = inst->callback;
+
+    inst->callback = NULL;
+    inst->is_busy  = false;
+
+    callback( status, inst->context );
+}
+
+static void smtc_hal_mcu_spi_stm32l4_dma_irq_handler( SPI_TypeDef* spi )
+{
+    for( int i = 0; i < SMTC_HAL_MCU_SPI_STM32L4_N_INSTANCES_MAX; i++ )
+    {
+        smtc_hal_mcu_spi_inst_t inst = &spi_inst_array[i];
+
+        if( ( inst->is_cfged == false ) || ( inst->spi != spi ) || ( inst->is_busy == false ) )
+        {
+            continue;
+        }
+
+        const uint32_t flags = SMTC_HAL_MCU_SPI_STM32L4_DMA_FLAGS( inst->dma_cfg.dma, inst->dma_cfg.rx_channel );
+
+        if( ( flags & ( DMA_ISR_TCIF1 | DMA_ISR_TEIF1 ) ) == 0 )
+        {
+            return;
+        }
+
+        smtc_hal_mcu_spi_stm32l4_dma_stop( inst );
+
+        if( ( flags & DMA_ISR_TEIF1 ) != 0 )
+        {
+            smtc_hal_mcu_spi_stm32l4_async_complete( inst, SMTC_HAL_MCU_STATUS_ERROR );
+            return;
+        }
+
+        inst->segment_index++;
+        smtc_hal_mcu_spi_stm32l4_async_continue( inst );
+        return;
+    }
+}
+
 /* --- EOF ------------------------------------------------------------------ */
@@ -43,6 +43,8 @@
 #include "stm32l4xx_ll_pwr.h"
 #include "stm32l4xx_ll_bus.h"
 #include "stm32l4xx_ll_utils.h"
+#include "stm32l4xx_ll_cortex.h"
+#include "smtc_hal_mcu.h"
 #include "smtc_hal_mcu_status.h"
 #include <stddef.h>
 #include <stdbool.h>
@@ -68,6 +70,11 @@
  * --- PRIVATE VARIABLES -------------------------------------------------------
  */
 
+/**
+ * @brief Number of SysTick periods elapsed since the MCU initialisation
+ */
+static volatile uint32_t smtc_hal_mcu_tick_ms = 0;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -124,6 +131,10 @@ smtc_hal_mcu_status_t smtc_hal_mcu_init( )
 
     LL_Init1msTick( 80000000 );
 
+    // The tick interrupt provides the time base and does not interfere with LL_mDelay which polls COUNTFLAG
+    NVIC_SetPriority( SysTick_IRQn, ( 1UL << __NVIC_PRIO_BITS ) - 1UL );
+    LL_SYSTICK_EnableIT( );
+
     LL_SetSystemCoreClock( 80000000 );
 
     LL_APB2_GRP1_EnableClock( LL_APB2_GRP1_PERIPH_SYSCFG );
@@ -131,6 +142,33 @@ smtc_hal_mcu_status_t smtc_hal_mcu_init( )
     return SMTC_HAL_MCU_STATUS_OK;
 }
 
+uint32_t smtc_hal_mcu_get_time_in_ms( void ) { return smtc_hal_mcu_tick_ms; }
+
+uint32_t smtc_hal_mcu_get_time_in_us( void )
+{
+    uint32_t tick_ms;
+    uint32_t tick_value;
+    bool     is_tick_pending;
+
+    do
+    {
+        tick_ms         = smtc_hal_mcu_tick_ms;
+        tick_value      = SysTick->VAL;
+        is_tick_pending = ( ( SCB->ICSR & SCB_ICSR_PENDSTSET_Msk ) != 0 ) ? true : false;
+    } while( tick_ms != smtc_hal_mcu_tick_ms );
+
+    if( is_tick_pending == true )
+    {
+        // Called with interrupts masked after a reload: account for the tick not yet handled
+        tick_ms++;
+        tick_value = SysTick->VAL;
+    }
+
+    return ( tick_ms * 1000 ) + ( ( SysTick->LOAD - tick_value ) / ( SystemCoreClock / 1000000 ) );
+}
+
+void SysTick_Handler( void ) { smtc_hal_mcu_tick_ms++; }
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
@@ -122,6 +122,19 @@ static struct smtc_hal_mcu_timer_inst_s* smtc_hal_mcu_timer_stm32l4_get_free_slo
  */
 static bool smtc_hal_mcu_timer_stm32l4_is_real_inst( smtc_hal_mcu_timer_inst_t inst );
 
+/**
+ * @brief Program the autoreload value and start counting
+ *
+ * @param [in] inst Timer instance
+ * @param [in] autoreload Autoreload value, in ticks
+ * @param [in] operating_mode LL_LPTIM_OPERATING_MODE_ONESHOT or LL_LPTIM_OPERATING_MODE_CONTINUOUS
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK The timer successfully started
+ * @retval SMTC_HAL_MCU_STATUS_BAD_PARAMETERS The timer peripheral is not supported
+ */
+static smtc_hal_mcu_status_t smtc_hal_mcu_timer_stm32l4_start( smtc_hal_mcu_timer_inst_t inst, uint32_t autoreload,
+                                                               uint32_t operating_mode );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -198,30 +211,28 @@ smtc_hal_mcu_status_t smtc_hal_mcu_timer_start( smtc_hal_mcu_timer_inst_t inst,
         return SMTC_HAL_MCU_STATUS_NOT_INIT;
     }
 
-    if( ( inst->tim == LPTIM1 ) || ( inst->tim == LPTIM2 ) )
-    {
-        LL_LPTIM_EnableIT_ARRM( inst->tim );
-
-        LL_LPTIM_Enable( inst->tim );
-        while( LL_LPTIM_IsEnabled( inst->tim ) != 1 )
-        {
-        }
+    return smtc_hal_mcu_timer_stm32l4_start( inst, timeout_in_ms, LL_LPTIM_OPERATING_MODE_ONESHOT );
+}
 
-        LL_LPTIM_ClearFlag_ARROK( inst->tim );
-        LL_LPTIM_SetAutoReload( inst->tim, timeout_in_ms );
-        while( LL_LPTIM_IsActiveFlag_ARROK( inst->tim ) != 1 )
-        {
-        }
-        LL_LPTIM_ClearFlag_ARROK( inst->tim );
+smtc_hal_mcu_status_t smtc_hal_mcu_timer_start_periodic( smtc_hal_mcu_timer_inst_t inst, uint32_t period_in_ms )
+{
+    if( smtc_hal_mcu_timer_stm32l4_is_real_inst( inst ) == false )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
 
-        LL_LPTIM_StartCounter( inst->tim, LL_LPTIM_OPERATING_MODE_ONESHOT );
+    if( inst->is_cfged == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
     }
-    else
+
+    // The counter goes from 0 to the autoreload value included, which must be greater than the compare value (0)
+    if( ( period_in_ms < 2 ) || ( period_in_ms > ( inst->max_value + 1 ) ) )
     {
         return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
     }
 
-    return SMTC_HAL_MCU_STATUS_OK;
+    return smtc_hal_mcu_timer_stm32l4_start( inst, period_in_ms - 1, LL_LPTIM_OPERATING_MODE_CONTINUOUS );
 }
 
 smtc_hal_mcu_status_t smtc_hal_mcu_timer_stop( smtc_hal_mcu_timer_inst_t inst )
@@ -356,6 +367,35 @@ static bool smtc_hal_mcu_timer_stm32l4_is_real_inst( smtc_hal_mcu_timer_inst_t i
     return false;
 }
 
+static smtc_hal_mcu_status_t smtc_hal_mcu_timer_stm32l4_start( smtc_hal_mcu_timer_inst_t inst, uint32_t autoreload,
+                                                               uint32_t operating_mode )
+{
+    if( ( inst->tim == LPTIM1 ) || ( inst->tim == LPTIM2 ) )
+    {
+        LL_LPTIM_EnableIT_ARRM( inst->tim );
+
+        LL_LPTIM_Enable( inst->tim );
+        while( LL_LPTIM_IsEnabled( inst->tim ) != 1 )
+        {
+        }
+
+        LL_LPTIM_ClearFlag_ARROK( inst->tim );
+        LL_LPTIM_SetAutoReload( inst->tim, autoreload );
+        while( LL_LPTIM_IsActiveFlag_ARROK( inst->tim ) != 1 )
+        {
+        }
+        LL_LPTIM_ClearFlag_ARROK( inst->tim );
+
+        LL_LPTIM_StartCounter( inst->tim, operating_mode );
+    }
+    else
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
 /**
  * @brief  This function handles LPTIM1 interrupts.
  */
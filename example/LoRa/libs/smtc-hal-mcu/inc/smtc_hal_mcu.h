@@ -75,6 +75,24 @@ extern "C" {
  */
 smtc_hal_mcu_status_t smtc_hal_mcu_init( );
 
+/**
+ * @brief Get the time elapsed since the MCU initialisation
+ *
+ * @remark The time base keeps running while the core sleeps in WFI
+ *
+ * @returns Time in milliseconds - wraps around after about 49 days
+ */
+uint32_t smtc_hal_mcu_get_time_in_ms( void );
+
+/**
+ * @brief Get the time elapsed since the MCU initialisation with a microsecond resolution
+ *
+ * @remark Intended for short interval measurements as the value wraps around after about 71 minutes
+ *
+ * @returns Time in microseconds
+ */
+uint32_t smtc_hal_mcu_get_time_in_us( void );
+
 #ifdef __cplusplus
 }
 #endif
@@ -231,6 +231,16 @@ smtc_hal_mcu_status_t smtc_hal_mcu_gpio_enable_irq( smtc_hal_mcu_gpio_inst_t ins
  */
 smtc_hal_mcu_status_t smtc_hal_mcu_gpio_disable_irq( smtc_hal_mcu_gpio_inst_t inst );
 
+/**
+ * @brief Discard an edge latched on a GPIO while its interrupt was disabled
+ *
+ * @param [in] inst GPIO instance
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK Operation completed successfully
+ * @retval SMTC_HAL_MCU_STATUS_BAD_PARAMETERS At least one parameter has an incorrect value
+ */
+smtc_hal_mcu_status_t smtc_hal_mcu_gpio_clear_irq( smtc_hal_mcu_gpio_inst_t inst );
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,6 +45,7 @@ extern "C" {
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "smtc_hal_mcu_status.h"
 
 /*
@@ -76,6 +77,28 @@ typedef struct smtc_hal_mcu_spi_inst_s* smtc_hal_mcu_spi_inst_t;
  */
 typedef struct smtc_hal_mcu_spi_cfg_s* smtc_hal_mcu_spi_cfg_t;
 
+/**
+ * @brief SPI transfer segment structure definition
+ *
+ * @remark A list of segments is exchanged back-to-back, as a single transfer on the bus
+ */
+typedef struct smtc_hal_mcu_spi_segment_s
+{
+    const uint8_t* data_out;     //!< Bytes to be sent - can be NULL, "0x00" bytes are sent in this case
+    uint8_t*       data_in;      //!< Buffer to store bytes received - can be NULL
+    uint16_t       data_length;  //!< Number of bytes to be exchanged - can be 0, the segment is skipped in this case
+} smtc_hal_mcu_spi_segment_t;
+
+/**
+ * @brief SPI transfer completion callback definition
+ *
+ * @remark Called from interrupt context
+ *
+ * @param [in] status SMTC_HAL_MCU_STATUS_OK if all segments have been exchanged, SMTC_HAL_MCU_STATUS_ERROR otherwise
+ * @param [in] context Context given when the transfer was started
+ */
+typedef void ( *smtc_hal_mcu_spi_done_callback_t )( smtc_hal_mcu_status_t status, void* context );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
@@ -122,6 +145,55 @@ smtc_hal_mcu_status_t smtc_hal_mcu_spi_deinit( smtc_hal_mcu_spi_inst_t* inst );
 smtc_hal_mcu_status_t smtc_hal_mcu_spi_rw_buffer( smtc_hal_mcu_spi_inst_t inst, const uint8_t* data_out,
                                                   uint8_t* data_in, uint16_t data_length );
 
+/**
+ * @brief Send / receive a list of segments over a SPI peripheral, as a single transfer
+ *
+ * @remark It is a blocking operation until all segments are exchanged
+ *
+ * @param [in] inst SPI instance
+ * @param [in] segments List of segments to be exchanged
+ * @param [in] nb_segments Number of segments in \p segments
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK The SPI read/write operation terminated successfully
+ * @retval SMTC_HAL_MCU_STATUS_BAD_PARAMETERS The operation failed because one parameter is incorrect
+ * @retval SMTC_HAL_MCU_STATUS_NOT_INIT The operation failed as the \p spi is not initialised
+ * @retval SMTC_HAL_MCU_STATUS_ERROR The operation failed because another error occurred - or a transfer is ongoing
+ */
+smtc_hal_mcu_status_t smtc_hal_mcu_spi_rw_segments( smtc_hal_mcu_spi_inst_t inst, const smtc_hal_mcu_spi_segment_t* segments,
+                                                    uint8_t nb_segments );
+
+/**
+ * @brief Start the exchange of a list of segments over a SPI peripheral, as a single transfer
+ *
+ * @remark The function returns as soon as the transfer is started. \p segments and the buffers they point to must
+ * remain valid until \p callback is called.
+ *
+ * @param [in] inst SPI instance
+ * @param [in] segments List of segments to be exchanged
+ * @param [in] nb_segments Number of segments in \p segments
+ * @param [in] callback Function called once the transfer is over
+ * @param [in] context Context given back to \p callback
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK The transfer has been started
+ * @retval SMTC_HAL_MCU_STATUS_BAD_PARAMETERS The operation failed because one parameter is incorrect
+ * @retval SMTC_HAL_MCU_STATUS_NOT_INIT The operation failed as the \p spi is not initialised
+ * @retval SMTC_HAL_MCU_STATUS_ERROR The operation failed because another error occurred - or a transfer is ongoing
+ */
+smtc_hal_mcu_status_t smtc_hal_mcu_spi_rw_segments_async( smtc_hal_mcu_spi_inst_t           inst,
+                                                          const smtc_hal_mcu_spi_segment_t* segments,
+                                                          uint8_t nb_segments, smtc_hal_mcu_spi_done_callback_t callback,
+                                                          void* context );
+
+/**
+ * @brief Check whether a transfer is ongoing on a SPI peripheral
+ *
+ * @param [in] inst SPI instance
+ *
+ * @retval true A transfer started with @ref smtc_hal_mcu_spi_rw_segments_async is ongoing
+ * @retval false No transfer is ongoing
+ */
+bool smtc_hal_mcu_spi_is_busy( smtc_hal_mcu_spi_inst_t inst );
+
 #ifdef __cplusplus
 }
 #endif
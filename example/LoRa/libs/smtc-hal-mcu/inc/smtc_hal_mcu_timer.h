@@ -131,6 +131,22 @@ smtc_hal_mcu_status_t smtc_hal_mcu_timer_deinit( smtc_hal_mcu_timer_inst_t* inst
  */
 smtc_hal_mcu_status_t smtc_hal_mcu_timer_start( smtc_hal_mcu_timer_inst_t inst, uint32_t timeout_in_ms );
 
+/**
+ * @brief Start the timer in periodic mode
+ *
+ * @remark The expiry function is called every \p period_in_ms. The period is kept by the hardware, so the expiries do
+ * not drift with the latency of the expiry function. Like @ref smtc_hal_mcu_timer_start, it restarts a running timer.
+ *
+ * @param [in] inst Timer instance
+ * @param [in] period_in_ms Period, in milliseconds - from 2 to the maximum value of the timer plus one
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK The timer successfully started
+ * @retval SMTC_HAL_MCU_STATUS_NOT_INIT The operation failed as the timer is not initialised
+ * @retval SMTC_HAL_MCU_STATUS_BAD_PARAMETERS At least one parameter has an incorrect value
+ * @retval SMTC_HAL_MCU_STATUS_ERROR The operation failed because another error occurred
+ */
+smtc_hal_mcu_status_t smtc_hal_mcu_timer_start_periodic( smtc_hal_mcu_timer_inst_t inst, uint32_t period_in_ms );
+
 /**
  * @brief Stop the timer
  *
@@ -0,0 +1,340 @@
+/*!
+ * @file      test_smtc_dbpsk.c
+ *
+ * @brief     Unit tests and benchmark of the DBPSK encoder
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "smtc_dbpsk.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+#define CHECK( condition )                                                                  \
+    do                                                                                      \
+    {                                                                                       \
+        nb_checks++;                                                                        \
+        if( !( condition ) )                                                                \
+        {                                                                                   \
+            fprintf( stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition ); \
+            nb_failures++;                                                                  \
+        }                                                                                   \
+    } while( 0 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*!
+ * \brief Longest input of the exhaustive test, in bits
+ */
+#define EXHAUSTIVE_MAX_LEN_IN_BITS 20
+
+/*!
+ * \brief Longest input of the random test, in bits
+ */
+#define RANDOM_MAX_LEN_IN_BITS 2050
+
+/*!
+ * \brief Number of frames of the random test
+ */
+#define RANDOM_NB_FRAMES 200000
+
+/*!
+ * \brief Value of the bytes after the encoded frame, which must not be overwritten
+ */
+#define GUARD_BYTE 0xA5
+
+/*!
+ * \brief Buffer size: the longest frame, one byte read past its end by the reference encoder, and the guard bytes
+ */
+#define BUFFER_SIZE ( ( RANDOM_MAX_LEN_IN_BITS + 2 + 7 ) / 8 + 8 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static unsigned int nb_checks;
+static unsigned int nb_failures;
+static uint32_t     random_state = 0x12345678;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/*!
+ * \brief Encoder before the word and table based implementation, bit per bit
+ *
+ * Kept as the reference of the tests. The only change is out_byte being initialised: it was shifted before being
+ * written, and its initial bits never reached the output. It reads one byte past the input when the length is a
+ * multiple of 8 bits.
+ */
+static void ref_encode_buffer( const uint8_t* data_in, int bpsk_pld_len_in_bits, uint8_t* data_out )
+{
+    uint8_t in_byte;
+    uint8_t out_byte = 0;
+
+    int data_in_bytecount = bpsk_pld_len_in_bits >> 3;
+    in_byte               = *data_in++;
+
+    uint8_t current = 0;
+
+    // Process full bytes
+    while( --data_in_bytecount >= 0 )
+    {
+        for( int i = 0; i < 8; ++i )
+        {
+            out_byte = ( out_byte << 1 ) | current;
+            if( ( in_byte & 0x80 ) == 0 )
+            {
+                current = current ^ 0x01;
+            }
+            in_byte <<= 1;
+        }
+        in_byte     = *data_in++;
+        *data_out++ = out_byte;
+    }
+
+    // Process remaining bits
+    for( int i = 0; i < ( bpsk_pld_len_in_bits & 7 ); ++i )
+    {
+        out_byte = ( out_byte << 1 ) | current;
+        if( ( in_byte & 0x80 ) == 0 )
+        {
+            current = current ^ 0x01;
+        }
+        in_byte <<= 1;
+    }
+
+    // Process last data bit
+    out_byte = ( out_byte << 1 ) | current;
+    if( ( bpsk_pld_len_in_bits & 7 ) == 7 )
+    {
+        *data_out++ = out_byte;
+    }
+
+    // Add duplicate bit and store
+    out_byte  = ( out_byte << 1 ) | current;
+    *data_out = out_byte << ( 7 - ( ( bpsk_pld_len_in_bits + 1 ) & 7 ) );
+}
+
+static uint32_t random_next( void )
+{
+    // xorshift32
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+/*!
+ * \brief Encode a frame out-of-place and in-place, and compare with the reference encoder
+ *
+ * The bits of the last input byte past the frame are random: they must not change the output.
+ *
+ * \returns true if both encodings match the reference and no guard byte was overwritten
+ */
+static bool check_frame( const uint8_t* data_in, int len_in_bits )
+{
+    const int len_in_bytes = smtc_dbpsk_get_pld_len_in_bytes( len_in_bits );
+    uint8_t   expected[BUFFER_SIZE];
+    uint8_t   out_of_place[BUFFER_SIZE];
+    uint8_t   in_place[BUFFER_SIZE];
+    bool      is_ok;
+
+    ref_encode_buffer( data_in, len_in_bits, expected );
+
+    memset( out_of_place, GUARD_BYTE, sizeof( out_of_place ) );
+    smtc_dbpsk_encode_buffer( data_in, len_in_bits, out_of_place );
+    is_ok = memcmp( out_of_place, expected, len_in_bytes ) == 0;
+
+    memset( in_place, GUARD_BYTE, sizeof( in_place ) );
+    memcpy( in_place, data_in, ( len_in_bits + 7 ) >> 3 );
+    smtc_dbpsk_encode_buffer( in_place, len_in_bits, in_place );
+    is_ok = is_ok && ( memcmp( in_place, expected, len_in_bytes ) == 0 );
+
+    for( int i = len_in_bytes; i < BUFFER_SIZE; i++ )
+    {
+        is_ok = is_ok && ( out_of_place[i] == GUARD_BYTE ) && ( in_place[i] == GUARD_BYTE );
+    }
+
+    return is_ok;
+}
+
+static void test_known_frames( void )
+{
+    const uint8_t ones[2]  = { 0xFF, 0xFF };
+    const uint8_t zeros[2] = { 0x00, 0x00 };
+    uint8_t       out[4]   = { 0 };
+
+    // No phase change on 1 bits, a phase change on every 0 bit, then the final phase state twice
+    smtc_dbpsk_encode_buffer( ones, 16, out );
+    CHECK( ( out[0] == 0x00 ) && ( out[1] == 0x00 ) && ( out[2] == 0x00 ) );
+    smtc_dbpsk_encode_buffer( zeros, 16, out );
+    CHECK( ( out[0] == 0x55 ) && ( out[1] == 0x55 ) && ( out[2] == 0x00 ) );
+
+    // Empty frame: the last bit and its duplicate
+    smtc_dbpsk_encode_buffer( zeros, 0, out );
+    CHECK( out[0] == 0x00 );
+}
+
+static void test_exhaustive( void )
+{
+    for( int len_in_bits = 0; len_in_bits <= EXHAUSTIVE_MAX_LEN_IN_BITS; len_in_bits++ )
+    {
+        unsigned int nb_mismatches = 0;
+
+        for( uint32_t value = 0; value < ( 1UL << len_in_bits ); value++ )
+        {
+            // MSB first, left aligned, random bits after the frame
+            const uint32_t word       = ( len_in_bits == 0 ) ? random_next( )
+                                                             : ( value << ( 32 - len_in_bits ) ) |
+                                                             ( random_next( ) >> len_in_bits );
+            const uint8_t  data_in[4] = { ( uint8_t ) ( word >> 24 ), ( uint8_t ) ( word >> 16 ),
+                                          ( uint8_t ) ( word >> 8 ), ( uint8_t ) word };
+
+            if( !check_frame( data_in, len_in_bits ) )
+            {
+                nb_mismatches++;
+            }
+        }
+        CHECK( nb_mismatches == 0 );
+    }
+}
+
+static void test_random( void )
+{
+    uint8_t      data_in[BUFFER_SIZE];
+    unsigned int nb_mismatches = 0;
+
+    for( unsigned int frame = 0; frame < RANDOM_NB_FRAMES; frame++ )
+    {
+        const int len_in_bits = ( int ) ( random_next( ) % ( RANDOM_MAX_LEN_IN_BITS + 1 ) );
+
+        for( int i = 0; i < BUFFER_SIZE; i++ )
+        {
+            data_in[i] = ( uint8_t ) random_next( );
+        }
+        if( !check_frame( data_in, len_in_bits ) )
+        {
+            nb_mismatches++;
+        }
+    }
+    CHECK( nb_mismatches == 0 );
+}
+
+static double now_in_ns( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return ( double ) now.tv_sec * 1e9 + ( double ) now.tv_nsec;
+}
+
+/*!
+ * \brief Time one encoder on a frame length, in ns per frame
+ */
+static double bench_encoder( void ( *encode )( const uint8_t*, int, uint8_t* ), int len_in_bits )
+{
+    const unsigned int nb_runs = 200000;
+    uint8_t            data_in[BUFFER_SIZE];
+    uint8_t            data_out[BUFFER_SIZE];
+    volatile uint8_t   sink = 0;
+    double             start;
+
+    for( int i = 0; i < BUFFER_SIZE; i++ )
+    {
+        data_in[i] = ( uint8_t ) random_next( );
+    }
+
+    start = now_in_ns( );
+    for( unsigned int run = 0; run < nb_runs; run++ )
+    {
+        data_in[0] = ( uint8_t ) run;
+        encode( data_in, len_in_bits, data_out );
+        sink ^= data_out[len_in_bits >> 3];
+    }
+    ( void ) sink;
+
+    return ( now_in_ns( ) - start ) / nb_runs;
+}
+
+static void bench( void )
+{
+    const int len_in_bytes[] = { 8, 26, 64, 255 };
+
+    printf( "frame [bytes]   previous [ns]   current [ns]\n" );
+    for( size_t i = 0; i < sizeof( len_in_bytes ) / sizeof( len_in_bytes[0] ); i++ )
+    {
+        const int len_in_bits = len_in_bytes[i] * 8;
+
+        printf( "%13d   %13.1f   %12.1f\n", len_in_bytes[i], bench_encoder( ref_encode_buffer, len_in_bits ),
+                bench_encoder( smtc_dbpsk_encode_buffer, len_in_bits ) );
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+int main( int argc, char** argv )
+{
+    if( ( argc > 1 ) && ( strcmp( argv[1], "bench" ) == 0 ) )
+    {
+        bench( );
+        return EXIT_SUCCESS;
+    }
+
+    test_known_frames( );
+    test_exhaustive( );
+    test_random( );
+
+    printf( "%u checks, %u failures\n", nb_checks, nb_failures );
+
+    return ( nb_failures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,335 @@
+/*!
+ * @file      lr11xx_per_stats.c
+ *
+ * @brief     Packet error rate and throughput statistics
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <string.h>
+#include "lr11xx_per_stats.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#if( ( LR11XX_PER_STATS_WINDOW_LENGTH % 32 ) != 0 ) || ( LR11XX_PER_STATS_WINDOW_LENGTH > 0xFFFF )
+#error "LR11XX_PER_STATS_WINDOW_LENGTH must be a multiple of 32, 65504 at most"
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Add expected packets to the sliding window
+ *
+ * @param [in,out] stats Statistics
+ * @param [in] nb_missed Number of missed packets to add before the received one
+ */
+static void lr11xx_per_stats_window_add( lr11xx_per_stats_t* stats, uint32_t nb_missed );
+
+/**
+ * @brief Get the histogram bin of a value
+ *
+ * @param [in] value Value
+ * @param [in] min Lower bound of the first bin
+ * @param [in] bin_width Width of the bins
+ *
+ * @returns Bin index, clamped to the histogram
+ */
+static uint8_t lr11xx_per_stats_get_bin( int16_t value, int16_t min, int16_t bin_width );
+
+/**
+ * @brief Compute a ratio in parts per million
+ *
+ * @param [in] numerator Numerator
+ * @param [in] denominator Denominator - 0 gives 0
+ *
+ * @returns Ratio in parts per million
+ */
+static uint32_t lr11xx_per_stats_get_ppm( uint32_t numerator, uint32_t denominator );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void lr11xx_per_stats_init( lr11xx_per_stats_t* stats, uint8_t seq_nb_length )
+{
+    memset( stats, 0, sizeof( *stats ) );
+
+    stats->seq_nb_mask     = ( seq_nb_length >= 4 ) ? 0xFFFFFFFF : ( ( 1UL << ( 8 * seq_nb_length ) ) - 1 );
+    stats->interval_min_us = UINT32_MAX;
+}
+
+void lr11xx_per_stats_on_rx_done( lr11xx_per_stats_t* stats, uint32_t seq_nb, uint8_t payload_length,
+                                  const lr11xx_radio_pkt_status_lora_t* pkt_status, uint32_t timestamp_us )
+{
+    seq_nb &= stats->seq_nb_mask;
+
+    if( pkt_status != NULL )
+    {
+        stats->rssi_histogram[lr11xx_per_stats_get_bin( pkt_status->rssi_pkt_in_dbm, LR11XX_PER_STATS_RSSI_MIN_DBM,
+                                                        LR11XX_PER_STATS_RSSI_BIN_WIDTH_DB )]++;
+        stats->snr_histogram[lr11xx_per_stats_get_bin( pkt_status->snr_pkt_in_db, LR11XX_PER_STATS_SNR_MIN_DB,
+                                                       LR11XX_PER_STATS_SNR_BIN_WIDTH_DB )]++;
+        stats->rssi_sum += pkt_status->rssi_pkt_in_dbm;
+        stats->snr_sum += pkt_status->snr_pkt_in_db;
+        stats->nb_pkt_status++;
+    }
+
+    if( stats->is_synchronized == false )
+    {
+        stats->is_synchronized   = true;
+        stats->seq_nb_last       = seq_nb;
+        stats->timestamp_last_us = timestamp_us;
+        stats->nb_received++;
+        lr11xx_per_stats_window_add( stats, 0 );
+        return;
+    }
+
+    // Sequence numbers wrap around: the distance is computed modulo their range
+    const uint32_t gap = ( seq_nb - stats->seq_nb_last ) & stats->seq_nb_mask;
+
+    if( gap == 0 )
+    {
+        stats->nb_duplicated++;
+        return;
+    }
+
+    if( gap > ( stats->seq_nb_mask >> 1 ) )
+    {
+        // More likely a jump back than half the sequence range lost: start a new sequence, the time spent between the
+        // two is not part of the goodput
+        stats->nb_resync++;
+        stats->nb_received++;
+        stats->seq_nb_last       = seq_nb;
+        stats->timestamp_last_us = timestamp_us;
+        lr11xx_per_stats_window_add( stats, 0 );
+        return;
+    }
+
+    const uint32_t elapsed_us  = timestamp_us - stats->timestamp_last_us;
+    const uint32_t interval_us = elapsed_us / gap;
+
+    stats->nb_received++;
+    stats->nb_missed += gap - 1;
+    stats->nb_bytes += payload_length;
+    stats->elapsed_us += elapsed_us;
+    lr11xx_per_stats_window_add( stats, gap - 1 );
+
+    // RFC 3550: J += ( |D| - J ) / 16, with D the variation of the interarrival time
+    if( stats->interval_last_us != 0 )
+    {
+        const uint32_t variation_us = ( interval_us > stats->interval_last_us )
+                                          ? ( interval_us - stats->interval_last_us )
+                                          : ( stats->interval_last_us - interval_us );
+
+        stats->jitter_x16_us = stats->jitter_x16_us + variation_us - ( ( stats->jitter_x16_us + 8 ) >> 4 );
+    }
+    stats->interval_last_us = interval_us;
+    if( interval_us < stats->interval_min_us )
+    {
+        stats->interval_min_us = interval_us;
+    }
+    if( interval_us > stats->interval_max_us )
+    {
+        stats->interval_max_us = interval_us;
+    }
+
+    stats->seq_nb_last       = seq_nb;
+    stats->timestamp_last_us = timestamp_us;
+}
+
+void lr11xx_per_stats_on_rx_error( lr11xx_per_stats_t* stats, lr11xx_per_stats_error_t error )
+{
+    if( error < LR11XX_PER_STATS_NB_ERRORS )
+    {
+        stats->nb_errors[error]++;
+    }
+}
+
+void lr11xx_per_stats_update_radio_stats( lr11xx_per_stats_t* stats, const lr11xx_radio_stats_lora_t* radio_stats )
+{
+    // The first read gives the reference, the radio may have counted packets before the test started
+    if( stats->has_radio_stats == true )
+    {
+        stats->radio_nb_pkt_received +=
+            ( uint16_t ) ( radio_stats->nb_pkt_received - stats->radio_stats_last.nb_pkt_received );
+        stats->radio_nb_pkt_crc_error +=
+            ( uint16_t ) ( radio_stats->nb_pkt_crc_error - stats->radio_stats_last.nb_pkt_crc_error );
+        stats->radio_nb_pkt_header_error +=
+            ( uint16_t ) ( radio_stats->nb_pkt_header_error - stats->radio_stats_last.nb_pkt_header_error );
+        stats->radio_nb_pkt_falsesync +=
+            ( uint16_t ) ( radio_stats->nb_pkt_falsesync - stats->radio_stats_last.nb_pkt_falsesync );
+    }
+
+    stats->has_radio_stats  = true;
+    stats->radio_stats_last = *radio_stats;
+}
+
+void lr11xx_per_stats_get_report( const lr11xx_per_stats_t* stats, lr11xx_per_stats_report_t* report )
+{
+    memset( report, 0, sizeof( *report ) );
+
+    report->nb_expected       = stats->nb_received + stats->nb_missed;
+    report->per_in_ppm        = lr11xx_per_stats_get_ppm( stats->nb_missed, report->nb_expected );
+    report->window_length     = stats->window.length;
+    report->window_per_in_ppm = lr11xx_per_stats_get_ppm( stats->window.length - stats->window.nb_received,
+                                                          stats->window.length );
+    report->jitter_us         = ( stats->jitter_x16_us + 8 ) >> 4;
+
+    if( stats->elapsed_us != 0 )
+    {
+        report->goodput_in_bps = ( uint32_t ) ( ( stats->nb_bytes * 8 * 1000000 ) / stats->elapsed_us );
+    }
+
+    if( stats->nb_pkt_status != 0 )
+    {
+        report->rssi_mean_in_dbm = ( int16_t ) ( stats->rssi_sum / ( int64_t ) stats->nb_pkt_status );
+        report->snr_mean_in_db   = ( int16_t ) ( stats->snr_sum / ( int64_t ) stats->nb_pkt_status );
+    }
+}
+
+void lr11xx_per_stats_set_seq_nb( uint8_t* payload, uint8_t seq_nb_length, uint32_t seq_nb )
+{
+    for( uint8_t i = 0; i < seq_nb_length; i++ )
+    {
+        payload[i] = ( uint8_t ) ( seq_nb >> ( 8 * i ) );
+    }
+}
+
+uint32_t lr11xx_per_stats_get_seq_nb( const uint8_t* payload, uint8_t seq_nb_length )
+{
+    uint32_t seq_nb = 0;
+
+    for( uint8_t i = 0; i < seq_nb_length; i++ )
+    {
+        seq_nb |= ( uint32_t ) payload[i] << ( 8 * i );
+    }
+
+    return seq_nb;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void lr11xx_per_stats_window_add( lr11xx_per_stats_t* stats, uint32_t nb_missed )
+{
+    if( nb_missed >= LR11XX_PER_STATS_WINDOW_LENGTH )
+    {
+        // The whole window is made of missed packets
+        memset( stats->window.bits, 0, sizeof( stats->window.bits ) );
+        stats->window.length      = LR11XX_PER_STATS_WINDOW_LENGTH;
+        stats->window.nb_received = 0;
+        nb_missed                 = 0;
+    }
+
+    for( uint32_t i = 0; i <= nb_missed; i++ )
+    {
+        const uint16_t index    = stats->window.index;
+        const uint32_t mask     = 1UL << ( index % 32 );
+        uint32_t*      word     = &stats->window.bits[index / 32];
+        const bool     received = ( i == nb_missed );
+
+        // The oldest bit is overwritten once the window is full
+        if( stats->window.length == LR11XX_PER_STATS_WINDOW_LENGTH )
+        {
+            if( ( *word & mask ) != 0 )
+            {
+                stats->window.nb_received--;
+            }
+        }
+        else
+        {
+            stats->window.length++;
+        }
+
+        if( received == true )
+        {
+            *word |= mask;
+            stats->window.nb_received++;
+        }
+        else
+        {
+            *word &= ~mask;
+        }
+
+        stats->window.index = ( uint16_t ) ( ( index + 1 ) % LR11XX_PER_STATS_WINDOW_LENGTH );
+    }
+}
+
+static uint8_t lr11xx_per_stats_get_bin( int16_t value, int16_t min, int16_t bin_width )
+{
+    if( value < min )
+    {
+        return 0;
+    }
+
+    const int16_t bin = ( value - min ) / bin_width;
+
+    return ( bin >= LR11XX_PER_STATS_NB_BINS ) ? ( LR11XX_PER_STATS_NB_BINS - 1 ) : ( uint8_t ) bin;
+}
+
+static uint32_t lr11xx_per_stats_get_ppm( uint32_t numerator, uint32_t denominator )
+{
+    if( denominator == 0 )
+    {
+        return 0;
+    }
+
+    return ( uint32_t ) ( ( ( uint64_t ) numerator * 1000000 ) / denominator );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,254 @@
+/*!
+ * @file      lr11xx_per_stats.h
+ *
+ * @brief     Packet error rate and throughput statistics
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LR11XX_PER_STATS_H
+#define LR11XX_PER_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lr11xx_radio_types.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Number of expected packets the windowed PER is computed on - must be a multiple of 32
+ */
+#ifndef LR11XX_PER_STATS_WINDOW_LENGTH
+#define LR11XX_PER_STATS_WINDOW_LENGTH ( 128 )
+#endif
+
+/**
+ * @brief Number of bins of the RSSI and SNR histograms - the first and last bins also count the values beyond them
+ */
+#ifndef LR11XX_PER_STATS_NB_BINS
+#define LR11XX_PER_STATS_NB_BINS ( 16 )
+#endif
+
+/**
+ * @brief Lower bound of the first RSSI bin, and width of the RSSI bins
+ */
+#ifndef LR11XX_PER_STATS_RSSI_MIN_DBM
+#define LR11XX_PER_STATS_RSSI_MIN_DBM ( -136 )
+#endif
+#ifndef LR11XX_PER_STATS_RSSI_BIN_WIDTH_DB
+#define LR11XX_PER_STATS_RSSI_BIN_WIDTH_DB ( 6 )
+#endif
+
+/**
+ * @brief Lower bound of the first SNR bin, and width of the SNR bins
+ */
+#ifndef LR11XX_PER_STATS_SNR_MIN_DB
+#define LR11XX_PER_STATS_SNR_MIN_DB ( -20 )
+#endif
+#ifndef LR11XX_PER_STATS_SNR_BIN_WIDTH_DB
+#define LR11XX_PER_STATS_SNR_BIN_WIDTH_DB ( 2 )
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Reception failures
+ */
+typedef enum lr11xx_per_stats_error_e
+{
+    LR11XX_PER_STATS_ERROR_CRC = 0,
+    LR11XX_PER_STATS_ERROR_HEADER,
+    LR11XX_PER_STATS_ERROR_RX_TIMEOUT,
+    LR11XX_PER_STATS_ERROR_FSK_LEN,
+    LR11XX_PER_STATS_NB_ERRORS,
+} lr11xx_per_stats_error_t;
+
+/**
+ * @brief Statistics of a PER / throughput test, on the receiver side
+ *
+ * The lost packets are found from the sequence number carried by each packet, so that a packet that is not seen at
+ * all - not even as a CRC error - is also counted.
+ */
+typedef struct lr11xx_per_stats_s
+{
+    uint32_t seq_nb_mask;        //!< Sequence number range - 0xFF, 0xFFFF or 0xFFFFFFFF
+    bool     is_synchronized;    //!< A valid packet was received, seq_nb_last and timestamp_last_us are meaningful
+    uint32_t seq_nb_last;        //!< Sequence number of the last valid packet
+    uint32_t timestamp_last_us;  //!< Reception time of the last valid packet
+
+    uint32_t nb_received;    //!< Valid packets
+    uint32_t nb_missed;      //!< Packets missing in the sequence
+    uint32_t nb_duplicated;  //!< Valid packets with the sequence number of the previous one
+    uint32_t nb_resync;      //!< Sequence restarts - a jump back, usually a transmitter reset
+    uint32_t nb_errors[LR11XX_PER_STATS_NB_ERRORS];
+
+    uint64_t nb_bytes;    //!< Payload bytes of the valid packets, the first one excluded
+    uint64_t elapsed_us;  //!< Time between the first and the last valid packets of the sequence
+
+    uint32_t interval_last_us;  //!< Time between two consecutive packets, from the last pair of valid packets
+    uint32_t interval_min_us;
+    uint32_t interval_max_us;
+    uint32_t jitter_x16_us;  //!< Interarrival jitter, smoothed as in RFC 3550, times 16
+
+    uint32_t rssi_histogram[LR11XX_PER_STATS_NB_BINS];
+    uint32_t snr_histogram[LR11XX_PER_STATS_NB_BINS];
+    int64_t  rssi_sum;
+    int64_t  snr_sum;
+    uint32_t nb_pkt_status;  //!< Number of packet statuses in the histograms
+
+    struct
+    {
+        uint32_t bits[LR11XX_PER_STATS_WINDOW_LENGTH / 32];  //!< One bit per expected packet, set if received
+        uint16_t index;                                      //!< Next bit to write
+        uint16_t length;                                     //!< Number of expected packets in the window
+        uint16_t nb_received;                                //!< Number of bits set in the window
+    } window;
+
+    bool                      has_radio_stats;
+    lr11xx_radio_stats_lora_t radio_stats_last;  //!< Last raw values of the 16-bit radio counters
+    uint32_t                  radio_nb_pkt_received;
+    uint32_t                  radio_nb_pkt_crc_error;
+    uint32_t                  radio_nb_pkt_header_error;
+    uint32_t                  radio_nb_pkt_falsesync;
+} lr11xx_per_stats_t;
+
+/**
+ * @brief Figures derived from the statistics
+ */
+typedef struct lr11xx_per_stats_report_s
+{
+    uint32_t nb_expected;        //!< Packets sent since the first valid one, as told by the sequence numbers
+    uint32_t per_in_ppm;         //!< Packet error rate since the first valid packet, in parts per million
+    uint16_t window_length;      //!< Number of expected packets the windowed PER is computed on
+    uint32_t window_per_in_ppm;  //!< Packet error rate on the last window_length expected packets
+    uint32_t goodput_in_bps;     //!< Payload bit rate of the valid packets
+    uint32_t jitter_us;          //!< Interarrival jitter
+    int16_t  rssi_mean_in_dbm;
+    int16_t  snr_mean_in_db;
+} lr11xx_per_stats_report_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Reset the statistics
+ *
+ * @param [out] stats Statistics
+ * @param [in] seq_nb_length Length of the sequence number carried by the packets, in bytes - 1, 2 or 4
+ */
+void lr11xx_per_stats_init( lr11xx_per_stats_t* stats, uint8_t seq_nb_length );
+
+/**
+ * @brief Account for a valid packet
+ *
+ * @param [in,out] stats Statistics
+ * @param [in] seq_nb Sequence number carried by the packet
+ * @param [in] payload_length Payload length in bytes
+ * @param [in] pkt_status LoRa packet status, or NULL if there is none - GFSK
+ * @param [in] timestamp_us Reception time - the RX_DONE interrupt edge
+ */
+void lr11xx_per_stats_on_rx_done( lr11xx_per_stats_t* stats, uint32_t seq_nb, uint8_t payload_length,
+                                  const lr11xx_radio_pkt_status_lora_t* pkt_status, uint32_t timestamp_us );
+
+/**
+ * @brief Account for a reception failure
+ *
+ * @remark The packet itself is counted as missed by the next valid one
+ *
+ * @param [in,out] stats Statistics
+ * @param [in] error Failure
+ */
+void lr11xx_per_stats_on_rx_error( lr11xx_per_stats_t* stats, lr11xx_per_stats_error_t error );
+
+/**
+ * @brief Accumulate the LoRa packet counters of the radio
+ *
+ * @remark The radio counters are 16-bit: they must be read often enough not to wrap around twice between two calls
+ *
+ * @param [in,out] stats Statistics
+ * @param [in] radio_stats Counters read with lr11xx_radio_get_lora_stats
+ */
+void lr11xx_per_stats_update_radio_stats( lr11xx_per_stats_t* stats, const lr11xx_radio_stats_lora_t* radio_stats );
+
+/**
+ * @brief Compute the figures derived from the statistics
+ *
+ * @param [in] stats Statistics
+ * @param [out] report Derived figures
+ */
+void lr11xx_per_stats_get_report( const lr11xx_per_stats_t* stats, lr11xx_per_stats_report_t* report );
+
+/**
+ * @brief Write a sequence number at the beginning of a payload, little endian
+ *
+ * @param [out] payload Payload
+ * @param [in] seq_nb_length Sequence number length in bytes - 1, 2 or 4
+ * @param [in] seq_nb Sequence number
+ */
+void lr11xx_per_stats_set_seq_nb( uint8_t* payload, uint8_t seq_nb_length, uint32_t seq_nb );
+
+/**
+ * @brief Read the sequence number at the beginning of a payload
+ *
+ * @param [in] payload Payload
+ * @param [in] seq_nb_length Sequence number length in bytes - 1, 2 or 4
+ *
+ * @returns Sequence number
+ */
+uint32_t lr11xx_per_stats_get_seq_nb( const uint8_t* payload, uint8_t seq_nb_length );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LR11XX_PER_STATS_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -1,13 +1,17 @@
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "apps_common.h"
 #include "apps_utilities.h"
+#include "lr11xx_per_stats.h"
 #include "lr11xx_radio.h"
 #include "lr11xx_regmem.h"
 #include "lr11xx_system.h"
 #include "main_per.h"
 #include "smtc_hal_mcu.h"
+#include "smtc_hal_mcu_timer.h"
+#include "smtc_hal_mcu_timer_stm32l4.h"
 #include "smtc_hal_dbg_trace.h"
 #include "uart_init.h"
 #include "stm32l4xx_ll_utils.h"
@@ -25,6 +29,19 @@
       LR11XX_SYSTEM_IRQ_PREAMBLE_DETECTED | LR11XX_SYSTEM_IRQ_HEADER_ERROR | LR11XX_SYSTEM_IRQ_FSK_LEN_ERROR | \
       LR11XX_SYSTEM_IRQ_CRC_ERROR )
 
+/**
+ * @brief Rx timeout value selecting the Rx continuous mode
+ */
+#define PER_RX_CONTINUOUS_TIMEOUT_IN_RTC_STEP 0xFFFFFF
+
+#if( PER_SEQ_NB_LENGTH != 1 ) && ( PER_SEQ_NB_LENGTH != 2 ) && ( PER_SEQ_NB_LENGTH != 4 )
+#error "PER_SEQ_NB_LENGTH must be 1, 2 or 4"
+#endif
+
+#if( PAYLOAD_LENGTH <= PER_SEQ_NB_LENGTH )
+#error "PAYLOAD_LENGTH is too short for the sequence number"
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE CONSTANTS -------------------------------------------------------
@@ -50,19 +67,23 @@ static lr11xx_hal_context_t* context;
 
 static uint8_t buffer[PAYLOAD_LENGTH];
 
-static uint16_t nb_ok            = 0;
-static uint16_t nb_rx_timeout    = 0;
-static uint16_t nb_rx_error      = 0;
-static uint16_t nb_fsk_len_error = 0;
-
-static uint8_t rolling_counter = 0;
-
-static uint16_t per_index      = 0;
-static bool     first_pkt_flag = false;
-
 static uint8_t  per_msg[PAYLOAD_LENGTH];
 static uint32_t rx_timeout = RX_TIMEOUT_VALUE;
 
+#if( RECEIVER == 1 )
+static lr11xx_per_stats_t per_stats;
+static uint32_t           per_stats_report_time_ms;  //!< Time of the next statistics report
+#else
+static uint32_t seq_nb = 0;
+#endif
+
+#if( RECEIVER == 0 )
+static smtc_hal_mcu_timer_inst_t tx_timer;              //!< Paces the transmissions
+static volatile bool             is_tx_due   = false;  //!< Set by tx_timer, cleared when the transmission starts
+static volatile bool             is_tx_ready = false;  //!< Next payload loaded in the radio, Tx not started yet
+static volatile uint16_t         nb_tx_late  = 0;      //!< Periods that expired before the payload was ready
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -71,9 +92,69 @@ static uint32_t rx_timeout = RX_TIMEOUT_VALUE;
 /**
  * @brief Handle reception failure for PER example
  *
- * @param [in] failure_counter pointer to the counter for each type of reception failure
+ * @param [in] error Type of reception failure
  */
-static void per_reception_failure_handling( uint16_t* failure_counter );
+static void per_reception_failure_handling( lr11xx_per_stats_error_t error );
+
+/**
+ * @brief Get the receiver ready for the next frame
+ *
+ * In Rx continuous mode the radio is already receiving, nothing is done.
+ */
+static void per_restart_rx( void );
+
+/**
+ * @brief Sleep until the next interrupt, unless there is work pending
+ */
+static void per_sleep( void );
+
+#if( RECEIVER == 1 )
+/**
+ * @brief Print the statistics report if its period expired
+ */
+static void per_stats_process( void );
+
+/**
+ * @brief Print a histogram of the statistics report on a single line
+ *
+ * @param [in] name Name of the histogram
+ * @param [in] histogram Histogram bins
+ * @param [in] min Lower bound of the first bin
+ * @param [in] bin_width Width of the bins
+ */
+static void per_stats_print_histogram( const char* name, const uint32_t* histogram, int16_t min, int16_t bin_width );
+#endif
+
+#if( RECEIVER == 0 )
+/**
+ * @brief Start the paced transmissions, the first one right away
+ */
+static void per_tx_init( void );
+
+/**
+ * @brief Start the transmission of the payload loaded in the radio
+ */
+static void per_tx_start( void );
+
+/**
+ * @brief Start the transmission if its period expired and the payload is ready
+ */
+static void per_tx_process( void );
+
+/**
+ * @brief Expiry of tx_timer - interrupt context
+ */
+static void per_tx_on_timer( void );
+
+/**
+ * @brief TX_DONE handler - load the next payload, and start it right away in the maximum rate mode
+ *
+ * @param [in] context Radio context
+ * @param [in] irq_regs Interrupts being served
+ * @param [in] timestamp_us Time of the interrupt edge
+ */
+static void per_tx_on_tx_done_irq( const void* context, lr11xx_system_irq_mask_t irq_regs, uint32_t timestamp_us );
+#endif
 
 /*
  * -----------------------------------------------------------------------------
@@ -101,62 +182,40 @@ int main( void )
     ASSERT_LR11XX_RC( lr11xx_system_set_dio_irq_params( context, IRQ_MASK, 0 ) );
     ASSERT_LR11XX_RC( lr11xx_system_clear_irq_status( context, LR11XX_SYSTEM_IRQ_ALL_MASK ) );
 
-    for( int i = 1; i < PAYLOAD_LENGTH; i++ )
+    for( int i = PER_SEQ_NB_LENGTH; i < PAYLOAD_LENGTH; i++ )
     {
         buffer[i] = i;
     }
     rx_timeout += get_time_on_air_in_ms( );
 #if RECEIVER == 1
+    memcpy( per_msg, &buffer[PER_SEQ_NB_LENGTH], PAYLOAD_LENGTH - PER_SEQ_NB_LENGTH );
+    lr11xx_per_stats_init( &per_stats, PER_SEQ_NB_LENGTH );
+    per_stats_report_time_ms = smtc_hal_mcu_get_time_in_ms( ) + PER_STATS_REPORT_PERIOD_MS;
+#if( PER_RX_CONTINUOUS == 1 )
+    // A detected preamble is never cut by the timer, and Rx continuous never leaves Rx on its own
+    ASSERT_LR11XX_RC( lr11xx_radio_stop_timeout_on_preamble( context, true ) );
+    apps_common_lr11xx_handle_pre_rx( );
+    ASSERT_LR11XX_RC( lr11xx_radio_set_rx_with_timeout_in_rtc_step( context, PER_RX_CONTINUOUS_TIMEOUT_IN_RTC_STEP ) );
+#else
     apps_common_lr11xx_handle_pre_rx( );
     ASSERT_LR11XX_RC( lr11xx_radio_set_rx( context, rx_timeout ) );
-    memcpy( per_msg, &buffer[1], PAYLOAD_LENGTH - 1 );
+#endif
 #else
-    buffer[0] = 0;
+    lr11xx_per_stats_set_seq_nb( buffer, PER_SEQ_NB_LENGTH, seq_nb );
     ASSERT_LR11XX_RC( lr11xx_regmem_write_buffer8( context, buffer, PAYLOAD_LENGTH ) );
-    apps_common_lr11xx_handle_pre_tx( );
-    ASSERT_LR11XX_RC( lr11xx_radio_set_tx( context, 0 ) );
+    per_tx_init( );
 #endif
 
-    //while( per_index < NB_FRAME )
-		while (1)
+    while( 1 )
     {
         apps_common_lr11xx_irq_process( context, IRQ_MASK );
-    }
-
-    /*if( per_index > NB_FRAME )
-    {
-        nb_ok--;
-    }
-    HAL_DBG_TRACE_PRINTF( "PER = %d \n", 100 - ( ( nb_ok * 100 ) / NB_FRAME ) );
-
-    HAL_DBG_TRACE_PRINTF( "Final PER index: %d \n", per_index );
-    HAL_DBG_TRACE_PRINTF( "Valid reception amount: %d \n", nb_ok );
-    HAL_DBG_TRACE_PRINTF( "Timeout reception amount: %d \n", nb_rx_timeout );
-    HAL_DBG_TRACE_PRINTF( "CRC Error reception amount: %d \n", nb_rx_error );
-#if( PACKET_TYPE == LR11XX_RADIO_PKT_TYPE_GFSK )
-    HAL_DBG_TRACE_PRINTF( "FSK Length Error reception amount: %d \n", nb_fsk_len_error );
+#if( RECEIVER == 0 )
+        per_tx_process( );
+#else
+        per_stats_process( );
 #endif
-
-    while( 1 )
-    {
-    }*/
-}
-
-/*!
- * @brief TX done interrupt handler
- */
-void on_tx_done( void )
-{
-    apps_common_lr11xx_handle_post_tx( );
-
-    LL_mDelay( TX_TO_TX_DELAY_IN_MS );
-
-    buffer[0]++;
-    HAL_DBG_TRACE_INFO( "Counter value: %d\n", buffer[0] );
-    ASSERT_LR11XX_RC( lr11xx_regmem_write_buffer8( context, buffer, PAYLOAD_LENGTH ) );
-
-    apps_common_lr11xx_handle_pre_tx( );
-    ASSERT_LR11XX_RC( lr11xx_radio_set_tx( context, 0 ) );
+        per_sleep( );
+    }
 }
 
 /*!
@@ -164,37 +223,40 @@ void on_tx_done( void )
  */
 void on_rx_done( void )
 {
-    uint8_t size;
+#if( RECEIVER == 1 )
+    const uint32_t                 timestamp_us = smtc_hal_mcu_get_time_in_us( );
+    apps_common_lr11xx_rx_packet_t packet;
+    lr11xx_status_t                status;
 
+#if( PER_RX_CONTINUOUS == 0 )
     apps_common_lr11xx_handle_post_rx( );
+#endif
 
-    apps_common_lr11xx_receive( context, buffer, PAYLOAD_LENGTH, &size );
-
-    if( memcmp( &buffer[1], per_msg, PAYLOAD_LENGTH - 1 ) == 0 )
+    // The next frame may already be on air: fetch this one first, the traces come after
+    status = apps_common_lr11xx_fetch_rx_packet( context, buffer, PAYLOAD_LENGTH, &packet );
+    if( status != LR11XX_STATUS_OK )
     {
-        if( first_pkt_flag == true )
-        {
-            uint8_t rolling_counter_gap = ( uint8_t ) ( buffer[0] - rolling_counter );
-            nb_ok++;
-            per_index += rolling_counter_gap;
-            if( rolling_counter_gap > 1 )
-            {
-                HAL_DBG_TRACE_WARNING( "%d packet(s) missed\n", ( rolling_counter_gap - 1 ) );
-            }
-            rolling_counter = buffer[0];
-        }
-        else
+        HAL_DBG_TRACE_WARNING( "Failed to fetch the received frame (size: %d)\n", packet.size );
+    }
+    else if( ( packet.size == PAYLOAD_LENGTH ) &&
+             ( memcmp( &buffer[PER_SEQ_NB_LENGTH], per_msg, PAYLOAD_LENGTH - PER_SEQ_NB_LENGTH ) == 0 ) )
+    {
+        const uint32_t previous_nb_missed = per_stats.nb_missed;
+        const uint32_t seq_nb             = lr11xx_per_stats_get_seq_nb( buffer, PER_SEQ_NB_LENGTH );
+
+        lr11xx_per_stats_on_rx_done( &per_stats, seq_nb, packet.size,
+                                     ( PACKET_TYPE == LR11XX_RADIO_PKT_TYPE_LORA ) ? &packet.pkt_status.lora : NULL,
+                                     timestamp_us );
+
+        if( per_stats.nb_missed != previous_nb_missed )
         {
-            first_pkt_flag  = true;
-            rolling_counter = buffer[0];
+            HAL_DBG_TRACE_WARNING( "%" PRIu32 " packet(s) missed\n", per_stats.nb_missed - previous_nb_missed );
         }
-        HAL_DBG_TRACE_INFO( "Counter value: %d, PER index: %d\n", buffer[0], per_index );
+        HAL_DBG_TRACE_INFO( "Seq nb: %" PRIu32 ", received: %" PRIu32 "\n", seq_nb, per_stats.nb_received );
     }
-    //if( per_index < NB_FRAME )  // Re-start Rx only if the expected number of frames is not reached
-    //{
-        apps_common_lr11xx_handle_pre_rx( );
-        ASSERT_LR11XX_RC( lr11xx_radio_set_rx( context, rx_timeout ) );
-    //}
+
+    per_restart_rx( );
+#endif
 }
 
 /*!
@@ -202,7 +264,7 @@ void on_rx_done( void )
  */
 void on_rx_timeout( void )
 {
-    per_reception_failure_handling( &nb_rx_timeout );
+    per_reception_failure_handling( LR11XX_PER_STATS_ERROR_RX_TIMEOUT );
 }
 
 /*!
@@ -210,7 +272,15 @@ void on_rx_timeout( void )
  */
 void on_rx_crc_error( void )
 {
-    per_reception_failure_handling( &nb_rx_error );
+    per_reception_failure_handling( LR11XX_PER_STATS_ERROR_CRC );
+}
+
+/*!
+ * @brief Header error interrupt handler
+ */
+void on_header_error( void )
+{
+    per_reception_failure_handling( LR11XX_PER_STATS_ERROR_HEADER );
 }
 
 /*!
@@ -218,23 +288,195 @@ void on_rx_crc_error( void )
  */
 void on_fsk_len_error( void )
 {
-    per_reception_failure_handling( &nb_fsk_len_error );
+    per_reception_failure_handling( LR11XX_PER_STATS_ERROR_FSK_LEN );
 }
 
 /*!
  * @brief Reception failure handling function
- * @param failure_counter Pointer to the specific failure type counter
+ * @param error Type of reception failure
  */
-static void per_reception_failure_handling( uint16_t* failure_counter )
+static void per_reception_failure_handling( lr11xx_per_stats_error_t error )
 {
+#if( RECEIVER == 1 )
+#if( PER_RX_CONTINUOUS == 0 )
     apps_common_lr11xx_handle_post_rx( );
+#endif
 
     // Let's start counting after the first received packet
-    if( first_pkt_flag == true )
+    if( per_stats.is_synchronized == true )
     {
-        ( *failure_counter )++;
+        lr11xx_per_stats_on_rx_error( &per_stats, error );
     }
 
+    per_restart_rx( );
+#endif
+}
+
+static void per_restart_rx( void )
+{
+#if( PER_RX_CONTINUOUS == 0 )
     apps_common_lr11xx_handle_pre_rx( );
     ASSERT_LR11XX_RC( lr11xx_radio_set_rx( context, rx_timeout ) );
-}
\ No newline at end of file
+#endif
+}
+
+static void per_sleep( void )
+{
+    // Masked so that an interrupt occurring after the check is kept pending and ends the sleep right away
+    __disable_irq( );
+#if( RECEIVER == 0 )
+    if( ( apps_common_lr11xx_irq_is_pending( ) == false ) && ( ( is_tx_due == false ) || ( is_tx_ready == false ) ) )
+#else
+    if( apps_common_lr11xx_irq_is_pending( ) == false )
+#endif
+    {
+        __WFI( );
+    }
+    __enable_irq( );
+}
+
+#if( RECEIVER == 1 )
+static void per_stats_process( void )
+{
+    lr11xx_per_stats_report_t report;
+
+    // Signed difference, so that the comparison holds across the wrap of the millisecond time
+    if( ( int32_t ) ( smtc_hal_mcu_get_time_in_ms( ) - per_stats_report_time_ms ) < 0 )
+    {
+        return;
+    }
+    per_stats_report_time_ms += PER_STATS_REPORT_PERIOD_MS;
+
+    if( PACKET_TYPE == LR11XX_RADIO_PKT_TYPE_LORA )
+    {
+        lr11xx_radio_stats_lora_t radio_stats;
+
+        if( lr11xx_radio_get_lora_stats( context, &radio_stats ) == LR11XX_STATUS_OK )
+        {
+            lr11xx_per_stats_update_radio_stats( &per_stats, &radio_stats );
+        }
+    }
+
+    lr11xx_per_stats_get_report( &per_stats, &report );
+
+    HAL_DBG_TRACE_PRINTF( "PER %" PRIu32 ".%04" PRIu32 "%% (%" PRIu32 "/%" PRIu32 "), last %u: %" PRIu32 ".%04" PRIu32
+                          "%%, goodput %" PRIu32 " bit/s, jitter %" PRIu32 " us\n",
+                          report.per_in_ppm / 10000, report.per_in_ppm % 10000, per_stats.nb_missed,
+                          report.nb_expected, report.window_length, report.window_per_in_ppm / 10000,
+                          report.window_per_in_ppm % 10000, report.goodput_in_bps, report.jitter_us );
+    HAL_DBG_TRACE_PRINTF( "Errors crc %" PRIu32 " hdr %" PRIu32 " timeout %" PRIu32 " fsk_len %" PRIu32 ", dup %" PRIu32
+                          ", resync %" PRIu32 "\n",
+                          per_stats.nb_errors[LR11XX_PER_STATS_ERROR_CRC],
+                          per_stats.nb_errors[LR11XX_PER_STATS_ERROR_HEADER],
+                          per_stats.nb_errors[LR11XX_PER_STATS_ERROR_RX_TIMEOUT],
+                          per_stats.nb_errors[LR11XX_PER_STATS_ERROR_FSK_LEN], per_stats.nb_duplicated,
+                          per_stats.nb_resync );
+
+    if( per_stats.has_radio_stats == true )
+    {
+        HAL_DBG_TRACE_PRINTF( "Radio rx %" PRIu32 " crc %" PRIu32 " hdr %" PRIu32 " falsesync %" PRIu32 "\n",
+                              per_stats.radio_nb_pkt_received, per_stats.radio_nb_pkt_crc_error,
+                              per_stats.radio_nb_pkt_header_error, per_stats.radio_nb_pkt_falsesync );
+    }
+
+    if( per_stats.nb_pkt_status != 0 )
+    {
+        HAL_DBG_TRACE_PRINTF( "RSSI %d dBm, SNR %d dB, interval %" PRIu32 "..%" PRIu32 " us\n", report.rssi_mean_in_dbm,
+                              report.snr_mean_in_db, per_stats.interval_min_us, per_stats.interval_max_us );
+        per_stats_print_histogram( "RSSI", per_stats.rssi_histogram, LR11XX_PER_STATS_RSSI_MIN_DBM,
+                                   LR11XX_PER_STATS_RSSI_BIN_WIDTH_DB );
+        per_stats_print_histogram( "SNR", per_stats.snr_histogram, LR11XX_PER_STATS_SNR_MIN_DB,
+                                   LR11XX_PER_STATS_SNR_BIN_WIDTH_DB );
+    }
+}
+
+static void per_stats_print_histogram( const char* name, const uint32_t* histogram, int16_t min, int16_t bin_width )
+{
+    HAL_DBG_TRACE_PRINTF( "%s from %d by %d:", name, min, bin_width );
+    for( uint8_t i = 0; i < LR11XX_PER_STATS_NB_BINS; i++ )
+    {
+        HAL_DBG_TRACE_PRINTF( " %" PRIu32, histogram[i] );
+    }
+    HAL_DBG_TRACE_PRINTF( "\n" );
+}
+#endif
+
+#if( RECEIVER == 0 )
+static void per_tx_init( void )
+{
+    apps_common_lr11xx_irq_register( LR11XX_SYSTEM_IRQ_TX_DONE, per_tx_on_tx_done_irq );
+    is_tx_ready = true;
+
+#if( PER_TX_MAX_RATE == 0 )
+    static const struct smtc_hal_mcu_timer_cfg_s tx_timer_cfg     = { .tim = LPTIM1 };
+    const smtc_hal_mcu_timer_cfg_app_t           tx_timer_cfg_app = { .expiry_func = per_tx_on_timer };
+    uint32_t                                     period_in_ms = get_time_on_air_in_ms( ) + TX_TO_TX_DELAY_IN_MS;
+    uint32_t                                     period_max_in_ms;
+
+    smtc_hal_mcu_timer_init( ( const smtc_hal_mcu_timer_cfg_t ) &tx_timer_cfg, &tx_timer_cfg_app, &tx_timer );
+    smtc_hal_mcu_timer_get_max_value( tx_timer, &period_max_in_ms );
+    period_max_in_ms += 1;
+    if( period_in_ms > period_max_in_ms )
+    {
+        HAL_DBG_TRACE_WARNING( "Tx period reduced from %" PRIu32 " ms to %" PRIu32 " ms\n", period_in_ms,
+                               period_max_in_ms );
+        period_in_ms = period_max_in_ms;
+    }
+
+    HAL_DBG_TRACE_INFO( "Tx period: %" PRIu32 " ms\n", period_in_ms );
+
+    // The first transmission starts with the timer, so that every following one is a whole number of periods later
+    smtc_hal_mcu_timer_start_periodic( tx_timer, period_in_ms );
+#else
+    HAL_DBG_TRACE_INFO( "Tx at the maximum rate\n" );
+#endif
+
+    per_tx_start( );
+}
+
+static void per_tx_start( void )
+{
+    is_tx_due   = false;
+    is_tx_ready = false;
+
+    apps_common_lr11xx_handle_pre_tx( );
+    ASSERT_LR11XX_RC( lr11xx_radio_set_tx( context, 0 ) );
+}
+
+static void per_tx_process( void )
+{
+    if( ( is_tx_due == true ) && ( is_tx_ready == true ) )
+    {
+        per_tx_start( );
+    }
+}
+
+static void per_tx_on_timer( void )
+{
+    if( is_tx_ready == false )
+    {
+        nb_tx_late++;
+    }
+    is_tx_due = true;
+}
+
+static void per_tx_on_tx_done_irq( const void* context, lr11xx_system_irq_mask_t irq_regs, uint32_t timestamp_us )
+{
+    apps_common_lr11xx_handle_post_tx( );
+
+    // Only the sequence number changes, the rest of the payload is still in the radio buffer from the first write
+    seq_nb++;
+    lr11xx_per_stats_set_seq_nb( buffer, PER_SEQ_NB_LENGTH, seq_nb );
+    ASSERT_LR11XX_RC( lr11xx_regmem_write_buffer8( context, buffer, PER_SEQ_NB_LENGTH ) );
+    is_tx_ready = true;
+
+#if( PER_TX_MAX_RATE == 1 )
+    per_tx_start( );
+
+    HAL_DBG_TRACE_INFO( "Seq nb: %" PRIu32 ", turnaround: %" PRIu32 " us\n", seq_nb,
+                        smtc_hal_mcu_get_time_in_us( ) - timestamp_us );
+#else
+    HAL_DBG_TRACE_INFO( "Seq nb: %" PRIu32 ", late: %u\n", seq_nb, nb_tx_late );
+#endif
+}
+#endif
@@ -62,13 +62,50 @@ extern "C" {
 #define RX_TIMEOUT_VALUE 2000
 #endif
 
+/*!
+ *  @brief Receiver mode: 1 to stay in Rx continuous between frames instead of restarting a single Rx after each one
+ *
+ *  The receiver is then never blind between two frames, which is needed to measure back-to-back bursts. There is no
+ *  Rx timeout in this mode, RX_TIMEOUT_VALUE is not used.
+ */
+#ifndef PER_RX_CONTINUOUS
+#define PER_RX_CONTINUOUS 0
+#endif
+
 /*!
  *  @brief Delay in ms between the end of a transmision and the beginning of the next one
+ *
+ *  The transmissions are paced by LPTIM1 on an absolute period of the time on air plus this delay, so that the
+ *  processing time does not add up to it.
  */
 #ifndef TX_TO_TX_DELAY_IN_MS
 #define TX_TO_TX_DELAY_IN_MS 1000
 #endif
 
+/*!
+ *  @brief Transmitter mode: 1 to start each transmission as soon as the previous one is done
+ *
+ *  The spacing between two transmissions is then the time on air plus the turnaround - from the TX_DONE interrupt to
+ *  the next Tx command - which is measured and reported. TX_TO_TX_DELAY_IN_MS is not used in this mode.
+ */
+#ifndef PER_TX_MAX_RATE
+#define PER_TX_MAX_RATE 0
+#endif
+
+/*!
+ *  @brief Length in bytes of the sequence number at the beginning of the payload - 1, 2 or 4
+ */
+#ifndef PER_SEQ_NB_LENGTH
+#define PER_SEQ_NB_LENGTH 2
+#endif
+
+/*!
+ *  @brief Period in ms of the statistics report on the receiver side
+ */
+#ifndef PER_STATS_REPORT_PERIOD_MS
+#define PER_STATS_REPORT_PERIOD_MS 10000
+#endif
+
 /*!
  *  @brief Number of frames expected on the receiver side
  */
@@ -0,0 +1,338 @@
+/**
+ * @file      test_lr11xx_per_stats.c
+ *
+ * @brief     LR11XX test cases for the packet error rate statistics
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include "unity.h"
+#include "lr11xx_per_stats.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#define PAYLOAD_LENGTH ( 20 )
+#define INTERVAL_US ( 100000 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static lr11xx_per_stats_t        stats;
+static lr11xx_per_stats_report_t report;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+static void receive( uint32_t seq_nb );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void setUp( void )
+{
+    lr11xx_per_stats_init( &stats, 2 );
+}
+
+void tearDown( void ) {}
+
+void test_lr11xx_per_stats_empty_report( void )
+{
+    lr11xx_per_stats_get_report( &stats, &report );
+
+    TEST_ASSERT_EQUAL_UINT32( 0, report.nb_expected );
+    TEST_ASSERT_EQUAL_UINT32( 0, report.per_in_ppm );
+    TEST_ASSERT_EQUAL_UINT16( 0, report.window_length );
+    TEST_ASSERT_EQUAL_UINT32( 0, report.window_per_in_ppm );
+    TEST_ASSERT_EQUAL_UINT32( 0, report.goodput_in_bps );
+    TEST_ASSERT_EQUAL_UINT32( 0, report.jitter_us );
+}
+
+void test_lr11xx_per_stats_in_order( void )
+{
+    for( uint32_t i = 10; i < 110; i++ )
+    {
+        receive( i );
+    }
+
+    lr11xx_per_stats_get_report( &stats, &report );
+
+    TEST_ASSERT_EQUAL_UINT32( 100, stats.nb_received );
+    TEST_ASSERT_EQUAL_UINT32( 0, stats.nb_missed );
+    TEST_ASSERT_EQUAL_UINT32( 100, report.nb_expected );
+    TEST_ASSERT_EQUAL_UINT32( 0, report.per_in_ppm );
+    TEST_ASSERT_EQUAL_UINT16( 100, report.window_length );
+    TEST_ASSERT_EQUAL_UINT32( 0, report.window_per_in_ppm );
+    TEST_ASSERT_EQUAL_UINT32( INTERVAL_US, stats.interval_min_us );
+    TEST_ASSERT_EQUAL_UINT32( INTERVAL_US, stats.interval_max_us );
+    TEST_ASSERT_EQUAL_UINT32( 0, report.jitter_us );
+
+    // 20 bytes every 100 ms
+    TEST_ASSERT_EQUAL_UINT32( 1600, report.goodput_in_bps );
+}
+
+void test_lr11xx_per_stats_missed_packets( void )
+{
+    receive( 0 );
+    receive( 1 );
+    receive( 4 );
+    receive( 5 );
+
+    lr11xx_per_stats_get_report( &stats, &report );
+
+    TEST_ASSERT_EQUAL_UINT32( 4, stats.nb_received );
+    TEST_ASSERT_EQUAL_UINT32( 2, stats.nb_missed );
+    TEST_ASSERT_EQUAL_UINT32( 6, report.nb_expected );
+    TEST_ASSERT_EQUAL_UINT32( 333333, report.per_in_ppm );
+    TEST_ASSERT_EQUAL_UINT16( 6, report.window_length );
+    TEST_ASSERT_EQUAL_UINT32( 333333, report.window_per_in_ppm );
+
+    // The interval is normalized by the number of packets sent in between
+    TEST_ASSERT_EQUAL_UINT32( INTERVAL_US, stats.interval_min_us );
+    TEST_ASSERT_EQUAL_UINT32( INTERVAL_US, stats.interval_max_us );
+}
+
+void test_lr11xx_per_stats_seq_nb_wrap( void )
+{
+    receive( 0xFFFE );
+    receive( 0xFFFF );
+    receive( 0x0001 );
+
+    TEST_ASSERT_EQUAL_UINT32( 3, stats.nb_received );
+    TEST_ASSERT_EQUAL_UINT32( 1, stats.nb_missed );
+    TEST_ASSERT_EQUAL_UINT32( 0, stats.nb_resync );
+
+    lr11xx_per_stats_init( &stats, 1 );
+    receive( 0xFE );
+    receive( 0x101 );
+
+    TEST_ASSERT_EQUAL_UINT32( 2, stats.nb_received );
+    TEST_ASSERT_EQUAL_UINT32( 2, stats.nb_missed );
+
+    lr11xx_per_stats_init( &stats, 4 );
+    receive( 0xFFFFFFFF );
+    receive( 0 );
+
+    TEST_ASSERT_EQUAL_UINT32( 2, stats.nb_received );
+    TEST_ASSERT_EQUAL_UINT32( 0, stats.nb_missed );
+}
+
+void test_lr11xx_per_stats_duplicate_and_resync( void )
+{
+    receive( 100 );
+    receive( 100 );
+
+    TEST_ASSERT_EQUAL_UINT32( 1, stats.nb_received );
+    TEST_ASSERT_EQUAL_UINT32( 1, stats.nb_duplicated );
+
+    // Transmitter restarted: not counted as 65000 missed packets
+    receive( 3 );
+    receive( 4 );
+
+    TEST_ASSERT_EQUAL_UINT32( 3, stats.nb_received );
+    TEST_ASSERT_EQUAL_UINT32( 0, stats.nb_missed );
+    TEST_ASSERT_EQUAL_UINT32( 1, stats.nb_resync );
+}
+
+void test_lr11xx_per_stats_sliding_window( void )
+{
+    uint32_t seq_nb = 0;
+
+    // Half of the packets lost at the beginning
+    for( uint32_t i = 0; i < LR11XX_PER_STATS_WINDOW_LENGTH / 2; i++ )
+    {
+        receive( seq_nb );
+        seq_nb += 2;
+    }
+
+    lr11xx_per_stats_get_report( &stats, &report );
+    TEST_ASSERT_EQUAL_UINT16( LR11XX_PER_STATS_WINDOW_LENGTH - 1, report.window_length );
+    TEST_ASSERT_UINT32_WITHIN( 10000, 500000, report.window_per_in_ppm );
+
+    // Then a clean link pushes the losses out of the window, not out of the total
+    for( uint32_t i = 0; i < LR11XX_PER_STATS_WINDOW_LENGTH; i++ )
+    {
+        receive( seq_nb++ );
+    }
+
+    lr11xx_per_stats_get_report( &stats, &report );
+    TEST_ASSERT_EQUAL_UINT16( LR11XX_PER_STATS_WINDOW_LENGTH, report.window_length );
+    TEST_ASSERT_EQUAL_UINT32( 0, report.window_per_in_ppm );
+    TEST_ASSERT_EQUAL_UINT32( LR11XX_PER_STATS_WINDOW_LENGTH / 2, stats.nb_missed );
+
+    // A long outage fills the whole window with missed packets
+    seq_nb += 1000;
+    receive( seq_nb );
+
+    lr11xx_per_stats_get_report( &stats, &report );
+    TEST_ASSERT_EQUAL_UINT16( LR11XX_PER_STATS_WINDOW_LENGTH, report.window_length );
+    TEST_ASSERT_EQUAL_UINT32( ( LR11XX_PER_STATS_WINDOW_LENGTH - 1 ) * 1000000UL / LR11XX_PER_STATS_WINDOW_LENGTH,
+                              report.window_per_in_ppm );
+}
+
+void test_lr11xx_per_stats_histograms( void )
+{
+    const lr11xx_radio_pkt_status_lora_t pkt_status[] = {
+        { .rssi_pkt_in_dbm = -30, .snr_pkt_in_db = 127, .signal_rssi_pkt_in_dbm = -30 },
+        { .rssi_pkt_in_dbm = -128, .snr_pkt_in_db = -128, .signal_rssi_pkt_in_dbm = -128 },
+        { .rssi_pkt_in_dbm = -100, .snr_pkt_in_db = 5, .signal_rssi_pkt_in_dbm = -100 },
+        { .rssi_pkt_in_dbm = -97, .snr_pkt_in_db = 8, .signal_rssi_pkt_in_dbm = -97 },
+    };
+
+    for( uint8_t i = 0; i < sizeof( pkt_status ) / sizeof( pkt_status[0] ); i++ )
+    {
+        lr11xx_per_stats_on_rx_done( &stats, i, PAYLOAD_LENGTH, &pkt_status[i], i * INTERVAL_US );
+    }
+
+    // Out of range values go to the first and last bins
+    TEST_ASSERT_EQUAL_UINT32( 1, stats.rssi_histogram[LR11XX_PER_STATS_NB_BINS - 1] );
+    TEST_ASSERT_EQUAL_UINT32( 1, stats.rssi_histogram[( -128 - LR11XX_PER_STATS_RSSI_MIN_DBM ) /
+                                                      LR11XX_PER_STATS_RSSI_BIN_WIDTH_DB] );
+    TEST_ASSERT_EQUAL_UINT32( 2, stats.rssi_histogram[( -100 - LR11XX_PER_STATS_RSSI_MIN_DBM ) /
+                                                      LR11XX_PER_STATS_RSSI_BIN_WIDTH_DB] );
+    TEST_ASSERT_EQUAL_UINT32( 1, stats.snr_histogram[0] );
+    TEST_ASSERT_EQUAL_UINT32( 1, stats.snr_histogram[LR11XX_PER_STATS_NB_BINS - 1] );
+
+    lr11xx_per_stats_get_report( &stats, &report );
+    TEST_ASSERT_EQUAL_INT16( ( -30 - 128 - 100 - 97 ) / 4, report.rssi_mean_in_dbm );
+    TEST_ASSERT_EQUAL_INT16( ( 127 - 128 + 5 + 8 ) / 4, report.snr_mean_in_db );
+}
+
+void test_lr11xx_per_stats_jitter( void )
+{
+    const uint32_t timestamps_us[] = { 0, 100000, 200000, 300500, 400000, 500000 };
+
+    for( uint8_t i = 0; i < sizeof( timestamps_us ) / sizeof( timestamps_us[0] ); i++ )
+    {
+        lr11xx_per_stats_on_rx_done( &stats, i, PAYLOAD_LENGTH, NULL, timestamps_us[i] );
+    }
+
+    TEST_ASSERT_EQUAL_UINT32( 99500, stats.interval_min_us );
+    TEST_ASSERT_EQUAL_UINT32( 100500, stats.interval_max_us );
+
+    // 500 us then 1000 us then 500 us of variation: J = 31, 92, 117 then 110 us
+    lr11xx_per_stats_get_report( &stats, &report );
+    TEST_ASSERT_UINT32_WITHIN( 2, 117, report.jitter_us );
+}
+
+void test_lr11xx_per_stats_timestamp_wrap( void )
+{
+    lr11xx_per_stats_on_rx_done( &stats, 0, PAYLOAD_LENGTH, NULL, UINT32_MAX - 49999 );
+    lr11xx_per_stats_on_rx_done( &stats, 1, PAYLOAD_LENGTH, NULL, 50000 );
+
+    TEST_ASSERT_EQUAL_UINT32( INTERVAL_US, stats.interval_last_us );
+    TEST_ASSERT_EQUAL_UINT64( INTERVAL_US, stats.elapsed_us );
+}
+
+void test_lr11xx_per_stats_errors( void )
+{
+    lr11xx_per_stats_on_rx_error( &stats, LR11XX_PER_STATS_ERROR_CRC );
+    lr11xx_per_stats_on_rx_error( &stats, LR11XX_PER_STATS_ERROR_CRC );
+    lr11xx_per_stats_on_rx_error( &stats, LR11XX_PER_STATS_ERROR_RX_TIMEOUT );
+    lr11xx_per_stats_on_rx_error( &stats, LR11XX_PER_STATS_NB_ERRORS );
+
+    TEST_ASSERT_EQUAL_UINT32( 2, stats.nb_errors[LR11XX_PER_STATS_ERROR_CRC] );
+    TEST_ASSERT_EQUAL_UINT32( 0, stats.nb_errors[LR11XX_PER_STATS_ERROR_HEADER] );
+    TEST_ASSERT_EQUAL_UINT32( 1, stats.nb_errors[LR11XX_PER_STATS_ERROR_RX_TIMEOUT] );
+}
+
+void test_lr11xx_per_stats_radio_counters_wrap( void )
+{
+    lr11xx_radio_stats_lora_t radio_stats = {
+        .nb_pkt_received = 65000, .nb_pkt_crc_error = 10, .nb_pkt_header_error = 3, .nb_pkt_falsesync = 0xFFFF
+    };
+
+    // The first read is the reference
+    lr11xx_per_stats_update_radio_stats( &stats, &radio_stats );
+    TEST_ASSERT_EQUAL_UINT32( 0, stats.radio_nb_pkt_received );
+
+    radio_stats.nb_pkt_received  = 100;
+    radio_stats.nb_pkt_crc_error = 12;
+    radio_stats.nb_pkt_falsesync = 1;
+    lr11xx_per_stats_update_radio_stats( &stats, &radio_stats );
+
+    radio_stats.nb_pkt_received = 50000;
+    lr11xx_per_stats_update_radio_stats( &stats, &radio_stats );
+
+    TEST_ASSERT_EQUAL_UINT32( 636 + 49900, stats.radio_nb_pkt_received );
+    TEST_ASSERT_EQUAL_UINT32( 2, stats.radio_nb_pkt_crc_error );
+    TEST_ASSERT_EQUAL_UINT32( 0, stats.radio_nb_pkt_header_error );
+    TEST_ASSERT_EQUAL_UINT32( 2, stats.radio_nb_pkt_falsesync );
+}
+
+void test_lr11xx_per_stats_seq_nb_in_payload( void )
+{
+    uint8_t payload[4] = { 0 };
+
+    lr11xx_per_stats_set_seq_nb( payload, 2, 0x12345678 );
+    TEST_ASSERT_EQUAL_HEX8( 0x78, payload[0] );
+    TEST_ASSERT_EQUAL_HEX8( 0x56, payload[1] );
+    TEST_ASSERT_EQUAL_HEX8( 0x00, payload[2] );
+    TEST_ASSERT_EQUAL_HEX32( 0x5678, lr11xx_per_stats_get_seq_nb( payload, 2 ) );
+
+    lr11xx_per_stats_set_seq_nb( payload, 4, 0x12345678 );
+    TEST_ASSERT_EQUAL_HEX32( 0x12345678, lr11xx_per_stats_get_seq_nb( payload, 4 ) );
+    TEST_ASSERT_EQUAL_HEX32( 0x78, lr11xx_per_stats_get_seq_nb( payload, 1 ) );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void receive( uint32_t seq_nb )
+{
+    // The transmitter sends a packet every INTERVAL_US, whether it is received or not
+    lr11xx_per_stats_on_rx_done( &stats, seq_nb, PAYLOAD_LENGTH, NULL, seq_nb * INTERVAL_US );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -47,7 +47,9 @@
 #include "apps_utilities.h"
 #include "lr11xx_system.h"
 #include "lr11xx_radio.h"
+#include "lr11xx_radio_toa.h"
 #include "lr11xx_driver_version.h"
+#include "smtc_hal_mcu.h"
 #include "smtc_hal_dbg_trace.h"
 #include "smtc_shield_pinout_mapping.h"
 #include "smtc_shield_lr11xx.h"
@@ -69,6 +71,11 @@
  * --- PRIVATE MACROS-----------------------------------------------------------
  */
 
+/*!
+ * @brief Check whether the trace of an interrupt is compiled in
+ */
+#define APPS_COMMON_IRQ_TRACE_ENABLED( irq ) ( ( APPS_COMMON_IRQ_TRACE_MASK & ( irq ) ) != 0 )
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE CONSTANTS -------------------------------------------------------
@@ -162,7 +169,7 @@ static lr11xx_radio_pkt_params_bpsk_t bpsk_pkt_params = {
 
 static lr11xx_hal_context_t context;
 
-static volatile bool irq_fired = false;
+static lr11xx_irq_dispatch_t irq_dispatch;
 
 static const smtc_shield_lr11xx_pinout_t* shield_pinout = 0;
 
@@ -234,6 +241,32 @@ void on_lora_rx_timestamp( void ) __attribute__( ( weak ) );
 void on_wifi_scan_done( void ) __attribute__( ( weak ) );
 void on_gnss_scan_done( void ) __attribute__( ( weak ) );
 
+/*!
+ * @brief Register the handlers calling the on_* callbacks
+ */
+static void apps_common_lr11xx_irq_register_default_handlers( void );
+
+static void apps_common_lr11xx_on_tx_done_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                               uint32_t timestamp_us );
+static void apps_common_lr11xx_on_rx_done_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                               uint32_t timestamp_us );
+static void apps_common_lr11xx_on_preamble_detected_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                                         uint32_t timestamp_us );
+static void apps_common_lr11xx_on_syncword_header_valid_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                                             uint32_t timestamp_us );
+static void apps_common_lr11xx_on_header_error_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                                    uint32_t timestamp_us );
+static void apps_common_lr11xx_on_cad_done_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                                uint32_t timestamp_us );
+static void apps_common_lr11xx_on_timeout_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                               uint32_t timestamp_us );
+static void apps_common_lr11xx_on_lora_rx_timestamp_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                                         uint32_t timestamp_us );
+static void apps_common_lr11xx_on_wifi_scan_done_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                                      uint32_t timestamp_us );
+static void apps_common_lr11xx_on_gnss_scan_done_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                                      uint32_t timestamp_us );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC VARIABLES --------------------------------------------------------
@@ -248,8 +281,9 @@ lr11xx_hal_context_t* apps_common_lr11xx_get_context( )
 {
     context.busy.cfg                 = smtc_shield_pinout_mapping_get_gpio_cfg( SMTC_SHIELD_PINOUT_D3 );
     context.busy.cfg_input.pull_mode = SMTC_HAL_MCU_GPIO_PULL_MODE_NONE;
-    context.busy.cfg_input.irq_mode  = SMTC_HAL_MCU_GPIO_IRQ_MODE_OFF;
-    context.busy.cfg_input.callback  = NULL;
+    context.busy.cfg_input.irq_mode  = SMTC_HAL_MCU_GPIO_IRQ_MODE_FALLING;
+    context.busy.cfg_input.callback  = lr11xx_hal_on_busy_irq;
+    context.busy.cfg_input.context   = &context;
 
     context.irq.cfg                 = smtc_shield_pinout_mapping_get_gpio_cfg( SMTC_SHIELD_PINOUT_D5 );
     context.irq.cfg_input.pull_mode = SMTC_HAL_MCU_GPIO_PULL_MODE_NONE;
@@ -272,6 +306,10 @@ lr11xx_hal_context_t* apps_common_lr11xx_get_context( )
     smtc_hal_mcu_gpio_init_output( context.nss.cfg, &( context.nss.cfg_output ), &( context.nss.inst ) );
     smtc_hal_mcu_gpio_init_output( context.reset.cfg, &( context.reset.cfg_output ), &( context.reset.inst ) );
 
+    lr11xx_irq_dispatch_init( &irq_dispatch );
+    apps_common_lr11xx_irq_register_default_handlers( );
+
+    // Busy interrupt is only enabled by lr11xx_hal while it times a command or waits for the radio
     smtc_hal_mcu_gpio_enable_irq( context.irq.inst );
 
     smtc_hal_mcu_spi_init( &( context.spi.cfg ), &( context.spi.inst ) );
@@ -528,37 +566,71 @@ void apps_common_lr11xx_radio_dbpsk_init( const void* context, const uint8_t pay
 
 void apps_common_lr11xx_receive( const void* context, uint8_t* buffer, uint8_t buffer_length, uint8_t* size )
 {
-    lr11xx_radio_rx_buffer_status_t rx_buffer_status;
-    lr11xx_radio_pkt_status_lora_t  pkt_status_lora;
-    lr11xx_radio_pkt_status_gfsk_t  pkt_status_gfsk;
+    apps_common_lr11xx_rx_packet_t packet;
+
+    const lr11xx_status_t status = apps_common_lr11xx_fetch_rx_packet( context, buffer, buffer_length, &packet );
 
-    lr11xx_radio_get_rx_buffer_status( context, &rx_buffer_status );
-    *size = rx_buffer_status.pld_len_in_bytes;
-    if( *size > buffer_length )
+    *size = packet.size;
+    if( status != LR11XX_STATUS_OK )
     {
         HAL_DBG_TRACE_ERROR( "Received payload (size: %d) is bigger than the buffer (size: %d)!\n", *size,
                              buffer_length );
         return;
     }
-    lr11xx_regmem_read_buffer8( context, buffer, rx_buffer_status.buffer_start_pointer,
-                                rx_buffer_status.pld_len_in_bytes );
 
     HAL_DBG_TRACE_ARRAY( "Packet content", buffer, *size );
 
     HAL_DBG_TRACE_INFO( "Packet status:\n" );
     if( PACKET_TYPE == LR11XX_RADIO_PKT_TYPE_LORA )
     {
-        lr11xx_radio_get_lora_pkt_status( context, &pkt_status_lora );
-        HAL_DBG_TRACE_INFO( "  - RSSI packet = %i dBm\n", pkt_status_lora.rssi_pkt_in_dbm );
-        HAL_DBG_TRACE_INFO( "  - Signal RSSI packet = %i dBm\n", pkt_status_lora.signal_rssi_pkt_in_dbm );
-        HAL_DBG_TRACE_INFO( "  - SNR packet = %i dB\n", pkt_status_lora.snr_pkt_in_db );
+        HAL_DBG_TRACE_INFO( "  - RSSI packet = %i dBm\n", packet.pkt_status.lora.rssi_pkt_in_dbm );
+        HAL_DBG_TRACE_INFO( "  - Signal RSSI packet = %i dBm\n", packet.pkt_status.lora.signal_rssi_pkt_in_dbm );
+        HAL_DBG_TRACE_INFO( "  - SNR packet = %i dB\n", packet.pkt_status.lora.snr_pkt_in_db );
+    }
+    else if( PACKET_TYPE == LR11XX_RADIO_PKT_TYPE_GFSK )
+    {
+        HAL_DBG_TRACE_INFO( "  - RSSI average = %i dBm\n", packet.pkt_status.gfsk.rssi_avg_in_dbm );
+        HAL_DBG_TRACE_INFO( "  - RSSI sync = %i dBm\n", packet.pkt_status.gfsk.rssi_sync_in_dbm );
+    }
+}
+
+lr11xx_status_t apps_common_lr11xx_fetch_rx_packet( const void* context, uint8_t* buffer, uint8_t buffer_length,
+                                                    apps_common_lr11xx_rx_packet_t* packet )
+{
+    lr11xx_radio_rx_buffer_status_t rx_buffer_status;
+    lr11xx_status_t                 status;
+
+    packet->size = 0;
+
+    status = lr11xx_radio_get_rx_buffer_status( context, &rx_buffer_status );
+    if( status != LR11XX_STATUS_OK )
+    {
+        return status;
+    }
+
+    packet->size = rx_buffer_status.pld_len_in_bytes;
+    if( packet->size > buffer_length )
+    {
+        return LR11XX_STATUS_ERROR;
+    }
+
+    status = lr11xx_regmem_read_buffer8( context, buffer, rx_buffer_status.buffer_start_pointer,
+                                         rx_buffer_status.pld_len_in_bytes );
+    if( status != LR11XX_STATUS_OK )
+    {
+        return status;
+    }
+
+    if( PACKET_TYPE == LR11XX_RADIO_PKT_TYPE_LORA )
+    {
+        status = lr11xx_radio_get_lora_pkt_status( context, &packet->pkt_status.lora );
     }
     else if( PACKET_TYPE == LR11XX_RADIO_PKT_TYPE_GFSK )
     {
-        lr11xx_radio_get_gfsk_pkt_status( context, &pkt_status_gfsk );
-        HAL_DBG_TRACE_INFO( "  - RSSI average = %i dBm\n", pkt_status_gfsk.rssi_avg_in_dbm );
-        HAL_DBG_TRACE_INFO( "  - RSSI sync = %i dBm\n", pkt_status_gfsk.rssi_sync_in_dbm );
+        status = lr11xx_radio_get_gfsk_pkt_status( context, &packet->pkt_status.gfsk );
     }
+
+    return status;
 }
 
 /*!
@@ -568,152 +640,45 @@ void apps_common_lr11xx_receive( const void* context, uint8_t* buffer, uint8_t b
  */
 void apps_common_lr11xx_irq_process( const void* context, lr11xx_system_irq_mask_t irq_filter_mask )
 {
-    // Check if interrupt flag is triggered
-    if( irq_fired == true )
-    {
-        // Reset interrupt flag to prevent processing the same interrupt multiple times
-        irq_fired = false;
+    uint32_t timestamp_us;
 
-        // Define variable to store interrupt register status
+    // Serve every edge queued by the ISR, a burst of interrupts is not merged into a single status read
+    while( lr11xx_irq_dispatch_pop( &irq_dispatch, &timestamp_us ) == true )
+    {
         lr11xx_system_irq_mask_t irq_regs;
-        // Get and clear LR11xx chip interrupt status
-        lr11xx_system_get_and_clear_irq_status( context, &irq_regs );
 
-        // Print original interrupt flags for debugging
-        HAL_DBG_TRACE_INFO( "Interrupt flags = 0x%08X\n", irq_regs );
-
-        // Filter interrupts using the mask
-        irq_regs &= irq_filter_mask;
-
-        // Print filtered interrupt flags for debugging
-        HAL_DBG_TRACE_INFO( "Interrupt flags (after filtering) = 0x%08X\n", irq_regs );
-
-        // Check if it's a TX done interrupt
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_TX_DONE ) == LR11XX_SYSTEM_IRQ_TX_DONE )
-        {
-            // Print TX done information
-            HAL_DBG_TRACE_INFO( "Tx done\n" );
-            // Call TX done callback function
-            on_tx_done( );
-        }
-
-        // Check if preamble detected interrupt
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_PREAMBLE_DETECTED ) == LR11XX_SYSTEM_IRQ_PREAMBLE_DETECTED )
-        {
-            // Print preamble detection information
-            HAL_DBG_TRACE_INFO( "Preamble detected\n" );
-            // Call preamble detected callback function
-            on_preamble_detected( );
-        }
-
-        // Check if header error interrupt
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_HEADER_ERROR ) == LR11XX_SYSTEM_IRQ_HEADER_ERROR )
-        {
-            // Print header error information
-            HAL_DBG_TRACE_ERROR( "Header error\n" );
-            // Call header error callback function
-            on_header_error( );
-        }
+        lr11xx_system_get_and_clear_irq_status( context, &irq_regs );
 
-        // Check if syncword or header valid interrupt
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_SYNC_WORD_HEADER_VALID ) == LR11XX_SYSTEM_IRQ_SYNC_WORD_HEADER_VALID )
+        if( APPS_COMMON_IRQ_TRACE_MASK != 0 )
         {
-            // Print syncword or header valid information
-            HAL_DBG_TRACE_INFO( "Syncword or header valid\n" );
-            // Call syncword or header valid callback function
-            on_syncword_header_valid( );
+            HAL_DBG_TRACE_INFO( "Interrupt flags = 0x%08X (t = %u us)\n", irq_regs, timestamp_us );
         }
 
-        // Check if RX done interrupt
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_RX_DONE ) == LR11XX_SYSTEM_IRQ_RX_DONE )
-        {
-            // Check if CRC error interrupt is also present
-            if( ( irq_regs & LR11XX_SYSTEM_IRQ_CRC_ERROR ) == LR11XX_SYSTEM_IRQ_CRC_ERROR )
-            {
-                // Print CRC error information
-                HAL_DBG_TRACE_ERROR( "CRC error\n" );
-                // Call CRC error callback function
-                on_rx_crc_error( );
-            }
-            // Check if FSK length error interrupt is also present
-            else if( ( irq_regs & LR11XX_SYSTEM_IRQ_FSK_LEN_ERROR ) == LR11XX_SYSTEM_IRQ_FSK_LEN_ERROR )
-            {
-                // Print FSK length error information
-                HAL_DBG_TRACE_ERROR( "FSK length error\n" );
-                // Call FSK length error callback function
-                on_fsk_len_error( );
-            }
-            else
-            {
-                // Print RX done information
-                HAL_DBG_TRACE_INFO( "Rx done\n" );
-                // Call RX done callback function
-                on_rx_done( );
-            }
-        }
+        irq_regs &= irq_filter_mask;
 
-        // Check if CAD (Channel Activity Detection) done interrupt
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_CAD_DONE ) == LR11XX_SYSTEM_IRQ_CAD_DONE )
+        // The status may already have been read on a previous edge of the burst
+        if( irq_regs == 0 )
         {
-            // Print CAD done information
-            HAL_DBG_TRACE_INFO( "CAD done\n" );
-            // Check if channel activity was detected
-            if( ( irq_regs & LR11XX_SYSTEM_IRQ_CAD_DETECTED ) == LR11XX_SYSTEM_IRQ_CAD_DETECTED )
-            {
-                // Print channel activity detected information
-                HAL_DBG_TRACE_INFO( "Channel activity detected\n" );
-                // Call channel activity detected callback function
-                on_cad_done_detected( );
-            }
-            else
-            {
-                // Print no channel activity detected information
-                HAL_DBG_TRACE_INFO( "No channel activity detected\n" );
-                // Call no channel activity detected callback function
-                on_cad_done_undetected( );
-            }
+            continue;
         }
 
-        // Check if RX timeout interrupt
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_TIMEOUT ) == LR11XX_SYSTEM_IRQ_TIMEOUT )
-        {
-            // Print RX timeout warning information
-            HAL_DBG_TRACE_WARNING( "Rx timeout\n" );
-            // Call RX timeout callback function
-            on_rx_timeout( );
-        }
+        lr11xx_irq_dispatch_run( &irq_dispatch, context, irq_regs, timestamp_us );
 
-        // Check if LoRa RX timestamp interrupt
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_LORA_RX_TIMESTAMP ) == LR11XX_SYSTEM_IRQ_LORA_RX_TIMESTAMP )
+        if( APPS_COMMON_IRQ_TRACE_MASK != 0 )
         {
-            // Print LoRa RX timestamp information
-            HAL_DBG_TRACE_INFO( "LoRa Rx timestamp\n" );
-            // Call LoRa RX timestamp callback function
-            on_lora_rx_timestamp( );
+            HAL_DBG_TRACE_PRINTF( "\n" );
         }
+    }
+}
 
-        // Check if Wi-Fi scan done interrupt
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_WIFI_SCAN_DONE ) == LR11XX_SYSTEM_IRQ_WIFI_SCAN_DONE )
-        {
-            // Print Wi-Fi scan done information
-            HAL_DBG_TRACE_INFO( "Wi-Fi scan done\n" );
-            // Call Wi-Fi scan done callback function
-            on_wifi_scan_done( );
-        }
+void apps_common_lr11xx_irq_register( lr11xx_system_irq_mask_t irq_mask, lr11xx_irq_dispatch_handler_t handler )
+{
+    lr11xx_irq_dispatch_register( &irq_dispatch, irq_mask, handler );
+}
 
-        // Check if GNSS scan done interrupt
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_GNSS_SCAN_DONE ) == LR11XX_SYSTEM_IRQ_GNSS_SCAN_DONE )
-        {
-            // Print GNSS scan done information
-            HAL_DBG_TRACE_INFO( "GNSS scan done\n" );
-            // Call GNSS scan done callback function
-            on_gnss_scan_done( );
-        }
+uint32_t apps_common_lr11xx_irq_get_nb_dropped( void ) { return irq_dispatch.nb_dropped; }
 
-        // Print empty line to separate different interrupt handling outputs
-        HAL_DBG_TRACE_PRINTF( "\n" );
-    }
-}
+bool apps_common_lr11xx_irq_is_pending( void ) { return irq_dispatch.head != irq_dispatch.tail; }
 
 void apps_common_lr11xx_handle_pre_tx( void )
 {
@@ -791,15 +756,19 @@ void apps_common_lr11xx_handle_post_wifi_scan( void )
 
 uint32_t get_time_on_air_in_ms( void )
 {
+    // The configuration is fixed at build time, so is the time on air: the compiler folds these down to a constant
     switch( PACKET_TYPE )
     {
     case LR11XX_RADIO_PKT_TYPE_LORA:
     {
-        return lr11xx_radio_get_lora_time_on_air_in_ms( &lora_pkt_params, &lora_mod_params );
+        return LR11XX_RADIO_LORA_TOA_IN_MS( LORA_SPREADING_FACTOR, LORA_BANDWIDTH, LORA_CODING_RATE,
+                                            apps_common_compute_lora_ldro( LORA_SPREADING_FACTOR, LORA_BANDWIDTH ),
+                                            LORA_PREAMBLE_LENGTH, LORA_PKT_LEN_MODE, PAYLOAD_LENGTH, LORA_CRC );
     }
     case LR11XX_RADIO_PKT_TYPE_GFSK:
     {
-        return lr11xx_radio_get_gfsk_time_on_air_in_ms( &gfsk_pkt_params, &gfsk_mod_params );
+        return LR11XX_RADIO_GFSK_TOA_IN_MS( FSK_BITRATE, FSK_PREAMBLE_LENGTH, FSK_SYNCWORD_LENGTH,
+                                            FSK_ADDRESS_FILTERING, FSK_HEADER_TYPE, PAYLOAD_LENGTH, FSK_CRC_TYPE );
     }
     default:
     {
@@ -820,7 +789,7 @@ void print_common_configuration( void )
     HAL_DBG_TRACE_INFO( "   RF frequency  = %u Hz\n", RF_FREQ_IN_HZ );
     HAL_DBG_TRACE_INFO( "   Output power  = %i dBm\n", TX_OUTPUT_POWER_DBM );
     HAL_DBG_TRACE_INFO( "   Fallback mode = %s\n", lr11xx_radio_fallback_modes_to_str( FALLBACK_MODE ) );
-    HAL_DBG_TRACE_INFO( ( ENABLE_RX_BOOST_MODE == true ) ? "   Rx boost activated\n" : "   Rx boost deactivated\n" );
+    HAL_DBG_TRACE_INFO( "   Rx boost %s\n", ( ENABLE_RX_BOOST_MODE == true ) ? "activated" : "deactivated" );
     HAL_DBG_TRACE_PRINTF( "\n" );
 }
 
@@ -891,7 +860,7 @@ void print_driver_version( void )
 
 void radio_on_dio_irq( void* context )
 {
-    irq_fired = true;
+    lr11xx_irq_dispatch_push( &irq_dispatch, smtc_hal_mcu_get_time_in_us( ) );
 }
 void on_tx_done( void )
 {
@@ -946,4 +915,159 @@ void on_gnss_scan_done( void )
     HAL_DBG_TRACE_INFO( "No IRQ routine defined\n" );
 }
 
+static void apps_common_lr11xx_irq_register_default_handlers( void )
+{
+    lr11xx_irq_dispatch_register( &irq_dispatch, LR11XX_SYSTEM_IRQ_TX_DONE, apps_common_lr11xx_on_tx_done_irq );
+    lr11xx_irq_dispatch_register( &irq_dispatch, LR11XX_SYSTEM_IRQ_RX_DONE, apps_common_lr11xx_on_rx_done_irq );
+    lr11xx_irq_dispatch_register( &irq_dispatch, LR11XX_SYSTEM_IRQ_PREAMBLE_DETECTED,
+                                  apps_common_lr11xx_on_preamble_detected_irq );
+    lr11xx_irq_dispatch_register( &irq_dispatch, LR11XX_SYSTEM_IRQ_SYNC_WORD_HEADER_VALID,
+                                  apps_common_lr11xx_on_syncword_header_valid_irq );
+    lr11xx_irq_dispatch_register( &irq_dispatch, LR11XX_SYSTEM_IRQ_HEADER_ERROR,
+                                  apps_common_lr11xx_on_header_error_irq );
+    lr11xx_irq_dispatch_register( &irq_dispatch, LR11XX_SYSTEM_IRQ_CAD_DONE, apps_common_lr11xx_on_cad_done_irq );
+    lr11xx_irq_dispatch_register( &irq_dispatch, LR11XX_SYSTEM_IRQ_TIMEOUT, apps_common_lr11xx_on_timeout_irq );
+    lr11xx_irq_dispatch_register( &irq_dispatch, LR11XX_SYSTEM_IRQ_LORA_RX_TIMESTAMP,
+                                  apps_common_lr11xx_on_lora_rx_timestamp_irq );
+    lr11xx_irq_dispatch_register( &irq_dispatch, LR11XX_SYSTEM_IRQ_WIFI_SCAN_DONE,
+                                  apps_common_lr11xx_on_wifi_scan_done_irq );
+    lr11xx_irq_dispatch_register( &irq_dispatch, LR11XX_SYSTEM_IRQ_GNSS_SCAN_DONE,
+                                  apps_common_lr11xx_on_gnss_scan_done_irq );
+}
+
+static void apps_common_lr11xx_on_tx_done_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                               uint32_t timestamp_us )
+{
+    if( APPS_COMMON_IRQ_TRACE_ENABLED( LR11XX_SYSTEM_IRQ_TX_DONE ) )
+    {
+        HAL_DBG_TRACE_INFO( "Tx done\n" );
+    }
+    on_tx_done( );
+}
+
+static void apps_common_lr11xx_on_rx_done_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                               uint32_t timestamp_us )
+{
+    // CRC and FSK length errors are only meaningful together with RX done
+    if( ( irq_regs & LR11XX_SYSTEM_IRQ_CRC_ERROR ) == LR11XX_SYSTEM_IRQ_CRC_ERROR )
+    {
+        if( APPS_COMMON_IRQ_TRACE_ENABLED( LR11XX_SYSTEM_IRQ_CRC_ERROR ) )
+        {
+            HAL_DBG_TRACE_ERROR( "CRC error\n" );
+        }
+        on_rx_crc_error( );
+    }
+    else if( ( irq_regs & LR11XX_SYSTEM_IRQ_FSK_LEN_ERROR ) == LR11XX_SYSTEM_IRQ_FSK_LEN_ERROR )
+    {
+        if( APPS_COMMON_IRQ_TRACE_ENABLED( LR11XX_SYSTEM_IRQ_FSK_LEN_ERROR ) )
+        {
+            HAL_DBG_TRACE_ERROR( "FSK length error\n" );
+        }
+        on_fsk_len_error( );
+    }
+    else
+    {
+        if( APPS_COMMON_IRQ_TRACE_ENABLED( LR11XX_SYSTEM_IRQ_RX_DONE ) )
+        {
+            HAL_DBG_TRACE_INFO( "Rx done\n" );
+        }
+        on_rx_done( );
+    }
+}
+
+static void apps_common_lr11xx_on_preamble_detected_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                                         uint32_t timestamp_us )
+{
+    if( APPS_COMMON_IRQ_TRACE_ENABLED( LR11XX_SYSTEM_IRQ_PREAMBLE_DETECTED ) )
+    {
+        HAL_DBG_TRACE_INFO( "Preamble detected\n" );
+    }
+    on_preamble_detected( );
+}
+
+static void apps_common_lr11xx_on_syncword_header_valid_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                                             uint32_t timestamp_us )
+{
+    if( APPS_COMMON_IRQ_TRACE_ENABLED( LR11XX_SYSTEM_IRQ_SYNC_WORD_HEADER_VALID ) )
+    {
+        HAL_DBG_TRACE_INFO( "Syncword or header valid\n" );
+    }
+    on_syncword_header_valid( );
+}
+
+static void apps_common_lr11xx_on_header_error_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                                    uint32_t timestamp_us )
+{
+    if( APPS_COMMON_IRQ_TRACE_ENABLED( LR11XX_SYSTEM_IRQ_HEADER_ERROR ) )
+    {
+        HAL_DBG_TRACE_ERROR( "Header error\n" );
+    }
+    on_header_error( );
+}
+
+static void apps_common_lr11xx_on_cad_done_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                                uint32_t timestamp_us )
+{
+    if( APPS_COMMON_IRQ_TRACE_ENABLED( LR11XX_SYSTEM_IRQ_CAD_DONE ) )
+    {
+        HAL_DBG_TRACE_INFO( "CAD done\n" );
+    }
+    if( ( irq_regs & LR11XX_SYSTEM_IRQ_CAD_DETECTED ) == LR11XX_SYSTEM_IRQ_CAD_DETECTED )
+    {
+        if( APPS_COMMON_IRQ_TRACE_ENABLED( LR11XX_SYSTEM_IRQ_CAD_DETECTED ) )
+        {
+            HAL_DBG_TRACE_INFO( "Channel activity detected\n" );
+        }
+        on_cad_done_detected( );
+    }
+    else
+    {
+        if( APPS_COMMON_IRQ_TRACE_ENABLED( LR11XX_SYSTEM_IRQ_CAD_DONE ) )
+        {
+            HAL_DBG_TRACE_INFO( "No channel activity detected\n" );
+        }
+        on_cad_done_undetected( );
+    }
+}
+
+static void apps_common_lr11xx_on_timeout_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                               uint32_t timestamp_us )
+{
+    if( APPS_COMMON_IRQ_TRACE_ENABLED( LR11XX_SYSTEM_IRQ_TIMEOUT ) )
+    {
+        HAL_DBG_TRACE_WARNING( "Rx timeout\n" );
+    }
+    on_rx_timeout( );
+}
+
+static void apps_common_lr11xx_on_lora_rx_timestamp_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                                         uint32_t timestamp_us )
+{
+    if( APPS_COMMON_IRQ_TRACE_ENABLED( LR11XX_SYSTEM_IRQ_LORA_RX_TIMESTAMP ) )
+    {
+        HAL_DBG_TRACE_INFO( "LoRa Rx timestamp\n" );
+    }
+    on_lora_rx_timestamp( );
+}
+
+static void apps_common_lr11xx_on_wifi_scan_done_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                                      uint32_t timestamp_us )
+{
+    if( APPS_COMMON_IRQ_TRACE_ENABLED( LR11XX_SYSTEM_IRQ_WIFI_SCAN_DONE ) )
+    {
+        HAL_DBG_TRACE_INFO( "Wi-Fi scan done\n" );
+    }
+    on_wifi_scan_done( );
+}
+
+static void apps_common_lr11xx_on_gnss_scan_done_irq( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                                      uint32_t timestamp_us )
+{
+    if( APPS_COMMON_IRQ_TRACE_ENABLED( LR11XX_SYSTEM_IRQ_GNSS_SCAN_DONE ) )
+    {
+        HAL_DBG_TRACE_INFO( "GNSS scan done\n" );
+    }
+    on_gnss_scan_done( );
+}
+
 /* --- EOF ------------------------------------------------------------------ */
@@ -46,12 +46,14 @@ extern "C" {
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "lr11xx_radio_types_str.h"
 #include "apps_configuration.h"
 #include "lr11xx_hal_context.h"
 #include "lr11xx_system_types.h"
 #include "lr11xx_radio_types.h"
 #include "lr11xx_radio.h"
+#include "lr11xx_irq_dispatch.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -73,6 +75,19 @@ extern "C" {
  * --- PUBLIC TYPES ------------------------------------------------------------
  */
 
+/*!
+ * @brief Received packet, as fetched by @ref apps_common_lr11xx_fetch_rx_packet
+ */
+typedef struct apps_common_lr11xx_rx_packet_s
+{
+    uint8_t size;  //!< Payload length in bytes
+    union
+    {
+        lr11xx_radio_pkt_status_lora_t lora;
+        lr11xx_radio_pkt_status_gfsk_t gfsk;
+    } pkt_status;  //!< Packet status, according to PACKET_TYPE
+} apps_common_lr11xx_rx_packet_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
@@ -169,11 +184,28 @@ void apps_common_lr11xx_handle_post_wifi_scan( void );
  */
 void apps_common_lr11xx_receive( const void* context, uint8_t* buffer, uint8_t buffer_length, uint8_t* size );
 
+/*!
+ * @brief Fetch the payload and the status of the last received packet, without tracing anything
+ *
+ * The Rx buffer status, the payload and the packet status are read back to back so that the time spent between
+ * RX_DONE and the end of the fetch is kept to the bus transactions. The radio may keep receiving meanwhile.
+ *
+ * @param [in] context Pointer to the radio context
+ * @param [out] buffer Payload
+ * @param [in] buffer_length Length of the buffer to contain payload data
+ * @param [out] packet Payload length and packet status
+ *
+ * @returns Operation status - LR11XX_STATUS_ERROR if the payload does not fit in the buffer, packet->size still
+ * holds its length then
+ */
+lr11xx_status_t apps_common_lr11xx_fetch_rx_packet( const void* context, uint8_t* buffer, uint8_t buffer_length,
+                                                    apps_common_lr11xx_rx_packet_t* packet );
+
 /*!
  * @brief Interface to lr11xx interrupt processing routine
  *
- * This function fetched the IRQ mask from the lr11xx and process the raised IRQ if the corresponding bit is also set in
- * irq_filter.
+ * For each interrupt edge queued by the IRQ line ISR, this function fetches the IRQ mask from the lr11xx and calls the
+ * handler registered for each raised IRQ whose bit is also set in irq_filter, lowest bit first.
  * The argument irq_filter allows to not process an IRQ even if it is raised by the lr11xx.
  *
  * @warning This function must be called from the main loop of project to dispense all the lr11xx interrupt routine
@@ -183,6 +215,32 @@ void apps_common_lr11xx_receive( const void* context, uint8_t* buffer, uint8_t b
  */
 void apps_common_lr11xx_irq_process( const void* context, lr11xx_system_irq_mask_t irq_filter_mask );
 
+/*!
+ * @brief Register a handler for one or several interrupts, in place of the default one calling the on_* callback
+ *
+ * The handler is called by apps_common_lr11xx_irq_process with the time of the IRQ line edge, captured in the ISR.
+ *
+ * @param [in] irq_mask Interrupts the handler is called for
+ * @param [in] handler Handler, NULL to ignore the interrupts
+ */
+void apps_common_lr11xx_irq_register( lr11xx_system_irq_mask_t irq_mask, lr11xx_irq_dispatch_handler_t handler );
+
+/*!
+ * @brief Get the number of interrupt edges lost because too many were pending
+ *
+ * @returns Number of lost interrupt edges
+ */
+uint32_t apps_common_lr11xx_irq_get_nb_dropped( void );
+
+/*!
+ * @brief Tell whether interrupt edges are waiting for @ref apps_common_lr11xx_irq_process
+ *
+ * @remark To be checked with interrupts masked right before sleeping, so that an edge cannot be missed
+ *
+ * @returns true if @ref apps_common_lr11xx_irq_process has work to do
+ */
+bool apps_common_lr11xx_irq_is_pending( void );
+
 /*!
  * @brief Computes time on air, packet type agnostic
  */
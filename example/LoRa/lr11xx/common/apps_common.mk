@@ -32,6 +32,13 @@ RADIO_SHIELD ?= LR1110MB1DIS
 C_DEFS += -DLR11XX_DISABLE_WARNINGS
 C_DEFS += -DLR11XX_DISABLE_HIGH_ACP_WORKAROUND
 
+# Binary debug traces, decoded on the host with tools/trace_decoder
+APP_TRACE_DEFERRED ?= no
+
+ifeq ($(APP_TRACE_DEFERRED), yes)
+C_DEFS += -DHAL_DBG_TRACE_DEFERRED=1
+endif
+
 ifeq ($(RADIO_SHIELD), LR1110MB1DIS)
 C_DEFS += -DLR1110MB1DIS
 C_SOURCES += \
@@ -102,13 +109,17 @@ $(TOP_DIR)/lr11xx/common/apps_common.c \
 $(TOP_DIR)/lr11xx/common/lr11xx_hal.c \
 $(TOP_DIR)/lr11xx/common/apps_version.c \
 $(TOP_DIR)/common/src/smtc_hal_dbg_trace.c \
+$(TOP_DIR)/common/src/smtc_hal_dbg_trace_deferred.c \
 $(TOP_DIR)/common/src/common_version.c \
 $(TOP_DIR)/common/src/smtc_shield_pinout_mapping.c \
-$(TOP_DIR)/common/src/uart_init.c \
+$(TOP_DIR)/../common/src/smtc_busy_stats.c \
+$(TOP_DIR)/../common/src/smtc_spi_crc.c \
+$(TOP_DIR)/../common/src/uart_init.c \
 
 C_INCLUDES +=  \
 -I$(TOP_DIR)/lr11xx/common \
--I$(TOP_DIR)/common/inc
+-I$(TOP_DIR)/common/inc \
+-I$(TOP_DIR)/../common/inc
 
 ifneq (,$(findstring LR1110,$(RADIO_SHIELD)))
 TRX_IS_GEOLOCATION_CAPABLE = true
@@ -121,11 +132,23 @@ endif
 C_SOURCES +=  \
 $(TOP_DIR)/lr11xx/lr11xx_driver/src/lr11xx_system.c \
 $(TOP_DIR)/lr11xx/lr11xx_driver/src/lr11xx_radio.c \
+$(TOP_DIR)/lr11xx/lr11xx_driver/src/lr11xx_radio_toa.c \
 $(TOP_DIR)/lr11xx/lr11xx_driver/src/lr11xx_regmem.c \
 $(TOP_DIR)/lr11xx/lr11xx_driver/src/lr11xx_wifi.c \
 $(TOP_DIR)/lr11xx/lr11xx_driver/src/lr11xx_gnss.c \
 $(TOP_DIR)/lr11xx/lr11xx_driver/src/lr11xx_driver_version.c \
 
+C_SOURCES +=  \
+$(TOP_DIR)/lr11xx/lr11xx_helpers/src/lr11xx_energy.c \
+$(TOP_DIR)/lr11xx/lr11xx_helpers/src/lr11xx_gnss_almanac_stream.c \
+$(TOP_DIR)/lr11xx/lr11xx_helpers/src/lr11xx_gnss_nav_batch.c \
+$(TOP_DIR)/lr11xx/lr11xx_helpers/src/lr11xx_hal_xfer.c \
+$(TOP_DIR)/lr11xx/lr11xx_helpers/src/lr11xx_irq_dispatch.c \
+$(TOP_DIR)/lr11xx/lr11xx_helpers/src/lr11xx_radio_cache.c \
+$(TOP_DIR)/lr11xx/lr11xx_helpers/src/lr11xx_regmem_batch.c \
+$(TOP_DIR)/lr11xx/lr11xx_helpers/src/lr11xx_wifi_aggregator.c \
+
 C_INCLUDES +=  \
 -I$(TOP_DIR)/lr11xx/lr11xx_driver/src \
+-I$(TOP_DIR)/lr11xx/lr11xx_helpers/src \
 -I$(TOP_DIR)/libs/smtc_dbpsk_driver/src/ \
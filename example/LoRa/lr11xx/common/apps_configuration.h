@@ -194,6 +194,13 @@ static const uint8_t gfsk_sync_word[8] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0
 #define FSK_BROADCAST_ADDRESS 0xAB
 #endif
 
+/*!
+ * @brief Interrupts traced on the debug interface when dispatched - the trace of a cleared bit is compiled out
+ */
+#ifndef APPS_COMMON_IRQ_TRACE_MASK
+#define APPS_COMMON_IRQ_TRACE_MASK LR11XX_SYSTEM_IRQ_ALL_MASK
+#endif
+
 /*!
  * @brief Sigfox radio configuration
  */
@@ -42,6 +42,8 @@
 #include <stddef.h>
 
 #include "lr11xx_hal.h"
+#include "lr11xx_hal_async.h"
+#include "smtc_hal_mcu.h"
 #include "smtc_hal_mcu_spi.h"
 #include "smtc_hal_mcu_gpio.h"
 #include "stm32l4xx_ll_utils.h"
@@ -58,6 +60,18 @@
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
 
+/**
+ * @brief Maximum time the chip may stay busy before a blocking transfer is aborted
+ */
+#ifndef LR11XX_HAL_BUSY_TIMEOUT_MS
+#define LR11XX_HAL_BUSY_TIMEOUT_MS ( 1000 )
+#endif
+
+/**
+ * @brief Opcode of the SetSleep command - the chip stays busy while asleep, so this command is not timed
+ */
+#define LR11XX_HAL_SET_SLEEP_OPCODE ( 0x011B )
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
@@ -65,18 +79,109 @@
 
 /*
  * -----------------------------------------------------------------------------
- * --- PRIVATE VARIABLES -------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Wait until radio busy pin returns to 0, sleeping until its falling edge
+ *
+ * @param [in] lr11xx_context Radio context
+ *
+ * @returns Operation status - LR11XX_HAL_STATUS_ERROR if the chip is still busy after LR11XX_HAL_BUSY_TIMEOUT_MS
  */
+static lr11xx_hal_status_t lr11xx_hal_wait_on_busy( lr11xx_hal_context_t* lr11xx_context );
+
+/**
+ * @brief Wait until radio busy pin returns to 0 without sleeping, for callers running in an interrupt handler
+ *
+ * @remark Neither the busy interrupt nor the tick interrupt can preempt the running handler, so the SysTick reloads
+ * are counted to enforce the timeout
+ *
+ * @param [in] lr11xx_context Radio context
+ *
+ * @returns Operation status - LR11XX_HAL_STATUS_ERROR if the chip is still busy after LR11XX_HAL_BUSY_TIMEOUT_MS
+ */
+static lr11xx_hal_status_t lr11xx_hal_poll_busy( lr11xx_hal_context_t* lr11xx_context );
+
+/**
+ * @brief Wait until the non-blocking transfer in flight, if any, is over
+ *
+ * @remark The transfer is moved forward by the busy and SPI interrupts, which cannot preempt the running handler: a
+ * caller running in an interrupt handler gets LR11XX_HAL_STATUS_ERROR if a transfer is ongoing
+ *
+ * @param [in] lr11xx_context Radio context
+ *
+ * @returns Operation status - LR11XX_HAL_STATUS_ERROR if the transfer is still ongoing after its timeout
+ */
+static lr11xx_hal_status_t lr11xx_hal_wait_on_xfer_idle( lr11xx_hal_context_t* lr11xx_context );
+
+/**
+ * @brief Start timing a command, right before NSS is released after it
+ *
+ * @remark The busy interrupt is armed so that the busy falling edge ending the command is timestamped
+ *
+ * @param [in] lr11xx_context Radio context
+ * @param [in] opcode Opcode of the command
+ */
+static void lr11xx_hal_start_busy_timing( lr11xx_hal_context_t* lr11xx_context, uint16_t opcode );
+
+/**
+ * @brief Record the time elapsed since the start of the command being timed, if any
+ *
+ * @remark To be called with interrupts masked, or from the busy interrupt
+ *
+ * @param [in] lr11xx_context Radio context
+ */
+static void lr11xx_hal_stop_busy_timing( lr11xx_hal_context_t* lr11xx_context );
+
+/**
+ * @brief Exchange the frames of a prepared transaction, blocking until the end of the last one
+ *
+ * @param [in] lr11xx_context Radio context holding the prepared transaction
+ * @param [in] opcode Opcode of the transaction command, LR11XX_HAL_BUSY_STATS_OPCODE_NONE if there is none
+ *
+ * @returns Operation status
+ */
+static lr11xx_hal_status_t lr11xx_hal_run_xfer( lr11xx_hal_context_t* lr11xx_context, uint16_t opcode );
+
+/**
+ * @brief Convert a transaction frame into a list of SPI segments
+ *
+ * @param [in] frame Transaction frame
+ * @param [out] segments SPI segments - at least LR11XX_HAL_XFER_SEGMENTS_MAX elements
+ */
+static void lr11xx_hal_frame_to_spi_segments( const lr11xx_hal_xfer_frame_t* frame,
+                                              smtc_hal_mcu_spi_segment_t*    segments );
+
+/**
+ * @brief Get the transaction descriptor of a radio context, ready to be started
+ *
+ * @param [in] context Radio context
+ *
+ * @returns Transaction descriptor
+ */
+static lr11xx_hal_xfer_t* lr11xx_hal_get_xfer( const void* context );
+
+static bool                lr11xx_hal_xfer_is_busy( const void* context );
+static void                lr11xx_hal_xfer_set_nss( const void* context, bool is_high );
+static void                lr11xx_hal_xfer_arm_busy_irq( const void* context );
+static lr11xx_hal_status_t lr11xx_hal_xfer_start_frame( const void* context, const lr11xx_hal_xfer_frame_t* frame );
+static void                lr11xx_hal_on_spi_done( smtc_hal_mcu_status_t status, void* context );
 
 /*
  * -----------------------------------------------------------------------------
- * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
  */
 
 /**
- * @brief Wait until radio busy pin returns to 0
+ * @brief Platform operations used by the non-blocking transaction engine
  */
-void lr11xx_hal_wait_on_busy( const void* radio );
+static const lr11xx_hal_xfer_ops_t lr11xx_hal_xfer_ops = {
+    .is_busy      = lr11xx_hal_xfer_is_busy,
+    .set_nss      = lr11xx_hal_xfer_set_nss,
+    .arm_busy_irq = lr11xx_hal_xfer_arm_busy_irq,
+    .start_frame  = lr11xx_hal_xfer_start_frame,
+};
 
 /*
  * -----------------------------------------------------------------------------
@@ -85,10 +190,12 @@ void lr11xx_hal_wait_on_busy( const void* radio );
 
 lr11xx_hal_status_t lr11xx_hal_reset( const void* context )
 {
-    const lr11xx_hal_context_t* lr11xx_context = ( const lr11xx_hal_context_t* ) context;
+    lr11xx_hal_context_t* lr11xx_context = ( lr11xx_hal_context_t* ) context;
 
     smtc_hal_mcu_gpio_set_state( lr11xx_context->reset.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
     LL_mDelay( 1 );
+    // The busy period following a reset is the chip boot time
+    lr11xx_hal_start_busy_timing( lr11xx_context, SMTC_BUSY_STATS_OPCODE_NONE );
     smtc_hal_mcu_gpio_set_state( lr11xx_context->reset.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
 
     return LR11XX_HAL_STATUS_OK;
@@ -108,93 +215,108 @@ lr11xx_hal_status_t lr11xx_hal_wakeup( const void* context )
 lr11xx_hal_status_t lr11xx_hal_write( const void* context, const uint8_t* command, const uint16_t command_length,
                                       const uint8_t* data, const uint16_t data_length )
 {
-#if defined( USE_LR11XX_CRC_OVER_SPI )
-    uint8_t cmd_crc = lr11xx_hal_compute_crc( 0xFF, command, command_length );
-    cmd_crc         = lr11xx_hal_compute_crc( cmd_crc, data, data_length );
-#endif
+    // The transaction state is owned by the context, hence the const qualifier drop
+    lr11xx_hal_context_t* lr11xx_context = ( lr11xx_hal_context_t* ) context;
 
-    const lr11xx_hal_context_t* lr11xx_context = ( const lr11xx_hal_context_t* ) context;
-
-    lr11xx_hal_wait_on_busy( lr11xx_context );
+    if( lr11xx_hal_wait_on_xfer_idle( lr11xx_context ) != LR11XX_HAL_STATUS_OK )
+    {
+        return LR11XX_HAL_STATUS_ERROR;
+    }
 
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
-    smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, command, NULL, command_length );
-    smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, data, NULL, data_length );
-#if defined( USE_LR11XX_CRC_OVER_SPI )
-    smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, &cmd_crc, NULL, 1 );
-#endif
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    if( lr11xx_hal_xfer_prepare_write( &lr11xx_context->async.xfer, command, command_length, data, data_length ) !=
+        LR11XX_HAL_STATUS_OK )
+    {
+        return LR11XX_HAL_STATUS_ERROR;
+    }
 
-    return LR11XX_HAL_STATUS_OK;
+    return lr11xx_hal_run_xfer( lr11xx_context, smtc_busy_stats_get_opcode( command, command_length ) );
 }
 
 lr11xx_hal_status_t lr11xx_hal_read( const void* context, const uint8_t* command, const uint16_t command_length,
                                      uint8_t* data, const uint16_t data_length )
 {
-#if defined( USE_LR11XX_CRC_OVER_SPI )
-    const uint8_t cmd_crc = lr11xx_hal_compute_crc( 0xFF, command, command_length );
-#endif
+    lr11xx_hal_context_t* lr11xx_context = ( lr11xx_hal_context_t* ) context;
 
-    const lr11xx_hal_context_t* lr11xx_context = ( const lr11xx_hal_context_t* ) context;
-    const uint8_t               dummy_byte     = LR11XX_NOP;
-    uint8_t                     dummy_byte_rx  = LR11XX_NOP;
+    if( lr11xx_hal_wait_on_xfer_idle( lr11xx_context ) != LR11XX_HAL_STATUS_OK )
+    {
+        return LR11XX_HAL_STATUS_ERROR;
+    }
 
-    lr11xx_hal_wait_on_busy( lr11xx_context );
+    if( lr11xx_hal_xfer_prepare_read( &lr11xx_context->async.xfer, command, command_length, data, data_length ) !=
+        LR11XX_HAL_STATUS_OK )
+    {
+        return LR11XX_HAL_STATUS_ERROR;
+    }
 
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
-    smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, command, NULL, command_length );
-#if defined( USE_LR11XX_CRC_OVER_SPI )
-    smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, &cmd_crc, NULL, 1 );
-#endif
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    return lr11xx_hal_run_xfer( lr11xx_context, smtc_busy_stats_get_opcode( command, command_length ) );
+}
 
-    lr11xx_hal_wait_on_busy( lr11xx_context );
+lr11xx_hal_status_t lr11xx_hal_direct_read( const void* radio, uint8_t* data, const uint16_t data_length )
+{
+    lr11xx_hal_context_t* lr11xx_context = ( lr11xx_hal_context_t* ) radio;
 
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
-    smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, &dummy_byte, &dummy_byte_rx, 1 );
-    smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, NULL, data, data_length );
-#if defined( USE_LR11XX_CRC_OVER_SPI )
-    uint8_t crc_rx;
-    smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, &dummy_byte, &crc_rx, 1 );
-#endif
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    if( lr11xx_hal_wait_on_xfer_idle( lr11xx_context ) != LR11XX_HAL_STATUS_OK )
+    {
+        return LR11XX_HAL_STATUS_ERROR;
+    }
 
-#if defined( USE_LR11XX_CRC_OVER_SPI )
-    uint8_t crc_computed = lr11xx_hal_compute_crc( 0xFF, &dummy, 1 );
-    crc_computed         = lr11xx_hal_compute_crc( crc_computed, data, data_length );
-    if( crc_rx != crc_computed )
+    if( lr11xx_hal_xfer_prepare_direct_read( &lr11xx_context->async.xfer, data, data_length ) !=
+        LR11XX_HAL_STATUS_OK )
     {
         return LR11XX_HAL_STATUS_ERROR;
     }
-#endif
 
-    return LR11XX_HAL_STATUS_OK;
+    return lr11xx_hal_run_xfer( lr11xx_context, SMTC_BUSY_STATS_OPCODE_NONE );
 }
 
-lr11xx_hal_status_t lr11xx_hal_direct_read( const void* radio, uint8_t* data, const uint16_t data_length )
+lr11xx_hal_status_t lr11xx_hal_write_async( const void* context, const uint8_t* command, const uint16_t command_length,
+                                            const uint8_t* data, const uint16_t data_length,
+                                            lr11xx_hal_callback_t callback, void* user_context )
 {
-    const lr11xx_hal_context_t* lr11xx_context = ( const lr11xx_hal_context_t* ) radio;
+    lr11xx_hal_xfer_t* xfer = lr11xx_hal_get_xfer( context );
 
-    lr11xx_hal_wait_on_busy( lr11xx_context );
+    if( lr11xx_hal_xfer_prepare_write( xfer, command, command_length, data, data_length ) != LR11XX_HAL_STATUS_OK )
+    {
+        return LR11XX_HAL_STATUS_ERROR;
+    }
 
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
-    smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, NULL, data, data_length );
-#if defined( USE_LR11XX_CRC_OVER_SPI )
-    uint8_t crc_rx;
-    smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, NULL, &crc_rx, 1 );
-#endif
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    return lr11xx_hal_xfer_start( xfer, callback, user_context );
+}
 
-#if defined( USE_LR11XX_CRC_OVER_SPI )
-    // check crc value
-    uint8_t crc_computed = lr11xx_hal_compute_crc( 0xFF, data, data_length );
-    if( rx_crc != crc_computed )
+lr11xx_hal_status_t lr11xx_hal_read_async( const void* context, const uint8_t* command, const uint16_t command_length,
+                                           uint8_t* data, const uint16_t data_length, lr11xx_hal_callback_t callback,
+                                           void* user_context )
+{
+    lr11xx_hal_xfer_t* xfer = lr11xx_hal_get_xfer( context );
+
+    if( lr11xx_hal_xfer_prepare_read( xfer, command, command_length, data, data_length ) != LR11XX_HAL_STATUS_OK )
     {
         return LR11XX_HAL_STATUS_ERROR;
     }
-#endif
 
-    return LR11XX_HAL_STATUS_OK;
+    return lr11xx_hal_xfer_start( xfer, callback, user_context );
+}
+
+void lr11xx_hal_on_busy_irq( void* context )
+{
+    lr11xx_hal_context_t* lr11xx_context = ( lr11xx_hal_context_t* ) context;
+
+    // One-shot notification, re-armed by the transaction engine if needed
+    smtc_hal_mcu_gpio_disable_irq( lr11xx_context->busy.inst );
+    lr11xx_hal_stop_busy_timing( lr11xx_context );
+    lr11xx_hal_xfer_process( &lr11xx_context->async.xfer );
+}
+
+const smtc_busy_stats_t* lr11xx_hal_get_busy_stats( const void* context )
+{
+    return &( ( const lr11xx_hal_context_t* ) context )->busy.stats;
+}
+
+void lr11xx_hal_reset_busy_stats( const void* context )
+{
+    lr11xx_hal_context_t* lr11xx_context = ( lr11xx_hal_context_t* ) context;
+
+    smtc_busy_stats_reset( &lr11xx_context->busy.stats );
 }
 
 /*
@@ -202,15 +324,286 @@ lr11xx_hal_status_t lr11xx_hal_direct_read( const void* radio, uint8_t* data, co
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
  */
 
-void lr11xx_hal_wait_on_busy( const void* radio )
+static lr11xx_hal_status_t lr11xx_hal_wait_on_busy( lr11xx_hal_context_t* lr11xx_context )
+{
+    if( lr11xx_hal_xfer_is_busy( lr11xx_context ) == false )
+    {
+        return LR11XX_HAL_STATUS_OK;
+    }
+
+    if( __get_IPSR( ) != 0 )
+    {
+        return lr11xx_hal_poll_busy( lr11xx_context );
+    }
+
+    const uint32_t start_ms = smtc_hal_mcu_get_time_in_ms( );
+    bool           is_busy  = true;
+
+    while( is_busy == true )
+    {
+        if( ( smtc_hal_mcu_get_time_in_ms( ) - start_ms ) > LR11XX_HAL_BUSY_TIMEOUT_MS )
+        {
+            smtc_hal_mcu_gpio_disable_irq( lr11xx_context->busy.inst );
+            lr11xx_context->busy.is_timing = false;
+            smtc_busy_stats_record_timeout( &lr11xx_context->busy.stats );
+            return LR11XX_HAL_STATUS_ERROR;
+        }
+
+        // The busy falling edge, or the 1 ms tick, ends the sleep. The line is sampled with interrupts masked so that
+        // an edge occurring between the check and WFI is kept pending and wakes the core up right away. Any edge still
+        // latched at this point predates the interrupt enabling, as it would have been taken otherwise
+        __disable_irq( );
+        if( lr11xx_context->busy.is_timing == false )
+        {
+            smtc_hal_mcu_gpio_clear_irq( lr11xx_context->busy.inst );
+            smtc_hal_mcu_gpio_enable_irq( lr11xx_context->busy.inst );
+        }
+        is_busy = lr11xx_hal_xfer_is_busy( lr11xx_context );
+        if( is_busy == true )
+        {
+            __WFI( );
+        }
+        __enable_irq( );
+    }
+
+    // The busy interrupt handler disables it, unless the line was sampled low before its edge was taken
+    if( lr11xx_context->busy.is_timing == false )
+    {
+        smtc_hal_mcu_gpio_disable_irq( lr11xx_context->busy.inst );
+    }
+
+    return LR11XX_HAL_STATUS_OK;
+}
+
+static lr11xx_hal_status_t lr11xx_hal_poll_busy( lr11xx_hal_context_t* lr11xx_context )
+{
+    uint32_t elapsed_ms = 0;
+    uint32_t tick_value = SysTick->VAL;
+
+    while( lr11xx_hal_xfer_is_busy( lr11xx_context ) == true )
+    {
+        // SysTick counts down, a greater value means it was reloaded
+        const uint32_t new_tick_value = SysTick->VAL;
+
+        if( ( new_tick_value > tick_value ) && ( ++elapsed_ms > LR11XX_HAL_BUSY_TIMEOUT_MS ) )
+        {
+            smtc_hal_mcu_gpio_disable_irq( lr11xx_context->busy.inst );
+            lr11xx_context->busy.is_timing = false;
+            smtc_busy_stats_record_timeout( &lr11xx_context->busy.stats );
+            return LR11XX_HAL_STATUS_ERROR;
+        }
+        tick_value = new_tick_value;
+    }
+
+    // The busy interrupt cannot preempt the running handler: the command ends now, and its edge is dropped
+    __disable_irq( );
+    if( lr11xx_context->busy.is_timing == true )
+    {
+        smtc_hal_mcu_gpio_disable_irq( lr11xx_context->busy.inst );
+        smtc_hal_mcu_gpio_clear_irq( lr11xx_context->busy.inst );
+        lr11xx_hal_stop_busy_timing( lr11xx_context );
+    }
+    __enable_irq( );
+
+    return LR11XX_HAL_STATUS_OK;
+}
+
+static lr11xx_hal_status_t lr11xx_hal_wait_on_xfer_idle( lr11xx_hal_context_t* lr11xx_context )
+{
+    const lr11xx_hal_xfer_t* xfer = &lr11xx_context->async.xfer;
+
+    if( lr11xx_hal_xfer_is_idle( xfer ) == true )
+    {
+        return LR11XX_HAL_STATUS_OK;
+    }
+
+    if( __get_IPSR( ) != 0 )
+    {
+        return LR11XX_HAL_STATUS_ERROR;
+    }
+
+    // Each frame of the transfer waits for the busy line
+    const uint32_t timeout_ms = LR11XX_HAL_XFER_FRAMES_MAX * LR11XX_HAL_BUSY_TIMEOUT_MS;
+    const uint32_t start_ms   = smtc_hal_mcu_get_time_in_ms( );
+    bool           is_idle    = false;
+
+    while( is_idle == false )
+    {
+        if( ( smtc_hal_mcu_get_time_in_ms( ) - start_ms ) > timeout_ms )
+        {
+            return LR11XX_HAL_STATUS_ERROR;
+        }
+
+        // The transfer ends in an interrupt, or the 1 ms tick ends the sleep. The state is sampled with interrupts
+        // masked so that an interrupt occurring between the check and WFI wakes the core up right away
+        __disable_irq( );
+        is_idle = lr11xx_hal_xfer_is_idle( xfer );
+        if( is_idle == false )
+        {
+            __WFI( );
+        }
+        __enable_irq( );
+    }
+
+    return LR11XX_HAL_STATUS_OK;
+}
+
+static void lr11xx_hal_start_busy_timing( lr11xx_hal_context_t* lr11xx_context, uint16_t opcode )
+{
+    if( opcode == LR11XX_HAL_SET_SLEEP_OPCODE )
+    {
+        return;
+    }
+
+    // The chip cannot end the command before NSS is released: a latched edge belongs to an earlier busy period
+    smtc_hal_mcu_gpio_disable_irq( lr11xx_context->busy.inst );
+    smtc_hal_mcu_gpio_clear_irq( lr11xx_context->busy.inst );
+
+    lr11xx_context->busy.opcode    = opcode;
+    lr11xx_context->busy.start_us  = smtc_hal_mcu_get_time_in_us( );
+    lr11xx_context->busy.is_timing = true;
+
+    smtc_hal_mcu_gpio_enable_irq( lr11xx_context->busy.inst );
+}
+
+static void lr11xx_hal_stop_busy_timing( lr11xx_hal_context_t* lr11xx_context )
+{
+    if( lr11xx_context->busy.is_timing == true )
+    {
+        lr11xx_context->busy.is_timing = false;
+        smtc_busy_stats_record( &lr11xx_context->busy.stats, lr11xx_context->busy.opcode,
+                                smtc_hal_mcu_get_time_in_us( ) - lr11xx_context->busy.start_us );
+    }
+}
+
+static lr11xx_hal_status_t lr11xx_hal_run_xfer( lr11xx_hal_context_t* lr11xx_context, uint16_t opcode )
+{
+    lr11xx_hal_xfer_t*         xfer   = &lr11xx_context->async.xfer;
+    lr11xx_hal_status_t        status = LR11XX_HAL_STATUS_OK;
+    smtc_hal_mcu_spi_segment_t segments[LR11XX_HAL_XFER_SEGMENTS_MAX];
+
+    for( uint8_t i = 0; i < xfer->nb_frames; i++ )
+    {
+        lr11xx_hal_frame_to_spi_segments( &xfer->frames[i], segments );
+
+        status = lr11xx_hal_wait_on_busy( lr11xx_context );
+        if( status != LR11XX_HAL_STATUS_OK )
+        {
+            break;
+        }
+
+        smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
+        const smtc_hal_mcu_status_t spi_status =
+            smtc_hal_mcu_spi_rw_segments( lr11xx_context->spi.inst, segments, xfer->frames[i].nb_segments );
+        if( ( i == 0 ) && ( opcode != SMTC_BUSY_STATS_OPCODE_NONE ) && ( spi_status == SMTC_HAL_MCU_STATUS_OK ) )
+        {
+            lr11xx_hal_start_busy_timing( lr11xx_context, opcode );
+        }
+        smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+
+        if( spi_status != SMTC_HAL_MCU_STATUS_OK )
+        {
+            status = LR11XX_HAL_STATUS_ERROR;
+            break;
+        }
+    }
+
+    if( status == LR11XX_HAL_STATUS_OK )
+    {
+        status = lr11xx_hal_xfer_check_crc( xfer );
+    }
+
+    lr11xx_hal_xfer_release( xfer );
+
+    return status;
+}
+
+static void lr11xx_hal_frame_to_spi_segments( const lr11xx_hal_xfer_frame_t* frame,
+                                              smtc_hal_mcu_spi_segment_t*    segments )
+{
+    for( uint8_t i = 0; i < frame->nb_segments; i++ )
+    {
+        // NULL tx buffers are sent as 0x00, which is LR11XX_NOP
+        segments[i].data_out    = frame->segments[i].tx;
+        segments[i].data_in     = frame->segments[i].rx;
+        segments[i].data_length = frame->segments[i].length;
+    }
+}
+
+static lr11xx_hal_xfer_t* lr11xx_hal_get_xfer( const void* context )
+{
+    lr11xx_hal_context_t* lr11xx_context = ( lr11xx_hal_context_t* ) context;
+
+    if( lr11xx_context->async.xfer.ops == NULL )
+    {
+        lr11xx_hal_xfer_init( &lr11xx_context->async.xfer, &lr11xx_hal_xfer_ops, lr11xx_context );
+    }
+
+    return &lr11xx_context->async.xfer;
+}
+
+static bool lr11xx_hal_xfer_is_busy( const void* context )
 {
-    const lr11xx_hal_context_t* lr11xx_context = ( const lr11xx_hal_context_t* ) radio;
+    const lr11xx_hal_context_t* lr11xx_context = ( const lr11xx_hal_context_t* ) context;
     smtc_hal_mcu_gpio_state_t   gpio_state;
 
-    do
+    smtc_hal_mcu_gpio_get_state( lr11xx_context->busy.inst, &gpio_state );
+
+    return ( gpio_state == SMTC_HAL_MCU_GPIO_STATE_HIGH ) ? true : false;
+}
+
+static void lr11xx_hal_xfer_set_nss( const void* context, bool is_high )
+{
+    lr11xx_hal_context_t*    lr11xx_context = ( lr11xx_hal_context_t* ) context;
+    const lr11xx_hal_xfer_t* xfer           = &lr11xx_context->async.xfer;
+
+    // NSS is released after the command frame of a non-blocking transfer
+    if( ( is_high == true ) && ( xfer->state == LR11XX_HAL_XFER_STATE_IN_FLIGHT ) && ( xfer->frame_index == 0 ) )
     {
-        smtc_hal_mcu_gpio_get_state( lr11xx_context->busy.inst, &gpio_state );
-    } while( gpio_state == SMTC_HAL_MCU_GPIO_STATE_HIGH );
+        const uint16_t opcode =
+            smtc_busy_stats_get_opcode( xfer->frames[0].segments[0].tx, xfer->frames[0].segments[0].length );
+
+        if( opcode != SMTC_BUSY_STATS_OPCODE_NONE )
+        {
+            lr11xx_hal_start_busy_timing( lr11xx_context, opcode );
+        }
+    }
+
+    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst,
+                                 ( is_high == true ) ? SMTC_HAL_MCU_GPIO_STATE_HIGH : SMTC_HAL_MCU_GPIO_STATE_LOW );
+}
+
+static void lr11xx_hal_xfer_arm_busy_irq( const void* context )
+{
+    const lr11xx_hal_context_t* lr11xx_context = ( const lr11xx_hal_context_t* ) context;
+
+    // An edge that occurred since the line was sampled is latched by the EXTI and fires right away
+    smtc_hal_mcu_gpio_enable_irq( lr11xx_context->busy.inst );
+}
+
+static lr11xx_hal_status_t lr11xx_hal_xfer_start_frame( const void* context, const lr11xx_hal_xfer_frame_t* frame )
+{
+    lr11xx_hal_context_t* lr11xx_context = ( lr11xx_hal_context_t* ) context;
+
+    lr11xx_hal_frame_to_spi_segments( frame, lr11xx_context->async.segments );
+
+    if( smtc_hal_mcu_spi_rw_segments_async( lr11xx_context->spi.inst, lr11xx_context->async.segments,
+                                            frame->nb_segments, lr11xx_hal_on_spi_done,
+                                            lr11xx_context ) != SMTC_HAL_MCU_STATUS_OK )
+    {
+        return LR11XX_HAL_STATUS_ERROR;
+    }
+
+    return LR11XX_HAL_STATUS_OK;
+}
+
+static void lr11xx_hal_on_spi_done( smtc_hal_mcu_status_t status, void* context )
+{
+    lr11xx_hal_context_t* lr11xx_context = ( lr11xx_hal_context_t* ) context;
+
+    lr11xx_hal_xfer_on_frame_done( &lr11xx_context->async.xfer, ( status == SMTC_HAL_MCU_STATUS_OK )
+                                                                    ? LR11XX_HAL_STATUS_OK
+                                                                    : LR11XX_HAL_STATUS_ERROR );
 }
 
 /* --- EOF ------------------------------------------------------------------ */
@@ -49,6 +49,8 @@ extern "C" {
 #include "smtc_hal_mcu_gpio_stm32l4.h"
 #include "stm32l4xx_ll_gpio.h"
 #include "stm32l4xx_ll_spi.h"
+#include "lr11xx_hal_xfer.h"
+#include "smtc_busy_stats.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -95,7 +97,16 @@ typedef struct
         smtc_hal_mcu_gpio_cfg_t       cfg;
         smtc_hal_mcu_gpio_input_cfg_t cfg_input;
         smtc_hal_mcu_gpio_inst_t      inst;
+        smtc_busy_stats_t             stats;
+        uint16_t                      opcode;     //!< Opcode of the command being timed
+        uint32_t                      start_us;   //!< Time NSS was released after the command being timed
+        volatile bool                 is_timing;  //!< The busy falling edge ending the command is awaited
     } busy;
+    struct
+    {
+        lr11xx_hal_xfer_t          xfer;
+        smtc_hal_mcu_spi_segment_t segments[LR11XX_HAL_XFER_SEGMENTS_MAX];
+    } async;
 } lr11xx_hal_context_t;
 
 /*
@@ -103,6 +114,34 @@ typedef struct
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
  */
 
+/**
+ * @brief Busy line falling edge handler, to be used as busy GPIO callback
+ *
+ * @remark The busy interrupt is enabled from the release of NSS after a command to the end of the busy period that
+ * follows, and while a transfer waits for the radio
+ *
+ * @param [in] context Pointer to the lr11xx_hal_context_t instance
+ */
+void lr11xx_hal_on_busy_irq( void* context );
+
+/**
+ * @brief Get the per-opcode busy time statistics
+ *
+ * @remark A command is timed from the release of NSS to the busy falling edge that follows
+ *
+ * @param [in] context Pointer to the lr11xx_hal_context_t instance
+ *
+ * @returns Pointer to the statistics table
+ */
+const smtc_busy_stats_t* lr11xx_hal_get_busy_stats( const void* context );
+
+/**
+ * @brief Clear the busy time statistics
+ *
+ * @param [in] context Pointer to the lr11xx_hal_context_t instance
+ */
+void lr11xx_hal_reset_busy_stats( const void* context );
+
 #ifdef __cplusplus
 }
 #endif
@@ -51,6 +51,7 @@
 #define LR11XX_LR_FHSS_FRAG_BITS ( 48 )
 #define LR11XX_LR_FHSS_BLOCK_PREAMBLE_BITS ( 2 )
 #define LR11XX_LR_FHSS_BLOCK_BITS ( LR11XX_LR_FHSS_FRAG_BITS + LR11XX_LR_FHSS_BLOCK_PREAMBLE_BITS )
+#define LR11XX_LR_FHSS_BIT_TIME_IN_US ( 2048 )  // 1 / 488.28125 bit/s
 
 /*
  * -----------------------------------------------------------------------------
@@ -167,6 +168,18 @@ uint32_t lr11xx_lr_fhss_get_time_on_air_in_ms( const lr11xx_lr_fhss_params_t* pa
     return ( ( lr11xx_lr_fhss_get_nb_bits( &params->lr_fhss_params, payload_length ) << 8 ) + 124 ) / 125;
 }
 
+uint32_t lr11xx_lr_fhss_get_time_on_air_in_us( const lr11xx_lr_fhss_params_t* params, uint16_t payload_length )
+{
+    return ( uint32_t ) lr11xx_lr_fhss_get_nb_bits( &params->lr_fhss_params, payload_length ) *
+           LR11XX_LR_FHSS_BIT_TIME_IN_US;
+}
+
+uint32_t lr11xx_lr_fhss_get_header_time_in_us( const lr11xx_lr_fhss_params_t* params )
+{
+    return ( uint32_t ) LR11XX_LR_FHSS_HEADER_BITS * params->lr_fhss_params.header_count *
+           LR11XX_LR_FHSS_BIT_TIME_IN_US;
+}
+
 unsigned int lr11xx_lr_fhss_get_hop_sequence_count( const lr11xx_lr_fhss_params_t* lr_fhss_params )
 {
     if( ( lr_fhss_params->lr_fhss_params.grid == LR_FHSS_V1_GRID_25391_HZ ) ||
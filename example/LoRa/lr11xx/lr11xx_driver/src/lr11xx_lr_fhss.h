@@ -120,6 +120,25 @@ lr11xx_status_t lr11xx_lr_fhss_build_frame( const void* context, const lr11xx_lr
  */
 uint32_t lr11xx_lr_fhss_get_time_on_air_in_ms( const lr11xx_lr_fhss_params_t* params, uint16_t payload_length );
 
+/*!
+ * @brief Get the time on air in us for LR-FHSS transmission
+ *
+ * @param [in]  params         LR11XX LR-FHSS parameter structure
+ * @param [in]  payload_length Length of application-layer payload
+ *
+ * @returns Time-on-air value in us for LR-FHSS transmission
+ */
+uint32_t lr11xx_lr_fhss_get_time_on_air_in_us( const lr11xx_lr_fhss_params_t* params, uint16_t payload_length );
+
+/*!
+ * @brief Get the duration in us of the header blocks of a LR-FHSS transmission
+ *
+ * @param [in]  params         LR11XX LR-FHSS parameter structure
+ *
+ * @returns Duration in us of the header blocks, sent before the payload
+ */
+uint32_t lr11xx_lr_fhss_get_header_time_in_us( const lr11xx_lr_fhss_params_t* params );
+
 /**
  * @brief Return the number of hop sequences available using the given parameters
  *
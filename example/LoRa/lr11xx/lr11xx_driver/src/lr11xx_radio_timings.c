@@ -39,6 +39,8 @@
 
 #include "lr11xx_radio_timings.h"
 #include "lr11xx_radio.h"
+#include "lr11xx_radio_toa.h"
+#include "lr11xx_lr_fhss.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -75,15 +77,6 @@
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
  */
 
-/**
- * @brief Get the power amplifier ramp time for a given power amplifier ramp time parameter
- *
- * @param [in] ramp_time Power amplifier ramp time parameter
- *
- * @returns Ramp time in microsecond
- */
-static uint32_t lr11xx_radio_timings_get_pa_ramp_time_in_us( const lr11xx_radio_ramp_time_t ramp_time );
-
 /**
  * @brief Get the LoRa reception input delay
  *
@@ -104,6 +97,26 @@ static uint32_t lr11xx_radio_timings_get_lora_rx_input_delay_in_us( lr11xx_radio
 static uint32_t lr11xx_radio_timings_get_lora_symb_time_in_us( const lr11xx_radio_lora_sf_t sf,
                                                                const lr11xx_radio_lora_bw_t bw );
 
+/**
+ * @brief Convert a number of periods of a frequency to microsecond, rounding up
+ *
+ * @param [in] nb_periods Number of periods
+ * @param [in] freq_in_hz Frequency in Hertz
+ *
+ * @returns Duration in microsecond
+ */
+static uint32_t lr11xx_radio_timings_periods_to_us( uint32_t nb_periods, uint32_t freq_in_hz );
+
+/**
+ * @brief Fill the parts of a transmission timing budget common to all packet types
+ *
+ * @param [in] ramp_time Power amplifier ramp time
+ * @param [in] tx_done_in_us Delay between the last bit sent and the Tx done interrupt
+ * @param [in,out] timings Timing budget, with the preamble and payload durations already set
+ */
+static void lr11xx_radio_timings_complete_tx( const lr11xx_radio_ramp_time_t ramp_time, uint32_t tx_done_in_us,
+                                              lr11xx_radio_timings_tx_t* timings );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -123,12 +136,85 @@ uint32_t lr11xx_radio_timings_get_delay_between_last_bit_sent_and_tx_done_in_us(
     return lr11xx_radio_timings_get_pa_ramp_time_in_us( ramp_time ) + TX_DONE_IRQ_PROCESSING_TIME_IN_US;
 }
 
-/*
- * -----------------------------------------------------------------------------
- * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
- */
+void lr11xx_radio_timings_get_lora_tx( const lr11xx_radio_pkt_params_lora_t* pkt_params,
+                                       const lr11xx_radio_mod_params_lora_t* mod_params,
+                                       const lr11xx_radio_ramp_time_t ramp_time, lr11xx_radio_timings_tx_t* timings )
+{
+    const uint32_t bw_in_hz = lr11xx_radio_get_lora_bw_in_hz( mod_params->bw );
+
+    // Preamble, then 4.25 symbols of synchronization word and 2 more symbols at SF5 and SF6, in quarters of symbol
+    const uint32_t preamble_numerator =
+        ( 4 * ( pkt_params->preamble_len_in_symb + 4 + 2 * LR11XX_RADIO_TOA_LORA_FINE_SYNCH( mod_params->sf ) ) + 1 )
+        << ( mod_params->sf - 2 );
+
+    timings->preamble_in_us = lr11xx_radio_timings_periods_to_us( preamble_numerator, bw_in_hz );
+    timings->payload_in_us =
+        lr11xx_radio_timings_periods_to_us( lr11xx_radio_get_lora_time_on_air_numerator( pkt_params, mod_params ),
+                                            bw_in_hz ) -
+        timings->preamble_in_us;
+
+    lr11xx_radio_timings_complete_tx(
+        ramp_time, lr11xx_radio_timings_get_delay_between_last_bit_sent_and_tx_done_in_us( ramp_time ), timings );
+}
 
-static uint32_t lr11xx_radio_timings_get_pa_ramp_time_in_us( const lr11xx_radio_ramp_time_t ramp_time )
+void lr11xx_radio_timings_get_gfsk_tx( const lr11xx_radio_pkt_params_gfsk_t* pkt_params,
+                                       const lr11xx_radio_mod_params_gfsk_t* mod_params,
+                                       const lr11xx_radio_ramp_time_t ramp_time, lr11xx_radio_timings_tx_t* timings )
+{
+    timings->preamble_in_us = lr11xx_radio_timings_periods_to_us(
+        pkt_params->preamble_len_in_bits + pkt_params->sync_word_len_in_bits, mod_params->br_in_bps );
+    timings->payload_in_us =
+        lr11xx_radio_timings_periods_to_us( lr11xx_radio_get_gfsk_time_on_air_numerator( pkt_params ),
+                                            mod_params->br_in_bps ) -
+        timings->preamble_in_us;
+
+    lr11xx_radio_timings_complete_tx(
+        ramp_time, lr11xx_radio_timings_get_delay_between_last_bit_sent_and_tx_done_in_us( ramp_time ), timings );
+}
+
+void lr11xx_radio_timings_get_bpsk_tx( const lr11xx_radio_pkt_params_bpsk_t* pkt_params,
+                                       const lr11xx_radio_mod_params_bpsk_t* mod_params,
+                                       const lr11xx_radio_ramp_time_t ramp_time, lr11xx_radio_timings_tx_t* timings )
+{
+    const uint32_t pld_len_in_bits =
+        ( pkt_params->pld_len_in_bits != 0 ) ? pkt_params->pld_len_in_bits : 8 * pkt_params->pld_len_in_bytes;
+
+    timings->preamble_in_us = 0;
+    timings->payload_in_us  = lr11xx_radio_timings_periods_to_us( pld_len_in_bits, mod_params->br_in_bps );
+
+    lr11xx_radio_timings_complete_tx(
+        ramp_time, lr11xx_radio_timings_get_delay_between_last_bit_sent_and_tx_done_in_us( ramp_time ), timings );
+}
+
+void lr11xx_radio_timings_get_lr_fhss_tx( const lr11xx_lr_fhss_params_t* params, uint16_t payload_length,
+                                          const lr11xx_radio_ramp_time_t ramp_time,
+                                          lr11xx_radio_timings_tx_t*     timings )
+{
+    timings->preamble_in_us = lr11xx_lr_fhss_get_header_time_in_us( params );
+    timings->payload_in_us =
+        lr11xx_lr_fhss_get_time_on_air_in_us( params, payload_length ) - timings->preamble_in_us;
+
+    lr11xx_radio_timings_complete_tx( ramp_time, lr11xx_lr_fhss_get_bit_delay_in_us( params, payload_length ),
+                                      timings );
+}
+
+void lr11xx_radio_timings_get_lora_rx( const lr11xx_radio_mod_params_lora_t* mod_params,
+                                       lr11xx_radio_timings_rx_t*            timings )
+{
+    timings->input_delay_in_us = lr11xx_radio_timings_get_lora_rx_input_delay_in_us( mod_params->bw );
+    timings->symb_time_in_us   = lr11xx_radio_timings_get_lora_symb_time_in_us( mod_params->sf, mod_params->bw );
+    timings->rx_done_in_us     = lr11xx_radio_timings_get_delay_between_last_bit_sent_and_rx_done_in_us( mod_params );
+}
+
+void lr11xx_radio_timings_get_gfsk_rx( const lr11xx_radio_mod_params_gfsk_t* mod_params,
+                                       lr11xx_radio_timings_rx_t*            timings )
+{
+    timings->input_delay_in_us = 0;
+    timings->symb_time_in_us   = lr11xx_radio_timings_periods_to_us( 1, mod_params->br_in_bps );
+    timings->rx_done_in_us     = RX_DONE_IRQ_PROCESSING_TIME_IN_US;
+}
+
+uint32_t lr11xx_radio_timings_get_pa_ramp_time_in_us( const lr11xx_radio_ramp_time_t ramp_time )
 {
     switch( ramp_time )
     {
@@ -201,6 +287,11 @@ static uint32_t lr11xx_radio_timings_get_pa_ramp_time_in_us( const lr11xx_radio_
     }
 }
 
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
 static uint32_t lr11xx_radio_timings_get_lora_rx_input_delay_in_us( lr11xx_radio_lora_bw_t bw )
 {
     switch( bw )
@@ -230,4 +321,23 @@ static uint32_t lr11xx_radio_timings_get_lora_symb_time_in_us( const lr11xx_radi
     return ( 1 << ( uint8_t ) sf ) * 1000000 / lr11xx_radio_get_lora_bw_in_hz( bw );
 }
 
+static uint32_t lr11xx_radio_timings_periods_to_us( uint32_t nb_periods, uint32_t freq_in_hz )
+{
+    if( freq_in_hz == 0 )
+    {
+        return 0;
+    }
+
+    return ( uint32_t ) ( ( ( uint64_t ) nb_periods * 1000000 + freq_in_hz - 1 ) / freq_in_hz );
+}
+
+static void lr11xx_radio_timings_complete_tx( const lr11xx_radio_ramp_time_t ramp_time, uint32_t tx_done_in_us,
+                                              lr11xx_radio_timings_tx_t* timings )
+{
+    timings->ramp_up_in_us = lr11xx_radio_timings_get_pa_ramp_time_in_us( ramp_time );
+    timings->tx_done_in_us = tx_done_in_us;
+    timings->total_in_us =
+        timings->ramp_up_in_us + timings->preamble_in_us + timings->payload_in_us + timings->tx_done_in_us;
+}
+
 /* --- EOF ------------------------------------------------------------------ */
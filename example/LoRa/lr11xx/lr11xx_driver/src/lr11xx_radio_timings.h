@@ -45,6 +45,7 @@ extern "C" {
  */
 
 #include "lr11xx_radio_types.h"
+#include "lr11xx_lr_fhss_types.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -61,6 +62,30 @@ extern "C" {
  * --- PUBLIC TYPES ------------------------------------------------------------
  */
 
+/**
+ * @brief Timing budget of a transmission, in microsecond
+ *
+ * The time the chip takes between the Tx command and the beginning of the power amplifier ramp-up is not included.
+ */
+typedef struct lr11xx_radio_timings_tx_s
+{
+    uint32_t ramp_up_in_us;   //!< Power amplifier ramp-up, before the first bit is sent
+    uint32_t preamble_in_us;  //!< Preamble and synchronization word - LR-FHSS header blocks
+    uint32_t payload_in_us;   //!< Header, payload and CRC - the rest of the time on air
+    uint32_t tx_done_in_us;   //!< From the last bit sent to the Tx done interrupt
+    uint32_t total_in_us;     //!< From the beginning of the ramp-up to the Tx done interrupt
+} lr11xx_radio_timings_tx_t;
+
+/**
+ * @brief Timing budget of a reception, in microsecond
+ */
+typedef struct lr11xx_radio_timings_rx_s
+{
+    uint32_t input_delay_in_us;  //!< Delay of the reception chain
+    uint32_t symb_time_in_us;    //!< Duration of a symbol - of a bit in GFSK
+    uint32_t rx_done_in_us;      //!< From the last bit sent on Tx side to the Rx done interrupt
+} lr11xx_radio_timings_rx_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
@@ -86,6 +111,85 @@ uint32_t lr11xx_radio_timings_get_delay_between_last_bit_sent_and_rx_done_in_us(
 uint32_t lr11xx_radio_timings_get_delay_between_last_bit_sent_and_tx_done_in_us(
     const lr11xx_radio_ramp_time_t ramp_time );
 
+/**
+ * @brief Get the power amplifier ramp time for a given power amplifier ramp time parameter
+ *
+ * @param [in] ramp_time Power amplifier ramp time parameter
+ *
+ * @returns Ramp time in microsecond
+ */
+uint32_t lr11xx_radio_timings_get_pa_ramp_time_in_us( const lr11xx_radio_ramp_time_t ramp_time );
+
+/**
+ * @brief Get the timing budget of a LoRa transmission
+ *
+ * @param [in] pkt_params Pointer to a structure holding the LoRa packet parameters
+ * @param [in] mod_params Pointer to a structure holding the LoRa modulation parameters
+ * @param [in] ramp_time Power amplifier ramp time
+ * @param [out] timings Timing budget - durations rounded up to the microsecond
+ */
+void lr11xx_radio_timings_get_lora_tx( const lr11xx_radio_pkt_params_lora_t* pkt_params,
+                                       const lr11xx_radio_mod_params_lora_t* mod_params,
+                                       const lr11xx_radio_ramp_time_t ramp_time, lr11xx_radio_timings_tx_t* timings );
+
+/**
+ * @brief Get the timing budget of a GFSK transmission
+ *
+ * @param [in] pkt_params Pointer to a structure holding the GFSK packet parameters
+ * @param [in] mod_params Pointer to a structure holding the GFSK modulation parameters
+ * @param [in] ramp_time Power amplifier ramp time
+ * @param [out] timings Timing budget - durations rounded up to the microsecond
+ */
+void lr11xx_radio_timings_get_gfsk_tx( const lr11xx_radio_pkt_params_gfsk_t* pkt_params,
+                                       const lr11xx_radio_mod_params_gfsk_t* mod_params,
+                                       const lr11xx_radio_ramp_time_t ramp_time, lr11xx_radio_timings_tx_t* timings );
+
+/**
+ * @brief Get the timing budget of a BPSK transmission
+ *
+ * The BPSK packet has no preamble of its own, it is part of the payload.
+ *
+ * @param [in] pkt_params Pointer to a structure holding the BPSK packet parameters
+ * @param [in] mod_params Pointer to a structure holding the BPSK modulation parameters
+ * @param [in] ramp_time Power amplifier ramp time
+ * @param [out] timings Timing budget - durations rounded up to the microsecond
+ */
+void lr11xx_radio_timings_get_bpsk_tx( const lr11xx_radio_pkt_params_bpsk_t* pkt_params,
+                                       const lr11xx_radio_mod_params_bpsk_t* mod_params,
+                                       const lr11xx_radio_ramp_time_t ramp_time, lr11xx_radio_timings_tx_t* timings );
+
+/**
+ * @brief Get the timing budget of a LR-FHSS transmission
+ *
+ * @param [in] params Pointer to a structure holding the LR-FHSS parameters
+ * @param [in] payload_length Length of application-layer payload
+ * @param [in] ramp_time Power amplifier ramp time
+ * @param [out] timings Timing budget
+ */
+void lr11xx_radio_timings_get_lr_fhss_tx( const lr11xx_lr_fhss_params_t* params, uint16_t payload_length,
+                                          const lr11xx_radio_ramp_time_t ramp_time,
+                                          lr11xx_radio_timings_tx_t*     timings );
+
+/**
+ * @brief Get the timing budget of a LoRa reception
+ *
+ * @param [in] mod_params Pointer to a structure holding the LoRa modulation parameters
+ * @param [out] timings Timing budget
+ */
+void lr11xx_radio_timings_get_lora_rx( const lr11xx_radio_mod_params_lora_t* mod_params,
+                                       lr11xx_radio_timings_rx_t*            timings );
+
+/**
+ * @brief Get the timing budget of a GFSK reception
+ *
+ * @remark The input delay of the GFSK reception chain is not characterized, it is given as 0.
+ *
+ * @param [in] mod_params Pointer to a structure holding the GFSK modulation parameters
+ * @param [out] timings Timing budget
+ */
+void lr11xx_radio_timings_get_gfsk_rx( const lr11xx_radio_mod_params_gfsk_t* mod_params,
+                                       lr11xx_radio_timings_rx_t*            timings );
+
 #ifdef __cplusplus
 }
 #endif
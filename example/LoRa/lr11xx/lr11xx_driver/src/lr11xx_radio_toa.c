@@ -0,0 +1,139 @@
+/*!
+ * @file      lr11xx_radio_toa.c
+ *
+ * @brief     LoRa time-on-air descriptor
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include "lr11xx_radio_toa.h"
+#include "lr11xx_radio.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Value of lr11xx_radio_lora_toa_t::pld_len_split when there is a single segment
+ */
+#define LR11XX_RADIO_TOA_NO_SPLIT ( 256 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void lr11xx_radio_lora_toa_init( lr11xx_radio_lora_toa_t* toa, const lr11xx_radio_pkt_params_lora_t* pkt_p,
+                                 const lr11xx_radio_mod_params_lora_t* mod_p )
+{
+    const int32_t sf             = mod_p->sf;
+    const int32_t fine_synch     = LR11XX_RADIO_TOA_LORA_FINE_SYNCH( sf );
+    const int32_t tx_bits_symbol = LR11XX_RADIO_TOA_LORA_BITS_PER_SYMB( sf, mod_p->ldro );
+    const int32_t crc_bits       = ( pkt_p->crc == LR11XX_RADIO_LORA_CRC_ON ) ? 16 : 0;
+
+    toa->bw_in_hz          = lr11xx_radio_get_lora_bw_in_hz( mod_p->bw );
+    toa->base_in_symb      = pkt_p->preamble_len_in_symb + 4 + 2 * fine_synch;
+    toa->shift             = ( uint8_t ) ( sf - 2 );
+    toa->pld_len_split     = LR11XX_RADIO_TOA_NO_SPLIT;
+    toa->bits_min          = 0;
+    toa->offset[0]         = 0;
+    toa->offset[1]         = 0;
+    toa->bits_per_block[0] = ( uint16_t ) ( 4 * tx_bits_symbol );
+    toa->bits_per_block[1] = ( uint16_t ) ( 4 * tx_bits_symbol );
+
+    if( mod_p->cr <= LR11XX_RADIO_LORA_CR_4_8 )
+    {
+        // Blocks of 4 symbols worth of bits, coded on 4 + cr symbols, after 8 symbols carrying the header
+        toa->bits_offset    = ( int16_t ) ( crc_bits - LR11XX_RADIO_TOA_LORA_SI_HEADER_BITS( sf, pkt_p->header_type ) );
+        toa->bits_weight    = 1;
+        toa->symb_per_block = ( uint8_t ) ( mod_p->cr + 4 );
+        toa->base_in_symb += 8;
+    }
+    else if( pkt_p->header_type == LR11XX_RADIO_LORA_PKT_EXPLICIT )
+    {
+        // The header symbols carry some payload bits, the CRC is never in them
+        toa->bits_offset    = ( int16_t ) ( crc_bits - LR11XX_RADIO_TOA_LORA_LI_HEADER_CAPACITY( sf ) );
+        toa->bits_min       = ( uint8_t ) crc_bits;
+        toa->bits_weight    = ( uint8_t ) LR11XX_RADIO_TOA_LORA_LI_FEC_DENOMINATOR( mod_p->cr );
+        toa->symb_per_block = 1;
+        toa->base_in_symb += 8;
+    }
+    else
+    {
+        const int32_t tx_bits_symbol_start = LR11XX_RADIO_TOA_LORA_LI_BITS_PER_SYMB_START( sf );
+        const int32_t fec_rate_denominator = LR11XX_RADIO_TOA_LORA_LI_FEC_DENOMINATOR( mod_p->cr );
+
+        // Short packets fit in the first 8 symbols, coded with their own number of bits per symbol
+        const int32_t max_bits = ( 28 * tx_bits_symbol_start ) / fec_rate_denominator - crc_bits;
+
+        toa->bits_offset       = ( int16_t ) crc_bits;
+        toa->bits_weight       = ( uint8_t ) fec_rate_denominator;
+        toa->symb_per_block    = 1;
+        toa->bits_per_block[0] = ( uint16_t ) ( 4 * tx_bits_symbol_start );
+        toa->offset[1]         = ( int16_t ) ( 32 * ( tx_bits_symbol - tx_bits_symbol_start ) );
+        toa->pld_len_split     = ( max_bits < 0 ) ? 0 : ( uint16_t ) ( max_bits / 8 + 1 );
+        if( toa->pld_len_split > LR11XX_RADIO_TOA_NO_SPLIT )
+        {
+            toa->pld_len_split = LR11XX_RADIO_TOA_NO_SPLIT;
+        }
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,320 @@
+/*!
+ * @file      lr11xx_radio_toa.h
+ *
+ * @brief     LoRa and GFSK time-on-air, evaluated at build time or from a per-configuration descriptor
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LR11XX_RADIO_TOA_H
+#define LR11XX_RADIO_TOA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include "lr11xx_radio_types.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/**
+ * @brief Actual value in Hertz of a LoRa bandwidth - constant expression counterpart of
+ * lr11xx_radio_get_lora_bw_in_hz
+ */
+#define LR11XX_RADIO_LORA_BW_IN_HZ( bw )                  \
+    ( ( ( bw ) == LR11XX_RADIO_LORA_BW_10 )    ? 10417UL  \
+      : ( ( bw ) == LR11XX_RADIO_LORA_BW_15 )  ? 15625UL  \
+      : ( ( bw ) == LR11XX_RADIO_LORA_BW_20 )  ? 20833UL  \
+      : ( ( bw ) == LR11XX_RADIO_LORA_BW_31 )  ? 31250UL  \
+      : ( ( bw ) == LR11XX_RADIO_LORA_BW_41 )  ? 41667UL  \
+      : ( ( bw ) == LR11XX_RADIO_LORA_BW_62 )  ? 62500UL  \
+      : ( ( bw ) == LR11XX_RADIO_LORA_BW_125 ) ? 125000UL \
+      : ( ( bw ) == LR11XX_RADIO_LORA_BW_250 ) ? 250000UL \
+      : ( ( bw ) == LR11XX_RADIO_LORA_BW_500 ) ? 500000UL \
+      : ( ( bw ) == LR11XX_RADIO_LORA_BW_200 ) ? 203000UL \
+      : ( ( bw ) == LR11XX_RADIO_LORA_BW_400 ) ? 406000UL \
+      : ( ( bw ) == LR11XX_RADIO_LORA_BW_800 ) ? 812000UL \
+                                               : 0UL )
+
+/**
+ * @brief LoRa time-on-air numerator - constant expression counterpart of lr11xx_radio_get_lora_time_on_air_numerator
+ *
+ * @remark Meant for configurations known at build time, where it is evaluated by the compiler: the arguments are
+ * evaluated several times.
+ *
+ * @param [in] sf Spreading factor - lr11xx_radio_lora_sf_t
+ * @param [in] cr Coding rate - lr11xx_radio_lora_cr_t
+ * @param [in] ldro Low data rate optimization - 0 or 1
+ * @param [in] preamble_len_in_symb Preamble length in symbols
+ * @param [in] header_type Header type - lr11xx_radio_lora_pkt_len_modes_t
+ * @param [in] pld_len_in_bytes Payload length in bytes
+ * @param [in] crc CRC mode - lr11xx_radio_lora_crc_t
+ */
+#define LR11XX_RADIO_LORA_TOA_NUMERATOR( sf, cr, ldro, preamble_len_in_symb, header_type, pld_len_in_bytes, crc ) \
+    ( ( ( 4 * ( ( uint32_t ) ( preamble_len_in_symb ) + 4 + 2 * LR11XX_RADIO_TOA_LORA_FINE_SYNCH( sf ) +          \
+                ( uint32_t ) LR11XX_RADIO_TOA_LORA_DATA_SYMB( sf, cr, ldro, header_type, pld_len_in_bytes,        \
+                                                              crc ) ) +                                           \
+          1 )                                                                                                     \
+        << ( ( sf ) - 2 ) ) -                                                                                     \
+      1 )
+
+/**
+ * @brief LoRa time-on-air in ms - constant expression counterpart of lr11xx_radio_get_lora_time_on_air_in_ms
+ *
+ * @remark Same parameters as LR11XX_RADIO_LORA_TOA_NUMERATOR, plus the bandwidth - lr11xx_radio_lora_bw_t
+ */
+#define LR11XX_RADIO_LORA_TOA_IN_MS( sf, bw, cr, ldro, preamble_len_in_symb, header_type, pld_len_in_bytes, crc )    \
+    LR11XX_RADIO_TOA_CEIL_DIV(                                                                                       \
+        1000UL * LR11XX_RADIO_LORA_TOA_NUMERATOR( sf, cr, ldro, preamble_len_in_symb, header_type, pld_len_in_bytes, \
+                                                  crc ),                                                             \
+        LR11XX_RADIO_LORA_BW_IN_HZ( bw ) )
+
+/**
+ * @brief GFSK time-on-air numerator - constant expression counterpart of lr11xx_radio_get_gfsk_time_on_air_numerator
+ *
+ * @param [in] preamble_len_in_bits Preamble length in bits
+ * @param [in] sync_word_len_in_bits Synchronization word length in bits
+ * @param [in] address_filtering Address filtering - lr11xx_radio_gfsk_address_filtering_t
+ * @param [in] header_type Header type - lr11xx_radio_gfsk_pkt_len_modes_t
+ * @param [in] pld_len_in_bytes Payload length in bytes
+ * @param [in] crc_type CRC type - lr11xx_radio_gfsk_crc_type_t
+ */
+#define LR11XX_RADIO_GFSK_TOA_NUMERATOR( preamble_len_in_bits, sync_word_len_in_bits, address_filtering, header_type, \
+                                         pld_len_in_bytes, crc_type )                                                 \
+    ( ( uint32_t ) ( preamble_len_in_bits ) + ( uint32_t ) ( sync_word_len_in_bits ) +                                \
+      ( ( ( header_type ) == LR11XX_RADIO_GFSK_PKT_FIX_LEN )   ? 0UL                                                  \
+        : ( ( header_type ) == LR11XX_RADIO_GFSK_PKT_VAR_LEN ) ? 8UL                                                  \
+                                                               : 9UL ) +                                              \
+      ( ( ( uint32_t ) ( pld_len_in_bytes ) +                                                                         \
+          ( ( ( address_filtering ) == LR11XX_RADIO_GFSK_ADDRESS_FILTERING_DISABLE ) ? 0UL : 1UL ) +                  \
+          ( ( ( crc_type ) == LR11XX_RADIO_GFSK_CRC_OFF )                                                             \
+                ? 0UL                                                                                                 \
+                : ( ( ( ( crc_type ) == LR11XX_RADIO_GFSK_CRC_2_BYTES ) ||                                            \
+                      ( ( crc_type ) == LR11XX_RADIO_GFSK_CRC_2_BYTES_INV ) )                                         \
+                        ? 2UL                                                                                         \
+                        : 1UL ) ) )                                                                                   \
+        << 3 ) )
+
+/**
+ * @brief GFSK time-on-air in ms - constant expression counterpart of lr11xx_radio_get_gfsk_time_on_air_in_ms
+ *
+ * @remark Same parameters as LR11XX_RADIO_GFSK_TOA_NUMERATOR, plus the bitrate in bit/s
+ */
+#define LR11XX_RADIO_GFSK_TOA_IN_MS( br_in_bps, preamble_len_in_bits, sync_word_len_in_bits, address_filtering, \
+                                     header_type, pld_len_in_bytes, crc_type )                                  \
+    LR11XX_RADIO_TOA_CEIL_DIV( 1000UL * LR11XX_RADIO_GFSK_TOA_NUMERATOR( preamble_len_in_bits,                  \
+                                                                         sync_word_len_in_bits,                 \
+                                                                         address_filtering, header_type,        \
+                                                                         pld_len_in_bytes, crc_type ),          \
+                               ( uint32_t ) ( br_in_bps ) )
+
+/*
+ * The helpers below follow the steps of lr11xx_radio_get_lora_time_on_air_numerator, see there for the details
+ */
+
+#define LR11XX_RADIO_TOA_CEIL_DIV( n, d ) ( ( ( n ) + ( d ) - 1 ) / ( d ) )
+
+#define LR11XX_RADIO_TOA_MAX( a, b ) ( ( ( a ) > ( b ) ) ? ( a ) : ( b ) )
+
+#define LR11XX_RADIO_TOA_LORA_FINE_SYNCH( sf ) ( ( ( sf ) <= 6 ) ? 1 : 0 )
+
+#define LR11XX_RADIO_TOA_LORA_BITS_PER_SYMB( sf, ldro ) ( ( int32_t ) ( sf ) - ( ( ( ldro ) != 0 ) ? 2 : 0 ) )
+
+#define LR11XX_RADIO_TOA_LORA_TOTAL_BITS( pld_len_in_bytes, crc ) \
+    ( 8 * ( ( int32_t ) ( pld_len_in_bytes ) + ( ( ( crc ) == LR11XX_RADIO_LORA_CRC_ON ) ? 2 : 0 ) ) )
+
+#define LR11XX_RADIO_TOA_LORA_DATA_SYMB( sf, cr, ldro, header_type, pld_len_in_bytes, crc )        \
+    ( ( ( cr ) <= LR11XX_RADIO_LORA_CR_4_8 )                                                       \
+          ? LR11XX_RADIO_TOA_LORA_SI_DATA_SYMB( sf, cr, ldro, header_type, pld_len_in_bytes, crc ) \
+      : ( ( header_type ) == LR11XX_RADIO_LORA_PKT_IMPLICIT )                                      \
+          ? LR11XX_RADIO_TOA_LORA_LI_IMPLICIT_DATA_SYMB( sf, cr, ldro, pld_len_in_bytes, crc )     \
+          : LR11XX_RADIO_TOA_LORA_LI_EXPLICIT_DATA_SYMB( sf, cr, ldro, pld_len_in_bytes, crc ) )
+
+// Short interleaver
+#define LR11XX_RADIO_TOA_LORA_SI_HEADER_BITS( sf, header_type )                 \
+    ( 4 * ( int32_t ) ( sf ) + 8 * LR11XX_RADIO_TOA_LORA_FINE_SYNCH( sf ) - 8 - \
+      ( ( ( header_type ) == LR11XX_RADIO_LORA_PKT_IMPLICIT ) ? 0 : 20 ) )
+
+#define LR11XX_RADIO_TOA_LORA_SI_DATA_SYMB( sf, cr, ldro, header_type, pld_len_in_bytes, crc )                      \
+    ( LR11XX_RADIO_TOA_CEIL_DIV( LR11XX_RADIO_TOA_MAX( LR11XX_RADIO_TOA_LORA_TOTAL_BITS( pld_len_in_bytes, crc ) -  \
+                                                           LR11XX_RADIO_TOA_LORA_SI_HEADER_BITS( sf, header_type ), \
+                                                       0 ),                                                         \
+                                 4 * LR11XX_RADIO_TOA_LORA_BITS_PER_SYMB( sf, ldro ) ) *                            \
+          ( ( int32_t ) ( cr ) + 4 ) +                                                                              \
+      8 )
+
+// Long interleaver
+#define LR11XX_RADIO_TOA_LORA_LI_FEC_DENOMINATOR( cr ) ( ( int32_t ) ( cr ) + ( ( ( cr ) == 7 ) ? 1 : 0 ) )
+
+#define LR11XX_RADIO_TOA_LORA_LI_BITS_PER_SYMB_START( sf ) \
+    ( ( int32_t ) ( sf ) - 2 + 2 * LR11XX_RADIO_TOA_LORA_FINE_SYNCH( sf ) )
+
+#define LR11XX_RADIO_TOA_LORA_LI_CODED_BITS( cr, pld_len_in_bytes, crc ) \
+    ( LR11XX_RADIO_TOA_LORA_TOTAL_BITS( pld_len_in_bytes, crc ) * LR11XX_RADIO_TOA_LORA_LI_FEC_DENOMINATOR( cr ) )
+
+#define LR11XX_RADIO_TOA_LORA_LI_IMPLICIT_DATA_SYMB( sf, cr, ldro, pld_len_in_bytes, crc )                    \
+    ( ( LR11XX_RADIO_TOA_LORA_LI_CODED_BITS( cr, pld_len_in_bytes, crc ) <=                                   \
+        28 * LR11XX_RADIO_TOA_LORA_LI_BITS_PER_SYMB_START( sf ) )                                             \
+          ? LR11XX_RADIO_TOA_CEIL_DIV( LR11XX_RADIO_TOA_LORA_LI_CODED_BITS( cr, pld_len_in_bytes, crc ),      \
+                                       4 * LR11XX_RADIO_TOA_LORA_LI_BITS_PER_SYMB_START( sf ) )               \
+          : LR11XX_RADIO_TOA_CEIL_DIV( 32 * LR11XX_RADIO_TOA_LORA_BITS_PER_SYMB( sf, ldro ) +                 \
+                                           LR11XX_RADIO_TOA_LORA_LI_CODED_BITS( cr, pld_len_in_bytes, crc ) - \
+                                           32 * LR11XX_RADIO_TOA_LORA_LI_BITS_PER_SYMB_START( sf ),           \
+                                       4 * LR11XX_RADIO_TOA_LORA_BITS_PER_SYMB( sf, ldro ) ) )
+
+#define LR11XX_RADIO_TOA_LORA_LI_HEADER_CAPACITY( sf ) \
+    ( ( 4 * ( int32_t ) ( sf ) + 8 * LR11XX_RADIO_TOA_LORA_FINE_SYNCH( sf ) - 28 ) & ~0x07 )
+
+#define LR11XX_RADIO_TOA_LORA_LI_HEADER_BITS( sf, pld_len_in_bytes, crc )                           \
+    ( ( ( LR11XX_RADIO_TOA_LORA_LI_HEADER_CAPACITY( sf ) <                                          \
+          LR11XX_RADIO_TOA_LORA_TOTAL_BITS( pld_len_in_bytes, crc ) ) &&                            \
+        ( LR11XX_RADIO_TOA_LORA_LI_HEADER_CAPACITY( sf ) > 8 * ( int32_t ) ( pld_len_in_bytes ) ) ) \
+          ? 8 * ( int32_t ) ( pld_len_in_bytes )                                                    \
+          : LR11XX_RADIO_TOA_LORA_LI_HEADER_CAPACITY( sf ) )
+
+#define LR11XX_RADIO_TOA_LORA_LI_EXPLICIT_DATA_SYMB( sf, cr, ldro, pld_len_in_bytes, crc )                           \
+    LR11XX_RADIO_TOA_CEIL_DIV( LR11XX_RADIO_TOA_MAX( LR11XX_RADIO_TOA_LORA_TOTAL_BITS( pld_len_in_bytes, crc ) -     \
+                                                         LR11XX_RADIO_TOA_LORA_LI_HEADER_BITS( sf, pld_len_in_bytes, \
+                                                                                               crc ),                \
+                                                     0 ) *                                                           \
+                                       LR11XX_RADIO_TOA_LORA_LI_FEC_DENOMINATOR( cr ) +                              \
+                                   32 * LR11XX_RADIO_TOA_LORA_BITS_PER_SYMB( sf, ldro ),                             \
+                               4 * LR11XX_RADIO_TOA_LORA_BITS_PER_SYMB( sf, ldro ) )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief LoRa time-on-air of a configuration, for any payload length
+ *
+ * Everything but the payload length is resolved by lr11xx_radio_lora_toa_init. The number of data symbols is then
+ * base_in_symb + symb_per_block * ceil( ( bits * bits_weight + offset ) / bits_per_block ), with bits the payload
+ * and CRC bits not carried by the header - the slope of the time on air against the payload length.
+ *
+ * The long interleaver with implicit header has two such segments, from pld_len_split on the second one applies.
+ */
+typedef struct lr11xx_radio_lora_toa_s
+{
+    uint32_t bw_in_hz;           //!< Bandwidth in Hertz
+    uint32_t base_in_symb;       //!< Preamble, sync word and fixed data symbols
+    int16_t  bits_offset;        //!< Added to 8 times the payload length, the result is clamped at 0
+    uint8_t  bits_min;           //!< Non-zero results below this value are rounded up to it
+    uint8_t  bits_weight;        //!< Weight of a bit - FEC denominator in long interleaver, 1 otherwise
+    uint8_t  symb_per_block;     //!< Symbols added per block
+    uint8_t  shift;              //!< Spreading factor minus 2
+    uint16_t pld_len_split;      //!< Payload length from which the second segment applies - 256 if none
+    int16_t  offset[2];          //!< Weighted bits added before the division, per segment
+    uint16_t bits_per_block[2];  //!< Weighted bits per block, per segment
+} lr11xx_radio_lora_toa_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Resolve the payload independent part of the LoRa time-on-air computation
+ *
+ * @param [out] toa Time-on-air descriptor
+ * @param [in] pkt_p LoRa packet parameters - the payload length is not used
+ * @param [in] mod_p LoRa modulation parameters
+ */
+void lr11xx_radio_lora_toa_init( lr11xx_radio_lora_toa_t* toa, const lr11xx_radio_pkt_params_lora_t* pkt_p,
+                                 const lr11xx_radio_mod_params_lora_t* mod_p );
+
+/**
+ * @brief Get the LoRa time-on-air numerator of a payload length
+ *
+ * Same result as lr11xx_radio_get_lora_time_on_air_numerator, with a single division and no branching on the
+ * modulation parameters.
+ *
+ * @param [in] toa Time-on-air descriptor
+ * @param [in] pld_len_in_bytes Payload length in bytes
+ *
+ * @returns LoRa time-on-air numerator - to be divided by the bandwidth in Hertz
+ */
+static inline uint32_t lr11xx_radio_lora_toa_get_numerator( const lr11xx_radio_lora_toa_t* toa,
+                                                             uint8_t                        pld_len_in_bytes )
+{
+    const uint8_t segment = ( pld_len_in_bytes >= toa->pld_len_split ) ? 1 : 0;
+    int32_t       bits    = 8 * ( int32_t ) pld_len_in_bytes + toa->bits_offset;
+
+    if( bits <= 0 )
+    {
+        bits = 0;
+    }
+    else if( bits < toa->bits_min )
+    {
+        bits = toa->bits_min;
+    }
+
+    const uint32_t blocks = ( uint32_t ) ( bits * toa->bits_weight + toa->offset[segment] +
+                                           toa->bits_per_block[segment] - 1 ) /
+                            toa->bits_per_block[segment];
+
+    return ( ( 4 * ( toa->base_in_symb + blocks * toa->symb_per_block ) + 1 ) << toa->shift ) - 1;
+}
+
+/**
+ * @brief Get the LoRa time-on-air in ms of a payload length
+ *
+ * @param [in] toa Time-on-air descriptor
+ * @param [in] pld_len_in_bytes Payload length in bytes
+ *
+ * @returns Time-on-air in ms, rounded up - same result as lr11xx_radio_get_lora_time_on_air_in_ms
+ */
+static inline uint32_t lr11xx_radio_lora_toa_get_in_ms( const lr11xx_radio_lora_toa_t* toa, uint8_t pld_len_in_bytes )
+{
+    return ( 1000U * lr11xx_radio_lora_toa_get_numerator( toa, pld_len_in_bytes ) + toa->bw_in_hz - 1 ) /
+           toa->bw_in_hz;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LR11XX_RADIO_TOA_H
+
+/* --- EOF ------------------------------------------------------------------ */
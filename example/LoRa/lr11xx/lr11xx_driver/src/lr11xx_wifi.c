@@ -37,6 +37,7 @@
  * --- DEPENDENCIES ------------------------------------------------------------
  */
 
+#include <string.h>
 #include "lr11xx_wifi.h"
 #include "lr11xx_system_types.h"
 #include "lr11xx_hal.h"
@@ -202,6 +203,36 @@ static void interpret_extended_full_result_from_buffer( const uint8_t nb_results
                                                         const uint8_t index_result_start_writing, const uint8_t* buffer,
                                                         lr11xx_wifi_extended_full_result_t* result );
 
+/*!
+ * @brief Parse a single basic complete result
+ */
+static void parse_basic_complete_result( const uint8_t* buffer, lr11xx_wifi_basic_complete_result_t* result );
+
+/*!
+ * @brief Parse a single basic MAC - type - channel result
+ */
+static void parse_basic_mac_type_channel_result( const uint8_t*                               buffer,
+                                                 lr11xx_wifi_basic_mac_type_channel_result_t* result );
+
+/*!
+ * @brief Parse a single extended full result
+ */
+static void parse_extended_full_result( const uint8_t* buffer, lr11xx_wifi_extended_full_result_t* result );
+
+/*!
+ * @brief Parse a single result in any format, and give back the transmitter MAC address and the RSSI
+ */
+static void parse_result( const uint8_t* buffer, const lr11xx_wifi_result_format_t format,
+                          lr11xx_wifi_result_t* result, const uint8_t** mac_address, int8_t* rssi );
+
+/*!
+ * @brief Look for a MAC address in the stream table of already seen MAC addresses, and record it if absent
+ *
+ * @returns true if the MAC address has already been seen
+ */
+static bool lr11xx_wifi_stream_check_and_record_mac_address( lr11xx_wifi_result_stream_t* stream,
+                                                             const uint8_t*               mac_address );
+
 /*!
  * @brief Parse basic MAC - type - channel result
  */
@@ -387,6 +418,67 @@ lr11xx_status_t lr11xx_wifi_read_extended_full_results( const void* radio, const
                                             LR11XX_WIFI_RESULT_FORMAT_EXTENDED_FULL, result_buffer, result_interface );
 }
 
+lr11xx_status_t lr11xx_wifi_stream_results( const void* context, const uint8_t start_result_index,
+                                            const uint8_t nb_results, lr11xx_wifi_result_stream_t* stream,
+                                            uint8_t* nb_results_delivered )
+{
+    const uint8_t result_size          = lr11xx_wifi_get_result_size_from_format( stream->format );
+    const uint8_t nb_results_per_chunk = MIN( stream->chunk_buffer_size / result_size,
+                                              LR11XX_WIFI_MAX_RESULT_PER_TRANSACTION( result_size ) );
+    uint8_t       index_to_read        = start_result_index;
+    uint8_t       remaining_results    = nb_results;
+
+    *nb_results_delivered = 0;
+
+    if( ( nb_results_per_chunk == 0 ) || ( stream->callback == NULL ) )
+    {
+        return LR11XX_STATUS_ERROR;
+    }
+
+    while( remaining_results > 0 )
+    {
+        const uint8_t results_to_read = MIN( remaining_results, nb_results_per_chunk );
+
+        const lr11xx_hal_status_t hal_status = lr11xx_wifi_read_results_helper(
+            context, index_to_read, results_to_read, stream->chunk_buffer, stream->format );
+        if( hal_status != LR11XX_HAL_STATUS_OK )
+        {
+            return ( lr11xx_status_t ) hal_status;
+        }
+
+        for( uint8_t index = 0; index < results_to_read; index++ )
+        {
+            lr11xx_wifi_result_t result;
+            const uint8_t*       mac_address;
+            int8_t               rssi;
+
+            parse_result( &stream->chunk_buffer[index * result_size], stream->format, &result, &mac_address, &rssi );
+
+            if( rssi < stream->rssi_min_in_dbm )
+            {
+                continue;
+            }
+
+            if( ( stream->seen_mac_addresses != NULL ) &&
+                lr11xx_wifi_stream_check_and_record_mac_address( stream, mac_address ) )
+            {
+                continue;
+            }
+
+            ( *nb_results_delivered )++;
+            if( !stream->callback( index_to_read + index, &result, stream->user_context ) )
+            {
+                return LR11XX_STATUS_OK;
+            }
+        }
+
+        index_to_read += results_to_read;
+        remaining_results -= results_to_read;
+    }
+
+    return LR11XX_STATUS_OK;
+}
+
 lr11xx_status_t lr11xx_wifi_reset_cumulative_timing( const void* context )
 {
     const uint8_t cbuffer[LR11XX_WIFI_RESET_CUMUL_TIMING_CMD_LENGTH] = {
@@ -740,16 +832,8 @@ static void interpret_basic_complete_result_from_buffer( const uint8_t  nb_resul
 {
     for( uint8_t result_index = 0; result_index < nb_results; result_index++ )
     {
-        const uint16_t                       local_index_start = LR11XX_WIFI_BASIC_COMPLETE_RESULT_SIZE * result_index;
-        lr11xx_wifi_basic_complete_result_t* local_wifi_result = &result[index_result_start_writing + result_index];
-        local_wifi_result->data_rate_info_byte                 = buffer[local_index_start + 0];
-        local_wifi_result->channel_info_byte                   = buffer[local_index_start + 1];
-        local_wifi_result->rssi                                = buffer[local_index_start + 2];
-        local_wifi_result->frame_type_info_byte                = buffer[local_index_start + 3];
-        lr11xx_wifi_read_mac_address_from_buffer( buffer, local_index_start + 4, local_wifi_result->mac_address );
-        local_wifi_result->phi_offset       = uint16_from_array( buffer, local_index_start + 10 );
-        local_wifi_result->timestamp_us     = uint64_from_array( buffer, local_index_start + 12 );
-        local_wifi_result->beacon_period_tu = uint16_from_array( buffer, local_index_start + 20 );
+        parse_basic_complete_result( &buffer[LR11XX_WIFI_BASIC_COMPLETE_RESULT_SIZE * result_index],
+                                     &result[index_result_start_writing + result_index] );
     }
 }
 
@@ -760,13 +844,8 @@ static void interpret_basic_mac_type_channel_result_from_buffer( const uint8_t
 {
     for( uint8_t result_index = 0; result_index < nb_results; result_index++ )
     {
-        const uint16_t local_index_start = LR11XX_WIFI_BASIC_MAC_TYPE_CHANNEL_RESULT_SIZE * result_index;
-        lr11xx_wifi_basic_mac_type_channel_result_t* local_wifi_result =
-            &result[index_result_start_writing + result_index];
-        local_wifi_result->data_rate_info_byte = buffer[local_index_start + 0];
-        local_wifi_result->channel_info_byte   = buffer[local_index_start + 1];
-        local_wifi_result->rssi                = buffer[local_index_start + 2];
-        lr11xx_wifi_read_mac_address_from_buffer( buffer, local_index_start + 3, local_wifi_result->mac_address );
+        parse_basic_mac_type_channel_result( &buffer[LR11XX_WIFI_BASIC_MAC_TYPE_CHANNEL_RESULT_SIZE * result_index],
+                                             &result[index_result_start_writing + result_index] );
     }
 }
 
@@ -775,34 +854,108 @@ void interpret_extended_full_result_from_buffer( const uint8_t nb_results, const
 {
     for( uint8_t result_index = 0; result_index < nb_results; result_index++ )
     {
-        const uint16_t local_index_start = LR11XX_WIFI_EXTENDED_COMPLETE_RESULT_SIZE * result_index;
-        lr11xx_wifi_extended_full_result_t* local_wifi_result = &result[index_result_start_writing + result_index];
-
-        local_wifi_result->data_rate_info_byte = buffer[local_index_start + 0];
-        local_wifi_result->channel_info_byte   = buffer[local_index_start + 1];
-        local_wifi_result->rssi                = buffer[local_index_start + 2];
-        local_wifi_result->rate                = buffer[local_index_start + 3];
-        local_wifi_result->service             = uint16_from_array( buffer, local_index_start + 4 );
-        local_wifi_result->length              = uint16_from_array( buffer, local_index_start + 6 );
-        local_wifi_result->frame_control       = uint16_from_array( buffer, local_index_start + 8 );
-        lr11xx_wifi_read_mac_address_from_buffer( buffer, local_index_start + 10, local_wifi_result->mac_address_1 );
-        lr11xx_wifi_read_mac_address_from_buffer( buffer, local_index_start + 16, local_wifi_result->mac_address_2 );
-        lr11xx_wifi_read_mac_address_from_buffer( buffer, local_index_start + 22, local_wifi_result->mac_address_3 );
-        local_wifi_result->timestamp_us     = uint64_from_array( buffer, local_index_start + 28 );
-        local_wifi_result->beacon_period_tu = uint16_from_array( buffer, local_index_start + 36 );
-        local_wifi_result->seq_control      = uint16_from_array( buffer, local_index_start + 38 );
-        for( uint8_t ssid_index = 0; ssid_index < LR11XX_WIFI_RESULT_SSID_LENGTH; ssid_index++ )
+        parse_extended_full_result( &buffer[LR11XX_WIFI_EXTENDED_COMPLETE_RESULT_SIZE * result_index],
+                                    &result[index_result_start_writing + result_index] );
+    }
+}
+
+static void parse_basic_complete_result( const uint8_t* buffer, lr11xx_wifi_basic_complete_result_t* result )
+{
+    result->data_rate_info_byte  = buffer[0];
+    result->channel_info_byte    = buffer[1];
+    result->rssi                 = buffer[2];
+    result->frame_type_info_byte = buffer[3];
+    lr11xx_wifi_read_mac_address_from_buffer( buffer, 4, result->mac_address );
+    result->phi_offset       = uint16_from_array( buffer, 10 );
+    result->timestamp_us     = uint64_from_array( buffer, 12 );
+    result->beacon_period_tu = uint16_from_array( buffer, 20 );
+}
+
+static void parse_basic_mac_type_channel_result( const uint8_t*                               buffer,
+                                                 lr11xx_wifi_basic_mac_type_channel_result_t* result )
+{
+    result->data_rate_info_byte = buffer[0];
+    result->channel_info_byte   = buffer[1];
+    result->rssi                = buffer[2];
+    lr11xx_wifi_read_mac_address_from_buffer( buffer, 3, result->mac_address );
+}
+
+static void parse_extended_full_result( const uint8_t* buffer, lr11xx_wifi_extended_full_result_t* result )
+{
+    result->data_rate_info_byte = buffer[0];
+    result->channel_info_byte   = buffer[1];
+    result->rssi                = buffer[2];
+    result->rate                = buffer[3];
+    result->service             = uint16_from_array( buffer, 4 );
+    result->length              = uint16_from_array( buffer, 6 );
+    result->frame_control       = uint16_from_array( buffer, 8 );
+    lr11xx_wifi_read_mac_address_from_buffer( buffer, 10, result->mac_address_1 );
+    lr11xx_wifi_read_mac_address_from_buffer( buffer, 16, result->mac_address_2 );
+    lr11xx_wifi_read_mac_address_from_buffer( buffer, 22, result->mac_address_3 );
+    result->timestamp_us     = uint64_from_array( buffer, 28 );
+    result->beacon_period_tu = uint16_from_array( buffer, 36 );
+    result->seq_control      = uint16_from_array( buffer, 38 );
+    for( uint8_t ssid_index = 0; ssid_index < LR11XX_WIFI_RESULT_SSID_LENGTH; ssid_index++ )
+    {
+        result->ssid_bytes[ssid_index] = buffer[ssid_index + 40];
+    }
+    result->current_channel               = buffer[72];
+    result->country_code[0]               = buffer[73];
+    result->country_code[1]               = buffer[74];
+    result->io_regulation                 = buffer[75];
+    result->fcs_check_byte.is_fcs_checked = ( ( buffer[76] & 0x01 ) == 0x01 );
+    result->fcs_check_byte.is_fcs_ok      = ( ( buffer[76] & 0x02 ) == 0x02 );
+    result->phi_offset                    = uint16_from_array( buffer, 77 );
+}
+
+static void parse_result( const uint8_t* buffer, const lr11xx_wifi_result_format_t format,
+                          lr11xx_wifi_result_t* result, const uint8_t** mac_address, int8_t* rssi )
+{
+    switch( format )
+    {
+    case LR11XX_WIFI_RESULT_FORMAT_BASIC_COMPLETE:
+    {
+        parse_basic_complete_result( buffer, &result->basic_complete );
+        *mac_address = result->basic_complete.mac_address;
+        *rssi        = result->basic_complete.rssi;
+        break;
+    }
+    case LR11XX_WIFI_RESULT_FORMAT_BASIC_MAC_TYPE_CHANNEL:
+    {
+        parse_basic_mac_type_channel_result( buffer, &result->basic_mac_type_channel );
+        *mac_address = result->basic_mac_type_channel.mac_address;
+        *rssi        = result->basic_mac_type_channel.rssi;
+        break;
+    }
+    case LR11XX_WIFI_RESULT_FORMAT_EXTENDED_FULL:
+    {
+        parse_extended_full_result( buffer, &result->extended_full );
+        *mac_address = result->extended_full.mac_address_2;
+        *rssi        = result->extended_full.rssi;
+        break;
+    }
+    }
+}
+
+static bool lr11xx_wifi_stream_check_and_record_mac_address( lr11xx_wifi_result_stream_t* stream,
+                                                             const uint8_t*               mac_address )
+{
+    for( uint8_t index = 0; index < stream->nb_seen_mac_addresses; index++ )
+    {
+        if( memcmp( stream->seen_mac_addresses[index], mac_address, LR11XX_WIFI_MAC_ADDRESS_LENGTH ) == 0 )
         {
-            local_wifi_result->ssid_bytes[ssid_index] = buffer[local_index_start + ssid_index + 40];
+            return true;
         }
-        local_wifi_result->current_channel               = buffer[local_index_start + 72];
-        local_wifi_result->country_code[0]               = buffer[local_index_start + 73];
-        local_wifi_result->country_code[1]               = buffer[local_index_start + 74];
-        local_wifi_result->io_regulation                 = buffer[local_index_start + 75];
-        local_wifi_result->fcs_check_byte.is_fcs_checked = ( ( buffer[local_index_start + 76] & 0x01 ) == 0x01 );
-        local_wifi_result->fcs_check_byte.is_fcs_ok      = ( ( buffer[local_index_start + 76] & 0x02 ) == 0x02 );
-        local_wifi_result->phi_offset                    = uint16_from_array( buffer, local_index_start + 77 );
     }
+
+    if( stream->nb_seen_mac_addresses < stream->seen_mac_addresses_size )
+    {
+        memcpy( stream->seen_mac_addresses[stream->nb_seen_mac_addresses], mac_address,
+                LR11XX_WIFI_MAC_ADDRESS_LENGTH );
+        stream->nb_seen_mac_addresses++;
+    }
+
+    return false;
 }
 
 bool lr11xx_wifi_is_well_formed_utf8_byte_sequence( const uint8_t* buffer, const uint8_t length )
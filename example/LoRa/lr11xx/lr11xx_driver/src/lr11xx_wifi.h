@@ -405,6 +405,54 @@ lr11xx_status_t lr11xx_wifi_read_extended_full_results( const void* radio, const
                                                         const uint8_t                       nb_results,
                                                         lr11xx_wifi_extended_full_result_t* results );
 
+/*!
+ * @brief Stream Wi-Fi scan results to a callback
+ *
+ * Contrary to the lr11xx_wifi_read_*_results functions, the results are not aggregated in an array: they are read in
+ * chunks into stream->chunk_buffer, then decoded one at a time and handed over to stream->callback. The chunk buffer is
+ * provided by the caller, so it can be as small as a single raw result (22, 9 or 79 bytes depending on the format).
+ *
+ * Before reaching the callback, the results are filtered:
+ *   - results with an RSSI below stream->rssi_min_in_dbm are dropped,
+ *   - if stream->seen_mac_addresses is not NULL, results from a MAC address already seen are dropped. The MAC address
+ *     of each result delivered is added to this table, which is kept between calls. Once the table is full, new MAC
+ *     addresses are still delivered but not recorded.
+ *
+ * \code{.cpp}
+ * uint8_t                     chunk_buffer[4 * 22];
+ * lr11xx_wifi_mac_address_t   seen[LR11XX_WIFI_MAX_RESULTS];
+ * lr11xx_wifi_result_stream_t stream = {
+ *     .format = LR11XX_WIFI_RESULT_FORMAT_BASIC_COMPLETE,
+ *     .chunk_buffer = chunk_buffer, .chunk_buffer_size = sizeof( chunk_buffer ),
+ *     .rssi_min_in_dbm = -90,
+ *     .seen_mac_addresses = seen, .seen_mac_addresses_size = LR11XX_WIFI_MAX_RESULTS,
+ *     .callback = on_wifi_result, .user_context = &app_context,
+ * };
+ * uint8_t nb_results = 0;
+ * uint8_t nb_results_delivered = 0;
+ * lr11xx_wifi_get_nb_results(&radio, &nb_results);
+ * lr11xx_wifi_stream_results(&radio, 0, nb_results, &stream, &nb_results_delivered);
+ * \endcode
+ *
+ * @remark The result format **MUST** be compatible with the scan mode used. Refer to @ref
+ * lr11xx_wifi_are_scan_mode_result_format_compatible.
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] start_result_index Result index from which starting to fetch the results
+ * @param [in] nb_results Number of results to fetch
+ * @param [in,out] stream Stream configuration
+ * @param [out] nb_results_delivered Number of results handed over to the callback
+ *
+ * @returns Operation status. LR11XX_STATUS_ERROR is returned without any access to the chip if the chunk buffer cannot
+ * hold a single result or if no callback is given.
+ *
+ * @see lr11xx_wifi_read_basic_complete_results, lr11xx_wifi_read_basic_mac_type_channel_results,
+ * lr11xx_wifi_read_extended_full_results
+ */
+lr11xx_status_t lr11xx_wifi_stream_results( const void* context, const uint8_t start_result_index,
+                                            const uint8_t nb_results, lr11xx_wifi_result_stream_t* stream,
+                                            uint8_t* nb_results_delivered );
+
 /*!
  * @brief Reset the internal counters of cumulative timing
  *
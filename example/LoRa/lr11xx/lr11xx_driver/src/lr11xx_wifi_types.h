@@ -376,6 +376,51 @@ typedef enum
     LR11XX_WIFI_RESULT_FORMAT_EXTENDED_FULL,  //!< Extended full result format: @ref lr11xx_wifi_extended_full_result_t
 } lr11xx_wifi_result_format_t;
 
+/*!
+ * @brief Wi-Fi scan result, in any of the result formats
+ *
+ * The member to use is the one matching the result format the results are fetched with.
+ */
+typedef union lr11xx_wifi_result_u
+{
+    lr11xx_wifi_basic_complete_result_t         basic_complete;
+    lr11xx_wifi_basic_mac_type_channel_result_t basic_mac_type_channel;
+    lr11xx_wifi_extended_full_result_t          extended_full;
+} lr11xx_wifi_result_t;
+
+/*!
+ * @brief Callback called on each Wi-Fi scan result delivered by @ref lr11xx_wifi_stream_results
+ *
+ * The result is only valid during the call: it has to be copied to be kept.
+ *
+ * @param [in] result_index Index of the result in the chip result list
+ * @param [in] result Decoded result
+ * @param [in] user_context User context given in the stream configuration
+ *
+ * @returns true to keep on streaming, false to stop
+ */
+typedef bool ( *lr11xx_wifi_result_callback_t )( const uint8_t result_index, const lr11xx_wifi_result_t* result,
+                                                 void* user_context );
+
+/*!
+ * @brief Wi-Fi scan result stream configuration
+ *
+ * The MAC address used for the de-duplication is the transmitter address: mac_address for the basic formats,
+ * mac_address_2 for the extended full format.
+ */
+typedef struct lr11xx_wifi_result_stream_s
+{
+    lr11xx_wifi_result_format_t   format;                   //!< Format to fetch the results with
+    uint8_t*                      chunk_buffer;             //!< Buffer receiving the raw results of one SPI read
+    uint16_t                      chunk_buffer_size;        //!< Size of chunk_buffer - at least one raw result
+    int8_t                        rssi_min_in_dbm;          //!< Results below are dropped - INT8_MIN keeps all
+    lr11xx_wifi_mac_address_t*    seen_mac_addresses;       //!< Already delivered - NULL disables dedup
+    uint8_t                       seen_mac_addresses_size;  //!< Capacity of seen_mac_addresses
+    uint8_t                       nb_seen_mac_addresses;    //!< Entries in use - reset to 0 to forget them
+    lr11xx_wifi_result_callback_t callback;                 //!< Called on each result not filtered out
+    void*                         user_context;             //!< Given back to callback
+} lr11xx_wifi_result_stream_t;
+
 /*!
  * @brief Wi-Fi country code structure
  */
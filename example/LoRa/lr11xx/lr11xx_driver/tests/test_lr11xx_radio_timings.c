@@ -40,6 +40,7 @@
 #include "unity.h"
 #include "lr11xx_radio_timings.h"
 #include "lr11xx_radio.h"
+#include "lr11xx_lr_fhss.h"
 #include "mock_lr11xx_hal.h"
 
 /*
@@ -133,6 +134,156 @@ void test_lr11xx_radio_timings_get_delay_between_last_bit_sent_and_tx_done_in_us
     TEST_ASSERT_EQUAL_UINT32( delay_in_us_expected, delay );
 }
 
+void test_lr11xx_radio_timings_get_lora_tx( void )
+{
+    const lr11xx_radio_pkt_params_lora_t pkt_params = {
+        .preamble_len_in_symb = 8,
+        .header_type          = LR11XX_RADIO_LORA_PKT_EXPLICIT,
+        .pld_len_in_bytes     = 10,
+        .crc                  = LR11XX_RADIO_LORA_CRC_ON,
+        .iq                   = LR11XX_RADIO_LORA_IQ_STANDARD,
+    };
+    const lr11xx_radio_mod_params_lora_t mod_params = {
+        .sf   = LR11XX_RADIO_LORA_SF7,
+        .bw   = LR11XX_RADIO_LORA_BW_125,
+        .cr   = LR11XX_RADIO_LORA_CR_4_5,
+        .ldro = 0,
+    };
+    lr11xx_radio_timings_tx_t timings;
+
+    lr11xx_radio_timings_get_lora_tx( &pkt_params, &mod_params, LR11XX_RADIO_RAMP_48_US, &timings );
+
+    // 12.25 symbols of preamble and synchronization word, then 28 symbols minus one chip of header, payload and CRC
+    TEST_ASSERT_EQUAL_UINT32( 48, timings.ramp_up_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 12544, timings.preamble_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 28664, timings.payload_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 48 + 111, timings.tx_done_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 48 + 12544 + 28664 + 48 + 111, timings.total_in_us );
+    TEST_ASSERT_EQUAL_UINT32( lr11xx_radio_get_lora_time_on_air_in_ms( &pkt_params, &mod_params ),
+                              ( timings.preamble_in_us + timings.payload_in_us + 999 ) / 1000 );
+}
+
+void test_lr11xx_radio_timings_get_gfsk_tx( void )
+{
+    const lr11xx_radio_pkt_params_gfsk_t pkt_params = {
+        .preamble_len_in_bits  = 32,
+        .preamble_detector     = LR11XX_RADIO_GFSK_PREAMBLE_DETECTOR_MIN_16BITS,
+        .sync_word_len_in_bits = 32,
+        .address_filtering     = LR11XX_RADIO_GFSK_ADDRESS_FILTERING_DISABLE,
+        .header_type           = LR11XX_RADIO_GFSK_PKT_VAR_LEN,
+        .pld_len_in_bytes      = 10,
+        .crc_type              = LR11XX_RADIO_GFSK_CRC_2_BYTES,
+        .dc_free               = LR11XX_RADIO_GFSK_DC_FREE_OFF,
+    };
+    const lr11xx_radio_mod_params_gfsk_t mod_params = {
+        .br_in_bps    = 50000,
+        .fdev_in_hz   = 25000,
+        .pulse_shape  = LR11XX_RADIO_GFSK_PULSE_SHAPE_BT_05,
+        .bw_dsb_param = LR11XX_RADIO_GFSK_BW_117300,
+    };
+    lr11xx_radio_timings_tx_t timings;
+
+    lr11xx_radio_timings_get_gfsk_tx( &pkt_params, &mod_params, LR11XX_RADIO_RAMP_16_US, &timings );
+
+    // 64 bits of preamble and synchronization word, then 8 + 80 + 16 bits of header, payload and CRC at 20 us/bit
+    TEST_ASSERT_EQUAL_UINT32( 16, timings.ramp_up_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 1280, timings.preamble_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 2080, timings.payload_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 16 + 111, timings.tx_done_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 16 + 1280 + 2080 + 16 + 111, timings.total_in_us );
+}
+
+void test_lr11xx_radio_timings_get_bpsk_tx( void )
+{
+    const lr11xx_radio_mod_params_bpsk_t mod_params = {
+        .br_in_bps   = 600,
+        .pulse_shape = LR11XX_RADIO_DBPSK_PULSE_SHAPE,
+    };
+    lr11xx_radio_pkt_params_bpsk_t pkt_params = {
+        .pld_len_in_bytes = 20,
+        .ramp_up_delay    = 0,
+        .ramp_down_delay  = 0,
+        .pld_len_in_bits  = 0,
+    };
+    lr11xx_radio_timings_tx_t timings;
+
+    lr11xx_radio_timings_get_bpsk_tx( &pkt_params, &mod_params, LR11XX_RADIO_RAMP_208_US, &timings );
+
+    TEST_ASSERT_EQUAL_UINT32( 208, timings.ramp_up_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 0, timings.preamble_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 266667, timings.payload_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 208 + 111, timings.tx_done_in_us );
+
+    // The number of bits, when given, takes precedence over the number of bytes
+    pkt_params.pld_len_in_bits = 150;
+    lr11xx_radio_timings_get_bpsk_tx( &pkt_params, &mod_params, LR11XX_RADIO_RAMP_208_US, &timings );
+
+    TEST_ASSERT_EQUAL_UINT32( 250000, timings.payload_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 208 + 250000 + 208 + 111, timings.total_in_us );
+}
+
+void test_lr11xx_radio_timings_get_lr_fhss_tx( void )
+{
+    const uint8_t                 sync_word[LR_FHSS_SYNC_WORD_BYTES] = { 0x2C, 0x0F, 0x79, 0x95 };
+    const lr11xx_lr_fhss_params_t params                             = {
+        .lr_fhss_params = {
+            .sync_word       = sync_word,
+            .modulation_type = LR_FHSS_V1_MODULATION_TYPE_GMSK_488,
+            .cr              = LR_FHSS_V1_CR_1_3,
+            .grid            = LR_FHSS_V1_GRID_3906_HZ,
+            .enable_hopping  = true,
+            .bw              = LR_FHSS_V1_BW_136719_HZ,
+            .header_count    = 3,
+        },
+        .device_offset = 0,
+    };
+    lr11xx_radio_timings_tx_t timings;
+
+    lr11xx_radio_timings_get_lr_fhss_tx( &params, 10, LR11XX_RADIO_RAMP_16_US, &timings );
+
+    // 3 header blocks of 114 bits, then 320 bits of payload at 2048 us/bit
+    TEST_ASSERT_EQUAL_UINT32( 16, timings.ramp_up_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 342 * 2048, timings.preamble_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 320 * 2048, timings.payload_in_us );
+    TEST_ASSERT_EQUAL_UINT32( lr11xx_lr_fhss_get_bit_delay_in_us( &params, 10 ), timings.tx_done_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 16 + 662 * 2048 + timings.tx_done_in_us, timings.total_in_us );
+}
+
+void test_lr11xx_radio_timings_get_lora_rx( void )
+{
+    const lr11xx_radio_mod_params_lora_t mod_params = {
+        .sf   = LR11XX_RADIO_LORA_SF7,
+        .bw   = LR11XX_RADIO_LORA_BW_125,
+        .cr   = LR11XX_RADIO_LORA_CR_4_5,
+        .ldro = 0,
+    };
+    lr11xx_radio_timings_rx_t timings;
+
+    lr11xx_radio_timings_get_lora_rx( &mod_params, &timings );
+
+    TEST_ASSERT_EQUAL_UINT32( 57, timings.input_delay_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 1024, timings.symb_time_in_us );
+    TEST_ASSERT_EQUAL_UINT32( lr11xx_radio_timings_get_delay_between_last_bit_sent_and_rx_done_in_us( &mod_params ),
+                              timings.rx_done_in_us );
+}
+
+void test_lr11xx_radio_timings_get_gfsk_rx( void )
+{
+    const lr11xx_radio_mod_params_gfsk_t mod_params = {
+        .br_in_bps    = 300000,
+        .fdev_in_hz   = 100000,
+        .pulse_shape  = LR11XX_RADIO_GFSK_PULSE_SHAPE_BT_05,
+        .bw_dsb_param = LR11XX_RADIO_GFSK_BW_467000,
+    };
+    lr11xx_radio_timings_rx_t timings;
+
+    lr11xx_radio_timings_get_gfsk_rx( &mod_params, &timings );
+
+    TEST_ASSERT_EQUAL_UINT32( 0, timings.input_delay_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 4, timings.symb_time_in_us );
+    TEST_ASSERT_EQUAL_UINT32( 74, timings.rx_done_in_us );
+}
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
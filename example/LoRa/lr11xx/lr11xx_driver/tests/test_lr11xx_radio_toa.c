@@ -0,0 +1,278 @@
+/**
+ * @file      test_lr11xx_radio_toa.c
+ *
+ * @brief     LR11XX test cases for the time-on-air descriptor and build time macros
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include "unity.h"
+#include "lr11xx_radio_toa.h"
+#include "lr11xx_radio.h"
+#include "sx126x_toa.h"
+
+#include "mock_lr11xx_hal.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+#define CEILING( x ) ( int ) ( x ) + ( 1 - ( int ) ( ( int ) ( ( x ) + 1 ) - ( x ) ) )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+static const uint16_t preamble_lengths_in_symb[] = { 6, 8, 12, 49, 65535 };
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+// Evaluated by the compiler: only constant expressions are allowed in a static initializer
+static const uint32_t lora_toa_in_ms_at_build_time = LR11XX_RADIO_LORA_TOA_IN_MS(
+    LR11XX_RADIO_LORA_SF9, LR11XX_RADIO_LORA_BW_125, LR11XX_RADIO_LORA_CR_4_5, 0, 8, LR11XX_RADIO_LORA_PKT_EXPLICIT, 51,
+    LR11XX_RADIO_LORA_CRC_ON );
+static const uint32_t gfsk_toa_in_ms_at_build_time =
+    LR11XX_RADIO_GFSK_TOA_IN_MS( 50000, 32, 40, LR11XX_RADIO_GFSK_ADDRESS_FILTERING_DISABLE,
+                                 LR11XX_RADIO_GFSK_PKT_VAR_LEN, 255, LR11XX_RADIO_GFSK_CRC_2_BYTES_INV );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+static lr11xx_radio_lora_bw_t get_lora_bw( uint32_t bw_in_hz );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void setUp( void ) {}
+
+void tearDown( void ) {}
+
+void test_lr11xx_radio_toa_lora_exhaustive( void )
+{
+    lr11xx_radio_pkt_params_lora_t pkt_p = { .iq = LR11XX_RADIO_LORA_IQ_STANDARD };
+    lr11xx_radio_mod_params_lora_t mod_p = { .bw = LR11XX_RADIO_LORA_BW_125 };
+    lr11xx_radio_lora_toa_t        toa;
+
+    for( uint8_t sf = LR11XX_RADIO_LORA_SF5; sf <= LR11XX_RADIO_LORA_SF12; sf++ )
+    {
+        for( uint8_t cr = LR11XX_RADIO_LORA_CR_4_5; cr <= LR11XX_RADIO_LORA_CR_LI_4_8; cr++ )
+        {
+            for( uint8_t i = 0; i < 8; i++ )
+            {
+                mod_p.sf                   = ( lr11xx_radio_lora_sf_t ) sf;
+                mod_p.cr                   = ( lr11xx_radio_lora_cr_t ) cr;
+                mod_p.ldro                 = i & 0x01;
+                pkt_p.header_type          = ( ( i & 0x02 ) != 0 ) ? LR11XX_RADIO_LORA_PKT_IMPLICIT
+                                                                   : LR11XX_RADIO_LORA_PKT_EXPLICIT;
+                pkt_p.crc                  = ( ( i & 0x04 ) != 0 ) ? LR11XX_RADIO_LORA_CRC_ON
+                                                                   : LR11XX_RADIO_LORA_CRC_OFF;
+                for( uint8_t j = 0; j < sizeof( preamble_lengths_in_symb ) / sizeof( preamble_lengths_in_symb[0] );
+                     j++ )
+                {
+                    pkt_p.preamble_len_in_symb = preamble_lengths_in_symb[j];
+                    lr11xx_radio_lora_toa_init( &toa, &pkt_p, &mod_p );
+
+                    for( uint16_t pld_len_in_bytes = 0; pld_len_in_bytes <= 255; pld_len_in_bytes++ )
+                    {
+                        pkt_p.pld_len_in_bytes = ( uint8_t ) pld_len_in_bytes;
+
+                        const uint32_t expected = lr11xx_radio_get_lora_time_on_air_numerator( &pkt_p, &mod_p );
+
+                        TEST_ASSERT_EQUAL_UINT32( expected, lr11xx_radio_lora_toa_get_numerator(
+                                                                &toa, ( uint8_t ) pld_len_in_bytes ) );
+                        TEST_ASSERT_EQUAL_UINT32(
+                            expected, LR11XX_RADIO_LORA_TOA_NUMERATOR( mod_p.sf, mod_p.cr, mod_p.ldro,
+                                                                       pkt_p.preamble_len_in_symb, pkt_p.header_type,
+                                                                       pkt_p.pld_len_in_bytes, pkt_p.crc ) );
+                    }
+                }
+            }
+        }
+    }
+}
+
+void test_lr11xx_radio_toa_lora_bw_in_hz( void )
+{
+    const lr11xx_radio_lora_bw_t bws[] = {
+        LR11XX_RADIO_LORA_BW_10,  LR11XX_RADIO_LORA_BW_15,  LR11XX_RADIO_LORA_BW_20,  LR11XX_RADIO_LORA_BW_31,
+        LR11XX_RADIO_LORA_BW_41,  LR11XX_RADIO_LORA_BW_62,  LR11XX_RADIO_LORA_BW_125, LR11XX_RADIO_LORA_BW_250,
+        LR11XX_RADIO_LORA_BW_500, LR11XX_RADIO_LORA_BW_200, LR11XX_RADIO_LORA_BW_400, LR11XX_RADIO_LORA_BW_800,
+    };
+
+    for( uint8_t i = 0; i < sizeof( bws ) / sizeof( bws[0] ); i++ )
+    {
+        TEST_ASSERT_EQUAL_UINT32( lr11xx_radio_get_lora_bw_in_hz( bws[i] ), LR11XX_RADIO_LORA_BW_IN_HZ( bws[i] ) );
+    }
+}
+
+void test_lr11xx_radio_toa_lora_in_ms_reference( void )
+{
+    lr11xx_radio_pkt_params_lora_t pkt_p = { .iq = LR11XX_RADIO_LORA_IQ_STANDARD };
+    lr11xx_radio_mod_params_lora_t mod_p;
+    lr11xx_radio_lora_toa_t        toa;
+
+    for( uint32_t i = 0; i < sizeof( assets ) / sizeof( assets[0] ); i++ )
+    {
+        pkt_p.preamble_len_in_symb = assets[i].pbl;
+        pkt_p.header_type = ( assets[i].impl == 1 ) ? LR11XX_RADIO_LORA_PKT_IMPLICIT : LR11XX_RADIO_LORA_PKT_EXPLICIT;
+        pkt_p.pld_len_in_bytes = assets[i].pld;
+        pkt_p.crc              = ( assets[i].crc == 1 ) ? LR11XX_RADIO_LORA_CRC_ON : LR11XX_RADIO_LORA_CRC_OFF;
+        mod_p.bw               = get_lora_bw( assets[i].bw );
+        mod_p.sf               = ( lr11xx_radio_lora_sf_t ) ( assets[i].sf );
+        mod_p.cr               = ( lr11xx_radio_lora_cr_t ) ( assets[i].cr );
+        mod_p.ldro             = assets[i].ldro;
+
+        lr11xx_radio_lora_toa_init( &toa, &pkt_p, &mod_p );
+
+        const uint32_t time_on_air_in_ms = lr11xx_radio_lora_toa_get_in_ms( &toa, pkt_p.pld_len_in_bytes );
+
+        TEST_ASSERT_UINT32_WITHIN( 1, CEILING( assets[i].toa * 1000 ), time_on_air_in_ms );
+        TEST_ASSERT_EQUAL_UINT32( lr11xx_radio_get_lora_time_on_air_in_ms( &pkt_p, &mod_p ), time_on_air_in_ms );
+        TEST_ASSERT_EQUAL_UINT32( time_on_air_in_ms,
+                                  LR11XX_RADIO_LORA_TOA_IN_MS( mod_p.sf, mod_p.bw, mod_p.cr, mod_p.ldro,
+                                                               pkt_p.preamble_len_in_symb, pkt_p.header_type,
+                                                               pkt_p.pld_len_in_bytes, pkt_p.crc ) );
+    }
+}
+
+void test_lr11xx_radio_toa_gfsk( void )
+{
+    const lr11xx_radio_gfsk_pkt_len_modes_t header_types[] = {
+        LR11XX_RADIO_GFSK_PKT_FIX_LEN,
+        LR11XX_RADIO_GFSK_PKT_VAR_LEN,
+        LR11XX_RADIO_GFSK_PKT_VAR_LEN_SX128X_COMP,
+    };
+    const lr11xx_radio_gfsk_crc_type_t crc_types[] = {
+        LR11XX_RADIO_GFSK_CRC_OFF,        LR11XX_RADIO_GFSK_CRC_1_BYTE,      LR11XX_RADIO_GFSK_CRC_2_BYTES,
+        LR11XX_RADIO_GFSK_CRC_1_BYTE_INV, LR11XX_RADIO_GFSK_CRC_2_BYTES_INV,
+    };
+    lr11xx_radio_pkt_params_gfsk_t pkt_p = { .preamble_len_in_bits = 32, .sync_word_len_in_bits = 40 };
+
+    for( uint8_t i = 0; i < sizeof( header_types ) / sizeof( header_types[0] ); i++ )
+    {
+        for( uint8_t j = 0; j < sizeof( crc_types ) / sizeof( crc_types[0] ); j++ )
+        {
+            for( uint8_t address_filtering = 0; address_filtering < 2; address_filtering++ )
+            {
+                pkt_p.header_type       = header_types[i];
+                pkt_p.crc_type          = crc_types[j];
+                pkt_p.address_filtering = ( address_filtering == 0 )
+                                              ? LR11XX_RADIO_GFSK_ADDRESS_FILTERING_DISABLE
+                                              : LR11XX_RADIO_GFSK_ADDRESS_FILTERING_NODE_ADDRESS;
+                for( uint16_t pld_len_in_bytes = 0; pld_len_in_bytes <= 255; pld_len_in_bytes++ )
+                {
+                    pkt_p.pld_len_in_bytes = ( uint8_t ) pld_len_in_bytes;
+
+                    TEST_ASSERT_EQUAL_UINT32( lr11xx_radio_get_gfsk_time_on_air_numerator( &pkt_p ),
+                                              LR11XX_RADIO_GFSK_TOA_NUMERATOR(
+                                                  pkt_p.preamble_len_in_bits, pkt_p.sync_word_len_in_bits,
+                                                  pkt_p.address_filtering, pkt_p.header_type,
+                                                  pkt_p.pld_len_in_bytes, pkt_p.crc_type ) );
+                }
+            }
+        }
+    }
+}
+
+void test_lr11xx_radio_toa_at_build_time( void )
+{
+    const lr11xx_radio_pkt_params_lora_t lora_pkt_p = {
+        .preamble_len_in_symb = 8,
+        .header_type          = LR11XX_RADIO_LORA_PKT_EXPLICIT,
+        .pld_len_in_bytes     = 51,
+        .crc                  = LR11XX_RADIO_LORA_CRC_ON,
+        .iq                   = LR11XX_RADIO_LORA_IQ_STANDARD,
+    };
+    const lr11xx_radio_mod_params_lora_t lora_mod_p = {
+        .sf   = LR11XX_RADIO_LORA_SF9,
+        .bw   = LR11XX_RADIO_LORA_BW_125,
+        .cr   = LR11XX_RADIO_LORA_CR_4_5,
+        .ldro = 0,
+    };
+    const lr11xx_radio_pkt_params_gfsk_t gfsk_pkt_p = {
+        .preamble_len_in_bits  = 32,
+        .sync_word_len_in_bits = 40,
+        .address_filtering     = LR11XX_RADIO_GFSK_ADDRESS_FILTERING_DISABLE,
+        .header_type           = LR11XX_RADIO_GFSK_PKT_VAR_LEN,
+        .pld_len_in_bytes      = 255,
+        .crc_type              = LR11XX_RADIO_GFSK_CRC_2_BYTES_INV,
+    };
+    const lr11xx_radio_mod_params_gfsk_t gfsk_mod_p = { .br_in_bps = 50000 };
+
+    TEST_ASSERT_EQUAL_UINT32( lr11xx_radio_get_lora_time_on_air_in_ms( &lora_pkt_p, &lora_mod_p ),
+                              lora_toa_in_ms_at_build_time );
+    TEST_ASSERT_EQUAL_UINT32( lr11xx_radio_get_gfsk_time_on_air_in_ms( &gfsk_pkt_p, &gfsk_mod_p ),
+                              gfsk_toa_in_ms_at_build_time );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static lr11xx_radio_lora_bw_t get_lora_bw( uint32_t bw_in_hz )
+{
+    const lr11xx_radio_lora_bw_t bws[] = {
+        LR11XX_RADIO_LORA_BW_10,  LR11XX_RADIO_LORA_BW_15,  LR11XX_RADIO_LORA_BW_20,  LR11XX_RADIO_LORA_BW_31,
+        LR11XX_RADIO_LORA_BW_41,  LR11XX_RADIO_LORA_BW_62,  LR11XX_RADIO_LORA_BW_125, LR11XX_RADIO_LORA_BW_250,
+        LR11XX_RADIO_LORA_BW_500, LR11XX_RADIO_LORA_BW_200, LR11XX_RADIO_LORA_BW_400, LR11XX_RADIO_LORA_BW_800,
+    };
+
+    for( uint8_t i = 0; i < sizeof( bws ) / sizeof( bws[0] ); i++ )
+    {
+        if( lr11xx_radio_get_lora_bw_in_hz( bws[i] ) == bw_in_hz )
+        {
+            return bws[i];
+        }
+    }
+
+    TEST_FAIL_MESSAGE( "Unknown bandwidth" );
+    return LR11XX_RADIO_LORA_BW_125;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -492,6 +492,177 @@ void test_lr11xx_wifi_ReadExtendedFullResultsWithManyResults( void )
     }
 }
 
+typedef struct
+{
+    uint8_t                                     nb_calls;
+    uint8_t                                     nb_calls_before_stop;
+    uint8_t                                     result_indexes[LR11XX_WIFI_MAX_RESULTS];
+    lr11xx_wifi_basic_mac_type_channel_result_t results[LR11XX_WIFI_MAX_RESULTS];
+} wifi_stream_collector_t;
+
+bool wifi_stream_collect( const uint8_t result_index, const lr11xx_wifi_result_t* result, void* user_context )
+{
+    wifi_stream_collector_t* collector = ( wifi_stream_collector_t* ) user_context;
+
+    collector->result_indexes[collector->nb_calls] = result_index;
+    collector->results[collector->nb_calls]        = result->basic_mac_type_channel;
+    collector->nb_calls++;
+
+    return collector->nb_calls != collector->nb_calls_before_stop;
+}
+
+void wifi_stream_fill_basic_mac_type_channel_result( uint8_t* buffer, const uint8_t mac_last_byte, const int8_t rssi )
+{
+    const uint8_t raw_result[9] = { LR11XX_WIFI_TYPE_RESULT_G, 0x0D, ( uint8_t ) rssi, 0x02, 0x03, 0x04, 0x05, 0x06,
+                                    mac_last_byte };
+
+    memcpy( buffer, raw_result, sizeof( raw_result ) );
+}
+
+void test_lr11xx_wifi_StreamResultsWithSmallChunkBuffer( void )
+{
+    const uint8_t cbuffer1_expected[] = { 0x03, 0x06, 0x02, 2, 0x04 };
+    const uint8_t cbuffer2_expected[] = { 0x03, 0x06, 0x04, 1, 0x04 };
+
+    uint8_t rbuffer_out_faked1[18] = { 0 };
+    uint8_t rbuffer_out_faked2[9]  = { 0 };
+    wifi_stream_fill_basic_mac_type_channel_result( &rbuffer_out_faked1[0], 0xA0, -60 );
+    wifi_stream_fill_basic_mac_type_channel_result( &rbuffer_out_faked1[9], 0xA1, -95 );
+    wifi_stream_fill_basic_mac_type_channel_result( &rbuffer_out_faked2[0], 0xA2, -80 );
+
+    // Room for two results and a half: results are fetched two by two
+    uint8_t                     chunk_buffer[22] = { 0 };
+    wifi_stream_collector_t     collector        = { 0 };
+    lr11xx_wifi_result_stream_t stream           = {
+        .format            = LR11XX_WIFI_RESULT_FORMAT_BASIC_MAC_TYPE_CHANNEL,
+        .chunk_buffer      = chunk_buffer,
+        .chunk_buffer_size = sizeof( chunk_buffer ),
+        .rssi_min_in_dbm   = -90,
+        .callback          = wifi_stream_collect,
+        .user_context      = &collector,
+    };
+    uint8_t nb_results_delivered = 0;
+
+    /********************/
+    /* Set expectations */
+    /********************/
+    lr11xx_hal_read_ExpectWithArrayAndReturn( context, 0, cbuffer1_expected, 5, 5, NULL, 18, 0, LR11XX_HAL_STATUS_OK );
+    lr11xx_hal_read_IgnoreArg_data( );
+    lr11xx_hal_read_ReturnArrayThruPtr_data( rbuffer_out_faked1, 18 );
+    lr11xx_hal_read_ExpectWithArrayAndReturn( context, 0, cbuffer2_expected, 5, 5, NULL, 9, 0, LR11XX_HAL_STATUS_OK );
+    lr11xx_hal_read_IgnoreArg_data( );
+    lr11xx_hal_read_ReturnArrayThruPtr_data( rbuffer_out_faked2, 9 );
+
+    /************************/
+    /* Perform transactions */
+    /************************/
+    const lr11xx_status_t status = lr11xx_wifi_stream_results( context, 2, 3, &stream, &nb_results_delivered );
+
+    /*****************/
+    /* Check results */
+    /*****************/
+    TEST_ASSERT_EQUAL_INT( LR11XX_STATUS_OK, status );
+    TEST_ASSERT_EQUAL_UINT8( 2, nb_results_delivered );
+    TEST_ASSERT_EQUAL_UINT8( 2, collector.nb_calls );
+
+    // The result at -95 dBm is below the threshold
+    TEST_ASSERT_EQUAL_UINT8( 2, collector.result_indexes[0] );
+    TEST_ASSERT_EQUAL_INT8( -60, collector.results[0].rssi );
+    TEST_ASSERT_EQUAL_UINT8( 0xA0, collector.results[0].mac_address[5] );
+    TEST_ASSERT_EQUAL_UINT8( 4, collector.result_indexes[1] );
+    TEST_ASSERT_EQUAL_INT8( -80, collector.results[1].rssi );
+    TEST_ASSERT_EQUAL_UINT8( 0x0D, collector.results[1].channel_info_byte );
+    TEST_ASSERT_EQUAL_UINT8( 0xA2, collector.results[1].mac_address[5] );
+}
+
+void test_lr11xx_wifi_StreamResultsWithMacDeduplication( void )
+{
+    const uint8_t cbuffer_expected[] = { 0x03, 0x06, 0x00, 4, 0x04 };
+
+    uint8_t rbuffer_out_faked[36] = { 0 };
+    wifi_stream_fill_basic_mac_type_channel_result( &rbuffer_out_faked[0], 0xB0, -50 );
+    wifi_stream_fill_basic_mac_type_channel_result( &rbuffer_out_faked[9], 0xB1, -51 );
+    wifi_stream_fill_basic_mac_type_channel_result( &rbuffer_out_faked[18], 0xB0, -52 );
+    wifi_stream_fill_basic_mac_type_channel_result( &rbuffer_out_faked[27], 0xB2, -53 );
+
+    uint8_t                     chunk_buffer[36] = { 0 };
+    lr11xx_wifi_mac_address_t   seen_mac_addresses[2];
+    wifi_stream_collector_t     collector = { 0 };
+    lr11xx_wifi_result_stream_t stream    = {
+        .format                  = LR11XX_WIFI_RESULT_FORMAT_BASIC_MAC_TYPE_CHANNEL,
+        .chunk_buffer            = chunk_buffer,
+        .chunk_buffer_size       = sizeof( chunk_buffer ),
+        .rssi_min_in_dbm         = INT8_MIN,
+        .seen_mac_addresses      = seen_mac_addresses,
+        .seen_mac_addresses_size = 2,
+        .callback                = wifi_stream_collect,
+        .user_context            = &collector,
+    };
+    uint8_t nb_results_delivered = 0;
+
+    lr11xx_hal_read_ExpectWithArrayAndReturn( context, 0, cbuffer_expected, 5, 5, NULL, 36, 0, LR11XX_HAL_STATUS_OK );
+    lr11xx_hal_read_IgnoreArg_data( );
+    lr11xx_hal_read_ReturnArrayThruPtr_data( rbuffer_out_faked, 36 );
+
+    lr11xx_status_t status = lr11xx_wifi_stream_results( context, 0, 4, &stream, &nb_results_delivered );
+
+    // The third result repeats the first MAC address. The last one is delivered but not recorded: the table is full.
+    TEST_ASSERT_EQUAL_INT( LR11XX_STATUS_OK, status );
+    TEST_ASSERT_EQUAL_UINT8( 3, nb_results_delivered );
+    TEST_ASSERT_EQUAL_UINT8( 0, collector.result_indexes[0] );
+    TEST_ASSERT_EQUAL_UINT8( 1, collector.result_indexes[1] );
+    TEST_ASSERT_EQUAL_UINT8( 3, collector.result_indexes[2] );
+    TEST_ASSERT_EQUAL_UINT8( 2, stream.nb_seen_mac_addresses );
+    TEST_ASSERT_EQUAL_UINT8( 0xB0, seen_mac_addresses[0][5] );
+    TEST_ASSERT_EQUAL_UINT8( 0xB1, seen_mac_addresses[1][5] );
+
+    // The table is kept between calls, and the callback can stop the stream
+    collector.nb_calls             = 0;
+    collector.nb_calls_before_stop = 1;
+
+    lr11xx_hal_read_ExpectWithArrayAndReturn( context, 0, cbuffer_expected, 5, 5, NULL, 36, 0, LR11XX_HAL_STATUS_OK );
+    lr11xx_hal_read_IgnoreArg_data( );
+    lr11xx_hal_read_ReturnArrayThruPtr_data( rbuffer_out_faked, 36 );
+
+    status = lr11xx_wifi_stream_results( context, 0, 4, &stream, &nb_results_delivered );
+
+    TEST_ASSERT_EQUAL_INT( LR11XX_STATUS_OK, status );
+    TEST_ASSERT_EQUAL_UINT8( 1, nb_results_delivered );
+    TEST_ASSERT_EQUAL_UINT8( 3, collector.result_indexes[0] );
+}
+
+void test_lr11xx_wifi_StreamResultsErrors( void )
+{
+    const uint8_t cbuffer_expected[] = { 0x03, 0x06, 0x00, 1, 0x01 };
+
+    uint8_t                     chunk_buffer[22] = { 0 };
+    wifi_stream_collector_t     collector        = { 0 };
+    lr11xx_wifi_result_stream_t stream           = {
+        .format            = LR11XX_WIFI_RESULT_FORMAT_BASIC_COMPLETE,
+        .chunk_buffer      = chunk_buffer,
+        .chunk_buffer_size = sizeof( chunk_buffer ) - 1,
+        .rssi_min_in_dbm   = INT8_MIN,
+        .callback          = wifi_stream_collect,
+        .user_context      = &collector,
+    };
+    uint8_t nb_results_delivered = 0xFF;
+
+    // A chunk buffer smaller than a single result is rejected without any access to the chip
+    TEST_ASSERT_EQUAL_INT( LR11XX_STATUS_ERROR,
+                           lr11xx_wifi_stream_results( context, 0, 1, &stream, &nb_results_delivered ) );
+    TEST_ASSERT_EQUAL_UINT8( 0, nb_results_delivered );
+
+    // A HAL error is propagated
+    stream.chunk_buffer_size = sizeof( chunk_buffer );
+    lr11xx_hal_read_ExpectWithArrayAndReturn( context, 0, cbuffer_expected, 5, 5, NULL, 22, 0,
+                                              LR11XX_HAL_STATUS_ERROR );
+    lr11xx_hal_read_IgnoreArg_data( );
+
+    TEST_ASSERT_EQUAL_INT( LR11XX_STATUS_ERROR,
+                           lr11xx_wifi_stream_results( context, 0, 1, &stream, &nb_results_delivered ) );
+    TEST_ASSERT_EQUAL_UINT8( 0, collector.nb_calls );
+}
+
 void test_lr11xx_wifi_ResetCumulativeTimings( void )
 {
     uint8_t cbuffer_expected[] = { 0x03, 0x07 };
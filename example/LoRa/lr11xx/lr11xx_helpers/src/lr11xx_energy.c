@@ -0,0 +1,274 @@
+/**
+ * @file      lr11xx_energy.c
+ *
+ * @brief     Charge accounting of the radio, Wi-Fi and GNSS scans, SPI and MCU
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <string.h>
+#include "lr11xx_energy.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Scan currents, in uA - the figures of lr11xx_wifi_get_consumption and lr11xx_gnss_get_consumption
+ */
+#define LR11XX_ENERGY_WIFI_CORRELATION_UA ( 12000 )
+#define LR11XX_ENERGY_WIFI_CAPTURE_UA ( 12000 )
+#define LR11XX_ENERGY_WIFI_DEMODULATION_UA ( 4000 )
+#define LR11XX_ENERGY_GNSS_RADIO_ACQUISITION_GPS_UA_DCDC ( 15000 )
+#define LR11XX_ENERGY_GNSS_RADIO_ACQUISITION_BEIDOU_UA_DCDC ( 16500 )
+#define LR11XX_ENERGY_GNSS_COMPUTATION_UA_DCDC ( 3100 )
+#define LR11XX_ENERGY_GNSS_RADIO_ACQUISITION_GPS_UA_LDO ( 24500 )
+#define LR11XX_ENERGY_GNSS_RADIO_ACQUISITION_BEIDOU_UA_LDO ( 27300 )
+#define LR11XX_ENERGY_GNSS_COMPUTATION_UA_LDO ( 5000 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Get the budget of a charge accounting
+ *
+ * @param [in] energy Charge accounting
+ *
+ * @returns Budget in uA.us
+ */
+static uint64_t lr11xx_energy_get_budget( const lr11xx_energy_t* energy );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void lr11xx_energy_init( lr11xx_energy_t* energy, const lr11xx_energy_profile_t* profile, uint32_t budget_in_uah )
+{
+    memset( energy, 0, sizeof( lr11xx_energy_t ) );
+
+    energy->profile       = profile;
+    energy->budget_in_uah = budget_in_uah;
+}
+
+uint64_t lr11xx_energy_estimate_tx( const lr11xx_energy_profile_t* profile, int8_t power_in_dbm,
+                                    uint32_t duration_in_us )
+{
+    uint8_t index = 0;
+
+    if( profile->nb_tx_currents == 0 )
+    {
+        return 0;
+    }
+
+    while( ( index < ( profile->nb_tx_currents - 1 ) ) && ( profile->tx_currents[index].power_in_dbm < power_in_dbm ) )
+    {
+        index++;
+    }
+
+    return ( uint64_t ) profile->tx_currents[index].current_in_ua * duration_in_us;
+}
+
+uint64_t lr11xx_energy_estimate_rx( const lr11xx_energy_profile_t* profile, uint32_t duration_in_us )
+{
+    return ( uint64_t ) profile->rx_current_in_ua * duration_in_us;
+}
+
+uint64_t lr11xx_energy_estimate_wifi( const lr11xx_energy_profile_t*   profile,
+                                      lr11xx_wifi_cumulative_timings_t timings )
+{
+    uint64_t charge_in_ua_us = ( uint64_t ) timings.rx_capture_us * LR11XX_ENERGY_WIFI_CAPTURE_UA +
+                               ( uint64_t ) timings.demodulation_us * LR11XX_ENERGY_WIFI_DEMODULATION_UA +
+                               ( uint64_t ) timings.rx_correlation_us * LR11XX_ENERGY_WIFI_CORRELATION_UA;
+
+    // Same LDO factor as lr11xx_wifi_get_consumption
+    if( profile->regulator == LR11XX_SYSTEM_REG_MODE_LDO )
+    {
+        charge_in_ua_us *= 2;
+    }
+
+    return charge_in_ua_us;
+}
+
+uint64_t lr11xx_energy_estimate_gnss( const lr11xx_energy_profile_t* profile, lr11xx_gnss_timings_t timings,
+                                      lr11xx_gnss_constellation_mask_t constellations_used )
+{
+    uint32_t computation_ua = LR11XX_ENERGY_GNSS_COMPUTATION_UA_LDO;
+    uint32_t gps_ua         = LR11XX_ENERGY_GNSS_RADIO_ACQUISITION_GPS_UA_LDO;
+    uint32_t beidou_ua      = LR11XX_ENERGY_GNSS_RADIO_ACQUISITION_BEIDOU_UA_LDO;
+    uint32_t radio_ua       = 0;
+
+    if( profile->regulator == LR11XX_SYSTEM_REG_MODE_DCDC )
+    {
+        computation_ua = LR11XX_ENERGY_GNSS_COMPUTATION_UA_DCDC;
+        gps_ua         = LR11XX_ENERGY_GNSS_RADIO_ACQUISITION_GPS_UA_DCDC;
+        beidou_ua      = LR11XX_ENERGY_GNSS_RADIO_ACQUISITION_BEIDOU_UA_DCDC;
+    }
+
+    switch( constellations_used )
+    {
+    case LR11XX_GNSS_GPS_MASK:
+        radio_ua = gps_ua;
+        break;
+    case LR11XX_GNSS_BEIDOU_MASK:
+        radio_ua = beidou_ua;
+        break;
+    case LR11XX_GNSS_GPS_MASK | LR11XX_GNSS_BEIDOU_MASK:
+        radio_ua = ( gps_ua + beidou_ua ) / 2;
+        break;
+    default:
+        break;
+    }
+
+    return ( ( uint64_t ) timings.computation_ms * computation_ua + ( uint64_t ) timings.radio_ms * radio_ua ) * 1000;
+}
+
+void lr11xx_energy_add( lr11xx_energy_t* energy, lr11xx_energy_subsystem_t subsystem, uint64_t charge_in_ua_us )
+{
+    if( subsystem < LR11XX_ENERGY_SUBSYSTEM_COUNT )
+    {
+        energy->charge_in_ua_us[subsystem] += charge_in_ua_us;
+    }
+}
+
+void lr11xx_energy_add_tx( lr11xx_energy_t* energy, int8_t power_in_dbm, uint32_t duration_in_us )
+{
+    lr11xx_energy_add( energy, LR11XX_ENERGY_SUBSYSTEM_TX,
+                       lr11xx_energy_estimate_tx( energy->profile, power_in_dbm, duration_in_us ) );
+}
+
+void lr11xx_energy_add_rx( lr11xx_energy_t* energy, uint32_t duration_in_us )
+{
+    lr11xx_energy_add( energy, LR11XX_ENERGY_SUBSYSTEM_RX,
+                       lr11xx_energy_estimate_rx( energy->profile, duration_in_us ) );
+}
+
+void lr11xx_energy_add_wifi( lr11xx_energy_t* energy, lr11xx_wifi_cumulative_timings_t timings )
+{
+    lr11xx_energy_add( energy, LR11XX_ENERGY_SUBSYSTEM_WIFI, lr11xx_energy_estimate_wifi( energy->profile, timings ) );
+}
+
+void lr11xx_energy_add_gnss( lr11xx_energy_t* energy, lr11xx_gnss_timings_t timings,
+                             lr11xx_gnss_constellation_mask_t constellations_used )
+{
+    lr11xx_energy_add( energy, LR11XX_ENERGY_SUBSYSTEM_GNSS,
+                       lr11xx_energy_estimate_gnss( energy->profile, timings, constellations_used ) );
+}
+
+void lr11xx_energy_add_spi( lr11xx_energy_t* energy, uint32_t duration_in_us )
+{
+    lr11xx_energy_add( energy, LR11XX_ENERGY_SUBSYSTEM_SPI,
+                       ( uint64_t ) energy->profile->spi_current_in_ua * duration_in_us );
+}
+
+void lr11xx_energy_add_mcu( lr11xx_energy_t* energy, uint32_t run_in_us, uint32_t stop_in_us )
+{
+    lr11xx_energy_add( energy, LR11XX_ENERGY_SUBSYSTEM_MCU_RUN,
+                       ( uint64_t ) energy->profile->mcu_run_current_in_ua * run_in_us );
+    lr11xx_energy_add( energy, LR11XX_ENERGY_SUBSYSTEM_MCU_STOP,
+                       ( uint64_t ) energy->profile->mcu_stop_current_in_ua * stop_in_us );
+}
+
+uint64_t lr11xx_energy_get_charge( const lr11xx_energy_t* energy, lr11xx_energy_subsystem_t subsystem )
+{
+    return ( subsystem < LR11XX_ENERGY_SUBSYSTEM_COUNT ) ? energy->charge_in_ua_us[subsystem] : 0;
+}
+
+uint64_t lr11xx_energy_get_total_charge( const lr11xx_energy_t* energy )
+{
+    uint64_t total = 0;
+
+    for( uint8_t subsystem = 0; subsystem < LR11XX_ENERGY_SUBSYSTEM_COUNT; subsystem++ )
+    {
+        total += energy->charge_in_ua_us[subsystem];
+    }
+
+    return total;
+}
+
+uint32_t lr11xx_energy_get_remaining_budget_in_uah( const lr11xx_energy_t* energy )
+{
+    const uint64_t budget = lr11xx_energy_get_budget( energy );
+    const uint64_t total  = lr11xx_energy_get_total_charge( energy );
+
+    if( total >= budget )
+    {
+        return 0;
+    }
+
+    return ( uint32_t ) ( ( budget - total ) / LR11XX_ENERGY_UA_US_PER_UAH );
+}
+
+bool lr11xx_energy_can_afford( const lr11xx_energy_t* energy, uint64_t charge_in_ua_us )
+{
+    const uint64_t budget = lr11xx_energy_get_budget( energy );
+    const uint64_t total  = lr11xx_energy_get_total_charge( energy );
+
+    if( energy->budget_in_uah == 0 )
+    {
+        return true;
+    }
+
+    return ( total <= budget ) && ( charge_in_ua_us <= ( budget - total ) );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static uint64_t lr11xx_energy_get_budget( const lr11xx_energy_t* energy )
+{
+    return ( uint64_t ) energy->budget_in_uah * LR11XX_ENERGY_UA_US_PER_UAH;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
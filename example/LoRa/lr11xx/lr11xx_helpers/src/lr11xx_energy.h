@@ -0,0 +1,293 @@
+/**
+ * @file      lr11xx_energy.h
+ *
+ * @brief     Charge accounting of the radio, Wi-Fi and GNSS scans, SPI and MCU
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LR11XX_ENERGY_H
+#define LR11XX_ENERGY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lr11xx_gnss_types.h"
+#include "lr11xx_system_types.h"
+#include "lr11xx_wifi_types.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Number of uA.us in one uAh
+ */
+#define LR11XX_ENERGY_UA_US_PER_UAH ( 3600000000ULL )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Subsystems the charge is accounted to
+ */
+typedef enum lr11xx_energy_subsystem_e
+{
+    LR11XX_ENERGY_SUBSYSTEM_TX = 0x00,  //!< Radio transmissions
+    LR11XX_ENERGY_SUBSYSTEM_RX,         //!< Radio receptions
+    LR11XX_ENERGY_SUBSYSTEM_WIFI,       //!< Wi-Fi passive scans
+    LR11XX_ENERGY_SUBSYSTEM_GNSS,       //!< GNSS scans
+    LR11XX_ENERGY_SUBSYSTEM_SPI,        //!< SPI transactions with the chip
+    LR11XX_ENERGY_SUBSYSTEM_MCU_RUN,    //!< MCU in run mode
+    LR11XX_ENERGY_SUBSYSTEM_MCU_STOP,   //!< MCU in stop mode
+    LR11XX_ENERGY_SUBSYSTEM_COUNT,      //!< Number of subsystems
+} lr11xx_energy_subsystem_t;
+
+/**
+ * @brief Supply current drawn while transmitting at a given power
+ */
+typedef struct lr11xx_energy_tx_current_s
+{
+    int8_t   power_in_dbm;   //!< Tx power
+    uint32_t current_in_ua;  //!< Supply current
+} lr11xx_energy_tx_current_t;
+
+/**
+ * @brief Currents of the board, e.g. from the datasheets or measured
+ *
+ * The Tx current table can be filled from the one of the LR1121 modem firmware, read with
+ * lr1121_modem_get_tx_power_consumption_ua.
+ */
+typedef struct lr11xx_energy_profile_s
+{
+    const lr11xx_energy_tx_current_t* tx_currents;  //!< Tx currents, sorted by increasing power
+    uint8_t                           nb_tx_currents;
+    uint32_t                          rx_current_in_ua;        //!< Radio in Rx
+    uint32_t                          spi_current_in_ua;       //!< Chip in standby and MCU driving the SPI
+    uint32_t                          mcu_run_current_in_ua;   //!< MCU in run mode
+    uint32_t                          mcu_stop_current_in_ua;  //!< MCU in stop mode
+    lr11xx_system_reg_mode_t          regulator;               //!< Regulator of the chip, for Wi-Fi and GNSS scans
+} lr11xx_energy_profile_t;
+
+/**
+ * @brief Charge accounting
+ */
+typedef struct lr11xx_energy_s
+{
+    const lr11xx_energy_profile_t* profile;
+    uint64_t                       charge_in_ua_us[LR11XX_ENERGY_SUBSYSTEM_COUNT];  //!< Charge per subsystem
+    uint32_t                       budget_in_uah;  //!< Charge allowed - 0 for no budget
+} lr11xx_energy_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Initialise - or reset - a charge accounting
+ *
+ * @param [out] energy Charge accounting
+ * @param [in] profile Currents of the board - must remain valid
+ * @param [in] budget_in_uah Charge allowed - 0 for no budget
+ */
+void lr11xx_energy_init( lr11xx_energy_t* energy, const lr11xx_energy_profile_t* profile, uint32_t budget_in_uah );
+
+/**
+ * @brief Estimate the charge of a transmission
+ *
+ * The current of the lowest table entry at or above power_in_dbm is used - the highest entry above the table.
+ *
+ * @param [in] profile Currents of the board
+ * @param [in] power_in_dbm Tx power
+ * @param [in] duration_in_us Transmission duration, e.g. total_in_us from lr11xx_radio_timings_get_lora_tx
+ *
+ * @returns Charge in uA.us
+ */
+uint64_t lr11xx_energy_estimate_tx( const lr11xx_energy_profile_t* profile, int8_t power_in_dbm,
+                                    uint32_t duration_in_us );
+
+/**
+ * @brief Estimate the charge of a reception
+ *
+ * @param [in] profile Currents of the board
+ * @param [in] duration_in_us Reception duration
+ *
+ * @returns Charge in uA.us
+ */
+uint64_t lr11xx_energy_estimate_rx( const lr11xx_energy_profile_t* profile, uint32_t duration_in_us );
+
+/**
+ * @brief Estimate the charge of a Wi-Fi passive scan
+ *
+ * @param [in] profile Currents of the board
+ * @param [in] timings Cumulative timings of the scan - expected or read with lr11xx_wifi_read_cumulative_timing
+ *
+ * @returns Charge in uA.us
+ */
+uint64_t lr11xx_energy_estimate_wifi( const lr11xx_energy_profile_t*   profile,
+                                      lr11xx_wifi_cumulative_timings_t timings );
+
+/**
+ * @brief Estimate the charge of a GNSS scan
+ *
+ * @param [in] profile Currents of the board
+ * @param [in] timings Timings of the scan - expected or read with lr11xx_gnss_get_timings
+ * @param [in] constellations_used Constellations scanned
+ *
+ * @returns Charge in uA.us
+ */
+uint64_t lr11xx_energy_estimate_gnss( const lr11xx_energy_profile_t* profile, lr11xx_gnss_timings_t timings,
+                                      lr11xx_gnss_constellation_mask_t constellations_used );
+
+/**
+ * @brief Account a charge to a subsystem
+ *
+ * @param [in] energy Charge accounting
+ * @param [in] subsystem Subsystem
+ * @param [in] charge_in_ua_us Charge in uA.us
+ */
+void lr11xx_energy_add( lr11xx_energy_t* energy, lr11xx_energy_subsystem_t subsystem, uint64_t charge_in_ua_us );
+
+/**
+ * @brief Account a transmission
+ *
+ * @param [in] energy Charge accounting
+ * @param [in] power_in_dbm Tx power
+ * @param [in] duration_in_us Transmission duration
+ */
+void lr11xx_energy_add_tx( lr11xx_energy_t* energy, int8_t power_in_dbm, uint32_t duration_in_us );
+
+/**
+ * @brief Account a reception
+ *
+ * @param [in] energy Charge accounting
+ * @param [in] duration_in_us Reception duration
+ */
+void lr11xx_energy_add_rx( lr11xx_energy_t* energy, uint32_t duration_in_us );
+
+/**
+ * @brief Account a Wi-Fi passive scan
+ *
+ * @param [in] energy Charge accounting
+ * @param [in] timings Cumulative timings of the scan
+ */
+void lr11xx_energy_add_wifi( lr11xx_energy_t* energy, lr11xx_wifi_cumulative_timings_t timings );
+
+/**
+ * @brief Account a GNSS scan
+ *
+ * @param [in] energy Charge accounting
+ * @param [in] timings Timings of the scan
+ * @param [in] constellations_used Constellations scanned
+ */
+void lr11xx_energy_add_gnss( lr11xx_energy_t* energy, lr11xx_gnss_timings_t timings,
+                             lr11xx_gnss_constellation_mask_t constellations_used );
+
+/**
+ * @brief Account SPI activity
+ *
+ * @param [in] energy Charge accounting
+ * @param [in] duration_in_us Time spent in SPI transactions and busy waits
+ */
+void lr11xx_energy_add_spi( lr11xx_energy_t* energy, uint32_t duration_in_us );
+
+/**
+ * @brief Account MCU time
+ *
+ * Typically called around the low power entry of the main loop, with the time spent in stop mode and the time spent
+ * running since the previous call.
+ *
+ * @param [in] energy Charge accounting
+ * @param [in] run_in_us Time spent in run mode
+ * @param [in] stop_in_us Time spent in stop mode
+ */
+void lr11xx_energy_add_mcu( lr11xx_energy_t* energy, uint32_t run_in_us, uint32_t stop_in_us );
+
+/**
+ * @brief Get the charge accounted to a subsystem
+ *
+ * @param [in] energy Charge accounting
+ * @param [in] subsystem Subsystem
+ *
+ * @returns Charge in uA.us
+ */
+uint64_t lr11xx_energy_get_charge( const lr11xx_energy_t* energy, lr11xx_energy_subsystem_t subsystem );
+
+/**
+ * @brief Get the charge accounted to all subsystems
+ *
+ * @param [in] energy Charge accounting
+ *
+ * @returns Charge in uA.us
+ */
+uint64_t lr11xx_energy_get_total_charge( const lr11xx_energy_t* energy );
+
+/**
+ * @brief Get the charge left in the budget
+ *
+ * @param [in] energy Charge accounting
+ *
+ * @returns Charge in uAh, rounded down - 0 once the budget is spent or if there is no budget
+ */
+uint32_t lr11xx_energy_get_remaining_budget_in_uah( const lr11xx_energy_t* energy );
+
+/**
+ * @brief Check whether an operation fits in the budget
+ *
+ * @param [in] energy Charge accounting
+ * @param [in] charge_in_ua_us Estimated charge of the operation, e.g. from lr11xx_energy_estimate_tx
+ *
+ * @returns true if there is no budget or if the operation fits in what is left of it
+ */
+bool lr11xx_energy_can_afford( const lr11xx_energy_t* energy, uint64_t charge_in_ua_us );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LR11XX_ENERGY_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,362 @@
+/**
+ * @file      lr11xx_gnss_almanac_stream.c
+ *
+ * @brief     Streaming almanac update from a stored image
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <string.h>
+#include "lr11xx_gnss_almanac_stream.h"
+#include "lr11xx_gnss.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#if( LR11XX_GNSS_ALMANAC_STREAM_CHUNK_NB_BLOCKS < 1 ) || ( LR11XX_GNSS_ALMANAC_STREAM_CHUNK_NB_BLOCKS > 25 )
+#error "LR11XX_GNSS_ALMANAC_STREAM_CHUNK_NB_BLOCKS must be between 1 and 25"
+#endif
+
+/**
+ * @brief Almanac update command - sent by lr11xx_gnss_almanac_update when transfers are blocking
+ */
+#define LR11XX_GNSS_ALMANAC_STREAM_UPDATE_OC ( 0x040E )
+#define LR11XX_GNSS_ALMANAC_STREAM_UPDATE_CMD_LENGTH ( 2 )
+
+/**
+ * @brief Size of a chunk buffer, in bytes
+ */
+#define LR11XX_GNSS_ALMANAC_STREAM_CHUNK_SIZE \
+    ( LR11XX_GNSS_ALMANAC_STREAM_CHUNK_NB_BLOCKS * LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE )
+
+/**
+ * @brief Offsets in the almanac image header block
+ */
+#define LR11XX_GNSS_ALMANAC_STREAM_HEADER_DATE_INDEX ( 1 )
+#define LR11XX_GNSS_ALMANAC_STREAM_HEADER_CRC_INDEX ( 3 )
+
+/**
+ * @brief Offsets in an almanac image satellite block
+ */
+#define LR11XX_GNSS_ALMANAC_STREAM_BLOCK_SV_ID_INDEX ( 0 )
+#define LR11XX_GNSS_ALMANAC_STREAM_BLOCK_DATE_INDEX ( 1 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Read a chunk of the almanac image
+ *
+ * @param [in] stream Almanac stream
+ * @param [in] first_block Index of the first block to read
+ * @param [out] chunk Buffer receiving the blocks
+ *
+ * @returns Number of blocks read, 0 if the image is over or on reader failure
+ */
+static uint8_t lr11xx_gnss_almanac_stream_read_chunk( lr11xx_gnss_almanac_stream_t* stream, uint16_t first_block,
+                                                      uint8_t* chunk );
+
+/**
+ * @brief Send the whole almanac image to the chip
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] stream Almanac stream
+ *
+ * @returns Operation status
+ */
+static lr11xx_status_t lr11xx_gnss_almanac_stream_write( const void* context, lr11xx_gnss_almanac_stream_t* stream );
+
+/**
+ * @brief Asynchronous transfer completion callback
+ *
+ * @param [in] status Transfer status
+ * @param [in] user_context Almanac stream
+ */
+static void lr11xx_gnss_almanac_stream_on_transfer_done( lr11xx_hal_status_t status, void* user_context );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void lr11xx_gnss_almanac_stream_init( lr11xx_gnss_almanac_stream_t* stream, lr11xx_gnss_almanac_stream_reader_t reader,
+                                      void* reader_context )
+{
+    memset( stream, 0, sizeof( lr11xx_gnss_almanac_stream_t ) );
+
+    stream->reader                  = reader;
+    stream->reader_context          = reader_context;
+    stream->min_nb_stale_satellites = 1;
+}
+
+lr11xx_status_t lr11xx_gnss_almanac_stream_get_nb_stale_satellites( const void*                   context,
+                                                                    lr11xx_gnss_almanac_stream_t* stream,
+                                                                    uint8_t*                      nb_stale_satellites )
+{
+    uint16_t first_block = 1;
+
+    *nb_stale_satellites = 0;
+
+    while( first_block < LR11XX_GNSS_ALMANAC_STREAM_NB_BLOCKS )
+    {
+        const uint8_t nb_blocks = lr11xx_gnss_almanac_stream_read_chunk( stream, first_block, stream->chunks[0] );
+
+        if( nb_blocks == 0 )
+        {
+            return LR11XX_STATUS_ERROR;
+        }
+
+        for( uint8_t index = 0; index < nb_blocks; index++ )
+        {
+            const uint8_t* block = &stream->chunks[0][index * LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE];
+            const uint16_t image_date =
+                ( uint16_t ) ( block[LR11XX_GNSS_ALMANAC_STREAM_BLOCK_DATE_INDEX] |
+                               ( block[LR11XX_GNSS_ALMANAC_STREAM_BLOCK_DATE_INDEX + 1] << 8 ) );
+            uint16_t chip_date = 0;
+
+            const lr11xx_status_t status = lr11xx_gnss_get_almanac_age_for_satellite(
+                context, block[LR11XX_GNSS_ALMANAC_STREAM_BLOCK_SV_ID_INDEX], &chip_date );
+
+            if( status != LR11XX_STATUS_OK )
+            {
+                return status;
+            }
+
+            // A satellite is only worth updating if the image brings a newer almanac
+            if( ( image_date > chip_date ) &&
+                ( lr11xx_gnss_compute_almanac_age( chip_date, stream->nb_days_between_epoch_and_rollover,
+                                                   stream->nb_days_since_epoch ) >= stream->max_age_in_days ) )
+            {
+                ( *nb_stale_satellites )++;
+            }
+        }
+
+        first_block += nb_blocks;
+    }
+
+    return LR11XX_STATUS_OK;
+}
+
+lr11xx_status_t lr11xx_gnss_almanac_stream_update( const void* context, lr11xx_gnss_almanac_stream_t* stream,
+                                                   lr11xx_gnss_almanac_stream_outcome_t* outcome )
+{
+    lr11xx_gnss_context_status_bytestream_t context_status_buffer;
+    lr11xx_gnss_context_status_t            context_status;
+    uint32_t                                image_crc;
+    lr11xx_status_t                         status;
+
+    if( lr11xx_gnss_almanac_stream_read_chunk( stream, 0, stream->chunks[0] ) == 0 )
+    {
+        return LR11XX_STATUS_ERROR;
+    }
+
+    image_crc = ( ( uint32_t ) stream->chunks[0][LR11XX_GNSS_ALMANAC_STREAM_HEADER_CRC_INDEX] << 0 ) +
+                ( ( uint32_t ) stream->chunks[0][LR11XX_GNSS_ALMANAC_STREAM_HEADER_CRC_INDEX + 1] << 8 ) +
+                ( ( uint32_t ) stream->chunks[0][LR11XX_GNSS_ALMANAC_STREAM_HEADER_CRC_INDEX + 2] << 16 ) +
+                ( ( uint32_t ) stream->chunks[0][LR11XX_GNSS_ALMANAC_STREAM_HEADER_CRC_INDEX + 3] << 24 );
+
+    status = lr11xx_gnss_get_context_status( context, context_status_buffer );
+    if( status != LR11XX_STATUS_OK )
+    {
+        return status;
+    }
+
+    status = lr11xx_gnss_parse_context_status_buffer( context_status_buffer, &context_status );
+    if( status != LR11XX_STATUS_OK )
+    {
+        return status;
+    }
+
+    if( context_status.global_almanac_crc == image_crc )
+    {
+        *outcome = LR11XX_GNSS_ALMANAC_STREAM_UP_TO_DATE;
+        return LR11XX_STATUS_OK;
+    }
+
+    if( stream->max_age_in_days != 0 )
+    {
+        uint8_t nb_stale_satellites = 0;
+
+        status = lr11xx_gnss_almanac_stream_get_nb_stale_satellites( context, stream, &nb_stale_satellites );
+        if( status != LR11XX_STATUS_OK )
+        {
+            return status;
+        }
+
+        if( nb_stale_satellites < stream->min_nb_stale_satellites )
+        {
+            *outcome = LR11XX_GNSS_ALMANAC_STREAM_NOT_STALE;
+            return LR11XX_STATUS_OK;
+        }
+    }
+
+    status = lr11xx_gnss_almanac_stream_write( context, stream );
+    if( status == LR11XX_STATUS_OK )
+    {
+        *outcome = LR11XX_GNSS_ALMANAC_STREAM_UPDATED;
+    }
+
+    return status;
+}
+
+bool lr11xx_gnss_almanac_stream_read_from_memory( void* user_context, uint16_t first_block, uint8_t nb_blocks,
+                                                  uint8_t* blocks )
+{
+    const uint8_t* image = ( const uint8_t* ) user_context;
+
+    memcpy( blocks, &image[first_block * LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE],
+            nb_blocks * LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE );
+
+    return true;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static uint8_t lr11xx_gnss_almanac_stream_read_chunk( lr11xx_gnss_almanac_stream_t* stream, uint16_t first_block,
+                                                      uint8_t* chunk )
+{
+    uint8_t nb_blocks = LR11XX_GNSS_ALMANAC_STREAM_CHUNK_NB_BLOCKS;
+
+    if( first_block >= LR11XX_GNSS_ALMANAC_STREAM_NB_BLOCKS )
+    {
+        return 0;
+    }
+
+    if( ( LR11XX_GNSS_ALMANAC_STREAM_NB_BLOCKS - first_block ) < nb_blocks )
+    {
+        nb_blocks = ( uint8_t ) ( LR11XX_GNSS_ALMANAC_STREAM_NB_BLOCKS - first_block );
+    }
+
+    if( stream->reader( stream->reader_context, first_block, nb_blocks, chunk ) == false )
+    {
+        return 0;
+    }
+
+    return nb_blocks;
+}
+
+static lr11xx_status_t lr11xx_gnss_almanac_stream_write( const void* context, lr11xx_gnss_almanac_stream_t* stream )
+{
+    uint16_t first_block = 0;
+    uint8_t  chunk_index = 0;
+    uint8_t  nb_blocks   = lr11xx_gnss_almanac_stream_read_chunk( stream, 0, stream->chunks[0] );
+
+    while( first_block < LR11XX_GNSS_ALMANAC_STREAM_NB_BLOCKS )
+    {
+        const uint8_t* chunk = stream->chunks[chunk_index];
+
+        if( nb_blocks == 0 )
+        {
+            return LR11XX_STATUS_ERROR;
+        }
+
+        first_block += nb_blocks;
+        chunk_index ^= 1;
+
+        if( stream->write_async != NULL )
+        {
+            const uint8_t cbuffer[LR11XX_GNSS_ALMANAC_STREAM_UPDATE_CMD_LENGTH] = {
+                ( uint8_t ) ( LR11XX_GNSS_ALMANAC_STREAM_UPDATE_OC >> 8 ),
+                ( uint8_t ) ( LR11XX_GNSS_ALMANAC_STREAM_UPDATE_OC >> 0 ),
+            };
+
+            stream->is_transfer_ongoing = true;
+
+            if( stream->write_async( context, cbuffer, LR11XX_GNSS_ALMANAC_STREAM_UPDATE_CMD_LENGTH, chunk,
+                                     nb_blocks * LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE,
+                                     lr11xx_gnss_almanac_stream_on_transfer_done, stream ) != LR11XX_HAL_STATUS_OK )
+            {
+                stream->is_transfer_ongoing = false;
+                return LR11XX_STATUS_ERROR;
+            }
+
+            // Read the next chunk from the image while the current one is clocked out
+            nb_blocks = lr11xx_gnss_almanac_stream_read_chunk( stream, first_block, stream->chunks[chunk_index] );
+
+            while( stream->is_transfer_ongoing == true )
+            {
+            }
+
+            if( stream->transfer_status != LR11XX_HAL_STATUS_OK )
+            {
+                return LR11XX_STATUS_ERROR;
+            }
+        }
+        else
+        {
+            const lr11xx_status_t status = lr11xx_gnss_almanac_update( context, chunk, nb_blocks );
+
+            if( status != LR11XX_STATUS_OK )
+            {
+                return status;
+            }
+
+            nb_blocks = lr11xx_gnss_almanac_stream_read_chunk( stream, first_block, stream->chunks[chunk_index] );
+        }
+    }
+
+    return LR11XX_STATUS_OK;
+}
+
+static void lr11xx_gnss_almanac_stream_on_transfer_done( lr11xx_hal_status_t status, void* user_context )
+{
+    lr11xx_gnss_almanac_stream_t* stream = ( lr11xx_gnss_almanac_stream_t* ) user_context;
+
+    stream->transfer_status     = status;
+    stream->is_transfer_ongoing = false;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
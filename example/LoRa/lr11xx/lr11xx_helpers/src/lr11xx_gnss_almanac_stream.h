@@ -0,0 +1,207 @@
+/**
+ * @file      lr11xx_gnss_almanac_stream.h
+ *
+ * @brief     Streaming almanac update from a stored image
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LR11XX_GNSS_ALMANAC_STREAM_H
+#define LR11XX_GNSS_ALMANAC_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lr11xx_gnss_types.h"
+#include "lr11xx_hal_async.h"
+#include "lr11xx_types.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Number of blocks of a full almanac image: one header block followed by one block per satellite
+ */
+#define LR11XX_GNSS_ALMANAC_STREAM_NB_BLOCKS ( LR11XX_GNSS_FULL_UPDATE_N_ALMANACS + 1 )
+
+/**
+ * @brief Number of almanac blocks read from the image and sent to the chip at once
+ *
+ * Two buffers of this many blocks are held by @ref lr11xx_gnss_almanac_stream_t. It must not exceed the 25 blocks
+ * fitting in a single almanac update command.
+ */
+#ifndef LR11XX_GNSS_ALMANAC_STREAM_CHUNK_NB_BLOCKS
+#define LR11XX_GNSS_ALMANAC_STREAM_CHUNK_NB_BLOCKS ( 8 )
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Almanac image reader
+ *
+ * Copies nb_blocks consecutive LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE-byte blocks of the almanac image, starting at
+ * block first_block - block 0 being the header block.
+ *
+ * @param [in] user_context Context given to lr11xx_gnss_almanac_stream_init
+ * @param [in] first_block Index of the first block to read
+ * @param [in] nb_blocks Number of blocks to read
+ * @param [out] blocks Buffer receiving the blocks
+ *
+ * @returns true on success
+ */
+typedef bool ( *lr11xx_gnss_almanac_stream_reader_t )( void* user_context, uint16_t first_block, uint8_t nb_blocks,
+                                                       uint8_t* blocks );
+
+/**
+ * @brief Non-blocking radio write, with the prototype of lr11xx_hal_write_async
+ *
+ * The application gives lr11xx_hal_write_async here when its HAL implements it - this module does not reference the
+ * optional HAL function itself.
+ */
+typedef lr11xx_hal_status_t ( *lr11xx_gnss_almanac_stream_write_async_t )(
+    const void* context, const uint8_t* command, const uint16_t command_length, const uint8_t* data,
+    const uint16_t data_length, lr11xx_hal_callback_t callback, void* user_context );
+
+/**
+ * @brief Outcome of an almanac update
+ */
+typedef enum lr11xx_gnss_almanac_stream_outcome_e
+{
+    LR11XX_GNSS_ALMANAC_STREAM_UP_TO_DATE = 0x00,  //!< The chip already holds the image (same global CRC)
+    LR11XX_GNSS_ALMANAC_STREAM_NOT_STALE  = 0x01,  //!< The image differs but too few satellites of the chip are stale
+    LR11XX_GNSS_ALMANAC_STREAM_UPDATED    = 0x02,  //!< The image has been written to the chip
+} lr11xx_gnss_almanac_stream_outcome_t;
+
+/**
+ * @brief Almanac stream
+ *
+ * The staleness check is enabled by setting max_age_in_days, nb_days_since_epoch and
+ * nb_days_between_epoch_and_rollover - leaving max_age_in_days at 0 updates the chip as soon as the global CRC differs.
+ */
+typedef struct lr11xx_gnss_almanac_stream_s
+{
+    lr11xx_gnss_almanac_stream_reader_t      reader;                   //!< Almanac image reader
+    void*                                    reader_context;           //!< Context given back to reader
+    lr11xx_gnss_almanac_stream_write_async_t write_async;              //!< Optional - overlaps reads and SPI transfers
+    uint16_t                                 max_age_in_days;          //!< Stale age - 0 disables the check
+    uint16_t                                 nb_days_since_epoch;      //!< Today, in days since January 6th 1980
+    uint16_t                                 nb_days_between_epoch_and_rollover;  //!< Days from Epoch to GPS rollover
+    uint8_t                                  min_nb_stale_satellites;  //!< Stale satellites needed to update the chip
+    uint8_t chunks[2][LR11XX_GNSS_ALMANAC_STREAM_CHUNK_NB_BLOCKS * LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE];  //!< Chunks
+    volatile bool                is_transfer_ongoing;  //!< Set while an asynchronous transfer is ongoing
+    volatile lr11xx_hal_status_t transfer_status;      //!< Status of the last asynchronous transfer
+} lr11xx_gnss_almanac_stream_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Initialise an almanac stream
+ *
+ * The staleness check is disabled, a single stale satellite triggers an update once enabled, and transfers are
+ * blocking - write_async being NULL.
+ *
+ * @param [out] stream Almanac stream
+ * @param [in] reader Almanac image reader
+ * @param [in] reader_context Context given back to reader
+ */
+void lr11xx_gnss_almanac_stream_init( lr11xx_gnss_almanac_stream_t* stream, lr11xx_gnss_almanac_stream_reader_t reader,
+                                      void* reader_context );
+
+/**
+ * @brief Count the satellites whose almanac in the chip is stale and newer in the image
+ *
+ * The image is read chunk by chunk - the whole almanac is never held in RAM.
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] stream Almanac stream, with the staleness check enabled
+ * @param [out] nb_stale_satellites Number of stale satellites
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_gnss_almanac_stream_get_nb_stale_satellites( const void*                   context,
+                                                                    lr11xx_gnss_almanac_stream_t* stream,
+                                                                    uint8_t*                      nb_stale_satellites );
+
+/**
+ * @brief Update the almanac of the chip from the image, if needed
+ *
+ * The chip is left untouched if its global almanac CRC matches the image header, or - staleness check enabled - if
+ * fewer than min_nb_stale_satellites satellites are stale. Otherwise the image is streamed chunk by chunk. The chip
+ * only accepts a complete image written in a row, so the satellites are never updated individually.
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] stream Almanac stream
+ * @param [out] outcome What has been done
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_gnss_almanac_stream_update( const void* context, lr11xx_gnss_almanac_stream_t* stream,
+                                                   lr11xx_gnss_almanac_stream_outcome_t* outcome );
+
+/**
+ * @brief Almanac image reader for memory-mapped images - e.g. stored in the MCU internal flash
+ *
+ * @param [in] user_context Address of the first byte of the image
+ * @param [in] first_block Index of the first block to read
+ * @param [in] nb_blocks Number of blocks to read
+ * @param [out] blocks Buffer receiving the blocks
+ *
+ * @returns Always true
+ */
+bool lr11xx_gnss_almanac_stream_read_from_memory( void* user_context, uint16_t first_block, uint8_t nb_blocks,
+                                                  uint8_t* blocks );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LR11XX_GNSS_ALMANAC_STREAM_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,329 @@
+/**
+ * @file      lr11xx_gnss_nav_batch.c
+ *
+ * @brief     Batching and compact uplink encoding of GNSS NAV messages
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <string.h>
+#include "lr11xx_gnss_nav_batch.h"
+#include "lr11xx_gnss.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#if( LR11XX_GNSS_NAV_BATCH_MAX_NAV_LENGTH > 255 )
+#error "LR11XX_GNSS_NAV_BATCH_MAX_NAV_LENGTH must be 255 at most"
+#endif
+
+#if( LR11XX_GNSS_NAV_BATCH_MAX_SCANS > 255 )
+#error "LR11XX_GNSS_NAV_BATCH_MAX_SCANS must be 255 at most"
+#endif
+
+/**
+ * @brief Largest LEB128 encoding of a 32-bit value, in bytes
+ */
+#define LR11XX_GNSS_NAV_BATCH_VARINT_MAX_SIZE ( 5 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Get the size of the LEB128 encoding of a value
+ *
+ * @param [in] value Value
+ *
+ * @returns Size, in bytes
+ */
+static uint8_t lr11xx_gnss_nav_batch_get_varint_size( uint32_t value );
+
+/**
+ * @brief LEB128-encode a value
+ *
+ * @param [in] value Value
+ * @param [out] buffer Buffer receiving the encoding
+ *
+ * @returns Size of the encoding, in bytes
+ */
+static uint8_t lr11xx_gnss_nav_batch_write_varint( uint32_t value, uint8_t* buffer );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void lr11xx_gnss_nav_batch_init( lr11xx_gnss_nav_batch_t* batch )
+{
+    memset( batch, 0, sizeof( lr11xx_gnss_nav_batch_t ) );
+}
+
+lr11xx_status_t lr11xx_gnss_nav_batch_add_result( lr11xx_gnss_nav_batch_t* batch, uint32_t timestamp_in_s,
+                                                  const uint8_t* result_buffer, uint16_t result_buffer_size,
+                                                  lr11xx_gnss_timings_t            timings,
+                                                  lr11xx_system_reg_mode_t         regulator,
+                                                  lr11xx_gnss_constellation_mask_t constellations_used )
+{
+    lr11xx_gnss_destination_t     destination;
+    lr11xx_gnss_nav_batch_scan_t* scan;
+
+    if( ( lr11xx_gnss_get_result_destination( result_buffer, result_buffer_size, &destination ) != LR11XX_STATUS_OK ) ||
+        ( destination != LR11XX_GNSS_DESTINATION_SOLVER ) ||
+        ( result_buffer_size > ( LR11XX_GNSS_NAV_BATCH_MAX_NAV_LENGTH + 1 ) ) )
+    {
+        return LR11XX_STATUS_ERROR;
+    }
+
+    if( ( batch->nb_scans >= LR11XX_GNSS_NAV_BATCH_MAX_SCANS ) ||
+        ( ( batch->nb_scans != 0 ) && ( timestamp_in_s < batch->scans[batch->nb_scans - 1].timestamp_in_s ) ) )
+    {
+        return LR11XX_STATUS_ERROR;
+    }
+
+    scan                     = &batch->scans[batch->nb_scans++];
+    scan->timestamp_in_s     = timestamp_in_s;
+    scan->timings            = timings;
+    scan->consumption_in_uah = lr11xx_gnss_get_consumption( regulator, timings, constellations_used );
+    scan->nav_length         = ( uint8_t ) ( result_buffer_size - 1 );
+    memcpy( scan->nav, &result_buffer[1], scan->nav_length );
+
+    batch->total_radio_ms += timings.radio_ms;
+    batch->total_computation_ms += timings.computation_ms;
+    batch->total_consumption_in_uah += scan->consumption_in_uah;
+
+    return LR11XX_STATUS_OK;
+}
+
+lr11xx_status_t lr11xx_gnss_nav_batch_add_last_scan( const void* context, lr11xx_gnss_nav_batch_t* batch,
+                                                     uint32_t timestamp_in_s, lr11xx_system_reg_mode_t regulator,
+                                                     lr11xx_gnss_constellation_mask_t constellations_used )
+{
+    uint8_t               result_buffer[LR11XX_GNSS_NAV_BATCH_MAX_NAV_LENGTH + 1];
+    uint16_t              result_size = 0;
+    lr11xx_gnss_timings_t timings;
+    lr11xx_status_t       status;
+
+    status = lr11xx_gnss_get_result_size( context, &result_size );
+    if( status != LR11XX_STATUS_OK )
+    {
+        return status;
+    }
+
+    if( ( result_size == 0 ) || ( result_size > sizeof( result_buffer ) ) )
+    {
+        return LR11XX_STATUS_ERROR;
+    }
+
+    status = lr11xx_gnss_read_results( context, result_buffer, result_size );
+    if( status != LR11XX_STATUS_OK )
+    {
+        return status;
+    }
+
+    status = lr11xx_gnss_get_timings( context, &timings );
+    if( status != LR11XX_STATUS_OK )
+    {
+        return status;
+    }
+
+    return lr11xx_gnss_nav_batch_add_result( batch, timestamp_in_s, result_buffer, result_size, timings, regulator,
+                                             constellations_used );
+}
+
+uint8_t lr11xx_gnss_nav_batch_encode( const lr11xx_gnss_nav_batch_t* batch, uint8_t first_scan, uint8_t* payload,
+                                      uint8_t max_payload_length, uint8_t* nb_scans_encoded )
+{
+    uint16_t length = LR11XX_GNSS_NAV_BATCH_HEADER_SIZE;
+
+    *nb_scans_encoded = 0;
+
+    if( ( first_scan >= batch->nb_scans ) || ( max_payload_length < LR11XX_GNSS_NAV_BATCH_HEADER_SIZE ) )
+    {
+        return 0;
+    }
+
+    for( uint8_t index = first_scan; index < batch->nb_scans; index++ )
+    {
+        const lr11xx_gnss_nav_batch_scan_t* scan       = &batch->scans[index];
+        uint32_t                            delta      = 0;
+        uint8_t                             delta_size = 0;
+
+        if( index != first_scan )
+        {
+            delta      = scan->timestamp_in_s - batch->scans[index - 1].timestamp_in_s;
+            delta_size = lr11xx_gnss_nav_batch_get_varint_size( delta );
+        }
+
+        if( ( length + delta_size + 1 + scan->nav_length ) > max_payload_length )
+        {
+            break;
+        }
+
+        if( delta_size != 0 )
+        {
+            length += lr11xx_gnss_nav_batch_write_varint( delta, &payload[length] );
+        }
+        payload[length++] = scan->nav_length;
+        memcpy( &payload[length], scan->nav, scan->nav_length );
+        length += scan->nav_length;
+
+        ( *nb_scans_encoded )++;
+    }
+
+    if( *nb_scans_encoded == 0 )
+    {
+        return 0;
+    }
+
+    payload[0] = *nb_scans_encoded;
+    payload[1] = ( uint8_t ) ( batch->scans[first_scan].timestamp_in_s >> 0 );
+    payload[2] = ( uint8_t ) ( batch->scans[first_scan].timestamp_in_s >> 8 );
+    payload[3] = ( uint8_t ) ( batch->scans[first_scan].timestamp_in_s >> 16 );
+    payload[4] = ( uint8_t ) ( batch->scans[first_scan].timestamp_in_s >> 24 );
+
+    return ( uint8_t ) length;
+}
+
+lr11xx_status_t lr11xx_gnss_nav_batch_decode( const uint8_t* payload, uint8_t payload_length,
+                                              lr11xx_gnss_nav_batch_decoded_scan_t* scans, uint8_t max_nb_scans,
+                                              uint8_t* nb_scans )
+{
+    uint16_t index = LR11XX_GNSS_NAV_BATCH_HEADER_SIZE;
+    uint32_t timestamp_in_s;
+
+    *nb_scans = 0;
+
+    if( ( payload_length < LR11XX_GNSS_NAV_BATCH_HEADER_SIZE ) || ( payload[0] == 0 ) || ( payload[0] > max_nb_scans ) )
+    {
+        return LR11XX_STATUS_ERROR;
+    }
+
+    timestamp_in_s = ( ( uint32_t ) payload[1] << 0 ) + ( ( uint32_t ) payload[2] << 8 ) +
+                     ( ( uint32_t ) payload[3] << 16 ) + ( ( uint32_t ) payload[4] << 24 );
+
+    for( uint8_t scan_index = 0; scan_index < payload[0]; scan_index++ )
+    {
+        if( scan_index != 0 )
+        {
+            uint32_t delta = 0;
+            uint8_t  shift = 0;
+            uint8_t  byte;
+
+            do
+            {
+                if( ( index >= payload_length ) || ( shift >= ( 7 * LR11XX_GNSS_NAV_BATCH_VARINT_MAX_SIZE ) ) )
+                {
+                    return LR11XX_STATUS_ERROR;
+                }
+                byte = payload[index++];
+                delta |= ( uint32_t ) ( byte & 0x7F ) << shift;
+                shift += 7;
+            } while( ( byte & 0x80 ) != 0 );
+
+            timestamp_in_s += delta;
+        }
+
+        if( ( index >= payload_length ) || ( ( index + 1 + payload[index] ) > payload_length ) )
+        {
+            return LR11XX_STATUS_ERROR;
+        }
+
+        scans[scan_index].timestamp_in_s = timestamp_in_s;
+        scans[scan_index].nav_length     = payload[index];
+        scans[scan_index].nav            = &payload[index + 1];
+        index += 1 + payload[index];
+    }
+
+    if( index != payload_length )
+    {
+        return LR11XX_STATUS_ERROR;
+    }
+
+    *nb_scans = payload[0];
+
+    return LR11XX_STATUS_OK;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static uint8_t lr11xx_gnss_nav_batch_get_varint_size( uint32_t value )
+{
+    uint8_t size = 1;
+
+    while( value >= 0x80 )
+    {
+        value >>= 7;
+        size++;
+    }
+
+    return size;
+}
+
+static uint8_t lr11xx_gnss_nav_batch_write_varint( uint32_t value, uint8_t* buffer )
+{
+    uint8_t size = 0;
+
+    while( value >= 0x80 )
+    {
+        buffer[size++] = ( uint8_t ) ( value | 0x80 );
+        value >>= 7;
+    }
+    buffer[size++] = ( uint8_t ) value;
+
+    return size;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,211 @@
+/**
+ * @file      lr11xx_gnss_nav_batch.h
+ *
+ * @brief     Batching and compact uplink encoding of GNSS NAV messages
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LR11XX_GNSS_NAV_BATCH_H
+#define LR11XX_GNSS_NAV_BATCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lr11xx_gnss_types.h"
+#include "lr11xx_system_types.h"
+#include "lr11xx_types.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Number of scans the batch can hold
+ */
+#ifndef LR11XX_GNSS_NAV_BATCH_MAX_SCANS
+#define LR11XX_GNSS_NAV_BATCH_MAX_SCANS ( 4 )
+#endif
+
+/**
+ * @brief Largest NAV message the batch accepts, in bytes - at most 255
+ */
+#ifndef LR11XX_GNSS_NAV_BATCH_MAX_NAV_LENGTH
+#define LR11XX_GNSS_NAV_BATCH_MAX_NAV_LENGTH ( 64 )
+#endif
+
+/**
+ * @brief Size of the uplink header: number of scans on one byte, then the timestamp of the first scan
+ */
+#define LR11XX_GNSS_NAV_BATCH_HEADER_SIZE ( 1 + 4 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief GNSS scan held by the batch
+ */
+typedef struct lr11xx_gnss_nav_batch_scan_s
+{
+    uint32_t              timestamp_in_s;                            //!< Scan time, e.g. GPS time in seconds
+    lr11xx_gnss_timings_t timings;                                   //!< Time spent by the chip on the scan
+    uint32_t              consumption_in_uah;                        //!< Charge drawn by the scan
+    uint8_t               nav_length;                                //!< NAV message length, in bytes
+    uint8_t               nav[LR11XX_GNSS_NAV_BATCH_MAX_NAV_LENGTH];  //!< NAV message, without the destination byte
+} lr11xx_gnss_nav_batch_scan_t;
+
+/**
+ * @brief Batch of GNSS scans
+ */
+typedef struct lr11xx_gnss_nav_batch_s
+{
+    lr11xx_gnss_nav_batch_scan_t scans[LR11XX_GNSS_NAV_BATCH_MAX_SCANS];
+    uint8_t                      nb_scans;                  //!< Number of scans held
+    uint32_t                     total_radio_ms;            //!< Acquisition time of the scans held
+    uint32_t                     total_computation_ms;      //!< Computation time of the scans held
+    uint32_t                     total_consumption_in_uah;  //!< Charge drawn by the scans held
+} lr11xx_gnss_nav_batch_t;
+
+/**
+ * @brief Scan decoded from an uplink payload
+ */
+typedef struct lr11xx_gnss_nav_batch_decoded_scan_s
+{
+    uint32_t       timestamp_in_s;  //!< Scan time
+    const uint8_t* nav;             //!< NAV message, pointing into the payload
+    uint8_t        nav_length;      //!< NAV message length, in bytes
+} lr11xx_gnss_nav_batch_decoded_scan_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Initialise - or empty - a batch
+ *
+ * @param [out] batch Batch
+ */
+void lr11xx_gnss_nav_batch_init( lr11xx_gnss_nav_batch_t* batch );
+
+/**
+ * @brief Add a scan result to a batch
+ *
+ * Only results destined to the solver - i.e. NAV messages - are accepted, and the timestamps must not decrease.
+ *
+ * @param [in] batch Batch
+ * @param [in] timestamp_in_s Scan time
+ * @param [in] result_buffer Result as read by lr11xx_gnss_read_results
+ * @param [in] result_buffer_size Result size, in bytes
+ * @param [in] timings Timings of the scan as given by lr11xx_gnss_get_timings
+ * @param [in] regulator Regulator used during the scan
+ * @param [in] constellations_used Constellations scanned
+ *
+ * @returns Operation status - LR11XX_STATUS_ERROR if the result is rejected or the batch is full
+ */
+lr11xx_status_t lr11xx_gnss_nav_batch_add_result( lr11xx_gnss_nav_batch_t* batch, uint32_t timestamp_in_s,
+                                                  const uint8_t* result_buffer, uint16_t result_buffer_size,
+                                                  lr11xx_gnss_timings_t            timings,
+                                                  lr11xx_system_reg_mode_t         regulator,
+                                                  lr11xx_gnss_constellation_mask_t constellations_used );
+
+/**
+ * @brief Read the result and the timings of the last scan from the chip, and add them to a batch
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] batch Batch
+ * @param [in] timestamp_in_s Scan time
+ * @param [in] regulator Regulator used during the scan
+ * @param [in] constellations_used Constellations scanned
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_gnss_nav_batch_add_last_scan( const void* context, lr11xx_gnss_nav_batch_t* batch,
+                                                     uint32_t timestamp_in_s, lr11xx_system_reg_mode_t regulator,
+                                                     lr11xx_gnss_constellation_mask_t constellations_used );
+
+/**
+ * @brief Encode consecutive scans of a batch into an uplink payload
+ *
+ * The payload starts with the number of scans and the timestamp of the first one, little endian. Each scan follows
+ * as its time since the previous scan - a LEB128 varint, absent for the first scan - its NAV length on one byte and
+ * its NAV message. Every payload can be decoded on its own.
+ *
+ * Scans are taken in order, as many as fit: calling it again from first_scan + nb_scans_encoded until all scans are
+ * encoded gives the smallest number of uplinks.
+ *
+ * @param [in] batch Batch
+ * @param [in] first_scan Index of the first scan to encode
+ * @param [out] payload Buffer receiving the payload - at least max_payload_length bytes
+ * @param [in] max_payload_length Maximum payload length, e.g. as given by lr1121_modem_get_next_tx_max_payload
+ * @param [out] nb_scans_encoded Number of scans encoded - 0 if the first one does not fit
+ *
+ * @returns Payload length, in bytes
+ */
+uint8_t lr11xx_gnss_nav_batch_encode( const lr11xx_gnss_nav_batch_t* batch, uint8_t first_scan, uint8_t* payload,
+                                      uint8_t max_payload_length, uint8_t* nb_scans_encoded );
+
+/**
+ * @brief Decode an uplink payload built by lr11xx_gnss_nav_batch_encode
+ *
+ * @param [in] payload Payload
+ * @param [in] payload_length Payload length, in bytes
+ * @param [out] scans Decoded scans - their NAV messages point into payload
+ * @param [in] max_nb_scans Number of elements of scans
+ * @param [out] nb_scans Number of scans decoded
+ *
+ * @returns Operation status - LR11XX_STATUS_ERROR if the payload is malformed or holds more than max_nb_scans scans
+ */
+lr11xx_status_t lr11xx_gnss_nav_batch_decode( const uint8_t* payload, uint8_t payload_length,
+                                              lr11xx_gnss_nav_batch_decoded_scan_t* scans, uint8_t max_nb_scans,
+                                              uint8_t* nb_scans );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LR11XX_GNSS_NAV_BATCH_H
+
+/* --- EOF ------------------------------------------------------------------ */
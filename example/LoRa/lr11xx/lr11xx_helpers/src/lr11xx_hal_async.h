@@ -0,0 +1,131 @@
+/*!
+ * @file      lr11xx_hal_async.h
+ *
+ * @brief     Optional non-blocking extension of the LR11XX HAL interface
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LR11XX_HAL_ASYNC_H
+#define LR11XX_HAL_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lr11xx_hal.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * @brief LR11XX HAL asynchronous operation completion callback
+ *
+ * @param [in] status       Operation status
+ * @param [in] user_context Context given when the operation was started
+ */
+typedef void ( *lr11xx_hal_callback_t )( lr11xx_hal_status_t status, void* user_context );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * @brief Radio data transfer - non-blocking write
+ *
+ * @remark Same bus sequence as @ref lr11xx_hal_write, but the function returns as soon as the transfer is scheduled.
+ * The command is copied by the implementation while \p data must remain valid until \p callback is called.
+ *
+ * @remark Optional - the driver only relies on the blocking functions of lr11xx_hal.h. A blocking call issued while a
+ * non-blocking transfer is ongoing waits for its end.
+ *
+ * @param [in] context          Radio implementation parameters
+ * @param [in] command          Pointer to the buffer to be transmitted
+ * @param [in] command_length   Buffer size to be transmitted
+ * @param [in] data             Pointer to the buffer to be transmitted
+ * @param [in] data_length      Buffer size to be transmitted
+ * @param [in] callback         Function called from interrupt context once the transfer is over - can be NULL
+ * @param [in] user_context     Context given back to \p callback
+ *
+ * @returns Operation status - LR11XX_HAL_STATUS_ERROR if the transfer could not be scheduled
+ */
+lr11xx_hal_status_t lr11xx_hal_write_async( const void* context, const uint8_t* command, const uint16_t command_length,
+                                            const uint8_t* data, const uint16_t data_length,
+                                            lr11xx_hal_callback_t callback, void* user_context );
+
+/*!
+ * @brief Radio data transfer - non-blocking read
+ *
+ * @remark Same bus sequence as @ref lr11xx_hal_read, but the function returns as soon as the transfer is scheduled.
+ * The command is copied by the implementation while \p data must remain valid until \p callback is called.
+ *
+ * @remark Optional - the driver only relies on the blocking functions of lr11xx_hal.h. A blocking call issued while a
+ * non-blocking transfer is ongoing waits for its end.
+ *
+ * @param [in] context          Radio implementation parameters
+ * @param [in] command          Pointer to the buffer to be transmitted
+ * @param [in] command_length   Buffer size to be transmitted
+ * @param [out] data            Pointer to the buffer to be received
+ * @param [in] data_length      Buffer size to be received
+ * @param [in] callback         Function called from interrupt context once the transfer is over - can be NULL
+ * @param [in] user_context     Context given back to \p callback
+ *
+ * @returns Operation status - LR11XX_HAL_STATUS_ERROR if the transfer could not be scheduled
+ */
+lr11xx_hal_status_t lr11xx_hal_read_async( const void* context, const uint8_t* command, const uint16_t command_length,
+                                           uint8_t* data, const uint16_t data_length, lr11xx_hal_callback_t callback,
+                                           void* user_context );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LR11XX_HAL_ASYNC_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,342 @@
+/*!
+ * @file      lr11xx_hal_xfer.c
+ *
+ * @brief     SPI transaction engine for LR11XX HAL implementations
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "lr11xx_hal_xfer.h"
+#include "smtc_spi_crc.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*!
+ * @brief Append a segment to a frame - zero-length segments are dropped
+ *
+ * @param [in,out] frame  Frame to be completed
+ * @param [in]     tx     Bytes to send - NULL to send NOP bytes
+ * @param [out]    rx     Buffer for the received bytes - NULL to discard them
+ * @param [in]     length Number of bytes in the segment
+ */
+static void lr11xx_hal_xfer_add_segment( lr11xx_hal_xfer_frame_t* frame, const uint8_t* tx, uint8_t* rx,
+                                         uint16_t length );
+
+/*!
+ * @brief Reset the frames of a transaction descriptor before preparing a new transaction
+ *
+ * @param [in,out] xfer           Transaction descriptor
+ * @param [in]     nb_frames      Number of frames of the new transaction
+ * @param [in]     rx_data        Buffer receiving the response data - NULL for a write transaction
+ * @param [in]     rx_data_length Size of the response data
+ */
+static void lr11xx_hal_xfer_reset_frames( lr11xx_hal_xfer_t* xfer, uint8_t nb_frames, uint8_t* rx_data,
+                                          uint16_t rx_data_length );
+
+/*!
+ * @brief Terminate a transaction and call the completion callback
+ *
+ * @param [in,out] xfer   Transaction descriptor
+ * @param [in]     status Status given to the completion callback
+ */
+static void lr11xx_hal_xfer_complete( lr11xx_hal_xfer_t* xfer, lr11xx_hal_status_t status );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void lr11xx_hal_xfer_init( lr11xx_hal_xfer_t* xfer, const lr11xx_hal_xfer_ops_t* ops, const void* context )
+{
+    memset( xfer, 0, sizeof( lr11xx_hal_xfer_t ) );
+
+    xfer->ops     = ops;
+    xfer->context = context;
+    xfer->state   = LR11XX_HAL_XFER_STATE_IDLE;
+}
+
+lr11xx_hal_status_t lr11xx_hal_xfer_prepare_write( lr11xx_hal_xfer_t* xfer, const uint8_t* command,
+                                                   uint16_t command_length, const uint8_t* data,
+                                                   uint16_t data_length )
+{
+    if( ( xfer->state != LR11XX_HAL_XFER_STATE_IDLE ) || ( command_length > LR11XX_HAL_XFER_COMMAND_LENGTH_MAX ) )
+    {
+        return LR11XX_HAL_STATUS_ERROR;
+    }
+
+    memcpy( xfer->command, command, command_length );
+
+    lr11xx_hal_xfer_reset_frames( xfer, 1, NULL, 0 );
+    lr11xx_hal_xfer_add_segment( &xfer->frames[0], xfer->command, NULL, command_length );
+    lr11xx_hal_xfer_add_segment( &xfer->frames[0], data, NULL, data_length );
+#if defined( USE_LR11XX_CRC_OVER_SPI )
+    xfer->tx_crc = smtc_spi_crc_update( SMTC_SPI_CRC_INITIAL_VALUE, command, command_length );
+    xfer->tx_crc = smtc_spi_crc_update( xfer->tx_crc, data, data_length );
+    lr11xx_hal_xfer_add_segment( &xfer->frames[0], &xfer->tx_crc, NULL, 1 );
+#endif
+
+    xfer->state = LR11XX_HAL_XFER_STATE_READY;
+
+    return LR11XX_HAL_STATUS_OK;
+}
+
+lr11xx_hal_status_t lr11xx_hal_xfer_prepare_read( lr11xx_hal_xfer_t* xfer, const uint8_t* command,
+                                                  uint16_t command_length, uint8_t* data, uint16_t data_length )
+{
+    if( ( xfer->state != LR11XX_HAL_XFER_STATE_IDLE ) || ( command_length > LR11XX_HAL_XFER_COMMAND_LENGTH_MAX ) )
+    {
+        return LR11XX_HAL_STATUS_ERROR;
+    }
+
+    memcpy( xfer->command, command, command_length );
+
+    lr11xx_hal_xfer_reset_frames( xfer, 2, data, data_length );
+    lr11xx_hal_xfer_add_segment( &xfer->frames[0], xfer->command, NULL, command_length );
+#if defined( USE_LR11XX_CRC_OVER_SPI )
+    xfer->tx_crc = smtc_spi_crc_update( SMTC_SPI_CRC_INITIAL_VALUE, command, command_length );
+    lr11xx_hal_xfer_add_segment( &xfer->frames[0], &xfer->tx_crc, NULL, 1 );
+#endif
+
+    // The response starts with a status byte, followed by the data
+    lr11xx_hal_xfer_add_segment( &xfer->frames[1], NULL, &xfer->rx_status, 1 );
+    lr11xx_hal_xfer_add_segment( &xfer->frames[1], NULL, data, data_length );
+#if defined( USE_LR11XX_CRC_OVER_SPI )
+    lr11xx_hal_xfer_add_segment( &xfer->frames[1], NULL, &xfer->rx_crc, 1 );
+#endif
+
+    xfer->state = LR11XX_HAL_XFER_STATE_READY;
+
+    return LR11XX_HAL_STATUS_OK;
+}
+
+lr11xx_hal_status_t lr11xx_hal_xfer_prepare_direct_read( lr11xx_hal_xfer_t* xfer, uint8_t* data,
+                                                         uint16_t data_length )
+{
+    if( xfer->state != LR11XX_HAL_XFER_STATE_IDLE )
+    {
+        return LR11XX_HAL_STATUS_ERROR;
+    }
+
+    lr11xx_hal_xfer_reset_frames( xfer, 1, data, data_length );
+    lr11xx_hal_xfer_add_segment( &xfer->frames[0], NULL, data, data_length );
+#if defined( USE_LR11XX_CRC_OVER_SPI )
+    lr11xx_hal_xfer_add_segment( &xfer->frames[0], NULL, &xfer->rx_crc, 1 );
+#endif
+
+    xfer->state = LR11XX_HAL_XFER_STATE_READY;
+
+    return LR11XX_HAL_STATUS_OK;
+}
+
+lr11xx_hal_status_t lr11xx_hal_xfer_check_crc( const lr11xx_hal_xfer_t* xfer )
+{
+#if defined( USE_LR11XX_CRC_OVER_SPI )
+    uint8_t crc_computed = SMTC_SPI_CRC_INITIAL_VALUE;
+
+    if( xfer->is_read == false )
+    {
+        return LR11XX_HAL_STATUS_OK;
+    }
+
+    if( xfer->nb_frames == 2 )
+    {
+        // The response CRC covers the status byte sent before the data
+        crc_computed = smtc_spi_crc_update_byte( crc_computed, xfer->rx_status );
+    }
+
+    crc_computed = smtc_spi_crc_update( crc_computed, xfer->rx_data, xfer->rx_data_length );
+
+    if( xfer->rx_crc != crc_computed )
+    {
+        return LR11XX_HAL_STATUS_ERROR;
+    }
+#else
+    ( void ) xfer;
+#endif
+
+    return LR11XX_HAL_STATUS_OK;
+}
+
+void lr11xx_hal_xfer_release( lr11xx_hal_xfer_t* xfer )
+{
+    xfer->state = LR11XX_HAL_XFER_STATE_IDLE;
+}
+
+lr11xx_hal_status_t lr11xx_hal_xfer_start( lr11xx_hal_xfer_t* xfer, lr11xx_hal_callback_t callback, void* context )
+{
+    if( ( xfer->state != LR11XX_HAL_XFER_STATE_READY ) || ( xfer->ops == NULL ) )
+    {
+        return LR11XX_HAL_STATUS_ERROR;
+    }
+
+    xfer->callback         = callback;
+    xfer->callback_context = context;
+    xfer->frame_index      = 0;
+    xfer->state            = LR11XX_HAL_XFER_STATE_WAIT_BUSY;
+
+    lr11xx_hal_xfer_process( xfer );
+
+    return LR11XX_HAL_STATUS_OK;
+}
+
+void lr11xx_hal_xfer_process( lr11xx_hal_xfer_t* xfer )
+{
+    if( xfer->state != LR11XX_HAL_XFER_STATE_WAIT_BUSY )
+    {
+        return;
+    }
+
+    if( xfer->ops->is_busy( xfer->context ) == true )
+    {
+        xfer->ops->arm_busy_irq( xfer->context );
+        return;
+    }
+
+    xfer->state = LR11XX_HAL_XFER_STATE_IN_FLIGHT;
+    xfer->ops->set_nss( xfer->context, false );
+
+    if( xfer->ops->start_frame( xfer->context, &xfer->frames[xfer->frame_index] ) != LR11XX_HAL_STATUS_OK )
+    {
+        xfer->ops->set_nss( xfer->context, true );
+        lr11xx_hal_xfer_complete( xfer, LR11XX_HAL_STATUS_ERROR );
+    }
+}
+
+void lr11xx_hal_xfer_on_frame_done( lr11xx_hal_xfer_t* xfer, lr11xx_hal_status_t status )
+{
+    if( xfer->state != LR11XX_HAL_XFER_STATE_IN_FLIGHT )
+    {
+        return;
+    }
+
+    xfer->ops->set_nss( xfer->context, true );
+
+    if( status != LR11XX_HAL_STATUS_OK )
+    {
+        lr11xx_hal_xfer_complete( xfer, status );
+        return;
+    }
+
+    xfer->frame_index++;
+
+    if( xfer->frame_index < xfer->nb_frames )
+    {
+        xfer->state = LR11XX_HAL_XFER_STATE_WAIT_BUSY;
+        lr11xx_hal_xfer_process( xfer );
+        return;
+    }
+
+    lr11xx_hal_xfer_complete( xfer, lr11xx_hal_xfer_check_crc( xfer ) );
+}
+
+bool lr11xx_hal_xfer_is_idle( const lr11xx_hal_xfer_t* xfer )
+{
+    return ( xfer->state == LR11XX_HAL_XFER_STATE_IDLE ) ? true : false;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void lr11xx_hal_xfer_add_segment( lr11xx_hal_xfer_frame_t* frame, const uint8_t* tx, uint8_t* rx,
+                                         uint16_t length )
+{
+    if( ( length == 0 ) || ( frame->nb_segments >= LR11XX_HAL_XFER_SEGMENTS_MAX ) )
+    {
+        return;
+    }
+
+    frame->segments[frame->nb_segments].tx     = tx;
+    frame->segments[frame->nb_segments].rx     = rx;
+    frame->segments[frame->nb_segments].length = length;
+    frame->nb_segments++;
+}
+
+static void lr11xx_hal_xfer_reset_frames( lr11xx_hal_xfer_t* xfer, uint8_t nb_frames, uint8_t* rx_data,
+                                          uint16_t rx_data_length )
+{
+    for( uint8_t i = 0; i < LR11XX_HAL_XFER_FRAMES_MAX; i++ )
+    {
+        xfer->frames[i].nb_segments = 0;
+    }
+
+    xfer->nb_frames      = nb_frames;
+    xfer->frame_index    = 0;
+    xfer->rx_status      = 0;
+    xfer->rx_crc         = 0;
+    xfer->is_read        = ( ( nb_frames > 1 ) || ( rx_data != NULL ) ) ? true : false;
+    xfer->rx_data        = rx_data;
+    xfer->rx_data_length = rx_data_length;
+}
+
+static void lr11xx_hal_xfer_complete( lr11xx_hal_xfer_t* xfer, lr11xx_hal_status_t status )
+{
+    lr11xx_hal_callback_t callback = xfer->callback;
+
+    xfer->callback = NULL;
+    xfer->state    = LR11XX_HAL_XFER_STATE_IDLE;
+
+    if( callback != NULL )
+    {
+        callback( status, xfer->callback_context );
+    }
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,277 @@
+/*!
+ * @file      lr11xx_hal_xfer.h
+ *
+ * @brief     SPI transaction engine for LR11XX HAL implementations
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LR11XX_HAL_XFER_H
+#define LR11XX_HAL_XFER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lr11xx_hal_async.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Maximum length of a command handled by the transaction engine
+ *
+ * @remark The command is copied in the transaction, so that the caller buffer does not have to outlive the call
+ */
+#ifndef LR11XX_HAL_XFER_COMMAND_LENGTH_MAX
+#define LR11XX_HAL_XFER_COMMAND_LENGTH_MAX ( 32 )
+#endif
+
+/**
+ * @brief Maximum number of SPI frames in a transaction
+ *
+ * @remark A read is made of a command frame and a response frame, separated by a busy wait
+ */
+#define LR11XX_HAL_XFER_FRAMES_MAX ( 2 )
+
+/**
+ * @brief Maximum number of segments in a SPI frame
+ */
+#define LR11XX_HAL_XFER_SEGMENTS_MAX ( 3 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * @brief Transaction state
+ */
+typedef enum lr11xx_hal_xfer_state_e
+{
+    LR11XX_HAL_XFER_STATE_IDLE = 0,   //!< No transaction ongoing
+    LR11XX_HAL_XFER_STATE_READY,      //!< Transaction prepared, not started yet
+    LR11XX_HAL_XFER_STATE_WAIT_BUSY,  //!< Waiting for the busy line to go low before the next frame
+    LR11XX_HAL_XFER_STATE_IN_FLIGHT,  //!< NSS asserted, frame being exchanged on the bus
+} lr11xx_hal_xfer_state_t;
+
+/*!
+ * @brief Segment of a SPI frame
+ */
+typedef struct lr11xx_hal_xfer_segment_s
+{
+    const uint8_t* tx;      //!< Bytes to send - NULL to send NOP bytes
+    uint8_t*       rx;      //!< Buffer for the received bytes - NULL to discard them
+    uint16_t       length;  //!< Number of bytes in the segment
+} lr11xx_hal_xfer_segment_t;
+
+/*!
+ * @brief SPI frame - segments exchanged back-to-back while NSS is asserted
+ */
+typedef struct lr11xx_hal_xfer_frame_s
+{
+    lr11xx_hal_xfer_segment_t segments[LR11XX_HAL_XFER_SEGMENTS_MAX];
+    uint8_t                   nb_segments;
+} lr11xx_hal_xfer_frame_t;
+
+/*!
+ * @brief Platform operations used by the transaction engine
+ *
+ * @remark start_frame is expected to return immediately and to report the end of the frame by calling
+ * @ref lr11xx_hal_xfer_on_frame_done - possibly before returning.
+ *
+ * @remark arm_busy_irq arms a one-shot notification: @ref lr11xx_hal_xfer_process is to be called once, on the next
+ * falling edge of the busy line or right away if an edge occurred since the line was sampled, then the notification is
+ * disarmed.
+ */
+typedef struct lr11xx_hal_xfer_ops_s
+{
+    bool ( *is_busy )( const void* context );
+    void ( *set_nss )( const void* context, bool is_high );
+    void ( *arm_busy_irq )( const void* context );
+    lr11xx_hal_status_t ( *start_frame )( const void* context, const lr11xx_hal_xfer_frame_t* frame );
+} lr11xx_hal_xfer_ops_t;
+
+/*!
+ * @brief Transaction descriptor
+ */
+typedef struct lr11xx_hal_xfer_s
+{
+    const lr11xx_hal_xfer_ops_t*     ops;
+    const void*                      context;
+    volatile lr11xx_hal_xfer_state_t state;
+    lr11xx_hal_xfer_frame_t          frames[LR11XX_HAL_XFER_FRAMES_MAX];
+    uint8_t                          nb_frames;
+    uint8_t                          frame_index;
+    lr11xx_hal_callback_t            callback;
+    void*                            callback_context;
+    uint8_t                          command[LR11XX_HAL_XFER_COMMAND_LENGTH_MAX];
+    uint8_t                          rx_status;
+    uint8_t                          tx_crc;
+    uint8_t                          rx_crc;
+    bool                             is_read;
+    uint8_t*                         rx_data;
+    uint16_t                         rx_data_length;
+} lr11xx_hal_xfer_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * @brief Initialise a transaction descriptor
+ *
+ * @param [out] xfer    Transaction descriptor
+ * @param [in]  ops     Platform operations - only required by @ref lr11xx_hal_xfer_start
+ * @param [in]  context Radio implementation parameters given back to \p ops
+ */
+void lr11xx_hal_xfer_init( lr11xx_hal_xfer_t* xfer, const lr11xx_hal_xfer_ops_t* ops, const void* context );
+
+/*!
+ * @brief Prepare the SPI frames of a write transaction
+ *
+ * @remark The command is copied, \p data must remain valid until the end of the transaction
+ *
+ * @param [in,out] xfer           Transaction descriptor
+ * @param [in]     command        Pointer to the buffer to be transmitted
+ * @param [in]     command_length Buffer size to be transmitted
+ * @param [in]     data           Pointer to the buffer to be transmitted
+ * @param [in]     data_length    Buffer size to be transmitted
+ *
+ * @returns Operation status - LR11XX_HAL_STATUS_ERROR if a transaction is ongoing or the command is too long
+ */
+lr11xx_hal_status_t lr11xx_hal_xfer_prepare_write( lr11xx_hal_xfer_t* xfer, const uint8_t* command,
+                                                   uint16_t command_length, const uint8_t* data,
+                                                   uint16_t data_length );
+
+/*!
+ * @brief Prepare the SPI frames of a read transaction
+ *
+ * @remark The command is copied, \p data must remain valid until the end of the transaction
+ *
+ * @param [in,out] xfer           Transaction descriptor
+ * @param [in]     command        Pointer to the buffer to be transmitted
+ * @param [in]     command_length Buffer size to be transmitted
+ * @param [out]    data           Pointer to the buffer to be received
+ * @param [in]     data_length    Buffer size to be received
+ *
+ * @returns Operation status - LR11XX_HAL_STATUS_ERROR if a transaction is ongoing or the command is too long
+ */
+lr11xx_hal_status_t lr11xx_hal_xfer_prepare_read( lr11xx_hal_xfer_t* xfer, const uint8_t* command,
+                                                  uint16_t command_length, uint8_t* data, uint16_t data_length );
+
+/*!
+ * @brief Prepare the SPI frame of a direct read transaction
+ *
+ * @param [in,out] xfer        Transaction descriptor
+ * @param [out]    data        Pointer to the buffer to be received
+ * @param [in]     data_length Buffer size to be received
+ *
+ * @returns Operation status - LR11XX_HAL_STATUS_ERROR if a transaction is ongoing
+ */
+lr11xx_hal_status_t lr11xx_hal_xfer_prepare_direct_read( lr11xx_hal_xfer_t* xfer, uint8_t* data,
+                                                         uint16_t data_length );
+
+/*!
+ * @brief Check the received CRC of a prepared transaction once all its frames are exchanged
+ *
+ * @remark Always succeeds when USE_LR11XX_CRC_OVER_SPI is not defined
+ *
+ * @param [in] xfer Transaction descriptor
+ *
+ * @returns Operation status - LR11XX_HAL_STATUS_ERROR on CRC mismatch
+ */
+lr11xx_hal_status_t lr11xx_hal_xfer_check_crc( const lr11xx_hal_xfer_t* xfer );
+
+/*!
+ * @brief Release a prepared transaction that has been executed by the caller, frame by frame
+ *
+ * @param [in,out] xfer Transaction descriptor
+ */
+void lr11xx_hal_xfer_release( lr11xx_hal_xfer_t* xfer );
+
+/*!
+ * @brief Start a prepared transaction
+ *
+ * @param [in,out] xfer     Transaction descriptor
+ * @param [in]     callback Function called once the transaction is over - can be NULL
+ * @param [in]     context  Context given back to \p callback
+ *
+ * @returns Operation status - LR11XX_HAL_STATUS_ERROR if no transaction is prepared
+ */
+lr11xx_hal_status_t lr11xx_hal_xfer_start( lr11xx_hal_xfer_t* xfer, lr11xx_hal_callback_t callback, void* context );
+
+/*!
+ * @brief Move the transaction forward if it is waiting for the busy line
+ *
+ * @remark To be called on busy line falling edge. Spurious calls are harmless.
+ *
+ * @param [in,out] xfer Transaction descriptor
+ */
+void lr11xx_hal_xfer_process( lr11xx_hal_xfer_t* xfer );
+
+/*!
+ * @brief Report the end of the frame started by lr11xx_hal_xfer_ops_t::start_frame
+ *
+ * @param [in,out] xfer   Transaction descriptor
+ * @param [in]     status Status of the frame exchange
+ */
+void lr11xx_hal_xfer_on_frame_done( lr11xx_hal_xfer_t* xfer, lr11xx_hal_status_t status );
+
+/*!
+ * @brief Check whether a transaction is prepared or ongoing
+ *
+ * @param [in] xfer Transaction descriptor
+ *
+ * @returns true if no transaction is prepared nor ongoing
+ */
+bool lr11xx_hal_xfer_is_idle( const lr11xx_hal_xfer_t* xfer );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LR11XX_HAL_XFER_H
+
+/* --- EOF ------------------------------------------------------------------ */
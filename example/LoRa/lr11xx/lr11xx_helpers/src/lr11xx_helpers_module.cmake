@@ -0,0 +1,50 @@
+# @file lr11xx_helpers_module.cmake
+#
+# @brief Defines CMake source files and include directories for this module
+#
+# --- The Clear BSD License ---
+# Copyright Semtech Corporation 2021. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted (subject to the limitations in the disclaimer
+# below) provided that the following conditions are met:
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#     * Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in the
+#       documentation and/or other materials provided with the distribution.
+#     * Neither the name of the Semtech corporation nor the
+#       names of its contributors may be used to endorse or promote products
+#       derived from this software without specific prior written permission.
+#
+# NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+# THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+# CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+# NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+# PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+set(LR11XX_HELPERS_MODULE_C_SOURCES
+  ${CMAKE_CURRENT_LIST_DIR}/lr11xx_energy.c
+  ${CMAKE_CURRENT_LIST_DIR}/lr11xx_gnss_almanac_stream.c
+  ${CMAKE_CURRENT_LIST_DIR}/lr11xx_gnss_nav_batch.c
+  ${CMAKE_CURRENT_LIST_DIR}/lr11xx_hal_xfer.c
+  ${CMAKE_CURRENT_LIST_DIR}/lr11xx_irq_dispatch.c
+  ${CMAKE_CURRENT_LIST_DIR}/lr11xx_radio_cache.c
+  ${CMAKE_CURRENT_LIST_DIR}/lr11xx_regmem_batch.c
+  ${CMAKE_CURRENT_LIST_DIR}/lr11xx_wifi_aggregator.c
+  ${CMAKE_CURRENT_LIST_DIR}/../../../../common/src/smtc_spi_crc.c
+  )
+
+# The helpers rely on the driver headers, and on the SPI CRC shared with the LoRaWAN example
+set(LR11XX_HELPERS_MODULE_C_INCLUDES
+  ${CMAKE_CURRENT_LIST_DIR}/.
+  ${CMAKE_CURRENT_LIST_DIR}/../../lr11xx_driver/src
+  ${CMAKE_CURRENT_LIST_DIR}/../../../../common/inc
+  )
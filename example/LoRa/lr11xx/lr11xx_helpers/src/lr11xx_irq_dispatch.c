@@ -0,0 +1,188 @@
+/*!
+ * @file      lr11xx_irq_dispatch.c
+ *
+ * @brief     Table-driven dispatch of the LR11XX interrupts
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "lr11xx_irq_dispatch.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#if( ( LR11XX_IRQ_DISPATCH_QUEUE_SIZE & ( LR11XX_IRQ_DISPATCH_QUEUE_SIZE - 1 ) ) != 0 ) || \
+    ( LR11XX_IRQ_DISPATCH_QUEUE_SIZE > 128 )
+#error "LR11XX_IRQ_DISPATCH_QUEUE_SIZE must be a power of two, 128 at most"
+#endif
+
+/**
+ * @brief Interrupts served first, in this order - the order the application interrupt processing always had, so that
+ * the preamble and header events of a packet are reported before its RX done
+ */
+static const lr11xx_system_irq_mask_t lr11xx_irq_dispatch_priority[] = {
+    LR11XX_SYSTEM_IRQ_TX_DONE,
+    LR11XX_SYSTEM_IRQ_PREAMBLE_DETECTED,
+    LR11XX_SYSTEM_IRQ_HEADER_ERROR,
+    LR11XX_SYSTEM_IRQ_SYNC_WORD_HEADER_VALID,
+    LR11XX_SYSTEM_IRQ_RX_DONE,
+    LR11XX_SYSTEM_IRQ_CAD_DONE,
+    LR11XX_SYSTEM_IRQ_TIMEOUT,
+    LR11XX_SYSTEM_IRQ_LORA_RX_TIMESTAMP,
+    LR11XX_SYSTEM_IRQ_WIFI_SCAN_DONE,
+    LR11XX_SYSTEM_IRQ_GNSS_SCAN_DONE,
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void lr11xx_irq_dispatch_init( lr11xx_irq_dispatch_t* dispatch ) { memset( dispatch, 0, sizeof( *dispatch ) ); }
+
+void lr11xx_irq_dispatch_register( lr11xx_irq_dispatch_t* dispatch, lr11xx_system_irq_mask_t irq_mask,
+                                   lr11xx_irq_dispatch_handler_t handler )
+{
+    while( irq_mask != 0 )
+    {
+        const uint8_t bit = ( uint8_t ) __builtin_ctz( irq_mask );
+
+        irq_mask &= irq_mask - 1;
+
+        dispatch->handlers[bit] = handler;
+        if( handler != NULL )
+        {
+            dispatch->registered |= ( lr11xx_system_irq_mask_t ) 1 << bit;
+        }
+        else
+        {
+            dispatch->registered &= ~( ( lr11xx_system_irq_mask_t ) 1 << bit );
+        }
+    }
+}
+
+bool lr11xx_irq_dispatch_push( lr11xx_irq_dispatch_t* dispatch, uint32_t timestamp_us )
+{
+    const uint8_t head = dispatch->head;
+
+    // Indexes are free running, their difference is the number of pending events
+    if( ( uint8_t ) ( head - dispatch->tail ) >= LR11XX_IRQ_DISPATCH_QUEUE_SIZE )
+    {
+        dispatch->nb_dropped++;
+        return false;
+    }
+
+    // The event must be written before the index that publishes it
+    dispatch->events[head & ( LR11XX_IRQ_DISPATCH_QUEUE_SIZE - 1 )] = timestamp_us;
+    dispatch->head                                                  = ( uint8_t ) ( head + 1 );
+
+    return true;
+}
+
+bool lr11xx_irq_dispatch_pop( lr11xx_irq_dispatch_t* dispatch, uint32_t* timestamp_us )
+{
+    const uint8_t tail = dispatch->tail;
+
+    if( tail == dispatch->head )
+    {
+        return false;
+    }
+
+    *timestamp_us  = dispatch->events[tail & ( LR11XX_IRQ_DISPATCH_QUEUE_SIZE - 1 )];
+    dispatch->tail = ( uint8_t ) ( tail + 1 );
+
+    return true;
+}
+
+lr11xx_system_irq_mask_t lr11xx_irq_dispatch_run( const lr11xx_irq_dispatch_t* dispatch, const void* context,
+                                                  lr11xx_system_irq_mask_t irq_regs, uint32_t timestamp_us )
+{
+    const lr11xx_system_irq_mask_t handled = irq_regs & dispatch->registered;
+    lr11xx_system_irq_mask_t       pending = handled;
+    const uint8_t nb_priority = sizeof( lr11xx_irq_dispatch_priority ) / sizeof( lr11xx_irq_dispatch_priority[0] );
+
+    for( uint8_t i = 0; ( i < nb_priority ) && ( pending != 0 ); i++ )
+    {
+        const lr11xx_system_irq_mask_t irq = lr11xx_irq_dispatch_priority[i];
+
+        if( ( pending & irq ) != 0 )
+        {
+            pending &= ~irq;
+            dispatch->handlers[__builtin_ctz( irq )]( context, irq_regs, timestamp_us );
+        }
+    }
+
+    // The other bits having a handler are visited lowest first, one count-trailing-zeros each
+    while( pending != 0 )
+    {
+        const uint8_t bit = ( uint8_t ) __builtin_ctz( pending );
+
+        pending &= pending - 1;
+
+        dispatch->handlers[bit]( context, irq_regs, timestamp_us );
+    }
+
+    return handled;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,170 @@
+/*!
+ * @file      lr11xx_irq_dispatch.h
+ *
+ * @brief     Table-driven dispatch of the LR11XX interrupts
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LR11XX_IRQ_DISPATCH_H
+#define LR11XX_IRQ_DISPATCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lr11xx_system_types.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Number of interrupt events that can be pending - must be a power of two, 128 at most
+ */
+#ifndef LR11XX_IRQ_DISPATCH_QUEUE_SIZE
+#define LR11XX_IRQ_DISPATCH_QUEUE_SIZE ( 8 )
+#endif
+
+/**
+ * @brief Number of interrupt bits of the LR11XX IRQ status
+ */
+#define LR11XX_IRQ_DISPATCH_NB_IRQ ( 32 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Interrupt handler
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] irq_regs Whole interrupt status the handled bit was read with, to check qualifier flags such as
+ * LR11XX_SYSTEM_IRQ_CRC_ERROR
+ * @param [in] timestamp_us Time of the interrupt edge in microseconds
+ */
+typedef void ( *lr11xx_irq_dispatch_handler_t )( const void* context, lr11xx_system_irq_mask_t irq_regs,
+                                                 uint32_t timestamp_us );
+
+/**
+ * @brief Interrupt dispatcher
+ *
+ * The event queue has a single producer - the interrupt line ISR - and a single consumer - the main loop - so that
+ * it needs no lock: each side only writes its own index.
+ */
+typedef struct lr11xx_irq_dispatch_s
+{
+    lr11xx_irq_dispatch_handler_t handlers[LR11XX_IRQ_DISPATCH_NB_IRQ];  //!< Handlers indexed by IRQ bit
+    lr11xx_system_irq_mask_t      registered;  //!< Interrupts having a handler
+    volatile uint32_t             events[LR11XX_IRQ_DISPATCH_QUEUE_SIZE];  //!< Timestamps of the pending events
+    volatile uint8_t              head;        //!< Next event to write - only written by the producer
+    volatile uint8_t              tail;        //!< Next event to read - only written by the consumer
+    volatile uint32_t             nb_dropped;  //!< Events lost because the queue was full
+} lr11xx_irq_dispatch_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Unregister all the handlers and flush the event queue
+ *
+ * @param [out] dispatch Dispatcher
+ */
+void lr11xx_irq_dispatch_init( lr11xx_irq_dispatch_t* dispatch );
+
+/**
+ * @brief Register a handler for one or several interrupts
+ *
+ * @param [in,out] dispatch Dispatcher
+ * @param [in] irq_mask Interrupts the handler is called for
+ * @param [in] handler Handler, NULL to unregister
+ */
+void lr11xx_irq_dispatch_register( lr11xx_irq_dispatch_t* dispatch, lr11xx_system_irq_mask_t irq_mask,
+                                   lr11xx_irq_dispatch_handler_t handler );
+
+/**
+ * @brief Queue an interrupt event - to be called from the interrupt line ISR
+ *
+ * @param [in,out] dispatch Dispatcher
+ * @param [in] timestamp_us Time of the interrupt edge in microseconds
+ *
+ * @returns True if the event is queued, false if the queue is full
+ */
+bool lr11xx_irq_dispatch_push( lr11xx_irq_dispatch_t* dispatch, uint32_t timestamp_us );
+
+/**
+ * @brief Take the oldest pending interrupt event
+ *
+ * @param [in,out] dispatch Dispatcher
+ * @param [out] timestamp_us Time of the interrupt edge in microseconds
+ *
+ * @returns True if an event was pending
+ */
+bool lr11xx_irq_dispatch_pop( lr11xx_irq_dispatch_t* dispatch, uint32_t* timestamp_us );
+
+/**
+ * @brief Call the handlers of the interrupts set in an interrupt status
+ *
+ * @remark TX done, preamble detected, header error, syncword / header valid, RX done, CAD done, timeout, LoRa RX
+ * timestamp, Wi-Fi scan done and GNSS scan done are served first, in this order. The other interrupts follow, lowest
+ * bit first.
+ *
+ * @param [in] dispatch Dispatcher
+ * @param [in] context Chip implementation context given to the handlers
+ * @param [in] irq_regs Interrupt status
+ * @param [in] timestamp_us Time of the interrupt edge in microseconds
+ *
+ * @returns Interrupts a handler was called for
+ */
+lr11xx_system_irq_mask_t lr11xx_irq_dispatch_run( const lr11xx_irq_dispatch_t* dispatch, const void* context,
+                                                  lr11xx_system_irq_mask_t irq_regs, uint32_t timestamp_us );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LR11XX_IRQ_DISPATCH_H
+
+/* --- EOF ------------------------------------------------------------------ */
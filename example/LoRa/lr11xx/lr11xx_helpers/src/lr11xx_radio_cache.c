@@ -0,0 +1,392 @@
+/**
+ * @file      lr11xx_radio_cache.c
+ *
+ * @brief     Radio configuration cache dropping redundant commands
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <string.h>
+#include "lr11xx_radio_cache.h"
+#include "lr11xx_system.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Items depending on the packet type
+ */
+#define LR11XX_RADIO_CACHE_PKT_TYPE_DEPENDENT_ITEMS                                                  \
+    ( LR11XX_RADIO_CACHE_LORA_MOD_PARAMS | LR11XX_RADIO_CACHE_LORA_PKT_PARAMS |                     \
+      LR11XX_RADIO_CACHE_GFSK_MOD_PARAMS | LR11XX_RADIO_CACHE_GFSK_PKT_PARAMS |                     \
+      LR11XX_RADIO_CACHE_LORA_SYNC_WORD | LR11XX_RADIO_CACHE_GFSK_SYNC_WORD )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Check whether a command can be dropped, and count it
+ *
+ * @param [in] cache Radio configuration cache
+ * @param [in] item LR11XX_RADIO_CACHE_* item set by the command
+ * @param [in] is_same true if the command parameters match the cached ones
+ *
+ * @returns true if the chip already holds the configuration
+ */
+static bool lr11xx_radio_cache_is_hit( lr11xx_radio_cache_t* cache, uint16_t item, bool is_same );
+
+/**
+ * @brief Record the outcome of a command sent to the chip
+ *
+ * @param [in] cache Radio configuration cache
+ * @param [in] item LR11XX_RADIO_CACHE_* item set by the command
+ * @param [in] status Command status - the item is forgotten on failure
+ *
+ * @returns status
+ */
+static lr11xx_status_t lr11xx_radio_cache_update( lr11xx_radio_cache_t* cache, uint16_t item, lr11xx_status_t status );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void lr11xx_radio_cache_init( lr11xx_radio_cache_t* cache )
+{
+    memset( cache, 0, sizeof( lr11xx_radio_cache_t ) );
+}
+
+void lr11xx_radio_cache_invalidate( lr11xx_radio_cache_t* cache )
+{
+    cache->valid = 0;
+}
+
+lr11xx_status_t lr11xx_radio_cache_set_pkt_type( const void* context, lr11xx_radio_cache_t* cache,
+                                                 lr11xx_radio_pkt_type_t pkt_type )
+{
+    lr11xx_status_t status;
+
+    if( lr11xx_radio_cache_is_hit( cache, LR11XX_RADIO_CACHE_PKT_TYPE, cache->pkt_type == pkt_type ) )
+    {
+        return LR11XX_STATUS_OK;
+    }
+
+    cache->valid &= ~LR11XX_RADIO_CACHE_PKT_TYPE_DEPENDENT_ITEMS;
+
+    status = lr11xx_radio_set_pkt_type( context, pkt_type );
+    if( status == LR11XX_STATUS_OK )
+    {
+        cache->pkt_type = pkt_type;
+    }
+
+    return lr11xx_radio_cache_update( cache, LR11XX_RADIO_CACHE_PKT_TYPE, status );
+}
+
+lr11xx_status_t lr11xx_radio_cache_set_rf_freq( const void* context, lr11xx_radio_cache_t* cache,
+                                                uint32_t freq_in_hz )
+{
+    lr11xx_status_t status;
+
+    if( lr11xx_radio_cache_is_hit( cache, LR11XX_RADIO_CACHE_RF_FREQ, cache->rf_freq_in_hz == freq_in_hz ) )
+    {
+        return LR11XX_STATUS_OK;
+    }
+
+    status = lr11xx_radio_set_rf_freq( context, freq_in_hz );
+    if( status == LR11XX_STATUS_OK )
+    {
+        cache->rf_freq_in_hz = freq_in_hz;
+    }
+
+    return lr11xx_radio_cache_update( cache, LR11XX_RADIO_CACHE_RF_FREQ, status );
+}
+
+lr11xx_status_t lr11xx_radio_cache_set_lora_mod_params( const void* context, lr11xx_radio_cache_t* cache,
+                                                        const lr11xx_radio_mod_params_lora_t* mod_params )
+{
+    const lr11xx_radio_mod_params_lora_t* cached = &cache->lora_mod_params;
+    lr11xx_status_t                       status;
+
+    if( lr11xx_radio_cache_is_hit( cache, LR11XX_RADIO_CACHE_LORA_MOD_PARAMS,
+                                   ( cached->sf == mod_params->sf ) && ( cached->bw == mod_params->bw ) &&
+                                       ( cached->cr == mod_params->cr ) && ( cached->ldro == mod_params->ldro ) ) )
+    {
+        return LR11XX_STATUS_OK;
+    }
+
+    status = lr11xx_radio_set_lora_mod_params( context, mod_params );
+    if( status == LR11XX_STATUS_OK )
+    {
+        cache->lora_mod_params = *mod_params;
+    }
+
+    return lr11xx_radio_cache_update( cache, LR11XX_RADIO_CACHE_LORA_MOD_PARAMS, status );
+}
+
+lr11xx_status_t lr11xx_radio_cache_set_lora_pkt_params( const void* context, lr11xx_radio_cache_t* cache,
+                                                        const lr11xx_radio_pkt_params_lora_t* pkt_params )
+{
+    const lr11xx_radio_pkt_params_lora_t* cached = &cache->lora_pkt_params;
+    lr11xx_status_t                       status;
+
+    if( lr11xx_radio_cache_is_hit( cache, LR11XX_RADIO_CACHE_LORA_PKT_PARAMS,
+                                   ( cached->preamble_len_in_symb == pkt_params->preamble_len_in_symb ) &&
+                                       ( cached->header_type == pkt_params->header_type ) &&
+                                       ( cached->pld_len_in_bytes == pkt_params->pld_len_in_bytes ) &&
+                                       ( cached->crc == pkt_params->crc ) && ( cached->iq == pkt_params->iq ) ) )
+    {
+        return LR11XX_STATUS_OK;
+    }
+
+    status = lr11xx_radio_set_lora_pkt_params( context, pkt_params );
+    if( status == LR11XX_STATUS_OK )
+    {
+        cache->lora_pkt_params = *pkt_params;
+    }
+
+    return lr11xx_radio_cache_update( cache, LR11XX_RADIO_CACHE_LORA_PKT_PARAMS, status );
+}
+
+lr11xx_status_t lr11xx_radio_cache_set_gfsk_mod_params( const void* context, lr11xx_radio_cache_t* cache,
+                                                        const lr11xx_radio_mod_params_gfsk_t* mod_params )
+{
+    const lr11xx_radio_mod_params_gfsk_t* cached = &cache->gfsk_mod_params;
+    lr11xx_status_t                       status;
+
+    if( lr11xx_radio_cache_is_hit( cache, LR11XX_RADIO_CACHE_GFSK_MOD_PARAMS,
+                                   ( cached->br_in_bps == mod_params->br_in_bps ) &&
+                                       ( cached->pulse_shape == mod_params->pulse_shape ) &&
+                                       ( cached->bw_dsb_param == mod_params->bw_dsb_param ) &&
+                                       ( cached->fdev_in_hz == mod_params->fdev_in_hz ) ) )
+    {
+        return LR11XX_STATUS_OK;
+    }
+
+    status = lr11xx_radio_set_gfsk_mod_params( context, mod_params );
+    if( status == LR11XX_STATUS_OK )
+    {
+        cache->gfsk_mod_params = *mod_params;
+    }
+
+    return lr11xx_radio_cache_update( cache, LR11XX_RADIO_CACHE_GFSK_MOD_PARAMS, status );
+}
+
+lr11xx_status_t lr11xx_radio_cache_set_gfsk_pkt_params( const void* context, lr11xx_radio_cache_t* cache,
+                                                        const lr11xx_radio_pkt_params_gfsk_t* pkt_params )
+{
+    const lr11xx_radio_pkt_params_gfsk_t* cached = &cache->gfsk_pkt_params;
+    lr11xx_status_t                       status;
+
+    if( lr11xx_radio_cache_is_hit( cache, LR11XX_RADIO_CACHE_GFSK_PKT_PARAMS,
+                                   ( cached->preamble_len_in_bits == pkt_params->preamble_len_in_bits ) &&
+                                       ( cached->preamble_detector == pkt_params->preamble_detector ) &&
+                                       ( cached->sync_word_len_in_bits == pkt_params->sync_word_len_in_bits ) &&
+                                       ( cached->address_filtering == pkt_params->address_filtering ) &&
+                                       ( cached->header_type == pkt_params->header_type ) &&
+                                       ( cached->pld_len_in_bytes == pkt_params->pld_len_in_bytes ) &&
+                                       ( cached->crc_type == pkt_params->crc_type ) &&
+                                       ( cached->dc_free == pkt_params->dc_free ) ) )
+    {
+        return LR11XX_STATUS_OK;
+    }
+
+    status = lr11xx_radio_set_gfsk_pkt_params( context, pkt_params );
+    if( status == LR11XX_STATUS_OK )
+    {
+        cache->gfsk_pkt_params = *pkt_params;
+    }
+
+    return lr11xx_radio_cache_update( cache, LR11XX_RADIO_CACHE_GFSK_PKT_PARAMS, status );
+}
+
+lr11xx_status_t lr11xx_radio_cache_set_pa_cfg( const void* context, lr11xx_radio_cache_t* cache,
+                                               const lr11xx_radio_pa_cfg_t* pa_cfg )
+{
+    const lr11xx_radio_pa_cfg_t* cached = &cache->pa_cfg;
+    lr11xx_status_t              status;
+
+    if( lr11xx_radio_cache_is_hit( cache, LR11XX_RADIO_CACHE_PA_CFG,
+                                   ( cached->pa_sel == pa_cfg->pa_sel ) &&
+                                       ( cached->pa_reg_supply == pa_cfg->pa_reg_supply ) &&
+                                       ( cached->pa_duty_cycle == pa_cfg->pa_duty_cycle ) &&
+                                       ( cached->pa_hp_sel == pa_cfg->pa_hp_sel ) ) )
+    {
+        return LR11XX_STATUS_OK;
+    }
+
+    status = lr11xx_radio_set_pa_cfg( context, pa_cfg );
+    if( status == LR11XX_STATUS_OK )
+    {
+        cache->pa_cfg = *pa_cfg;
+    }
+
+    return lr11xx_radio_cache_update( cache, LR11XX_RADIO_CACHE_PA_CFG, status );
+}
+
+lr11xx_status_t lr11xx_radio_cache_set_tx_params( const void* context, lr11xx_radio_cache_t* cache, int8_t pwr_in_dbm,
+                                                  lr11xx_radio_ramp_time_t ramp_time )
+{
+    lr11xx_status_t status;
+
+    if( lr11xx_radio_cache_is_hit( cache, LR11XX_RADIO_CACHE_TX_PARAMS,
+                                   ( cache->tx_power_in_dbm == pwr_in_dbm ) && ( cache->ramp_time == ramp_time ) ) )
+    {
+        return LR11XX_STATUS_OK;
+    }
+
+    status = lr11xx_radio_set_tx_params( context, pwr_in_dbm, ramp_time );
+    if( status == LR11XX_STATUS_OK )
+    {
+        cache->tx_power_in_dbm = pwr_in_dbm;
+        cache->ramp_time       = ramp_time;
+    }
+
+    return lr11xx_radio_cache_update( cache, LR11XX_RADIO_CACHE_TX_PARAMS, status );
+}
+
+lr11xx_status_t lr11xx_radio_cache_set_lora_sync_word( const void* context, lr11xx_radio_cache_t* cache,
+                                                       uint8_t sync_word )
+{
+    lr11xx_status_t status;
+
+    if( lr11xx_radio_cache_is_hit( cache, LR11XX_RADIO_CACHE_LORA_SYNC_WORD, cache->lora_sync_word == sync_word ) )
+    {
+        return LR11XX_STATUS_OK;
+    }
+
+    status = lr11xx_radio_set_lora_sync_word( context, sync_word );
+    if( status == LR11XX_STATUS_OK )
+    {
+        cache->lora_sync_word = sync_word;
+    }
+
+    return lr11xx_radio_cache_update( cache, LR11XX_RADIO_CACHE_LORA_SYNC_WORD, status );
+}
+
+lr11xx_status_t lr11xx_radio_cache_set_gfsk_sync_word(
+    const void* context, lr11xx_radio_cache_t* cache,
+    const uint8_t gfsk_sync_word[LR11XX_RADIO_GFSK_SYNC_WORD_LENGTH] )
+{
+    lr11xx_status_t status;
+
+    if( lr11xx_radio_cache_is_hit(
+            cache, LR11XX_RADIO_CACHE_GFSK_SYNC_WORD,
+            memcmp( cache->gfsk_sync_word, gfsk_sync_word, LR11XX_RADIO_GFSK_SYNC_WORD_LENGTH ) == 0 ) )
+    {
+        return LR11XX_STATUS_OK;
+    }
+
+    status = lr11xx_radio_set_gfsk_sync_word( context, gfsk_sync_word );
+    if( status == LR11XX_STATUS_OK )
+    {
+        memcpy( cache->gfsk_sync_word, gfsk_sync_word, LR11XX_RADIO_GFSK_SYNC_WORD_LENGTH );
+    }
+
+    return lr11xx_radio_cache_update( cache, LR11XX_RADIO_CACHE_GFSK_SYNC_WORD, status );
+}
+
+lr11xx_status_t lr11xx_radio_cache_set_sleep( const void* context, lr11xx_radio_cache_t* cache,
+                                              lr11xx_system_sleep_cfg_t sleep_cfg, uint32_t sleep_time )
+{
+    lr11xx_radio_cache_invalidate( cache );
+
+    return lr11xx_system_set_sleep( context, sleep_cfg, sleep_time );
+}
+
+lr11xx_status_t lr11xx_radio_cache_reset( const void* context, lr11xx_radio_cache_t* cache )
+{
+    lr11xx_radio_cache_invalidate( cache );
+
+    return lr11xx_system_reset( context );
+}
+
+lr11xx_status_t lr11xx_radio_cache_reboot( const void* context, lr11xx_radio_cache_t* cache,
+                                           bool stay_in_bootloader )
+{
+    lr11xx_radio_cache_invalidate( cache );
+
+    return lr11xx_system_reboot( context, stay_in_bootloader );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static bool lr11xx_radio_cache_is_hit( lr11xx_radio_cache_t* cache, uint16_t item, bool is_same )
+{
+    if( ( ( cache->valid & item ) != 0 ) && is_same )
+    {
+        cache->nb_hits++;
+        return true;
+    }
+
+    cache->nb_misses++;
+    return false;
+}
+
+static lr11xx_status_t lr11xx_radio_cache_update( lr11xx_radio_cache_t* cache, uint16_t item, lr11xx_status_t status )
+{
+    if( status == LR11XX_STATUS_OK )
+    {
+        cache->valid |= item;
+    }
+    else
+    {
+        cache->valid &= ~item;
+    }
+
+    return status;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,291 @@
+/**
+ * @file      lr11xx_radio_cache.h
+ *
+ * @brief     Radio configuration cache dropping redundant commands
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LR11XX_RADIO_CACHE_H
+#define LR11XX_RADIO_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lr11xx_radio.h"
+#include "lr11xx_radio_types.h"
+#include "lr11xx_system_types.h"
+#include "lr11xx_types.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Configuration items held by the cache - bits of lr11xx_radio_cache_t::valid
+ */
+#define LR11XX_RADIO_CACHE_PKT_TYPE ( 1 << 0 )
+#define LR11XX_RADIO_CACHE_RF_FREQ ( 1 << 1 )
+#define LR11XX_RADIO_CACHE_LORA_MOD_PARAMS ( 1 << 2 )
+#define LR11XX_RADIO_CACHE_LORA_PKT_PARAMS ( 1 << 3 )
+#define LR11XX_RADIO_CACHE_GFSK_MOD_PARAMS ( 1 << 4 )
+#define LR11XX_RADIO_CACHE_GFSK_PKT_PARAMS ( 1 << 5 )
+#define LR11XX_RADIO_CACHE_PA_CFG ( 1 << 6 )
+#define LR11XX_RADIO_CACHE_TX_PARAMS ( 1 << 7 )
+#define LR11XX_RADIO_CACHE_LORA_SYNC_WORD ( 1 << 8 )
+#define LR11XX_RADIO_CACHE_GFSK_SYNC_WORD ( 1 << 9 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Last radio configuration written to the chip
+ */
+typedef struct lr11xx_radio_cache_s
+{
+    uint16_t                       valid;  //!< LR11XX_RADIO_CACHE_* items known to be set in the chip
+    lr11xx_radio_pkt_type_t        pkt_type;
+    uint32_t                       rf_freq_in_hz;
+    lr11xx_radio_mod_params_lora_t lora_mod_params;
+    lr11xx_radio_pkt_params_lora_t lora_pkt_params;
+    lr11xx_radio_mod_params_gfsk_t gfsk_mod_params;
+    lr11xx_radio_pkt_params_gfsk_t gfsk_pkt_params;
+    lr11xx_radio_pa_cfg_t          pa_cfg;
+    int8_t                         tx_power_in_dbm;
+    lr11xx_radio_ramp_time_t       ramp_time;
+    uint8_t                        lora_sync_word;
+    uint8_t                        gfsk_sync_word[LR11XX_RADIO_GFSK_SYNC_WORD_LENGTH];
+    uint32_t                       nb_hits;    //!< Commands dropped as the chip already holds the configuration
+    uint32_t                       nb_misses;  //!< Commands sent to the chip
+} lr11xx_radio_cache_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Initialise a radio configuration cache - nothing is known about the chip configuration
+ *
+ * @param [out] cache Radio configuration cache
+ */
+void lr11xx_radio_cache_init( lr11xx_radio_cache_t* cache );
+
+/**
+ * @brief Forget the chip configuration
+ *
+ * Called by the sleep, reset and reboot wrappers below - to be called as well whenever the chip configuration is
+ * changed without going through the cache.
+ *
+ * @param [in] cache Radio configuration cache
+ */
+void lr11xx_radio_cache_invalidate( lr11xx_radio_cache_t* cache );
+
+/**
+ * @brief Cached lr11xx_radio_set_pkt_type
+ *
+ * Changing the packet type also forgets the modulation and packet parameters and the sync words.
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] cache Radio configuration cache
+ * @param [in] pkt_type Packet type
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_radio_cache_set_pkt_type( const void* context, lr11xx_radio_cache_t* cache,
+                                                 lr11xx_radio_pkt_type_t pkt_type );
+
+/**
+ * @brief Cached lr11xx_radio_set_rf_freq
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] cache Radio configuration cache
+ * @param [in] freq_in_hz RF frequency
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_radio_cache_set_rf_freq( const void* context, lr11xx_radio_cache_t* cache,
+                                                uint32_t freq_in_hz );
+
+/**
+ * @brief Cached lr11xx_radio_set_lora_mod_params
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] cache Radio configuration cache
+ * @param [in] mod_params LoRa modulation parameters
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_radio_cache_set_lora_mod_params( const void* context, lr11xx_radio_cache_t* cache,
+                                                        const lr11xx_radio_mod_params_lora_t* mod_params );
+
+/**
+ * @brief Cached lr11xx_radio_set_lora_pkt_params
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] cache Radio configuration cache
+ * @param [in] pkt_params LoRa packet parameters
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_radio_cache_set_lora_pkt_params( const void* context, lr11xx_radio_cache_t* cache,
+                                                        const lr11xx_radio_pkt_params_lora_t* pkt_params );
+
+/**
+ * @brief Cached lr11xx_radio_set_gfsk_mod_params
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] cache Radio configuration cache
+ * @param [in] mod_params GFSK modulation parameters
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_radio_cache_set_gfsk_mod_params( const void* context, lr11xx_radio_cache_t* cache,
+                                                        const lr11xx_radio_mod_params_gfsk_t* mod_params );
+
+/**
+ * @brief Cached lr11xx_radio_set_gfsk_pkt_params
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] cache Radio configuration cache
+ * @param [in] pkt_params GFSK packet parameters
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_radio_cache_set_gfsk_pkt_params( const void* context, lr11xx_radio_cache_t* cache,
+                                                        const lr11xx_radio_pkt_params_gfsk_t* pkt_params );
+
+/**
+ * @brief Cached lr11xx_radio_set_pa_cfg
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] cache Radio configuration cache
+ * @param [in] pa_cfg Power amplifier configuration
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_radio_cache_set_pa_cfg( const void* context, lr11xx_radio_cache_t* cache,
+                                               const lr11xx_radio_pa_cfg_t* pa_cfg );
+
+/**
+ * @brief Cached lr11xx_radio_set_tx_params
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] cache Radio configuration cache
+ * @param [in] pwr_in_dbm Tx power
+ * @param [in] ramp_time Power amplifier ramp time
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_radio_cache_set_tx_params( const void* context, lr11xx_radio_cache_t* cache, int8_t pwr_in_dbm,
+                                                  lr11xx_radio_ramp_time_t ramp_time );
+
+/**
+ * @brief Cached lr11xx_radio_set_lora_sync_word
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] cache Radio configuration cache
+ * @param [in] sync_word LoRa sync word
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_radio_cache_set_lora_sync_word( const void* context, lr11xx_radio_cache_t* cache,
+                                                       uint8_t sync_word );
+
+/**
+ * @brief Cached lr11xx_radio_set_gfsk_sync_word
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] cache Radio configuration cache
+ * @param [in] gfsk_sync_word GFSK sync word
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_radio_cache_set_gfsk_sync_word(
+    const void* context, lr11xx_radio_cache_t* cache,
+    const uint8_t gfsk_sync_word[LR11XX_RADIO_GFSK_SYNC_WORD_LENGTH] );
+
+/**
+ * @brief lr11xx_system_set_sleep, forgetting the chip configuration
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] cache Radio configuration cache
+ * @param [in] sleep_cfg Sleep configuration
+ * @param [in] sleep_time Sleep time, in RTC steps
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_radio_cache_set_sleep( const void* context, lr11xx_radio_cache_t* cache,
+                                              lr11xx_system_sleep_cfg_t sleep_cfg, uint32_t sleep_time );
+
+/**
+ * @brief lr11xx_system_reset, forgetting the chip configuration
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] cache Radio configuration cache
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_radio_cache_reset( const void* context, lr11xx_radio_cache_t* cache );
+
+/**
+ * @brief lr11xx_system_reboot, forgetting the chip configuration
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] cache Radio configuration cache
+ * @param [in] stay_in_bootloader Stay in the bootloader after the reboot
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_radio_cache_reboot( const void* context, lr11xx_radio_cache_t* cache,
+                                           bool stay_in_bootloader );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LR11XX_RADIO_CACHE_H
+
+/* --- EOF ------------------------------------------------------------------ */
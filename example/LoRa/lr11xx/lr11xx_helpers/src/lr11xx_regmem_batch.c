@@ -0,0 +1,294 @@
+/**
+ * @file      lr11xx_regmem_batch.c
+ *
+ * @brief     Batched register writes with a shadow of the register values
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <string.h>
+#include "lr11xx_regmem_batch.h"
+#include "lr11xx_regmem.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#if( LR11XX_REGMEM_BATCH_MAX_WRITES > 255 ) || ( LR11XX_REGMEM_BATCH_SHADOW_SIZE > 255 )
+#error "LR11XX_REGMEM_BATCH_MAX_WRITES and LR11XX_REGMEM_BATCH_SHADOW_SIZE must be 255 at most"
+#endif
+
+/**
+ * @brief Mask of a whole register write
+ */
+#define LR11XX_REGMEM_BATCH_FULL_MASK ( 0xFFFFFFFF )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Find the known value of a register
+ *
+ * @param [in] batch Register write batch
+ * @param [in] address Register address
+ *
+ * @returns Shadow entry, NULL if the value is unknown
+ */
+static lr11xx_regmem_batch_shadow_t* lr11xx_regmem_batch_find_shadow( lr11xx_regmem_batch_t* batch,
+                                                                      uint32_t               address );
+
+/**
+ * @brief Remember the value of a register
+ *
+ * @param [in] batch Register write batch
+ * @param [in] address Register address
+ * @param [in] value Register value
+ */
+static void lr11xx_regmem_batch_set_shadow( lr11xx_regmem_batch_t* batch, uint32_t address, uint32_t value );
+
+/**
+ * @brief Add a write to the queue, flushing it first if it is full
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] batch Register write batch
+ * @param [in] address Register address
+ * @param [in] mask Bits to write
+ * @param [in] data Value to write
+ *
+ * @returns Operation status of the forced flush, if any
+ */
+static lr11xx_status_t lr11xx_regmem_batch_enqueue( const void* context, lr11xx_regmem_batch_t* batch,
+                                                    uint32_t address, uint32_t mask, uint32_t data );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void lr11xx_regmem_batch_init( lr11xx_regmem_batch_t* batch )
+{
+    memset( batch, 0, sizeof( lr11xx_regmem_batch_t ) );
+}
+
+void lr11xx_regmem_batch_invalidate( lr11xx_regmem_batch_t* batch )
+{
+    batch->nb_shadow_entries = 0;
+    batch->next_shadow_entry = 0;
+}
+
+lr11xx_status_t lr11xx_regmem_batch_write( const void* context, lr11xx_regmem_batch_t* batch, uint32_t address,
+                                           uint32_t data )
+{
+    return lr11xx_regmem_batch_write_mask( context, batch, address, LR11XX_REGMEM_BATCH_FULL_MASK, data );
+}
+
+lr11xx_status_t lr11xx_regmem_batch_write_mask( const void* context, lr11xx_regmem_batch_t* batch, uint32_t address,
+                                                uint32_t mask, uint32_t data )
+{
+    const lr11xx_regmem_batch_shadow_t* shadow = lr11xx_regmem_batch_find_shadow( batch, address );
+    lr11xx_status_t                     status;
+
+    if( shadow != NULL )
+    {
+        const uint32_t value = ( shadow->value & ~mask ) | ( data & mask );
+
+        if( value == shadow->value )
+        {
+            batch->nb_skipped++;
+            return LR11XX_STATUS_OK;
+        }
+
+        mask = LR11XX_REGMEM_BATCH_FULL_MASK;
+        data = value;
+    }
+
+    status = lr11xx_regmem_batch_enqueue( context, batch, address, mask, data );
+
+    if( mask == LR11XX_REGMEM_BATCH_FULL_MASK )
+    {
+        lr11xx_regmem_batch_set_shadow( batch, address, data );
+    }
+
+    return status;
+}
+
+lr11xx_status_t lr11xx_regmem_batch_read( const void* context, lr11xx_regmem_batch_t* batch, uint32_t address,
+                                          uint32_t* value )
+{
+    lr11xx_status_t status = lr11xx_regmem_batch_flush( context, batch );
+
+    if( status != LR11XX_STATUS_OK )
+    {
+        return status;
+    }
+
+    status = lr11xx_regmem_read_regmem32( context, address, value, 1 );
+    batch->nb_transactions++;
+
+    if( status == LR11XX_STATUS_OK )
+    {
+        lr11xx_regmem_batch_set_shadow( batch, address, *value );
+    }
+
+    return status;
+}
+
+lr11xx_status_t lr11xx_regmem_batch_flush( const void* context, lr11xx_regmem_batch_t* batch )
+{
+    lr11xx_status_t status = LR11XX_STATUS_OK;
+    uint8_t         index  = 0;
+
+    while( ( index < batch->nb_writes ) && ( status == LR11XX_STATUS_OK ) )
+    {
+        const lr11xx_regmem_batch_write_t* first = &batch->writes[index];
+
+        if( first->mask == LR11XX_REGMEM_BATCH_FULL_MASK )
+        {
+            uint32_t data[LR11XX_REGMEM_BATCH_MAX_WRITES];
+            uint8_t  nb_words = 0;
+
+            do
+            {
+                data[nb_words++] = batch->writes[index++].data;
+            } while( ( index < batch->nb_writes ) && ( nb_words < LR11XX_REGMEM_MAX_WRITE_READ_WORDS ) &&
+                     ( batch->writes[index].mask == LR11XX_REGMEM_BATCH_FULL_MASK ) &&
+                     ( batch->writes[index].address == ( first->address + ( nb_words * sizeof( uint32_t ) ) ) ) );
+
+            status = lr11xx_regmem_write_regmem32( context, first->address, data, nb_words );
+        }
+        else
+        {
+            status = lr11xx_regmem_write_regmem32_mask( context, first->address, first->mask, first->data );
+            index++;
+        }
+
+        batch->nb_transactions++;
+    }
+
+    batch->nb_writes = 0;
+
+    if( status != LR11XX_STATUS_OK )
+    {
+        lr11xx_regmem_batch_invalidate( batch );
+    }
+
+    return status;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static lr11xx_regmem_batch_shadow_t* lr11xx_regmem_batch_find_shadow( lr11xx_regmem_batch_t* batch,
+                                                                      uint32_t               address )
+{
+    for( uint8_t index = 0; index < batch->nb_shadow_entries; index++ )
+    {
+        if( batch->shadow[index].address == address )
+        {
+            return &batch->shadow[index];
+        }
+    }
+
+    return NULL;
+}
+
+static void lr11xx_regmem_batch_set_shadow( lr11xx_regmem_batch_t* batch, uint32_t address, uint32_t value )
+{
+    lr11xx_regmem_batch_shadow_t* shadow = lr11xx_regmem_batch_find_shadow( batch, address );
+
+    if( shadow == NULL )
+    {
+        if( batch->nb_shadow_entries < LR11XX_REGMEM_BATCH_SHADOW_SIZE )
+        {
+            shadow = &batch->shadow[batch->nb_shadow_entries++];
+        }
+        else
+        {
+            shadow                   = &batch->shadow[batch->next_shadow_entry];
+            batch->next_shadow_entry = ( batch->next_shadow_entry + 1 ) % LR11XX_REGMEM_BATCH_SHADOW_SIZE;
+        }
+        shadow->address = address;
+    }
+
+    shadow->value = value;
+}
+
+static lr11xx_status_t lr11xx_regmem_batch_enqueue( const void* context, lr11xx_regmem_batch_t* batch,
+                                                    uint32_t address, uint32_t mask, uint32_t data )
+{
+    lr11xx_status_t status = LR11XX_STATUS_OK;
+
+    // A whole register write replacing the last queued write to the same register takes its place
+    if( ( batch->nb_writes != 0 ) && ( mask == LR11XX_REGMEM_BATCH_FULL_MASK ) &&
+        ( batch->writes[batch->nb_writes - 1].address == address ) )
+    {
+        batch->writes[batch->nb_writes - 1].mask = mask;
+        batch->writes[batch->nb_writes - 1].data = data;
+        return LR11XX_STATUS_OK;
+    }
+
+    if( batch->nb_writes >= LR11XX_REGMEM_BATCH_MAX_WRITES )
+    {
+        status = lr11xx_regmem_batch_flush( context, batch );
+    }
+
+    batch->writes[batch->nb_writes].address = address;
+    batch->writes[batch->nb_writes].mask    = mask;
+    batch->writes[batch->nb_writes].data    = data;
+    batch->nb_writes++;
+
+    return status;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
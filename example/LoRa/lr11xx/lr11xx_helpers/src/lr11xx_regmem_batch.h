@@ -0,0 +1,203 @@
+/**
+ * @file      lr11xx_regmem_batch.h
+ *
+ * @brief     Batched register writes with a shadow of the register values
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LR11XX_REGMEM_BATCH_H
+#define LR11XX_REGMEM_BATCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lr11xx_types.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Number of register writes queued before a flush is forced
+ */
+#ifndef LR11XX_REGMEM_BATCH_MAX_WRITES
+#define LR11XX_REGMEM_BATCH_MAX_WRITES ( 16 )
+#endif
+
+/**
+ * @brief Number of registers whose value is remembered
+ */
+#ifndef LR11XX_REGMEM_BATCH_SHADOW_SIZE
+#define LR11XX_REGMEM_BATCH_SHADOW_SIZE ( 16 )
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Queued register write
+ */
+typedef struct lr11xx_regmem_batch_write_s
+{
+    uint32_t address;  //!< Register address
+    uint32_t mask;     //!< Bits to write - 0xFFFFFFFF for a whole register
+    uint32_t data;     //!< Value to write
+} lr11xx_regmem_batch_write_t;
+
+/**
+ * @brief Register value known to the batch
+ */
+typedef struct lr11xx_regmem_batch_shadow_s
+{
+    uint32_t address;  //!< Register address
+    uint32_t value;    //!< Register value once the queue is flushed
+} lr11xx_regmem_batch_shadow_t;
+
+/**
+ * @brief Register write batch
+ */
+typedef struct lr11xx_regmem_batch_s
+{
+    lr11xx_regmem_batch_write_t  writes[LR11XX_REGMEM_BATCH_MAX_WRITES];
+    uint8_t                      nb_writes;  //!< Number of queued writes
+    lr11xx_regmem_batch_shadow_t shadow[LR11XX_REGMEM_BATCH_SHADOW_SIZE];
+    uint8_t                      nb_shadow_entries;  //!< Number of registers with a known value
+    uint8_t                      next_shadow_entry;  //!< Entry replaced when a register is added to a full shadow
+    uint32_t                     nb_skipped;         //!< Writes dropped as the register already holds the value
+    uint32_t                     nb_transactions;    //!< SPI transactions issued by the flushes
+} lr11xx_regmem_batch_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Initialise a register write batch
+ *
+ * @param [out] batch Register write batch
+ */
+void lr11xx_regmem_batch_init( lr11xx_regmem_batch_t* batch );
+
+/**
+ * @brief Forget the register values known to the batch
+ *
+ * To be called whenever the chip may have lost or changed them: after a sleep without retention, a reset or a reboot.
+ *
+ * @param [in] batch Register write batch
+ */
+void lr11xx_regmem_batch_invalidate( lr11xx_regmem_batch_t* batch );
+
+/**
+ * @brief Queue the write of a whole register
+ *
+ * The write is dropped if the register is known to hold the value already. The queue is flushed first if it is full.
+ *
+ * @remark Only registers that the chip does not modify on its own must be written through a batch.
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] batch Register write batch
+ * @param [in] address Register address
+ * @param [in] data Value to write
+ *
+ * @returns Operation status of the forced flush, if any
+ */
+lr11xx_status_t lr11xx_regmem_batch_write( const void* context, lr11xx_regmem_batch_t* batch, uint32_t address,
+                                           uint32_t data );
+
+/**
+ * @brief Queue the write of some bits of a register
+ *
+ * If the register value is known, the write is either dropped - bits already set as requested - or turned into the
+ * write of a whole register, which can be merged with the writes of the neighbouring registers.
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] batch Register write batch
+ * @param [in] address Register address
+ * @param [in] mask Bits to write
+ * @param [in] data Value to write
+ *
+ * @returns Operation status of the forced flush, if any
+ */
+lr11xx_status_t lr11xx_regmem_batch_write_mask( const void* context, lr11xx_regmem_batch_t* batch, uint32_t address,
+                                                uint32_t mask, uint32_t data );
+
+/**
+ * @brief Read a register from the chip, and remember its value
+ *
+ * The queued writes are flushed first.
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] batch Register write batch
+ * @param [in] address Register address
+ * @param [out] value Register value
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_regmem_batch_read( const void* context, lr11xx_regmem_batch_t* batch, uint32_t address,
+                                          uint32_t* value );
+
+/**
+ * @brief Send the queued writes to the chip
+ *
+ * Consecutive queued writes of whole registers at consecutive addresses are merged into a single
+ * lr11xx_regmem_write_regmem32 command. The queue is emptied even on failure, and the known register values are then
+ * forgotten.
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] batch Register write batch
+ *
+ * @returns Operation status
+ */
+lr11xx_status_t lr11xx_regmem_batch_flush( const void* context, lr11xx_regmem_batch_t* batch );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LR11XX_REGMEM_BATCH_H
+
+/* --- EOF ------------------------------------------------------------------ */
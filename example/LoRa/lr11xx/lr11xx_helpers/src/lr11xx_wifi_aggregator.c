@@ -0,0 +1,375 @@
+/*!
+ * @file      lr11xx_wifi_aggregator.c
+ *
+ * @brief     Wi-Fi scan aggregation and uplink encoding
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <string.h>
+#include "lr11xx_wifi_aggregator.h"
+#include "lr11xx_wifi.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#if( LR11XX_WIFI_AGGREGATOR_MAX_ACCESS_POINTS > 127 )
+#error "LR11XX_WIFI_AGGREGATOR_MAX_ACCESS_POINTS must be 127 at most"
+#endif
+
+#if( ( LR11XX_WIFI_AGGREGATOR_HASH_TABLE_SIZE & ( LR11XX_WIFI_AGGREGATOR_HASH_TABLE_SIZE - 1 ) ) != 0 ) || \
+    ( LR11XX_WIFI_AGGREGATOR_HASH_TABLE_SIZE < 2 * LR11XX_WIFI_AGGREGATOR_MAX_ACCESS_POINTS ) ||        \
+    ( LR11XX_WIFI_AGGREGATOR_HASH_TABLE_SIZE > 256 )
+#error "LR11XX_WIFI_AGGREGATOR_HASH_TABLE_SIZE must be a power of two, 256 at most, twice the number of APs"
+#endif
+
+/**
+ * @brief Bit of the first MAC address byte set for locally administered addresses
+ */
+#define LR11XX_WIFI_AGGREGATOR_MAC_LOCALLY_ADMIN_BIT ( 0x02 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Check a result against the aggregator filters
+ *
+ * @param [in] filters LR11XX_WIFI_AGGREGATOR_FILTER_* combination
+ * @param [in] result Basic complete result
+ *
+ * @returns true if the result has to be dropped
+ */
+static bool lr11xx_wifi_aggregator_is_filtered_out( uint8_t                                    filters,
+                                                    const lr11xx_wifi_basic_complete_result_t* result );
+
+/**
+ * @brief Get the first hash table slot to probe for a MAC address
+ *
+ * The last bytes of the MAC address - the part assigned by the manufacturer to each device - are mixed by a
+ * multiplicative hash.
+ *
+ * @param [in] mac_address MAC address
+ *
+ * @returns Slot index
+ */
+static uint8_t lr11xx_wifi_aggregator_hash( const lr11xx_wifi_mac_address_t mac_address );
+
+/**
+ * @brief Find the hash table slot of a MAC address, or the free slot where to insert it
+ *
+ * @param [in] aggregator Aggregator
+ * @param [in] mac_address MAC address
+ *
+ * @returns Slot index
+ */
+static uint8_t lr11xx_wifi_aggregator_probe( const lr11xx_wifi_aggregator_t* aggregator,
+                                             const lr11xx_wifi_mac_address_t mac_address );
+
+/**
+ * @brief Compare two access points for the ranking
+ *
+ * @param [in] ap_1 Access point
+ * @param [in] ap_2 Access point
+ *
+ * @returns true if ap_1 ranks before ap_2
+ */
+static bool lr11xx_wifi_aggregator_ranks_before( const lr11xx_wifi_aggregator_access_point_t* ap_1,
+                                                 const lr11xx_wifi_aggregator_access_point_t* ap_2 );
+
+/**
+ * @brief Get the mean RSSI of an access point, rounded to the nearest dBm
+ *
+ * @param [in] ap Access point
+ *
+ * @returns Mean RSSI, in dBm
+ */
+static int8_t lr11xx_wifi_aggregator_get_rssi_mean( const lr11xx_wifi_aggregator_access_point_t* ap );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void lr11xx_wifi_aggregator_init( lr11xx_wifi_aggregator_t* aggregator, uint8_t filters )
+{
+    memset( aggregator, 0, sizeof( *aggregator ) );
+    aggregator->filters = filters;
+}
+
+bool lr11xx_wifi_aggregator_add_result( lr11xx_wifi_aggregator_t*                  aggregator,
+                                        const lr11xx_wifi_basic_complete_result_t* result )
+{
+    aggregator->nb_results++;
+
+    if( lr11xx_wifi_aggregator_is_filtered_out( aggregator->filters, result ) )
+    {
+        aggregator->nb_filtered++;
+        return false;
+    }
+
+    const uint8_t                          slot = lr11xx_wifi_aggregator_probe( aggregator, result->mac_address );
+    lr11xx_wifi_aggregator_access_point_t* ap;
+
+    if( aggregator->hash_table[slot] != 0 )
+    {
+        ap = &aggregator->access_points[aggregator->hash_table[slot] - 1];
+        if( ap->nb_detections == UINT8_MAX )
+        {
+            return true;
+        }
+    }
+    else
+    {
+        if( aggregator->nb_access_points == LR11XX_WIFI_AGGREGATOR_MAX_ACCESS_POINTS )
+        {
+            aggregator->nb_overflow++;
+            return false;
+        }
+
+        ap = &aggregator->access_points[aggregator->nb_access_points];
+        aggregator->nb_access_points++;
+        aggregator->hash_table[slot] = aggregator->nb_access_points;
+
+        memcpy( ap->mac_address, result->mac_address, LR11XX_WIFI_MAC_ADDRESS_LENGTH );
+        ap->rssi_sum      = 0;
+        ap->nb_detections = 0;
+        ap->rssi_max      = INT8_MIN;
+    }
+
+    ap->rssi_sum += result->rssi;
+    ap->nb_detections++;
+    if( result->rssi > ap->rssi_max )
+    {
+        ap->rssi_max = result->rssi;
+    }
+
+    return true;
+}
+
+void lr11xx_wifi_aggregator_add_results( lr11xx_wifi_aggregator_t*                  aggregator,
+                                         const lr11xx_wifi_basic_complete_result_t* results, uint8_t nb_results )
+{
+    for( uint8_t index = 0; index < nb_results; index++ )
+    {
+        lr11xx_wifi_aggregator_add_result( aggregator, &results[index] );
+    }
+}
+
+bool lr11xx_wifi_aggregator_on_stream_result( const uint8_t result_index, const lr11xx_wifi_result_t* result,
+                                              void* user_context )
+{
+    ( void ) result_index;
+
+    lr11xx_wifi_aggregator_add_result( ( lr11xx_wifi_aggregator_t* ) user_context, &result->basic_complete );
+
+    return true;
+}
+
+const lr11xx_wifi_aggregator_access_point_t* lr11xx_wifi_aggregator_find(
+    const lr11xx_wifi_aggregator_t* aggregator, const lr11xx_wifi_mac_address_t mac_address )
+{
+    const uint8_t slot = lr11xx_wifi_aggregator_probe( aggregator, mac_address );
+
+    if( aggregator->hash_table[slot] == 0 )
+    {
+        return NULL;
+    }
+
+    return &aggregator->access_points[aggregator->hash_table[slot] - 1];
+}
+
+uint8_t lr11xx_wifi_aggregator_encode( const lr11xx_wifi_aggregator_t* aggregator, uint8_t max_nb_access_points,
+                                       uint8_t* payload, uint8_t max_payload_length )
+{
+    uint8_t ranking[LR11XX_WIFI_AGGREGATOR_MAX_ACCESS_POINTS];
+    uint8_t nb_ranked = 0;
+
+    if( max_nb_access_points > max_payload_length / LR11XX_WIFI_AGGREGATOR_RECORD_SIZE )
+    {
+        max_nb_access_points = max_payload_length / LR11XX_WIFI_AGGREGATOR_RECORD_SIZE;
+    }
+
+    // Keep the max_nb_access_points best ones, sorted by insertion
+    for( uint8_t index = 0; index < aggregator->nb_access_points; index++ )
+    {
+        const lr11xx_wifi_aggregator_access_point_t* ap       = &aggregator->access_points[index];
+        uint8_t                                      position = nb_ranked;
+
+        while( ( position > 0 ) &&
+               lr11xx_wifi_aggregator_ranks_before( ap, &aggregator->access_points[ranking[position - 1]] ) )
+        {
+            position--;
+        }
+
+        if( position >= max_nb_access_points )
+        {
+            continue;
+        }
+
+        if( nb_ranked < max_nb_access_points )
+        {
+            nb_ranked++;
+        }
+        for( uint8_t shift = nb_ranked - 1; shift > position; shift-- )
+        {
+            ranking[shift] = ranking[shift - 1];
+        }
+        ranking[position] = index;
+    }
+
+    for( uint8_t rank = 0; rank < nb_ranked; rank++ )
+    {
+        const lr11xx_wifi_aggregator_access_point_t* ap     = &aggregator->access_points[ranking[rank]];
+        uint8_t*                                     record = &payload[rank * LR11XX_WIFI_AGGREGATOR_RECORD_SIZE];
+
+        record[0] = ( uint8_t ) lr11xx_wifi_aggregator_get_rssi_mean( ap );
+        memcpy( &record[1], ap->mac_address, LR11XX_WIFI_MAC_ADDRESS_LENGTH );
+    }
+
+    return nb_ranked * LR11XX_WIFI_AGGREGATOR_RECORD_SIZE;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static bool lr11xx_wifi_aggregator_is_filtered_out( uint8_t                                    filters,
+                                                    const lr11xx_wifi_basic_complete_result_t* result )
+{
+    lr11xx_wifi_channel_t    channel;
+    bool                     rssi_validity;
+    lr11xx_wifi_mac_origin_t mac_origin;
+
+    lr11xx_wifi_parse_channel_info( result->channel_info_byte, &channel, &rssi_validity, &mac_origin );
+
+    if( ( ( filters & LR11XX_WIFI_AGGREGATOR_FILTER_MOBILE_AP ) != 0 ) &&
+        ( mac_origin == LR11XX_WIFI_ORIGIN_BEACON_MOBILE_AP ) )
+    {
+        return true;
+    }
+
+    if( ( ( filters & LR11XX_WIFI_AGGREGATOR_FILTER_LOCALLY_ADMIN ) != 0 ) &&
+        ( ( result->mac_address[0] & LR11XX_WIFI_AGGREGATOR_MAC_LOCALLY_ADMIN_BIT ) != 0 ) )
+    {
+        return true;
+    }
+
+    if( ( filters & LR11XX_WIFI_AGGREGATOR_FILTER_FROM_STATION ) != 0 )
+    {
+        lr11xx_wifi_frame_type_t     frame_type;
+        lr11xx_wifi_frame_sub_type_t frame_sub_type;
+        bool                         to_ds;
+        bool                         from_ds;
+
+        lr11xx_wifi_parse_frame_type_info( result->frame_type_info_byte, &frame_type, &frame_sub_type, &to_ds,
+                                           &from_ds );
+
+        // The RSSI is then the one of the station, not of the access point
+        if( !rssi_validity || ( ( frame_type == LR11XX_WIFI_FRAME_TYPE_DATA ) && to_ds && !from_ds ) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static uint8_t lr11xx_wifi_aggregator_hash( const lr11xx_wifi_mac_address_t mac_address )
+{
+    const uint32_t key = ( ( uint32_t ) mac_address[2] << 24 ) | ( ( uint32_t ) mac_address[3] << 16 ) |
+                         ( ( uint32_t ) mac_address[4] << 8 ) | ( uint32_t ) mac_address[5];
+
+    const uint32_t hash = ( uint32_t ) ( key * 2654435761UL );
+
+    return ( uint8_t ) ( ( hash >> 24 ) & ( LR11XX_WIFI_AGGREGATOR_HASH_TABLE_SIZE - 1 ) );
+}
+
+static uint8_t lr11xx_wifi_aggregator_probe( const lr11xx_wifi_aggregator_t* aggregator,
+                                             const lr11xx_wifi_mac_address_t mac_address )
+{
+    uint8_t slot = lr11xx_wifi_aggregator_hash( mac_address );
+
+    // The table is at most half full: a free slot is always found
+    while( ( aggregator->hash_table[slot] != 0 ) &&
+           ( memcmp( aggregator->access_points[aggregator->hash_table[slot] - 1].mac_address, mac_address,
+                     LR11XX_WIFI_MAC_ADDRESS_LENGTH ) != 0 ) )
+    {
+        slot = ( slot + 1 ) & ( LR11XX_WIFI_AGGREGATOR_HASH_TABLE_SIZE - 1 );
+    }
+
+    return slot;
+}
+
+static bool lr11xx_wifi_aggregator_ranks_before( const lr11xx_wifi_aggregator_access_point_t* ap_1,
+                                                 const lr11xx_wifi_aggregator_access_point_t* ap_2 )
+{
+    // Compare the means without dividing: sum_1 / n_1 > sum_2 / n_2
+    const int32_t weighted_1 = ( int32_t ) ap_1->rssi_sum * ap_2->nb_detections;
+    const int32_t weighted_2 = ( int32_t ) ap_2->rssi_sum * ap_1->nb_detections;
+
+    if( weighted_1 != weighted_2 )
+    {
+        return weighted_1 > weighted_2;
+    }
+
+    return ap_1->nb_detections > ap_2->nb_detections;
+}
+
+static int8_t lr11xx_wifi_aggregator_get_rssi_mean( const lr11xx_wifi_aggregator_access_point_t* ap )
+{
+    // The sum is negative or null: round half away from zero
+    return ( int8_t ) ( ( ap->rssi_sum - ap->nb_detections / 2 ) / ap->nb_detections );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,212 @@
+/*!
+ * @file      lr11xx_wifi_aggregator.h
+ *
+ * @brief     Wi-Fi scan aggregation and uplink encoding
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LR11XX_WIFI_AGGREGATOR_H
+#define LR11XX_WIFI_AGGREGATOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lr11xx_wifi_types.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Number of distinct access points the aggregator can hold - at most 127
+ */
+#ifndef LR11XX_WIFI_AGGREGATOR_MAX_ACCESS_POINTS
+#define LR11XX_WIFI_AGGREGATOR_MAX_ACCESS_POINTS ( 32 )
+#endif
+
+/**
+ * @brief Number of slots of the MAC address hash table - a power of two, at least twice the number of access points
+ */
+#ifndef LR11XX_WIFI_AGGREGATOR_HASH_TABLE_SIZE
+#define LR11XX_WIFI_AGGREGATOR_HASH_TABLE_SIZE ( 64 )
+#endif
+
+/**
+ * @brief Size of an access point record in the uplink payload: RSSI on one byte, then the MAC address
+ */
+#define LR11XX_WIFI_AGGREGATOR_RECORD_SIZE ( 1 + LR11XX_WIFI_MAC_ADDRESS_LENGTH )
+
+/**
+ * @brief Filters applied to the results before aggregation - to be combined
+ */
+#define LR11XX_WIFI_AGGREGATOR_FILTER_NONE ( 0x00 )
+#define LR11XX_WIFI_AGGREGATOR_FILTER_MOBILE_AP ( 0x01 )      //!< Access points estimated mobile by the chip
+#define LR11XX_WIFI_AGGREGATOR_FILTER_LOCALLY_ADMIN ( 0x02 )  //!< Locally administered - random - MAC addresses
+#define LR11XX_WIFI_AGGREGATOR_FILTER_FROM_STATION ( 0x04 )   //!< Frames sent by a station to its access point
+#define LR11XX_WIFI_AGGREGATOR_FILTER_ALL                                                           \
+    ( LR11XX_WIFI_AGGREGATOR_FILTER_MOBILE_AP | LR11XX_WIFI_AGGREGATOR_FILTER_LOCALLY_ADMIN | \
+      LR11XX_WIFI_AGGREGATOR_FILTER_FROM_STATION )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Access point seen in one or several scans
+ */
+typedef struct lr11xx_wifi_aggregator_access_point_s
+{
+    lr11xx_wifi_mac_address_t mac_address;
+    int16_t                   rssi_sum;       //!< Sum of the RSSI of each detection, in dBm
+    uint8_t                   nb_detections;  //!< Number of results the access point was seen in
+    int8_t                    rssi_max;       //!< Strongest RSSI, in dBm
+} lr11xx_wifi_aggregator_access_point_t;
+
+/**
+ * @brief Wi-Fi scan aggregator
+ *
+ * The access points are stored in the order they are first seen. The hash table gives, for a MAC address, the index of
+ * its access point plus one - 0 marking a free slot. Collisions are resolved by linear probing.
+ */
+typedef struct lr11xx_wifi_aggregator_s
+{
+    lr11xx_wifi_aggregator_access_point_t access_points[LR11XX_WIFI_AGGREGATOR_MAX_ACCESS_POINTS];
+    uint8_t                               hash_table[LR11XX_WIFI_AGGREGATOR_HASH_TABLE_SIZE];
+    uint8_t                               nb_access_points;
+    uint8_t                               filters;      //!< LR11XX_WIFI_AGGREGATOR_FILTER_* combination
+    uint16_t                              nb_results;   //!< Results given to the aggregator
+    uint16_t                              nb_filtered;  //!< Results dropped by the filters
+    uint16_t                              nb_overflow;  //!< Results dropped because the aggregator was full
+} lr11xx_wifi_aggregator_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Empty the aggregator
+ *
+ * @param [out] aggregator Aggregator
+ * @param [in] filters Filters to apply - combination of LR11XX_WIFI_AGGREGATOR_FILTER_*
+ */
+void lr11xx_wifi_aggregator_init( lr11xx_wifi_aggregator_t* aggregator, uint8_t filters );
+
+/**
+ * @brief Add a scan result
+ *
+ * If the access point is already known, its RSSI statistics are updated.
+ *
+ * @param [in,out] aggregator Aggregator
+ * @param [in] result Basic complete result
+ *
+ * @returns true if the result is aggregated, false if it is filtered out or the aggregator is full
+ */
+bool lr11xx_wifi_aggregator_add_result( lr11xx_wifi_aggregator_t*                  aggregator,
+                                        const lr11xx_wifi_basic_complete_result_t* result );
+
+/**
+ * @brief Add the results of a scan
+ *
+ * @param [in,out] aggregator Aggregator
+ * @param [in] results Basic complete results
+ * @param [in] nb_results Number of results
+ */
+void lr11xx_wifi_aggregator_add_results( lr11xx_wifi_aggregator_t*                  aggregator,
+                                         const lr11xx_wifi_basic_complete_result_t* results, uint8_t nb_results );
+
+/**
+ * @brief Callback to give to lr11xx_wifi_stream_results to feed the aggregator directly from the chip
+ *
+ * The stream has to fetch the results in LR11XX_WIFI_RESULT_FORMAT_BASIC_COMPLETE format, with user_context pointing
+ * to the aggregator. Its MAC de-duplication should be disabled: the aggregator does it.
+ *
+ * @param [in] result_index Index of the result in the chip result list
+ * @param [in] result Decoded result
+ * @param [in] user_context Aggregator
+ *
+ * @returns Always true - the stream is never stopped
+ */
+bool lr11xx_wifi_aggregator_on_stream_result( const uint8_t result_index, const lr11xx_wifi_result_t* result,
+                                              void* user_context );
+
+/**
+ * @brief Get an access point by MAC address
+ *
+ * @param [in] aggregator Aggregator
+ * @param [in] mac_address MAC address
+ *
+ * @returns The access point, NULL if not seen
+ */
+const lr11xx_wifi_aggregator_access_point_t* lr11xx_wifi_aggregator_find(
+    const lr11xx_wifi_aggregator_t* aggregator, const lr11xx_wifi_mac_address_t mac_address );
+
+/**
+ * @brief Encode the strongest access points into an uplink payload
+ *
+ * The access points are ranked by mean RSSI over their detections, strongest first - ties going to the most detected
+ * one. As many as fit in max_payload_length are encoded, each as a LR11XX_WIFI_AGGREGATOR_RECORD_SIZE-byte record: the
+ * mean RSSI as a signed byte, then the MAC address.
+ *
+ * max_payload_length is typically the value given by lr1121_modem_get_next_tx_max_payload, or the maximum payload
+ * size of the current LoRaWAN datarate.
+ *
+ * @param [in] aggregator Aggregator
+ * @param [in] max_nb_access_points Maximum number of access points to encode
+ * @param [out] payload Buffer receiving the payload - at least max_payload_length bytes
+ * @param [in] max_payload_length Maximum payload length
+ *
+ * @returns Payload length, in bytes
+ */
+uint8_t lr11xx_wifi_aggregator_encode( const lr11xx_wifi_aggregator_t* aggregator, uint8_t max_nb_access_points,
+                                       uint8_t* payload, uint8_t max_payload_length );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LR11XX_WIFI_AGGREGATOR_H
+
+/* --- EOF ------------------------------------------------------------------ */
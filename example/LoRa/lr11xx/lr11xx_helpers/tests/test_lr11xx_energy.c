@@ -0,0 +1,197 @@
+/**
+ * @file      test_lr11xx_energy.c
+ *
+ * @brief     LR11XX test cases for the charge accounting
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include "unity.h"
+#include "lr11xx_energy.h"
+#include "lr11xx_gnss.h"
+#include "lr11xx_wifi.h"
+#include "mock_lr11xx_hal.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static const lr11xx_energy_tx_current_t tx_currents[] = {
+    { .power_in_dbm = 0, .current_in_ua = 10000 },
+    { .power_in_dbm = 14, .current_in_ua = 40000 },
+    { .power_in_dbm = 22, .current_in_ua = 120000 },
+};
+
+static const lr11xx_energy_profile_t profile = {
+    .tx_currents            = tx_currents,
+    .nb_tx_currents         = 3,
+    .rx_current_in_ua       = 5000,
+    .spi_current_in_ua      = 1500,
+    .mcu_run_current_in_ua  = 3000,
+    .mcu_stop_current_in_ua = 2,
+    .regulator              = LR11XX_SYSTEM_REG_MODE_DCDC,
+};
+
+static lr11xx_energy_t energy;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void setUp( void )
+{
+    lr11xx_energy_init( &energy, &profile, 2 );
+}
+
+void tearDown( void )
+{
+}
+
+void test_lr11xx_energy_estimate_tx( void )
+{
+    const lr11xx_energy_profile_t no_table = { .nb_tx_currents = 0 };
+
+    TEST_ASSERT_EQUAL_UINT64( 10000ULL * 1000, lr11xx_energy_estimate_tx( &profile, -9, 1000 ) );
+    TEST_ASSERT_EQUAL_UINT64( 10000ULL * 1000, lr11xx_energy_estimate_tx( &profile, 0, 1000 ) );
+    TEST_ASSERT_EQUAL_UINT64( 40000ULL * 1000, lr11xx_energy_estimate_tx( &profile, 10, 1000 ) );
+    TEST_ASSERT_EQUAL_UINT64( 120000ULL * 1000, lr11xx_energy_estimate_tx( &profile, 22, 1000 ) );
+    TEST_ASSERT_EQUAL_UINT64( 120000ULL * 1000, lr11xx_energy_estimate_tx( &profile, 30, 1000 ) );
+    TEST_ASSERT_EQUAL_UINT64( 0, lr11xx_energy_estimate_tx( &no_table, 14, 1000 ) );
+}
+
+void test_lr11xx_energy_accumulate( void )
+{
+    lr11xx_energy_add_tx( &energy, 14, 100000 );
+    lr11xx_energy_add_rx( &energy, 10000 );
+    lr11xx_energy_add_rx( &energy, 10000 );
+    lr11xx_energy_add_spi( &energy, 2000 );
+    lr11xx_energy_add_mcu( &energy, 1000000, 1000000 );
+
+    TEST_ASSERT_EQUAL_UINT64( 4000000000ULL, lr11xx_energy_get_charge( &energy, LR11XX_ENERGY_SUBSYSTEM_TX ) );
+    TEST_ASSERT_EQUAL_UINT64( 100000000ULL, lr11xx_energy_get_charge( &energy, LR11XX_ENERGY_SUBSYSTEM_RX ) );
+    TEST_ASSERT_EQUAL_UINT64( 3000000ULL, lr11xx_energy_get_charge( &energy, LR11XX_ENERGY_SUBSYSTEM_SPI ) );
+    TEST_ASSERT_EQUAL_UINT64( 3000000000ULL, lr11xx_energy_get_charge( &energy, LR11XX_ENERGY_SUBSYSTEM_MCU_RUN ) );
+    TEST_ASSERT_EQUAL_UINT64( 2000000ULL, lr11xx_energy_get_charge( &energy, LR11XX_ENERGY_SUBSYSTEM_MCU_STOP ) );
+    TEST_ASSERT_EQUAL_UINT64( 0, lr11xx_energy_get_charge( &energy, LR11XX_ENERGY_SUBSYSTEM_COUNT ) );
+    TEST_ASSERT_EQUAL_UINT64( 7105000000ULL, lr11xx_energy_get_total_charge( &energy ) );
+}
+
+void test_lr11xx_energy_budget( void )
+{
+    lr11xx_energy_t unlimited;
+
+    // 2 uAh = 7.2e9 uA.us
+    TEST_ASSERT_EQUAL_UINT32( 2, lr11xx_energy_get_remaining_budget_in_uah( &energy ) );
+
+    lr11xx_energy_add_mcu( &energy, 1000000, 0 );
+
+    TEST_ASSERT_EQUAL_UINT32( 1, lr11xx_energy_get_remaining_budget_in_uah( &energy ) );
+    TEST_ASSERT_TRUE( lr11xx_energy_can_afford( &energy, 4200000000ULL ) );
+    TEST_ASSERT_FALSE( lr11xx_energy_can_afford( &energy, 4200000001ULL ) );
+
+    lr11xx_energy_add_tx( &energy, 22, 40000 );
+
+    TEST_ASSERT_EQUAL_UINT32( 0, lr11xx_energy_get_remaining_budget_in_uah( &energy ) );
+    TEST_ASSERT_FALSE( lr11xx_energy_can_afford( &energy, 0 ) );
+
+    lr11xx_energy_init( &unlimited, &profile, 0 );
+    lr11xx_energy_add_mcu( &unlimited, 1000000, 0 );
+    TEST_ASSERT_TRUE( lr11xx_energy_can_afford( &unlimited, 1000000000000ULL ) );
+}
+
+void test_lr11xx_energy_scans( void )
+{
+    const lr11xx_wifi_cumulative_timings_t wifi_timings = {
+        .rx_detection_us   = 0,
+        .rx_correlation_us = 20000,
+        .rx_capture_us     = 60000,
+        .demodulation_us   = 10000,
+    };
+    const lr11xx_gnss_timings_t gnss_timings = { .radio_ms = 1500, .computation_ms = 300 };
+    lr11xx_energy_profile_t     ldo_profile  = profile;
+    uint64_t                    gnss_charge;
+
+    ldo_profile.regulator = LR11XX_SYSTEM_REG_MODE_LDO;
+
+    // A short scan is below 1 uAh, which lr11xx_wifi_get_consumption rounds down to 0
+    TEST_ASSERT_EQUAL_UINT64( 0, lr11xx_wifi_get_consumption( LR11XX_SYSTEM_REG_MODE_DCDC, wifi_timings ) );
+    TEST_ASSERT_EQUAL_UINT64( 1000000000ULL, lr11xx_energy_estimate_wifi( &profile, wifi_timings ) );
+    TEST_ASSERT_EQUAL_UINT64( 2000000000ULL, lr11xx_energy_estimate_wifi( &ldo_profile, wifi_timings ) );
+
+    gnss_charge = lr11xx_energy_estimate_gnss( &profile, gnss_timings, LR11XX_GNSS_GPS_MASK );
+    TEST_ASSERT_EQUAL_UINT32( lr11xx_gnss_get_consumption( LR11XX_SYSTEM_REG_MODE_DCDC, gnss_timings,
+                                                           LR11XX_GNSS_GPS_MASK ),
+                              ( uint32_t ) ( gnss_charge / 1000 / ( 3600000 - 1800 ) ) );
+    TEST_ASSERT_EQUAL_UINT32( lr11xx_gnss_get_consumption( LR11XX_SYSTEM_REG_MODE_LDO, gnss_timings,
+                                                           LR11XX_GNSS_GPS_MASK | LR11XX_GNSS_BEIDOU_MASK ),
+                              ( uint32_t ) ( lr11xx_energy_estimate_gnss( &ldo_profile, gnss_timings,
+                                                                          LR11XX_GNSS_GPS_MASK |
+                                                                              LR11XX_GNSS_BEIDOU_MASK ) /
+                                             1000 / ( 3600000 - 1800 ) ) );
+
+    lr11xx_energy_add_wifi( &energy, wifi_timings );
+    lr11xx_energy_add_gnss( &energy, gnss_timings, LR11XX_GNSS_GPS_MASK );
+
+    TEST_ASSERT_EQUAL_UINT64( 1000000000ULL, lr11xx_energy_get_charge( &energy, LR11XX_ENERGY_SUBSYSTEM_WIFI ) );
+    TEST_ASSERT_EQUAL_UINT64( gnss_charge, lr11xx_energy_get_charge( &energy, LR11XX_ENERGY_SUBSYSTEM_GNSS ) );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,285 @@
+/**
+ * @file      test_lr11xx_gnss_almanac_stream.c
+ *
+ * @brief     LR11XX test cases for the streaming almanac update
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include "unity.h"
+#include "lr11xx_gnss_almanac_stream.h"
+#include "lr11xx_gnss.h"
+#include "mock_lr11xx_hal.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#define IMAGE_SIZE ( LR11XX_GNSS_ALMANAC_STREAM_NB_BLOCKS * LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE )
+#define IMAGE_CRC ( 0x12345678 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+void* context;
+
+static uint8_t                      image[IMAGE_SIZE];
+static lr11xx_gnss_almanac_stream_t stream;
+
+static uint16_t            fake_write_async_nb_calls;
+static uint16_t            fake_write_async_nb_blocks;
+static bool                fake_write_async_is_ok;
+static lr11xx_hal_status_t fake_write_async_callback_status;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+static void expect_context_status( uint32_t global_almanac_crc );
+
+static bool failing_reader( void* user_context, uint16_t first_block, uint8_t nb_blocks, uint8_t* blocks );
+
+static lr11xx_hal_status_t fake_write_async( const void* context, const uint8_t* command, const uint16_t command_length,
+                                             const uint8_t* data, const uint16_t data_length,
+                                             lr11xx_hal_callback_t callback, void* user_context );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void setUp( void )
+{
+    image[0] = 0x80;
+    image[1] = 0x10;
+    image[2] = 0x02;
+    image[3] = ( uint8_t ) ( IMAGE_CRC >> 0 );
+    image[4] = ( uint8_t ) ( IMAGE_CRC >> 8 );
+    image[5] = ( uint8_t ) ( IMAGE_CRC >> 16 );
+    image[6] = ( uint8_t ) ( IMAGE_CRC >> 24 );
+
+    for( uint16_t index = LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE; index < IMAGE_SIZE; index++ )
+    {
+        image[index] = ( uint8_t ) index;
+    }
+
+    for( uint8_t sv_id = 0; sv_id < LR11XX_GNSS_FULL_UPDATE_N_ALMANACS; sv_id++ )
+    {
+        image[( sv_id + 1 ) * LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE] = sv_id;
+    }
+
+    lr11xx_gnss_almanac_stream_init( &stream, lr11xx_gnss_almanac_stream_read_from_memory, image );
+
+    fake_write_async_nb_calls        = 0;
+    fake_write_async_nb_blocks       = 0;
+    fake_write_async_is_ok           = true;
+    fake_write_async_callback_status = LR11XX_HAL_STATUS_OK;
+}
+
+void tearDown( void )
+{
+}
+
+void test_lr11xx_gnss_almanac_stream_up_to_date( void )
+{
+    lr11xx_gnss_almanac_stream_outcome_t outcome = LR11XX_GNSS_ALMANAC_STREAM_UPDATED;
+
+    expect_context_status( IMAGE_CRC );
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_gnss_almanac_stream_update( context, &stream, &outcome ) );
+    TEST_ASSERT_EQUAL( LR11XX_GNSS_ALMANAC_STREAM_UP_TO_DATE, outcome );
+}
+
+void test_lr11xx_gnss_almanac_stream_update_in_chunks( void )
+{
+    uint8_t                              cbuffer_expected[] = { 0x04, 0x0E };
+    lr11xx_gnss_almanac_stream_outcome_t outcome            = LR11XX_GNSS_ALMANAC_STREAM_UP_TO_DATE;
+
+    expect_context_status( IMAGE_CRC + 1 );
+
+    for( uint16_t first_block = 0; first_block < LR11XX_GNSS_ALMANAC_STREAM_NB_BLOCKS;
+         first_block += LR11XX_GNSS_ALMANAC_STREAM_CHUNK_NB_BLOCKS )
+    {
+        uint16_t nb_blocks = LR11XX_GNSS_ALMANAC_STREAM_NB_BLOCKS - first_block;
+
+        if( nb_blocks > LR11XX_GNSS_ALMANAC_STREAM_CHUNK_NB_BLOCKS )
+        {
+            nb_blocks = LR11XX_GNSS_ALMANAC_STREAM_CHUNK_NB_BLOCKS;
+        }
+
+        lr11xx_hal_write_ExpectWithArrayAndReturn(
+            context, 0, cbuffer_expected, 2, 2, &image[first_block * LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE],
+            nb_blocks * LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE, nb_blocks * LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE,
+            LR11XX_HAL_STATUS_OK );
+    }
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_gnss_almanac_stream_update( context, &stream, &outcome ) );
+    TEST_ASSERT_EQUAL( LR11XX_GNSS_ALMANAC_STREAM_UPDATED, outcome );
+}
+
+void test_lr11xx_gnss_almanac_stream_write_error( void )
+{
+    uint8_t                              cbuffer_expected[] = { 0x04, 0x0E };
+    lr11xx_gnss_almanac_stream_outcome_t outcome            = LR11XX_GNSS_ALMANAC_STREAM_UP_TO_DATE;
+
+    expect_context_status( IMAGE_CRC + 1 );
+    lr11xx_hal_write_ExpectWithArrayAndReturn(
+        context, 0, cbuffer_expected, 2, 2, image,
+        LR11XX_GNSS_ALMANAC_STREAM_CHUNK_NB_BLOCKS * LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE,
+        LR11XX_GNSS_ALMANAC_STREAM_CHUNK_NB_BLOCKS * LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE, LR11XX_HAL_STATUS_ERROR );
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_ERROR, lr11xx_gnss_almanac_stream_update( context, &stream, &outcome ) );
+    TEST_ASSERT_EQUAL( LR11XX_GNSS_ALMANAC_STREAM_UP_TO_DATE, outcome );
+}
+
+void test_lr11xx_gnss_almanac_stream_update_async( void )
+{
+    lr11xx_gnss_almanac_stream_outcome_t outcome = LR11XX_GNSS_ALMANAC_STREAM_UP_TO_DATE;
+
+    stream.write_async = fake_write_async;
+    expect_context_status( IMAGE_CRC + 1 );
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_gnss_almanac_stream_update( context, &stream, &outcome ) );
+    TEST_ASSERT_EQUAL( LR11XX_GNSS_ALMANAC_STREAM_UPDATED, outcome );
+    TEST_ASSERT_EQUAL( ( LR11XX_GNSS_ALMANAC_STREAM_NB_BLOCKS + LR11XX_GNSS_ALMANAC_STREAM_CHUNK_NB_BLOCKS - 1 ) /
+                           LR11XX_GNSS_ALMANAC_STREAM_CHUNK_NB_BLOCKS,
+                       fake_write_async_nb_calls );
+    TEST_ASSERT_EQUAL( LR11XX_GNSS_ALMANAC_STREAM_NB_BLOCKS, fake_write_async_nb_blocks );
+    TEST_ASSERT_FALSE( stream.is_transfer_ongoing );
+}
+
+void test_lr11xx_gnss_almanac_stream_update_async_error( void )
+{
+    lr11xx_gnss_almanac_stream_outcome_t outcome = LR11XX_GNSS_ALMANAC_STREAM_UP_TO_DATE;
+
+    // Transfer not scheduled
+    stream.write_async     = fake_write_async;
+    fake_write_async_is_ok = false;
+    expect_context_status( IMAGE_CRC + 1 );
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_ERROR, lr11xx_gnss_almanac_stream_update( context, &stream, &outcome ) );
+    TEST_ASSERT_EQUAL( LR11XX_GNSS_ALMANAC_STREAM_UP_TO_DATE, outcome );
+    TEST_ASSERT_FALSE( stream.is_transfer_ongoing );
+
+    // Transfer failed
+    fake_write_async_is_ok           = true;
+    fake_write_async_callback_status = LR11XX_HAL_STATUS_ERROR;
+    expect_context_status( IMAGE_CRC + 1 );
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_ERROR, lr11xx_gnss_almanac_stream_update( context, &stream, &outcome ) );
+    TEST_ASSERT_EQUAL( 1, fake_write_async_nb_calls );
+}
+
+void test_lr11xx_gnss_almanac_stream_reader_error( void )
+{
+    lr11xx_gnss_almanac_stream_outcome_t outcome = LR11XX_GNSS_ALMANAC_STREAM_UP_TO_DATE;
+
+    lr11xx_gnss_almanac_stream_init( &stream, failing_reader, NULL );
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_ERROR, lr11xx_gnss_almanac_stream_update( context, &stream, &outcome ) );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void expect_context_status( uint32_t global_almanac_crc )
+{
+    static uint8_t cbuffer_expected[]  = { 0x04, 0x16 };
+    static uint8_t rbuffer_out_faked[] = { 0x02, 0x18, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+    rbuffer_out_faked[3] = ( uint8_t ) ( global_almanac_crc >> 0 );
+    rbuffer_out_faked[4] = ( uint8_t ) ( global_almanac_crc >> 8 );
+    rbuffer_out_faked[5] = ( uint8_t ) ( global_almanac_crc >> 16 );
+    rbuffer_out_faked[6] = ( uint8_t ) ( global_almanac_crc >> 24 );
+
+    lr11xx_hal_read_ExpectWithArrayAndReturn( context, 0, cbuffer_expected, 2, 2, NULL, 9, 0, LR11XX_HAL_STATUS_OK );
+    lr11xx_hal_read_IgnoreArg_data( );
+    lr11xx_hal_read_ReturnArrayThruPtr_data( rbuffer_out_faked, 9 );
+}
+
+static bool failing_reader( void* user_context, uint16_t first_block, uint8_t nb_blocks, uint8_t* blocks )
+{
+    ( void ) user_context;
+    ( void ) first_block;
+    ( void ) nb_blocks;
+    ( void ) blocks;
+
+    return false;
+}
+
+static lr11xx_hal_status_t fake_write_async( const void* context, const uint8_t* command, const uint16_t command_length,
+                                             const uint8_t* data, const uint16_t data_length,
+                                             lr11xx_hal_callback_t callback, void* user_context )
+{
+    const uint16_t first_byte = fake_write_async_nb_blocks * LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE;
+
+    ( void ) context;
+
+    if( fake_write_async_is_ok == false )
+    {
+        return LR11XX_HAL_STATUS_ERROR;
+    }
+
+    TEST_ASSERT_EQUAL( 2, command_length );
+    TEST_ASSERT_EQUAL_HEX8( 0x04, command[0] );
+    TEST_ASSERT_EQUAL_HEX8( 0x0E, command[1] );
+    TEST_ASSERT_EQUAL( 0, data_length % LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE );
+    TEST_ASSERT_EQUAL_HEX8_ARRAY( &image[first_byte], data, data_length );
+
+    fake_write_async_nb_calls++;
+    fake_write_async_nb_blocks += data_length / LR11XX_GNSS_SINGLE_ALMANAC_WRITE_SIZE;
+
+    // Completes at once, as an interrupt raised before the function returns would
+    callback( fake_write_async_callback_status, user_context );
+
+    return LR11XX_HAL_STATUS_OK;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,251 @@
+/**
+ * @file      test_lr11xx_gnss_nav_batch.c
+ *
+ * @brief     LR11XX test cases for the GNSS NAV message batching
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "lr11xx_gnss_nav_batch.h"
+#include "lr11xx_gnss.h"
+#include "mock_lr11xx_hal.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#define NAV_LENGTH ( 20 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+void* context;
+
+static lr11xx_gnss_nav_batch_t     batch;
+static const lr11xx_gnss_timings_t timings = { .radio_ms = 1500, .computation_ms = 300 };
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+static void make_result( uint8_t destination, uint8_t seed, uint8_t* result );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void setUp( void )
+{
+    lr11xx_gnss_nav_batch_init( &batch );
+}
+
+void tearDown( void )
+{
+}
+
+void test_lr11xx_gnss_nav_batch_add_result( void )
+{
+    uint8_t        result[NAV_LENGTH + 1];
+    const uint32_t consumption =
+        lr11xx_gnss_get_consumption( LR11XX_SYSTEM_REG_MODE_DCDC, timings, LR11XX_GNSS_GPS_MASK );
+
+    make_result( LR11XX_GNSS_DESTINATION_HOST, 0, result );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_ERROR,
+                       lr11xx_gnss_nav_batch_add_result( &batch, 1000, result, sizeof( result ), timings,
+                                                         LR11XX_SYSTEM_REG_MODE_DCDC, LR11XX_GNSS_GPS_MASK ) );
+
+    make_result( LR11XX_GNSS_DESTINATION_SOLVER, 0, result );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK,
+                       lr11xx_gnss_nav_batch_add_result( &batch, 1000, result, sizeof( result ), timings,
+                                                         LR11XX_SYSTEM_REG_MODE_DCDC, LR11XX_GNSS_GPS_MASK ) );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_ERROR,
+                       lr11xx_gnss_nav_batch_add_result( &batch, 999, result, sizeof( result ), timings,
+                                                         LR11XX_SYSTEM_REG_MODE_DCDC, LR11XX_GNSS_GPS_MASK ) );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK,
+                       lr11xx_gnss_nav_batch_add_result( &batch, 1030, result, sizeof( result ), timings,
+                                                         LR11XX_SYSTEM_REG_MODE_DCDC, LR11XX_GNSS_GPS_MASK ) );
+
+    TEST_ASSERT_EQUAL_UINT8( 2, batch.nb_scans );
+    TEST_ASSERT_EQUAL_UINT8( NAV_LENGTH, batch.scans[1].nav_length );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &result[1], batch.scans[1].nav, NAV_LENGTH );
+    TEST_ASSERT_EQUAL_UINT32( consumption, batch.scans[1].consumption_in_uah );
+    TEST_ASSERT_EQUAL_UINT32( 2 * consumption, batch.total_consumption_in_uah );
+    TEST_ASSERT_EQUAL_UINT32( 3000, batch.total_radio_ms );
+    TEST_ASSERT_EQUAL_UINT32( 600, batch.total_computation_ms );
+}
+
+void test_lr11xx_gnss_nav_batch_add_last_scan( void )
+{
+    uint8_t cbuffer_size_expected[]    = { 0x04, 0x0C };
+    uint8_t cbuffer_read_expected[]    = { 0x04, 0x0D };
+    uint8_t cbuffer_timings_expected[] = { 0x04, 0x19 };
+    uint8_t rbuffer_size_faked[]       = { 0x00, NAV_LENGTH + 1 };
+    uint8_t rbuffer_timings_faked[]    = { 0x00, 0x04, 0x93, 0xE0, 0x00, 0x16, 0xE3, 0x60 };
+    uint8_t result[NAV_LENGTH + 1];
+
+    make_result( LR11XX_GNSS_DESTINATION_SOLVER, 7, result );
+
+    lr11xx_hal_read_ExpectWithArrayAndReturn( context, 0, cbuffer_size_expected, 2, 2, NULL, 2, 0,
+                                              LR11XX_HAL_STATUS_OK );
+    lr11xx_hal_read_IgnoreArg_data( );
+    lr11xx_hal_read_ReturnArrayThruPtr_data( rbuffer_size_faked, 2 );
+    lr11xx_hal_read_ExpectWithArrayAndReturn( context, 0, cbuffer_read_expected, 2, 2, NULL, NAV_LENGTH + 1, 0,
+                                              LR11XX_HAL_STATUS_OK );
+    lr11xx_hal_read_IgnoreArg_data( );
+    lr11xx_hal_read_ReturnArrayThruPtr_data( result, NAV_LENGTH + 1 );
+    lr11xx_hal_read_ExpectWithArrayAndReturn( context, 0, cbuffer_timings_expected, 2, 2, NULL, 8, 0,
+                                              LR11XX_HAL_STATUS_OK );
+    lr11xx_hal_read_IgnoreArg_data( );
+    lr11xx_hal_read_ReturnArrayThruPtr_data( rbuffer_timings_faked, 8 );
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_gnss_nav_batch_add_last_scan(
+                                             context, &batch, 1000, LR11XX_SYSTEM_REG_MODE_DCDC,
+                                             LR11XX_GNSS_GPS_MASK | LR11XX_GNSS_BEIDOU_MASK ) );
+
+    TEST_ASSERT_EQUAL_UINT8( 1, batch.nb_scans );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &result[1], batch.scans[0].nav, NAV_LENGTH );
+    TEST_ASSERT_EQUAL_UINT32( 300, batch.scans[0].timings.computation_ms );
+    TEST_ASSERT_EQUAL_UINT32( 1500, batch.scans[0].timings.radio_ms );
+}
+
+void test_lr11xx_gnss_nav_batch_encode_decode( void )
+{
+    const uint32_t                       timestamps[] = { 1000, 1030, 1230, 1231 };
+    uint8_t                              result[NAV_LENGTH + 1];
+    uint8_t                              payload[51];
+    lr11xx_gnss_nav_batch_decoded_scan_t decoded[LR11XX_GNSS_NAV_BATCH_MAX_SCANS];
+    uint8_t                              nb_decoded = 0;
+    uint8_t                              first_scan = 0;
+    uint8_t                              nb_uplinks = 0;
+    uint8_t                              nb_encoded = 0;
+    uint8_t                              length     = 0;
+
+    for( uint8_t index = 0; index < 4; index++ )
+    {
+        make_result( LR11XX_GNSS_DESTINATION_SOLVER, index, result );
+        TEST_ASSERT_EQUAL( LR11XX_STATUS_OK,
+                           lr11xx_gnss_nav_batch_add_result( &batch, timestamps[index], result, sizeof( result ),
+                                                             timings, LR11XX_SYSTEM_REG_MODE_LDO,
+                                                             LR11XX_GNSS_GPS_MASK ) );
+    }
+
+    // The header, two NAV messages with their length and a one-byte time delta fill a 51-byte uplink
+    while( first_scan < batch.nb_scans )
+    {
+        length = lr11xx_gnss_nav_batch_encode( &batch, first_scan, payload, sizeof( payload ), &nb_encoded );
+
+        TEST_ASSERT_EQUAL_UINT8( 2, nb_encoded );
+        TEST_ASSERT_EQUAL_UINT8( LR11XX_GNSS_NAV_BATCH_HEADER_SIZE + 1 + 2 * ( 1 + NAV_LENGTH ), length );
+        TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_gnss_nav_batch_decode( payload, length, decoded,
+                                                                           LR11XX_GNSS_NAV_BATCH_MAX_SCANS,
+                                                                           &nb_decoded ) );
+        TEST_ASSERT_EQUAL_UINT8( nb_encoded, nb_decoded );
+
+        for( uint8_t index = 0; index < nb_decoded; index++ )
+        {
+            TEST_ASSERT_EQUAL_UINT32( timestamps[first_scan + index], decoded[index].timestamp_in_s );
+            TEST_ASSERT_EQUAL_UINT8( NAV_LENGTH, decoded[index].nav_length );
+            TEST_ASSERT_EQUAL_UINT8_ARRAY( batch.scans[first_scan + index].nav, decoded[index].nav, NAV_LENGTH );
+        }
+
+        first_scan += nb_encoded;
+        nb_uplinks++;
+    }
+
+    TEST_ASSERT_EQUAL_UINT8( 2, nb_uplinks );
+
+    // A scan larger than the uplink is never encoded
+    TEST_ASSERT_EQUAL_UINT8( 0, lr11xx_gnss_nav_batch_encode( &batch, 0, payload, 25, &nb_encoded ) );
+    TEST_ASSERT_EQUAL_UINT8( 0, nb_encoded );
+}
+
+void test_lr11xx_gnss_nav_batch_decode_malformed( void )
+{
+    uint8_t                              result[NAV_LENGTH + 1];
+    uint8_t                              payload[64];
+    lr11xx_gnss_nav_batch_decoded_scan_t decoded[LR11XX_GNSS_NAV_BATCH_MAX_SCANS];
+    uint8_t                              nb_decoded = 0;
+    uint8_t                              nb_encoded = 0;
+    uint8_t                              length;
+
+    make_result( LR11XX_GNSS_DESTINATION_SOLVER, 0, result );
+    lr11xx_gnss_nav_batch_add_result( &batch, 1000, result, sizeof( result ), timings, LR11XX_SYSTEM_REG_MODE_LDO,
+                                      LR11XX_GNSS_GPS_MASK );
+    lr11xx_gnss_nav_batch_add_result( &batch, 1000 + 300, result, sizeof( result ), timings,
+                                      LR11XX_SYSTEM_REG_MODE_LDO, LR11XX_GNSS_GPS_MASK );
+    length = lr11xx_gnss_nav_batch_encode( &batch, 0, payload, sizeof( payload ), &nb_encoded );
+    TEST_ASSERT_EQUAL_UINT8( 2, nb_encoded );
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_ERROR,
+                       lr11xx_gnss_nav_batch_decode( payload, length - 1, decoded, 2, &nb_decoded ) );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_ERROR, lr11xx_gnss_nav_batch_decode( payload, length, decoded, 1, &nb_decoded ) );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_ERROR,
+                       lr11xx_gnss_nav_batch_decode( payload, LR11XX_GNSS_NAV_BATCH_HEADER_SIZE + NAV_LENGTH + 2,
+                                                     decoded, 2, &nb_decoded ) );
+    TEST_ASSERT_EQUAL_UINT8( 0, nb_decoded );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void make_result( uint8_t destination, uint8_t seed, uint8_t* result )
+{
+    result[0] = destination;
+
+    for( uint8_t index = 1; index <= NAV_LENGTH; index++ )
+    {
+        result[index] = ( uint8_t ) ( seed * 31 + index );
+    }
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,524 @@
+/**
+ * @file      test_lr11xx_hal_xfer.c
+ *
+ * @brief     LR11XX test cases for the HAL SPI transaction engine
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include "unity.h"
+#include "lr11xx_hal_xfer.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#define FAKE_BUS_LENGTH_MAX 64
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief Model of the radio side of the bus: busy line, NSS line and a DMA engine
+ */
+typedef struct fake_radio_s
+{
+    bool                           busy;
+    bool                           nss_high;
+    int                            nb_nss_falls;
+    int                            nb_busy_irq_armed;
+    int                            nb_frames_started;
+    const lr11xx_hal_xfer_frame_t* frame_in_flight;
+    lr11xx_hal_status_t            start_frame_status;
+    bool                           complete_in_start;
+    uint8_t                        mosi[FAKE_BUS_LENGTH_MAX];
+    uint16_t                       mosi_length;
+    uint8_t                        miso[FAKE_BUS_LENGTH_MAX];
+    uint16_t                       miso_index;
+} fake_radio_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static fake_radio_t      radio;
+static lr11xx_hal_xfer_t xfer;
+
+static int                 nb_callbacks;
+static lr11xx_hal_status_t callback_status;
+static void*               callback_context;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+static bool                fake_is_busy( const void* context );
+static void                fake_set_nss( const void* context, bool is_high );
+static void                fake_arm_busy_irq( const void* context );
+static lr11xx_hal_status_t fake_start_frame( const void* context, const lr11xx_hal_xfer_frame_t* frame );
+static void                fake_dma_complete( lr11xx_hal_status_t status );
+static void                on_xfer_done( lr11xx_hal_status_t status, void* context );
+
+static const lr11xx_hal_xfer_ops_t fake_ops = {
+    .is_busy      = fake_is_busy,
+    .set_nss      = fake_set_nss,
+    .arm_busy_irq = fake_arm_busy_irq,
+    .start_frame  = fake_start_frame,
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void setUp( void )
+{
+    memset( &radio, 0, sizeof( radio ) );
+    radio.nss_high           = true;
+    radio.start_frame_status = LR11XX_HAL_STATUS_OK;
+
+    nb_callbacks     = 0;
+    callback_status  = LR11XX_HAL_STATUS_ERROR;
+    callback_context = NULL;
+
+    lr11xx_hal_xfer_init( &xfer, &fake_ops, &radio );
+}
+
+void tearDown( void )
+{
+}
+
+void test_lr11xx_hal_xfer_prepare_write( )
+{
+    uint8_t       command[] = { 0x02, 0x0E, 0x11 };
+    const uint8_t data[]    = { 0xAA, 0xBB };
+
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_OK,
+                           lr11xx_hal_xfer_prepare_write( &xfer, command, sizeof( command ), data, sizeof( data ) ) );
+
+    // The command is copied so that the caller may reuse its buffer
+    command[0] = 0xFF;
+
+    TEST_ASSERT_FALSE( lr11xx_hal_xfer_is_idle( &xfer ) );
+    TEST_ASSERT_EQUAL_UINT8( 1, xfer.nb_frames );
+    TEST_ASSERT_EQUAL_UINT8( 2, xfer.frames[0].nb_segments );
+    TEST_ASSERT_EQUAL_HEX8( 0x02, xfer.frames[0].segments[0].tx[0] );
+    TEST_ASSERT_EQUAL_UINT16( 3, xfer.frames[0].segments[0].length );
+    TEST_ASSERT_NULL( xfer.frames[0].segments[0].rx );
+    TEST_ASSERT_EQUAL_PTR( data, xfer.frames[0].segments[1].tx );
+    TEST_ASSERT_EQUAL_UINT16( 2, xfer.frames[0].segments[1].length );
+}
+
+void test_lr11xx_hal_xfer_prepare_write_without_data( )
+{
+    const uint8_t command[] = { 0x01, 0x00 };
+
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_OK,
+                           lr11xx_hal_xfer_prepare_write( &xfer, command, sizeof( command ), NULL, 0 ) );
+
+    TEST_ASSERT_EQUAL_UINT8( 1, xfer.frames[0].nb_segments );
+}
+
+void test_lr11xx_hal_xfer_prepare_read( )
+{
+    const uint8_t command[] = { 0x03, 0x05 };
+    uint8_t       data[1020];
+
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_OK,
+                           lr11xx_hal_xfer_prepare_read( &xfer, command, sizeof( command ), data, sizeof( data ) ) );
+
+    TEST_ASSERT_EQUAL_UINT8( 2, xfer.nb_frames );
+    TEST_ASSERT_EQUAL_UINT8( 1, xfer.frames[0].nb_segments );
+    TEST_ASSERT_EQUAL_UINT8( 2, xfer.frames[1].nb_segments );
+
+    // Status byte, then data - both clocked out with NOP bytes
+    TEST_ASSERT_NULL( xfer.frames[1].segments[0].tx );
+    TEST_ASSERT_EQUAL_UINT16( 1, xfer.frames[1].segments[0].length );
+    TEST_ASSERT_NULL( xfer.frames[1].segments[1].tx );
+    TEST_ASSERT_EQUAL_PTR( data, xfer.frames[1].segments[1].rx );
+    TEST_ASSERT_EQUAL_UINT16( 1020, xfer.frames[1].segments[1].length );
+}
+
+void test_lr11xx_hal_xfer_prepare_rejected_when_not_idle( )
+{
+    const uint8_t command[] = { 0x01, 0x00 };
+    uint8_t       data[2];
+
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_OK,
+                           lr11xx_hal_xfer_prepare_write( &xfer, command, sizeof( command ), NULL, 0 ) );
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_ERROR,
+                           lr11xx_hal_xfer_prepare_read( &xfer, command, sizeof( command ), data, sizeof( data ) ) );
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_ERROR, lr11xx_hal_xfer_prepare_direct_read( &xfer, data, sizeof( data ) ) );
+
+    lr11xx_hal_xfer_release( &xfer );
+
+    TEST_ASSERT_TRUE( lr11xx_hal_xfer_is_idle( &xfer ) );
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_OK, lr11xx_hal_xfer_prepare_direct_read( &xfer, data, sizeof( data ) ) );
+}
+
+void test_lr11xx_hal_xfer_prepare_rejects_too_long_command( )
+{
+    uint8_t command[LR11XX_HAL_XFER_COMMAND_LENGTH_MAX + 1] = { 0 };
+
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_ERROR,
+                           lr11xx_hal_xfer_prepare_write( &xfer, command, sizeof( command ), NULL, 0 ) );
+    TEST_ASSERT_TRUE( lr11xx_hal_xfer_is_idle( &xfer ) );
+}
+
+void test_lr11xx_hal_xfer_start_requires_prepared_transaction( )
+{
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_ERROR, lr11xx_hal_xfer_start( &xfer, on_xfer_done, NULL ) );
+    TEST_ASSERT_EQUAL_INT( 0, radio.nb_frames_started );
+}
+
+void test_lr11xx_hal_xfer_write_when_not_busy( )
+{
+    const uint8_t command[] = { 0x02, 0x0E };
+    const uint8_t data[]    = { 0x11, 0x22, 0x33 };
+    int           user_context;
+
+    lr11xx_hal_xfer_prepare_write( &xfer, command, sizeof( command ), data, sizeof( data ) );
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_OK, lr11xx_hal_xfer_start( &xfer, on_xfer_done, &user_context ) );
+
+    // Frame is in flight: NSS low, nothing reported yet
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_XFER_STATE_IN_FLIGHT, xfer.state );
+    TEST_ASSERT_FALSE( radio.nss_high );
+    TEST_ASSERT_EQUAL_INT( 1, radio.nb_frames_started );
+    TEST_ASSERT_EQUAL_INT( 0, nb_callbacks );
+
+    fake_dma_complete( LR11XX_HAL_STATUS_OK );
+
+    const uint8_t mosi_expected[] = { 0x02, 0x0E, 0x11, 0x22, 0x33 };
+    TEST_ASSERT_EQUAL_UINT16( sizeof( mosi_expected ), radio.mosi_length );
+    TEST_ASSERT_EQUAL_HEX8_ARRAY( mosi_expected, radio.mosi, sizeof( mosi_expected ) );
+    TEST_ASSERT_TRUE( radio.nss_high );
+    TEST_ASSERT_EQUAL_INT( 1, radio.nb_nss_falls );
+    TEST_ASSERT_EQUAL_INT( 1, nb_callbacks );
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_OK, callback_status );
+    TEST_ASSERT_EQUAL_PTR( &user_context, callback_context );
+    TEST_ASSERT_TRUE( lr11xx_hal_xfer_is_idle( &xfer ) );
+    TEST_ASSERT_EQUAL_INT( 0, radio.nb_busy_irq_armed );
+}
+
+void test_lr11xx_hal_xfer_write_waits_for_busy( )
+{
+    const uint8_t command[] = { 0x02, 0x0E };
+
+    radio.busy = true;
+
+    lr11xx_hal_xfer_prepare_write( &xfer, command, sizeof( command ), NULL, 0 );
+    lr11xx_hal_xfer_start( &xfer, on_xfer_done, NULL );
+
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_XFER_STATE_WAIT_BUSY, xfer.state );
+    TEST_ASSERT_EQUAL_INT( 1, radio.nb_busy_irq_armed );
+    TEST_ASSERT_EQUAL_INT( 0, radio.nb_frames_started );
+    TEST_ASSERT_TRUE( radio.nss_high );
+
+    // Spurious notification - busy still high: re-armed, nothing started
+    lr11xx_hal_xfer_process( &xfer );
+    TEST_ASSERT_EQUAL_INT( 2, radio.nb_busy_irq_armed );
+    TEST_ASSERT_EQUAL_INT( 0, radio.nb_frames_started );
+
+    radio.busy = false;
+    lr11xx_hal_xfer_process( &xfer );
+    TEST_ASSERT_EQUAL_INT( 1, radio.nb_frames_started );
+    TEST_ASSERT_EQUAL_INT( 2, radio.nb_busy_irq_armed );
+
+    // Another notification while the frame is in flight is ignored
+    lr11xx_hal_xfer_process( &xfer );
+    TEST_ASSERT_EQUAL_INT( 1, radio.nb_frames_started );
+
+    fake_dma_complete( LR11XX_HAL_STATUS_OK );
+    TEST_ASSERT_EQUAL_INT( 1, nb_callbacks );
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_OK, callback_status );
+}
+
+void test_lr11xx_hal_xfer_read_two_frames( )
+{
+    const uint8_t command[] = { 0x03, 0x06, 0x00, 0x04 };
+    uint8_t       data[4]   = { 0 };
+
+    lr11xx_hal_xfer_prepare_read( &xfer, command, sizeof( command ), data, sizeof( data ) );
+    lr11xx_hal_xfer_start( &xfer, on_xfer_done, NULL );
+
+    // Command frame
+    TEST_ASSERT_EQUAL_INT( 1, radio.nb_frames_started );
+    fake_dma_complete( LR11XX_HAL_STATUS_OK );
+    TEST_ASSERT_TRUE( radio.nss_high );
+    TEST_ASSERT_EQUAL_UINT16( 4, radio.mosi_length );
+    TEST_ASSERT_EQUAL_HEX8_ARRAY( command, radio.mosi, sizeof( command ) );
+
+    // The radio processes the command: the response frame is not started before busy is low
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_XFER_STATE_WAIT_BUSY, xfer.state );
+    TEST_ASSERT_EQUAL_INT( 1, radio.nb_busy_irq_armed );
+    TEST_ASSERT_EQUAL_INT( 1, radio.nb_frames_started );
+    TEST_ASSERT_EQUAL_INT( 0, nb_callbacks );
+
+    radio.busy = false;
+    radio.miso[0] = 0x04;  // Status
+    radio.miso[1] = 0xDE;
+    radio.miso[2] = 0xAD;
+    radio.miso[3] = 0xBE;
+    radio.miso[4] = 0xEF;
+    radio.mosi_length = 0;
+    lr11xx_hal_xfer_process( &xfer );
+
+    // Response frame
+    TEST_ASSERT_EQUAL_INT( 2, radio.nb_frames_started );
+    TEST_ASSERT_FALSE( radio.nss_high );
+    fake_dma_complete( LR11XX_HAL_STATUS_OK );
+
+    const uint8_t data_expected[] = { 0xDE, 0xAD, 0xBE, 0xEF };
+    const uint8_t nop_expected[5] = { LR11XX_NOP, LR11XX_NOP, LR11XX_NOP, LR11XX_NOP, LR11XX_NOP };
+    TEST_ASSERT_EQUAL_HEX8_ARRAY( data_expected, data, sizeof( data ) );
+    TEST_ASSERT_EQUAL_HEX8( 0x04, xfer.rx_status );
+    TEST_ASSERT_EQUAL_UINT16( 5, radio.mosi_length );
+    TEST_ASSERT_EQUAL_HEX8_ARRAY( nop_expected, radio.mosi, sizeof( nop_expected ) );
+    TEST_ASSERT_EQUAL_INT( 2, radio.nb_nss_falls );
+    TEST_ASSERT_TRUE( radio.nss_high );
+    TEST_ASSERT_EQUAL_INT( 1, nb_callbacks );
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_OK, callback_status );
+    TEST_ASSERT_TRUE( lr11xx_hal_xfer_is_idle( &xfer ) );
+}
+
+void test_lr11xx_hal_xfer_direct_read( )
+{
+    uint8_t data[2] = { 0 };
+
+    radio.miso[0] = 0x12;
+    radio.miso[1] = 0x34;
+
+    lr11xx_hal_xfer_prepare_direct_read( &xfer, data, sizeof( data ) );
+    lr11xx_hal_xfer_start( &xfer, on_xfer_done, NULL );
+    fake_dma_complete( LR11XX_HAL_STATUS_OK );
+
+    TEST_ASSERT_EQUAL_HEX8( 0x12, data[0] );
+    TEST_ASSERT_EQUAL_HEX8( 0x34, data[1] );
+    TEST_ASSERT_EQUAL_INT( 1, radio.nb_frames_started );
+    TEST_ASSERT_EQUAL_INT( 1, nb_callbacks );
+}
+
+void test_lr11xx_hal_xfer_frame_error_aborts_read( )
+{
+    const uint8_t command[] = { 0x03, 0x06 };
+    uint8_t       data[4];
+
+    lr11xx_hal_xfer_prepare_read( &xfer, command, sizeof( command ), data, sizeof( data ) );
+    lr11xx_hal_xfer_start( &xfer, on_xfer_done, NULL );
+    fake_dma_complete( LR11XX_HAL_STATUS_ERROR );
+
+    TEST_ASSERT_TRUE( radio.nss_high );
+    TEST_ASSERT_EQUAL_INT( 1, radio.nb_frames_started );
+    TEST_ASSERT_EQUAL_INT( 1, nb_callbacks );
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_ERROR, callback_status );
+    TEST_ASSERT_TRUE( lr11xx_hal_xfer_is_idle( &xfer ) );
+
+    // A late busy notification does not restart anything
+    radio.busy = false;
+    lr11xx_hal_xfer_process( &xfer );
+    TEST_ASSERT_EQUAL_INT( 1, radio.nb_frames_started );
+}
+
+void test_lr11xx_hal_xfer_start_frame_failure( )
+{
+    const uint8_t command[] = { 0x02, 0x0E };
+
+    radio.start_frame_status = LR11XX_HAL_STATUS_ERROR;
+
+    lr11xx_hal_xfer_prepare_write( &xfer, command, sizeof( command ), NULL, 0 );
+    lr11xx_hal_xfer_start( &xfer, on_xfer_done, NULL );
+
+    TEST_ASSERT_TRUE( radio.nss_high );
+    TEST_ASSERT_EQUAL_INT( 1, nb_callbacks );
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_ERROR, callback_status );
+    TEST_ASSERT_TRUE( lr11xx_hal_xfer_is_idle( &xfer ) );
+}
+
+void test_lr11xx_hal_xfer_frame_done_from_start_frame( )
+{
+    const uint8_t command[] = { 0x03, 0x06 };
+    uint8_t       data[2];
+
+    // Frames short enough to be exchanged before start_frame returns
+    radio.complete_in_start = true;
+
+    lr11xx_hal_xfer_prepare_read( &xfer, command, sizeof( command ), data, sizeof( data ) );
+    lr11xx_hal_xfer_start( &xfer, on_xfer_done, NULL );
+
+    TEST_ASSERT_EQUAL_INT( 1, radio.nb_frames_started );
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_XFER_STATE_WAIT_BUSY, xfer.state );
+
+    radio.busy = false;
+    lr11xx_hal_xfer_process( &xfer );
+
+    TEST_ASSERT_EQUAL_INT( 2, radio.nb_frames_started );
+    TEST_ASSERT_EQUAL_INT( 1, nb_callbacks );
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_OK, callback_status );
+    TEST_ASSERT_TRUE( radio.nss_high );
+}
+
+void test_lr11xx_hal_xfer_callback_can_chain_transaction( )
+{
+    const uint8_t command[] = { 0x02, 0x0E };
+
+    lr11xx_hal_xfer_prepare_write( &xfer, command, sizeof( command ), NULL, 0 );
+    lr11xx_hal_xfer_start( &xfer, on_xfer_done, NULL );
+    fake_dma_complete( LR11XX_HAL_STATUS_OK );
+
+    // Descriptor is released before the callback, so it can be reused right away
+    radio.busy = false;
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_OK,
+                           lr11xx_hal_xfer_prepare_write( &xfer, command, sizeof( command ), NULL, 0 ) );
+    TEST_ASSERT_EQUAL_INT( LR11XX_HAL_STATUS_OK, lr11xx_hal_xfer_start( &xfer, on_xfer_done, NULL ) );
+    fake_dma_complete( LR11XX_HAL_STATUS_OK );
+
+    TEST_ASSERT_EQUAL_INT( 2, nb_callbacks );
+}
+
+void test_lr11xx_hal_xfer_spurious_frame_done_ignored( )
+{
+    lr11xx_hal_xfer_on_frame_done( &xfer, LR11XX_HAL_STATUS_OK );
+
+    TEST_ASSERT_EQUAL_INT( 0, nb_callbacks );
+    TEST_ASSERT_TRUE( radio.nss_high );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static bool fake_is_busy( const void* context )
+{
+    return ( ( const fake_radio_t* ) context )->busy;
+}
+
+static void fake_set_nss( const void* context, bool is_high )
+{
+    fake_radio_t* fake = ( fake_radio_t* ) context;
+
+    if( ( fake->nss_high == true ) && ( is_high == false ) )
+    {
+        fake->nb_nss_falls++;
+    }
+
+    // The radio raises busy as soon as a frame is over
+    if( ( fake->nss_high == false ) && ( is_high == true ) )
+    {
+        fake->busy = true;
+    }
+
+    fake->nss_high = is_high;
+}
+
+static void fake_arm_busy_irq( const void* context )
+{
+    ( ( fake_radio_t* ) context )->nb_busy_irq_armed++;
+}
+
+static lr11xx_hal_status_t fake_start_frame( const void* context, const lr11xx_hal_xfer_frame_t* frame )
+{
+    fake_radio_t* fake = ( fake_radio_t* ) context;
+
+    TEST_ASSERT_FALSE( fake->nss_high );
+
+    fake->nb_frames_started++;
+
+    if( fake->start_frame_status != LR11XX_HAL_STATUS_OK )
+    {
+        return fake->start_frame_status;
+    }
+
+    fake->frame_in_flight = frame;
+
+    if( fake->complete_in_start == true )
+    {
+        fake_dma_complete( LR11XX_HAL_STATUS_OK );
+    }
+
+    return LR11XX_HAL_STATUS_OK;
+}
+
+static void fake_dma_complete( lr11xx_hal_status_t status )
+{
+    const lr11xx_hal_xfer_frame_t* frame = radio.frame_in_flight;
+
+    TEST_ASSERT_NOT_NULL( frame );
+
+    radio.frame_in_flight = NULL;
+
+    for( uint8_t i = 0; i < frame->nb_segments; i++ )
+    {
+        const lr11xx_hal_xfer_segment_t* segment = &frame->segments[i];
+
+        for( uint16_t j = 0; j < segment->length; j++ )
+        {
+            const uint8_t mosi = ( segment->tx != NULL ) ? segment->tx[j] : LR11XX_NOP;
+            const uint8_t miso = radio.miso[radio.miso_index++ % FAKE_BUS_LENGTH_MAX];
+
+            if( radio.mosi_length < FAKE_BUS_LENGTH_MAX )
+            {
+                radio.mosi[radio.mosi_length++] = mosi;
+            }
+
+            if( segment->rx != NULL )
+            {
+                segment->rx[j] = miso;
+            }
+        }
+    }
+
+    radio.miso_index = 0;
+
+    lr11xx_hal_xfer_on_frame_done( &xfer, status );
+}
+
+static void on_xfer_done( lr11xx_hal_status_t status, void* context )
+{
+    nb_callbacks++;
+    callback_status  = status;
+    callback_context = context;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,277 @@
+/**
+ * @file      test_lr11xx_irq_dispatch.c
+ *
+ * @brief     LR11XX test cases for the interrupt dispatcher
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include "unity.h"
+#include "lr11xx_irq_dispatch.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#define CALLS_MAX ( 8 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+typedef struct
+{
+    char                     handler;
+    const void*              context;
+    lr11xx_system_irq_mask_t irq_regs;
+    uint32_t                 timestamp_us;
+} call_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static lr11xx_irq_dispatch_t dispatch;
+
+static call_t  calls[CALLS_MAX];
+static uint8_t nb_calls;
+
+static const int radio = 0;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+static void record_call( char handler, const void* context, lr11xx_system_irq_mask_t irq_regs, uint32_t timestamp_us );
+static void handler_a( const void* context, lr11xx_system_irq_mask_t irq_regs, uint32_t timestamp_us );
+static void handler_b( const void* context, lr11xx_system_irq_mask_t irq_regs, uint32_t timestamp_us );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void setUp( void )
+{
+    lr11xx_irq_dispatch_init( &dispatch );
+    nb_calls = 0;
+}
+
+void tearDown( void ) {}
+
+void test_lr11xx_irq_dispatch_nothing_registered( void )
+{
+    TEST_ASSERT_EQUAL_HEX32( 0, lr11xx_irq_dispatch_run( &dispatch, &radio, LR11XX_SYSTEM_IRQ_ALL_MASK, 10 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0, nb_calls );
+}
+
+void test_lr11xx_irq_dispatch_priority_order( void )
+{
+    const lr11xx_system_irq_mask_t irq_regs = LR11XX_SYSTEM_IRQ_TX_DONE | LR11XX_SYSTEM_IRQ_RX_DONE |
+                                              LR11XX_SYSTEM_IRQ_PREAMBLE_DETECTED |
+                                              LR11XX_SYSTEM_IRQ_SYNC_WORD_HEADER_VALID | LR11XX_SYSTEM_IRQ_HEADER_ERROR;
+
+    lr11xx_irq_dispatch_register( &dispatch, LR11XX_SYSTEM_IRQ_TX_DONE | LR11XX_SYSTEM_IRQ_HEADER_ERROR, handler_a );
+    lr11xx_irq_dispatch_register( &dispatch, LR11XX_SYSTEM_IRQ_PREAMBLE_DETECTED, handler_b );
+    lr11xx_irq_dispatch_register( &dispatch, LR11XX_SYSTEM_IRQ_SYNC_WORD_HEADER_VALID, handler_b );
+    lr11xx_irq_dispatch_register( &dispatch, LR11XX_SYSTEM_IRQ_RX_DONE, handler_a );
+
+    TEST_ASSERT_EQUAL_HEX32( irq_regs, lr11xx_irq_dispatch_run( &dispatch, &radio, irq_regs, 0 ) );
+
+    // TX done, preamble, header error, syncword / header valid, then RX done - not in bit order
+    TEST_ASSERT_EQUAL_UINT8( 5, nb_calls );
+    TEST_ASSERT_EQUAL_UINT8( 'a', calls[0].handler );
+    TEST_ASSERT_EQUAL_UINT8( 'b', calls[1].handler );
+    TEST_ASSERT_EQUAL_UINT8( 'a', calls[2].handler );
+    TEST_ASSERT_EQUAL_UINT8( 'b', calls[3].handler );
+    TEST_ASSERT_EQUAL_UINT8( 'a', calls[4].handler );
+}
+
+void test_lr11xx_irq_dispatch_other_irqs_lowest_bit_first( void )
+{
+    const lr11xx_system_irq_mask_t irq_regs =
+        LR11XX_SYSTEM_IRQ_CMD_ERROR | LR11XX_SYSTEM_IRQ_EOL | LR11XX_SYSTEM_IRQ_GNSS_SCAN_DONE;
+
+    lr11xx_irq_dispatch_register( &dispatch, LR11XX_SYSTEM_IRQ_CMD_ERROR, handler_b );
+    lr11xx_irq_dispatch_register( &dispatch, LR11XX_SYSTEM_IRQ_EOL | LR11XX_SYSTEM_IRQ_GNSS_SCAN_DONE, handler_a );
+
+    lr11xx_irq_dispatch_run( &dispatch, &radio, irq_regs, 0 );
+
+    // GNSS scan done is in the priority table, EOL and command error follow in bit order
+    TEST_ASSERT_EQUAL_UINT8( 3, nb_calls );
+    TEST_ASSERT_EQUAL_UINT8( 'a', calls[0].handler );
+    TEST_ASSERT_EQUAL_UINT8( 'a', calls[1].handler );
+    TEST_ASSERT_EQUAL_UINT8( 'b', calls[2].handler );
+    TEST_ASSERT_EQUAL_HEX32( irq_regs, calls[2].irq_regs );
+}
+
+void test_lr11xx_irq_dispatch_context_and_status( void )
+{
+    const lr11xx_system_irq_mask_t irq_regs =
+        LR11XX_SYSTEM_IRQ_GNSS_SCAN_DONE | LR11XX_SYSTEM_IRQ_RX_DONE | LR11XX_SYSTEM_IRQ_CRC_ERROR;
+
+    lr11xx_irq_dispatch_register( &dispatch, LR11XX_SYSTEM_IRQ_GNSS_SCAN_DONE, handler_b );
+    lr11xx_irq_dispatch_register( &dispatch, LR11XX_SYSTEM_IRQ_RX_DONE, handler_a );
+
+    TEST_ASSERT_EQUAL_HEX32( LR11XX_SYSTEM_IRQ_GNSS_SCAN_DONE | LR11XX_SYSTEM_IRQ_RX_DONE,
+                             lr11xx_irq_dispatch_run( &dispatch, &radio, irq_regs, 1234 ) );
+
+    TEST_ASSERT_EQUAL_UINT8( 2, nb_calls );
+    TEST_ASSERT_EQUAL_UINT8( 'a', calls[0].handler );
+    TEST_ASSERT_EQUAL_UINT8( 'b', calls[1].handler );
+    for( uint8_t i = 0; i < nb_calls; i++ )
+    {
+        TEST_ASSERT_EQUAL_PTR( &radio, calls[i].context );
+        TEST_ASSERT_EQUAL_HEX32( irq_regs, calls[i].irq_regs );
+        TEST_ASSERT_EQUAL_UINT32( 1234, calls[i].timestamp_us );
+    }
+}
+
+void test_lr11xx_irq_dispatch_register_mask_and_unregister( void )
+{
+    lr11xx_irq_dispatch_register( &dispatch, LR11XX_SYSTEM_IRQ_TX_DONE | LR11XX_SYSTEM_IRQ_TIMEOUT, handler_a );
+
+    lr11xx_irq_dispatch_run( &dispatch, &radio, LR11XX_SYSTEM_IRQ_TX_DONE | LR11XX_SYSTEM_IRQ_TIMEOUT, 0 );
+    TEST_ASSERT_EQUAL_UINT8( 2, nb_calls );
+
+    lr11xx_irq_dispatch_register( &dispatch, LR11XX_SYSTEM_IRQ_TX_DONE, NULL );
+
+    TEST_ASSERT_EQUAL_HEX32( LR11XX_SYSTEM_IRQ_TIMEOUT,
+                             lr11xx_irq_dispatch_run( &dispatch, &radio, LR11XX_SYSTEM_IRQ_TX_DONE |
+                                                                             LR11XX_SYSTEM_IRQ_TIMEOUT, 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 3, nb_calls );
+}
+
+void test_lr11xx_irq_dispatch_highest_bit( void )
+{
+    lr11xx_irq_dispatch_register( &dispatch, LR11XX_SYSTEM_IRQ_LORA_RX_TIMESTAMP, handler_a );
+
+    TEST_ASSERT_EQUAL_HEX32( LR11XX_SYSTEM_IRQ_LORA_RX_TIMESTAMP,
+                             lr11xx_irq_dispatch_run( &dispatch, &radio, LR11XX_SYSTEM_IRQ_ALL_MASK, 0 ) );
+    TEST_ASSERT_EQUAL_UINT8( 1, nb_calls );
+}
+
+void test_lr11xx_irq_dispatch_queue_keeps_bursts( void )
+{
+    uint32_t timestamp_us;
+
+    TEST_ASSERT_FALSE( lr11xx_irq_dispatch_pop( &dispatch, &timestamp_us ) );
+
+    // Preamble detected, header valid and RX done edges in a row
+    TEST_ASSERT_TRUE( lr11xx_irq_dispatch_push( &dispatch, 100 ) );
+    TEST_ASSERT_TRUE( lr11xx_irq_dispatch_push( &dispatch, 250 ) );
+    TEST_ASSERT_TRUE( lr11xx_irq_dispatch_push( &dispatch, 900 ) );
+
+    TEST_ASSERT_TRUE( lr11xx_irq_dispatch_pop( &dispatch, &timestamp_us ) );
+    TEST_ASSERT_EQUAL_UINT32( 100, timestamp_us );
+    TEST_ASSERT_TRUE( lr11xx_irq_dispatch_pop( &dispatch, &timestamp_us ) );
+    TEST_ASSERT_EQUAL_UINT32( 250, timestamp_us );
+    TEST_ASSERT_TRUE( lr11xx_irq_dispatch_pop( &dispatch, &timestamp_us ) );
+    TEST_ASSERT_EQUAL_UINT32( 900, timestamp_us );
+    TEST_ASSERT_FALSE( lr11xx_irq_dispatch_pop( &dispatch, &timestamp_us ) );
+}
+
+void test_lr11xx_irq_dispatch_queue_full( void )
+{
+    uint32_t timestamp_us;
+
+    for( uint32_t i = 0; i < LR11XX_IRQ_DISPATCH_QUEUE_SIZE; i++ )
+    {
+        TEST_ASSERT_TRUE( lr11xx_irq_dispatch_push( &dispatch, i ) );
+    }
+
+    TEST_ASSERT_FALSE( lr11xx_irq_dispatch_push( &dispatch, 0xFFFF ) );
+    TEST_ASSERT_EQUAL_UINT32( 1, dispatch.nb_dropped );
+
+    // The oldest events are kept
+    TEST_ASSERT_TRUE( lr11xx_irq_dispatch_pop( &dispatch, &timestamp_us ) );
+    TEST_ASSERT_EQUAL_UINT32( 0, timestamp_us );
+    TEST_ASSERT_TRUE( lr11xx_irq_dispatch_push( &dispatch, 0xFFFF ) );
+}
+
+void test_lr11xx_irq_dispatch_queue_index_wrap( void )
+{
+    uint32_t timestamp_us;
+
+    // Run the free running indexes over their 8-bit range
+    for( uint32_t i = 0; i < 600; i++ )
+    {
+        TEST_ASSERT_TRUE( lr11xx_irq_dispatch_push( &dispatch, i ) );
+        TEST_ASSERT_TRUE( lr11xx_irq_dispatch_push( &dispatch, i + 1000 ) );
+        TEST_ASSERT_TRUE( lr11xx_irq_dispatch_pop( &dispatch, &timestamp_us ) );
+        TEST_ASSERT_EQUAL_UINT32( i, timestamp_us );
+        TEST_ASSERT_TRUE( lr11xx_irq_dispatch_pop( &dispatch, &timestamp_us ) );
+        TEST_ASSERT_EQUAL_UINT32( i + 1000, timestamp_us );
+    }
+
+    TEST_ASSERT_FALSE( lr11xx_irq_dispatch_pop( &dispatch, &timestamp_us ) );
+    TEST_ASSERT_EQUAL_UINT32( 0, dispatch.nb_dropped );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void record_call( char handler, const void* context, lr11xx_system_irq_mask_t irq_regs, uint32_t timestamp_us )
+{
+    TEST_ASSERT_TRUE( nb_calls < CALLS_MAX );
+
+    calls[nb_calls].handler      = handler;
+    calls[nb_calls].context      = context;
+    calls[nb_calls].irq_regs     = irq_regs;
+    calls[nb_calls].timestamp_us = timestamp_us;
+    nb_calls++;
+}
+
+static void handler_a( const void* context, lr11xx_system_irq_mask_t irq_regs, uint32_t timestamp_us )
+{
+    record_call( 'a', context, irq_regs, timestamp_us );
+}
+
+static void handler_b( const void* context, lr11xx_system_irq_mask_t irq_regs, uint32_t timestamp_us )
+{
+    record_call( 'b', context, irq_regs, timestamp_us );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
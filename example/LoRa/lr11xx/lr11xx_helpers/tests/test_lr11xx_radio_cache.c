@@ -0,0 +1,195 @@
+/**
+ * @file      test_lr11xx_radio_cache.c
+ *
+ * @brief     LR11XX test cases for the radio configuration cache
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include "unity.h"
+#include "lr11xx_radio_cache.h"
+#include "lr11xx_radio.h"
+#include "lr11xx_system.h"
+#include "mock_lr11xx_hal.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+void* context;
+
+static lr11xx_radio_cache_t cache;
+
+static const lr11xx_radio_mod_params_lora_t mod_params = {
+    .sf   = LR11XX_RADIO_LORA_SF7,
+    .bw   = LR11XX_RADIO_LORA_BW_125,
+    .cr   = LR11XX_RADIO_LORA_CR_4_5,
+    .ldro = 0,
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void setUp( void )
+{
+    lr11xx_radio_cache_init( &cache );
+}
+
+void tearDown( void )
+{
+}
+
+void test_lr11xx_radio_cache_set_rf_freq( void )
+{
+    uint8_t cbuffer_1_expected[] = { 0x02, 0x0B, 0x33, 0xBC, 0xA1, 0x00 };
+    uint8_t cbuffer_2_expected[] = { 0x02, 0x0B, 0x33, 0xC5, 0xC8, 0xC0 };
+
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_1_expected, 6, 6, NULL, 0, 0,
+                                               LR11XX_HAL_STATUS_OK );
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_radio_cache_set_rf_freq( context, &cache, 868000000 ) );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_radio_cache_set_rf_freq( context, &cache, 868000000 ) );
+
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_2_expected, 6, 6, NULL, 0, 0,
+                                               LR11XX_HAL_STATUS_OK );
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_radio_cache_set_rf_freq( context, &cache, 868600000 ) );
+    TEST_ASSERT_EQUAL_UINT32( 1, cache.nb_hits );
+    TEST_ASSERT_EQUAL_UINT32( 2, cache.nb_misses );
+}
+
+void test_lr11xx_radio_cache_pkt_type_change( void )
+{
+    uint8_t cbuffer_lora_expected[]   = { 0x02, 0x0E, 0x02 };
+    uint8_t cbuffer_gfsk_expected[]   = { 0x02, 0x0E, 0x01 };
+    uint8_t cbuffer_params_expected[] = { 0x02, 0x0F, 0x07, 0x04, 0x01, 0x00 };
+
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_lora_expected, 3, 3, NULL, 0, 0,
+                                               LR11XX_HAL_STATUS_OK );
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_params_expected, 6, 6, NULL, 0, 0,
+                                               LR11XX_HAL_STATUS_OK );
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK,
+                       lr11xx_radio_cache_set_pkt_type( context, &cache, LR11XX_RADIO_PKT_TYPE_LORA ) );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_radio_cache_set_lora_mod_params( context, &cache, &mod_params ) );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK,
+                       lr11xx_radio_cache_set_pkt_type( context, &cache, LR11XX_RADIO_PKT_TYPE_LORA ) );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_radio_cache_set_lora_mod_params( context, &cache, &mod_params ) );
+
+    // The chip drops the modulation parameters when the packet type changes
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_gfsk_expected, 3, 3, NULL, 0, 0,
+                                               LR11XX_HAL_STATUS_OK );
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_lora_expected, 3, 3, NULL, 0, 0,
+                                               LR11XX_HAL_STATUS_OK );
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_params_expected, 6, 6, NULL, 0, 0,
+                                               LR11XX_HAL_STATUS_OK );
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK,
+                       lr11xx_radio_cache_set_pkt_type( context, &cache, LR11XX_RADIO_PKT_TYPE_GFSK ) );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK,
+                       lr11xx_radio_cache_set_pkt_type( context, &cache, LR11XX_RADIO_PKT_TYPE_LORA ) );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_radio_cache_set_lora_mod_params( context, &cache, &mod_params ) );
+    TEST_ASSERT_EQUAL_UINT32( 2, cache.nb_hits );
+}
+
+void test_lr11xx_radio_cache_error( void )
+{
+    uint8_t cbuffer_expected[] = { 0x02, 0x11, 0x0E, 0x02 };
+
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_expected, 4, 4, NULL, 0, 0,
+                                               LR11XX_HAL_STATUS_ERROR );
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_expected, 4, 4, NULL, 0, 0,
+                                               LR11XX_HAL_STATUS_OK );
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_ERROR,
+                       lr11xx_radio_cache_set_tx_params( context, &cache, 14, LR11XX_RADIO_RAMP_48_US ) );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK,
+                       lr11xx_radio_cache_set_tx_params( context, &cache, 14, LR11XX_RADIO_RAMP_48_US ) );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK,
+                       lr11xx_radio_cache_set_tx_params( context, &cache, 14, LR11XX_RADIO_RAMP_48_US ) );
+    TEST_ASSERT_EQUAL_UINT32( 1, cache.nb_hits );
+    TEST_ASSERT_EQUAL_UINT32( 2, cache.nb_misses );
+}
+
+void test_lr11xx_radio_cache_set_sleep( void )
+{
+    uint8_t                   cbuffer_sync_word_expected[] = { 0x02, 0x2B, 0x12 };
+    uint8_t                   cbuffer_sleep_expected[]     = { 0x01, 0x1B, 0x01, 0x00, 0x00, 0x00, 0x00 };
+    lr11xx_system_sleep_cfg_t sleep_cfg                    = { .is_warm_start = true, .is_rtc_timeout = false };
+
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_sync_word_expected, 3, 3, NULL, 0, 0,
+                                               LR11XX_HAL_STATUS_OK );
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_radio_cache_set_lora_sync_word( context, &cache, 0x12 ) );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_radio_cache_set_lora_sync_word( context, &cache, 0x12 ) );
+
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_sleep_expected, 7, 7, NULL, 0, 0,
+                                               LR11XX_HAL_STATUS_OK );
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_sync_word_expected, 3, 3, NULL, 0, 0,
+                                               LR11XX_HAL_STATUS_OK );
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_radio_cache_set_sleep( context, &cache, sleep_cfg, 0 ) );
+    TEST_ASSERT_EQUAL_UINT16( 0, cache.valid );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_radio_cache_set_lora_sync_word( context, &cache, 0x12 ) );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/* --- EOF ------------------------------------------------------------------ */
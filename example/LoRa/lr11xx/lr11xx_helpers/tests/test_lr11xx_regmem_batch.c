@@ -0,0 +1,189 @@
+/**
+ * @file      test_lr11xx_regmem_batch.c
+ *
+ * @brief     LR11XX test cases for the batched register writes
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include "unity.h"
+#include "lr11xx_regmem_batch.h"
+#include "lr11xx_regmem.h"
+#include "mock_lr11xx_hal.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+void* context;
+
+static lr11xx_regmem_batch_t batch;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void setUp( void )
+{
+    lr11xx_regmem_batch_init( &batch );
+}
+
+void tearDown( void )
+{
+}
+
+void test_lr11xx_regmem_batch_coalesce( void )
+{
+    uint8_t cbuffer_1_expected[] = { 0x01, 0x05, 0x00, 0xF3, 0x00, 0x10 };
+    uint8_t cdata_1_expected[]   = { 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x03 };
+    uint8_t cbuffer_2_expected[] = { 0x01, 0x05, 0x00, 0xF3, 0x00, 0x40 };
+    uint8_t cdata_2_expected[]   = { 0x00, 0x00, 0x00, 0x04 };
+
+    lr11xx_regmem_batch_write( context, &batch, 0x00F30010, 0x00000001 );
+    lr11xx_regmem_batch_write( context, &batch, 0x00F30014, 0x00000002 );
+    lr11xx_regmem_batch_write( context, &batch, 0x00F30018, 0x00000003 );
+    lr11xx_regmem_batch_write( context, &batch, 0x00F30040, 0x00000004 );
+
+    TEST_ASSERT_EQUAL_UINT8( 4, batch.nb_writes );
+
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_1_expected, 6, 6, cdata_1_expected, 12, 12,
+                                               LR11XX_HAL_STATUS_OK );
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_2_expected, 6, 6, cdata_2_expected, 4, 4,
+                                               LR11XX_HAL_STATUS_OK );
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_regmem_batch_flush( context, &batch ) );
+    TEST_ASSERT_EQUAL_UINT8( 0, batch.nb_writes );
+    TEST_ASSERT_EQUAL_UINT32( 2, batch.nb_transactions );
+}
+
+void test_lr11xx_regmem_batch_skip_unchanged( void )
+{
+    uint8_t cbuffer_expected[] = { 0x01, 0x05, 0x00, 0xF3, 0x00, 0x54 };
+    uint8_t cdata_expected[]   = { 0x40, 0x00, 0x00, 0x01 };
+
+    lr11xx_regmem_batch_write( context, &batch, 0x00F30054, 0x40000001 );
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_expected, 6, 6, cdata_expected, 4, 4,
+                                               LR11XX_HAL_STATUS_OK );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_regmem_batch_flush( context, &batch ) );
+
+    // Same value, then bits already set as requested
+    lr11xx_regmem_batch_write( context, &batch, 0x00F30054, 0x40000001 );
+    lr11xx_regmem_batch_write_mask( context, &batch, 0x00F30054, 1 << 30, 1 << 30 );
+
+    TEST_ASSERT_EQUAL_UINT8( 0, batch.nb_writes );
+    TEST_ASSERT_EQUAL_UINT32( 2, batch.nb_skipped );
+
+    // A masked write of a known register becomes a whole register write
+    cdata_expected[0] = 0x00;
+    lr11xx_regmem_batch_write_mask( context, &batch, 0x00F30054, 1 << 30, 0 << 30 );
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_expected, 6, 6, cdata_expected, 4, 4,
+                                               LR11XX_HAL_STATUS_OK );
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_regmem_batch_flush( context, &batch ) );
+}
+
+void test_lr11xx_regmem_batch_unknown_register( void )
+{
+    uint8_t  cbuffer_mask_expected[] = { 0x01, 0x0C, 0x00, 0xF3, 0x00, 0x24, 0x00,
+                                         0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10 };
+    uint8_t  cbuffer_read_expected[] = { 0x01, 0x06, 0x00, 0xF3, 0x00, 0x24, 0x01 };
+    uint8_t  rbuffer_out_faked[]     = { 0x00, 0x00, 0x00, 0x13 };
+    uint32_t value                   = 0;
+
+    lr11xx_regmem_batch_write_mask( context, &batch, 0x00F30024, 1 << 4, 1 << 4 );
+
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_mask_expected, 14, 14, NULL, 0, 0,
+                                               LR11XX_HAL_STATUS_OK );
+    lr11xx_hal_read_ExpectWithArrayAndReturn( context, 0, cbuffer_read_expected, 7, 7, NULL, 4, 0,
+                                              LR11XX_HAL_STATUS_OK );
+    lr11xx_hal_read_IgnoreArg_data( );
+    lr11xx_hal_read_ReturnArrayThruPtr_data( rbuffer_out_faked, 4 );
+
+    // Reading flushes the queue, and the value read is remembered
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_OK, lr11xx_regmem_batch_read( context, &batch, 0x00F30024, &value ) );
+    TEST_ASSERT_EQUAL_UINT32( 0x00000013, value );
+
+    lr11xx_regmem_batch_write_mask( context, &batch, 0x00F30024, 1 << 4, 1 << 4 );
+    TEST_ASSERT_EQUAL_UINT32( 1, batch.nb_skipped );
+
+    lr11xx_regmem_batch_invalidate( &batch );
+    lr11xx_regmem_batch_write_mask( context, &batch, 0x00F30024, 1 << 4, 1 << 4 );
+    TEST_ASSERT_EQUAL_UINT8( 1, batch.nb_writes );
+}
+
+void test_lr11xx_regmem_batch_flush_error( void )
+{
+    uint8_t cbuffer_expected[] = { 0x01, 0x05, 0x00, 0xF3, 0x00, 0x10 };
+    uint8_t cdata_expected[]   = { 0x00, 0x00, 0x00, 0x01 };
+
+    lr11xx_regmem_batch_write( context, &batch, 0x00F30010, 0x00000001 );
+    lr11xx_hal_write_ExpectWithArrayAndReturn( context, 0, cbuffer_expected, 6, 6, cdata_expected, 4, 4,
+                                               LR11XX_HAL_STATUS_ERROR );
+
+    TEST_ASSERT_EQUAL( LR11XX_STATUS_ERROR, lr11xx_regmem_batch_flush( context, &batch ) );
+    TEST_ASSERT_EQUAL_UINT8( 0, batch.nb_writes );
+
+    // The register value is no longer trusted
+    lr11xx_regmem_batch_write( context, &batch, 0x00F30010, 0x00000001 );
+    TEST_ASSERT_EQUAL_UINT8( 1, batch.nb_writes );
+    TEST_ASSERT_EQUAL_UINT32( 0, batch.nb_skipped );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/* --- EOF ------------------------------------------------------------------ */
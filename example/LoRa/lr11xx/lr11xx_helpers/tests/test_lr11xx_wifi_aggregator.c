@@ -0,0 +1,256 @@
+/**
+ * @file      test_lr11xx_wifi_aggregator.c
+ *
+ * @brief     LR11XX test cases for the Wi-Fi scan aggregator
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include "unity.h"
+#include "lr11xx_wifi_aggregator.h"
+#include "lr11xx_wifi.h"
+#include "mock_lr11xx_hal.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#define CHANNEL_INFO_FIX_AP ( 0x10 | LR11XX_WIFI_CHANNEL_6 )
+#define CHANNEL_INFO_MOBILE_AP ( 0x20 | LR11XX_WIFI_CHANNEL_6 )
+#define CHANNEL_INFO_RSSI_INVALID ( 0x40 | CHANNEL_INFO_FIX_AP )
+#define FRAME_TYPE_INFO_BEACON ( 0x08 << 2 )
+#define FRAME_TYPE_INFO_DATA_TO_DS ( ( LR11XX_WIFI_FRAME_TYPE_DATA << 6 ) | 0x02 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static lr11xx_wifi_aggregator_t aggregator;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+static lr11xx_wifi_basic_complete_result_t make_result( uint8_t mac_first_byte, uint8_t mac_last_byte, int8_t rssi );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void setUp( void )
+{
+    lr11xx_wifi_aggregator_init( &aggregator, LR11XX_WIFI_AGGREGATOR_FILTER_ALL );
+}
+
+void tearDown( void )
+{
+}
+
+void test_lr11xx_wifi_aggregator_merge_scans( void )
+{
+    const lr11xx_wifi_basic_complete_result_t scan_1[] = {
+        make_result( 0x00, 0x01, -60 ),
+        make_result( 0x00, 0x02, -80 ),
+    };
+    const lr11xx_wifi_basic_complete_result_t scan_2[] = {
+        make_result( 0x00, 0x02, -70 ),
+        make_result( 0x00, 0x03, -90 ),
+        make_result( 0x00, 0x01, -63 ),
+    };
+    const lr11xx_wifi_mac_address_t unknown_mac = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x04 };
+
+    lr11xx_wifi_aggregator_add_results( &aggregator, scan_1, 2 );
+    lr11xx_wifi_aggregator_add_results( &aggregator, scan_2, 3 );
+
+    TEST_ASSERT_EQUAL_UINT8( 3, aggregator.nb_access_points );
+    TEST_ASSERT_EQUAL_UINT16( 5, aggregator.nb_results );
+    TEST_ASSERT_EQUAL_UINT16( 0, aggregator.nb_filtered );
+
+    const lr11xx_wifi_aggregator_access_point_t* ap = lr11xx_wifi_aggregator_find( &aggregator, scan_2[2].mac_address );
+    TEST_ASSERT_NOT_NULL( ap );
+    TEST_ASSERT_EQUAL_UINT8( 2, ap->nb_detections );
+    TEST_ASSERT_EQUAL_INT16( -123, ap->rssi_sum );
+    TEST_ASSERT_EQUAL_INT8( -60, ap->rssi_max );
+
+    ap = lr11xx_wifi_aggregator_find( &aggregator, scan_2[1].mac_address );
+    TEST_ASSERT_NOT_NULL( ap );
+    TEST_ASSERT_EQUAL_UINT8( 1, ap->nb_detections );
+
+    TEST_ASSERT_NULL( lr11xx_wifi_aggregator_find( &aggregator, unknown_mac ) );
+}
+
+void test_lr11xx_wifi_aggregator_filters( void )
+{
+    lr11xx_wifi_basic_complete_result_t results[5] = {
+        make_result( 0x00, 0x01, -60 ),
+        make_result( 0x00, 0x02, -60 ),
+        make_result( 0x02, 0x03, -60 ),
+        make_result( 0x00, 0x04, -60 ),
+        make_result( 0x00, 0x05, -60 ),
+    };
+    results[1].channel_info_byte    = CHANNEL_INFO_MOBILE_AP;
+    results[3].frame_type_info_byte = FRAME_TYPE_INFO_DATA_TO_DS;
+    results[4].channel_info_byte    = CHANNEL_INFO_RSSI_INVALID;
+
+    lr11xx_wifi_aggregator_add_results( &aggregator, results, 5 );
+
+    // Only the fixed access point sending beacons from a universally administered MAC address is kept
+    TEST_ASSERT_EQUAL_UINT8( 1, aggregator.nb_access_points );
+    TEST_ASSERT_EQUAL_UINT16( 4, aggregator.nb_filtered );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( results[0].mac_address, aggregator.access_points[0].mac_address,
+                                   LR11XX_WIFI_MAC_ADDRESS_LENGTH );
+
+    lr11xx_wifi_aggregator_init( &aggregator, LR11XX_WIFI_AGGREGATOR_FILTER_NONE );
+    lr11xx_wifi_aggregator_add_results( &aggregator, results, 5 );
+
+    TEST_ASSERT_EQUAL_UINT8( 5, aggregator.nb_access_points );
+    TEST_ASSERT_EQUAL_UINT16( 0, aggregator.nb_filtered );
+}
+
+void test_lr11xx_wifi_aggregator_hash_collisions_and_overflow( void )
+{
+    // The hash ignores the first bytes of the MAC address: all these results land on the same slot
+    for( uint8_t index = 0; index < LR11XX_WIFI_AGGREGATOR_MAX_ACCESS_POINTS; index++ )
+    {
+        const lr11xx_wifi_basic_complete_result_t result = make_result( index << 2, 0x42, -50 - index );
+
+        TEST_ASSERT_TRUE( lr11xx_wifi_aggregator_add_result( &aggregator, &result ) );
+    }
+
+    for( uint8_t index = 0; index < LR11XX_WIFI_AGGREGATOR_MAX_ACCESS_POINTS; index++ )
+    {
+        const lr11xx_wifi_basic_complete_result_t result = make_result( index << 2, 0x42, -50 - index );
+
+        TEST_ASSERT_TRUE( lr11xx_wifi_aggregator_add_result( &aggregator, &result ) );
+
+        const lr11xx_wifi_aggregator_access_point_t* ap =
+            lr11xx_wifi_aggregator_find( &aggregator, result.mac_address );
+        TEST_ASSERT_EQUAL_PTR( &aggregator.access_points[index], ap );
+        TEST_ASSERT_EQUAL_UINT8( 2, ap->nb_detections );
+    }
+
+    const lr11xx_wifi_basic_complete_result_t extra = make_result( 0x00, 0x43, -40 );
+
+    TEST_ASSERT_FALSE( lr11xx_wifi_aggregator_add_result( &aggregator, &extra ) );
+    TEST_ASSERT_EQUAL_UINT8( LR11XX_WIFI_AGGREGATOR_MAX_ACCESS_POINTS, aggregator.nb_access_points );
+    TEST_ASSERT_EQUAL_UINT16( 1, aggregator.nb_overflow );
+    TEST_ASSERT_NULL( lr11xx_wifi_aggregator_find( &aggregator, extra.mac_address ) );
+}
+
+void test_lr11xx_wifi_aggregator_encode( void )
+{
+    const lr11xx_wifi_basic_complete_result_t results[] = {
+        make_result( 0x00, 0x01, -80 ), make_result( 0x00, 0x02, -55 ), make_result( 0x00, 0x03, -70 ),
+        make_result( 0x00, 0x04, -71 ), make_result( 0x00, 0x04, -70 ), make_result( 0x00, 0x05, -55 ),
+        make_result( 0x00, 0x05, -55 ),
+    };
+    uint8_t payload[64];
+
+    lr11xx_wifi_aggregator_add_results( &aggregator, results, sizeof( results ) / sizeof( results[0] ) );
+
+    // Mean RSSI: 0x05 -55 dBm twice, 0x02 -55 dBm once, 0x03 -70 dBm, 0x04 -70.5 dBm, 0x01 -80 dBm
+    TEST_ASSERT_EQUAL_UINT8( 5 * LR11XX_WIFI_AGGREGATOR_RECORD_SIZE,
+                             lr11xx_wifi_aggregator_encode( &aggregator, LR11XX_WIFI_MAX_RESULTS, payload,
+                                                            sizeof( payload ) ) );
+
+    const uint8_t expected_last_bytes[] = { 0x05, 0x02, 0x03, 0x04, 0x01 };
+    const int8_t  expected_rssi[]       = { -55, -55, -70, -71, -80 };
+    for( uint8_t rank = 0; rank < 5; rank++ )
+    {
+        const uint8_t* record = &payload[rank * LR11XX_WIFI_AGGREGATOR_RECORD_SIZE];
+
+        TEST_ASSERT_EQUAL_INT8( expected_rssi[rank], ( int8_t ) record[0] );
+        TEST_ASSERT_EQUAL_UINT8( 0x00, record[1] );
+        TEST_ASSERT_EQUAL_UINT8( expected_last_bytes[rank], record[1 + LR11XX_WIFI_MAC_ADDRESS_LENGTH - 1] );
+    }
+
+    // Truncated to what fits in the payload, then to the number of access points asked for
+    TEST_ASSERT_EQUAL_UINT8( 2 * LR11XX_WIFI_AGGREGATOR_RECORD_SIZE,
+                             lr11xx_wifi_aggregator_encode( &aggregator, LR11XX_WIFI_MAX_RESULTS, payload, 20 ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x05, payload[LR11XX_WIFI_AGGREGATOR_RECORD_SIZE - 1] );
+    TEST_ASSERT_EQUAL_UINT8( 0x02, payload[2 * LR11XX_WIFI_AGGREGATOR_RECORD_SIZE - 1] );
+
+    TEST_ASSERT_EQUAL_UINT8( 1 * LR11XX_WIFI_AGGREGATOR_RECORD_SIZE,
+                             lr11xx_wifi_aggregator_encode( &aggregator, 1, payload, sizeof( payload ) ) );
+    TEST_ASSERT_EQUAL_UINT8( 0x05, payload[LR11XX_WIFI_AGGREGATOR_RECORD_SIZE - 1] );
+
+    TEST_ASSERT_EQUAL_UINT8( 0, lr11xx_wifi_aggregator_encode( &aggregator, LR11XX_WIFI_MAX_RESULTS, payload, 6 ) );
+}
+
+void test_lr11xx_wifi_aggregator_on_stream_result( void )
+{
+    lr11xx_wifi_result_t result;
+
+    result.basic_complete = make_result( 0x00, 0x01, -75 );
+
+    TEST_ASSERT_TRUE( lr11xx_wifi_aggregator_on_stream_result( 3, &result, &aggregator ) );
+    TEST_ASSERT_TRUE( lr11xx_wifi_aggregator_on_stream_result( 4, &result, &aggregator ) );
+
+    TEST_ASSERT_EQUAL_UINT8( 1, aggregator.nb_access_points );
+    TEST_ASSERT_EQUAL_UINT8( 2, aggregator.access_points[0].nb_detections );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static lr11xx_wifi_basic_complete_result_t make_result( uint8_t mac_first_byte, uint8_t mac_last_byte, int8_t rssi )
+{
+    const lr11xx_wifi_basic_complete_result_t result = {
+        .data_rate_info_byte  = LR11XX_WIFI_TYPE_RESULT_B,
+        .channel_info_byte    = CHANNEL_INFO_FIX_AP,
+        .rssi                 = rssi,
+        .frame_type_info_byte = FRAME_TYPE_INFO_BEACON,
+        .mac_address          = { mac_first_byte, 0x11, 0x22, 0x33, 0x44, mac_last_byte },
+    };
+
+    return result;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
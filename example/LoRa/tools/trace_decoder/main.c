@@ -0,0 +1,243 @@
+/*!
+ * @file      main.c
+ *
+ * @brief     Command line decoder of the deferred debug traces
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "trace_decoder.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Print the command line help
+ *
+ * @param [in] name Program name
+ */
+static void print_usage( const char* name );
+
+/**
+ * @brief Load the string table of a firmware image
+ *
+ * @param [in,out] table String table
+ * @param [in] path Path of the .elf or .axf image
+ *
+ * @returns Number of format strings loaded, or -1 on error
+ */
+static int load_elf( trace_decoder_table_t* table, const char* path );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+int main( int argc, char** argv )
+{
+    trace_decoder_table_t table;
+    trace_decoder_t       decoder;
+    const char*           elf_path   = NULL;
+    const char*           table_path = NULL;
+    bool                  write_only = false;
+    bool                  color      = true;
+    int                   nb_loaded  = -1;
+    int                   option;
+
+    while( ( option = getopt( argc, argv, "e:s:t:mh" ) ) != -1 )
+    {
+        switch( option )
+        {
+        case 't':
+            write_only = true;
+            /* fall through */
+        case 'e':
+            elf_path = optarg;
+            break;
+        case 's':
+            table_path = optarg;
+            break;
+        case 'm':
+            color = false;
+            break;
+        default:
+            print_usage( argv[0] );
+            return ( option == 'h' ) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if( ( ( elf_path == NULL ) == ( table_path == NULL ) ) || ( optind < ( argc - 1 ) ) )
+    {
+        print_usage( argv[0] );
+        return EXIT_FAILURE;
+    }
+
+    trace_decoder_table_init( &table );
+
+    if( elf_path != NULL )
+    {
+        nb_loaded = load_elf( &table, elf_path );
+    }
+    else
+    {
+        FILE* file = fopen( table_path, "r" );
+
+        if( file != NULL )
+        {
+            nb_loaded = trace_decoder_table_load_text( &table, file );
+            fclose( file );
+        }
+    }
+
+    if( nb_loaded < 0 )
+    {
+        fprintf( stderr, "cannot load the string table from %s\n", ( elf_path != NULL ) ? elf_path : table_path );
+        trace_decoder_table_free( &table );
+        return EXIT_FAILURE;
+    }
+
+    if( write_only == true )
+    {
+        trace_decoder_table_write( &table, stdout );
+        trace_decoder_table_free( &table );
+        return EXIT_SUCCESS;
+    }
+
+    FILE* capture = ( optind < argc ) ? fopen( argv[optind], "rb" ) : stdin;
+
+    if( capture == NULL )
+    {
+        fprintf( stderr, "cannot open %s\n", argv[optind] );
+        trace_decoder_table_free( &table );
+        return EXIT_FAILURE;
+    }
+
+    // Unbuffered so that a live capture - a serial port or a pipe - is decoded as it comes
+    setvbuf( stdout, NULL, _IONBF, 0 );
+    trace_decoder_init( &decoder, &table, color );
+
+    uint8_t buffer[256];
+    ssize_t length;
+
+    while( ( length = read( fileno( capture ), buffer, sizeof( buffer ) ) ) > 0 )
+    {
+        trace_decoder_feed( &decoder, buffer, ( size_t ) length, stdout );
+    }
+
+    if( capture != stdin )
+    {
+        fclose( capture );
+    }
+    trace_decoder_table_free( &table );
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void print_usage( const char* name )
+{
+    fprintf( stderr,
+             "Usage: %s [-m] -e image.elf|-s table.txt [capture]\n"
+             "       %s -t image.elf > table.txt\n"
+             "\n"
+             "Decode the deferred debug traces of a firmware built with HAL_DBG_TRACE_DEFERRED, read from the\n"
+             "capture file or the standard input - a serial port for instance.\n"
+             "\n"
+             "  -e image.elf  take the format strings from the symbol table of the firmware image\n"
+             "  -s table.txt  take the format strings from a table written with -t\n"
+             "  -t image.elf  write the string table of the firmware image and exit\n"
+             "  -m            do not color the INFO, WARN and ERROR messages\n",
+             name, name );
+}
+
+static int load_elf( trace_decoder_table_t* table, const char* path )
+{
+    FILE* file = fopen( path, "rb" );
+
+    if( file == NULL )
+    {
+        return -1;
+    }
+
+    uint8_t* image = NULL;
+    long     size  = -1;
+
+    if( ( fseek( file, 0, SEEK_END ) == 0 ) && ( ( size = ftell( file ) ) > 0 ) && ( fseek( file, 0, SEEK_SET ) == 0 ) )
+    {
+        image = malloc( ( size_t ) size );
+    }
+
+    int nb_loaded = -1;
+
+    if( ( image != NULL ) && ( fread( image, 1, ( size_t ) size, file ) == ( size_t ) size ) )
+    {
+        nb_loaded = trace_decoder_table_load_elf( table, image, ( size_t ) size );
+    }
+
+    free( image );
+    fclose( file );
+
+    return nb_loaded;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
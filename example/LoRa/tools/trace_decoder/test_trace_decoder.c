@@ -0,0 +1,421 @@
+/*!
+ * @file      test_trace_decoder.c
+ *
+ * @brief     Unit tests of the deferred debug trace encoder and host decoder
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trace_decoder.h"
+#include "smtc_hal_dbg_trace_deferred.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+#define CHECK( condition )                                                                  \
+    do                                                                                      \
+    {                                                                                       \
+        nb_checks++;                                                                        \
+        if( !( condition ) )                                                                \
+        {                                                                                   \
+            fprintf( stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition ); \
+            nb_failures++;                                                                  \
+        }                                                                                   \
+    } while( 0 )
+
+#define CHECK_STRING( actual, expected )                                                                    \
+    do                                                                                                      \
+    {                                                                                                       \
+        nb_checks++;                                                                                        \
+        if( strcmp( ( actual ), ( expected ) ) != 0 )                                                       \
+        {                                                                                                   \
+            fprintf( stderr, "%s:%d: expected \"%s\", got \"%s\"\n", __FILE__, __LINE__, expected, actual ); \
+            nb_failures++;                                                                                  \
+        }                                                                                                   \
+    } while( 0 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static unsigned int nb_checks;
+static unsigned int nb_failures;
+
+static trace_decoder_table_t table;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/**
+ * @brief Encode a record the way the firmware does, and register its format string
+ */
+static uint16_t encode( uint8_t* record, hal_dbg_trace_deferred_level_t level, const char* fmt, ... )
+{
+    va_list argp;
+
+    va_start( argp, fmt );
+    const uint16_t length = hal_dbg_trace_deferred_encode( record, level, fmt, argp );
+    va_end( argp );
+
+    trace_decoder_table_add( &table, ( uint32_t ) ( uintptr_t ) fmt, fmt );
+
+    return length;
+}
+
+/**
+ * @brief Format a message with the host printf, as the text mode would
+ */
+static void format( char* text, size_t size, const char* fmt, ... )
+{
+    va_list argp;
+
+    va_start( argp, fmt );
+    vsnprintf( text, size, fmt, argp );
+    va_end( argp );
+}
+
+/**
+ * @brief Feed a captured stream to a new decoder, in chunks of chunk_length bytes
+ */
+static char* decode( const uint8_t* data, size_t length, size_t chunk_length )
+{
+    trace_decoder_t decoder;
+    char*           text        = NULL;
+    size_t          text_length = 0;
+    FILE*           file        = open_memstream( &text, &text_length );
+
+    trace_decoder_init( &decoder, &table, false );
+    for( size_t i = 0; i < length; i += chunk_length )
+    {
+        trace_decoder_feed( &decoder, &data[i], ( ( length - i ) < chunk_length ) ? ( length - i ) : chunk_length,
+                            file );
+    }
+    fclose( file );
+
+    return text;
+}
+
+static void test_round_trip( void )
+{
+    static const char fmt_int[]    = "RSSI %d dBm, SNR %+d dB, %u bytes, id 0x%08X, '%c'\n";
+    static const char fmt_long[]   = "%ld %lu %lld %llu %jd %-6lx|\n";
+    static const char fmt_star[]   = "[%*d] [%-*.*s] [%.*u]\n";
+    static const char fmt_string[] = "%s / %10s / %-4s| %s%%\n";
+    static const char fmt_float[]  = "%f %.2e %g\n";
+    static const char fmt_ptr[]    = "buffer at %p\n";
+    uint8_t           record[HAL_DBG_TRACE_DEFERRED_RECORD_LENGTH_MAX];
+    char              expected[512];
+    uint16_t          length;
+    char*             text;
+
+    length = encode( record, HAL_DBG_TRACE_DEFERRED_LEVEL_PRINTF, fmt_int, -87, 7, 255u, 0xDEADBEEFu, 'z' );
+    text = decode( record, length, length );
+    format( expected, sizeof( expected ), fmt_int, -87, 7, 255u, 0xDEADBEEFu, 'z' );
+    CHECK_STRING( text, expected );
+    free( text );
+
+    length = encode( record, HAL_DBG_TRACE_DEFERRED_LEVEL_PRINTF, fmt_long, -5L, 4000000000UL, -1234567890123LL,
+            18446744073709551615ULL, ( intmax_t ) -42, 0xABCUL );
+    text = decode( record, length, length );
+    format( expected, sizeof( expected ), fmt_long, -5L, 4000000000UL, -1234567890123LL, 18446744073709551615ULL,
+            ( intmax_t ) -42, 0xABCUL );
+    CHECK_STRING( text, expected );
+    free( text );
+
+    length = encode( record, HAL_DBG_TRACE_DEFERRED_LEVEL_PRINTF, fmt_star, 5, 42, 8, 3, "abcdef", 4, 7u );
+    text = decode( record, length, length );
+    format( expected, sizeof( expected ), fmt_star, 5, 42, 8, 3, "abcdef", 4, 7u );
+    CHECK_STRING( text, expected );
+    free( text );
+
+    length =
+        encode( record, HAL_DBG_TRACE_DEFERRED_LEVEL_PRINTF, fmt_string, "LoRa", "GFSK", "", ( const char* ) NULL );
+    text = decode( record, length, length );
+    format( expected, sizeof( expected ), fmt_string, "LoRa", "GFSK", "", "(null)" );
+    CHECK_STRING( text, expected );
+    free( text );
+
+    length = encode( record, HAL_DBG_TRACE_DEFERRED_LEVEL_PRINTF, fmt_float, 3.14159, -0.000123, 868.1e6 );
+    text = decode( record, length, length );
+    format( expected, sizeof( expected ), fmt_float, 3.14159, -0.000123, 868.1e6 );
+    CHECK_STRING( text, expected );
+    free( text );
+
+    // Pointers are 32-bit on the target
+    length = encode( record, HAL_DBG_TRACE_DEFERRED_LEVEL_PRINTF, fmt_ptr, ( void* ) ( uintptr_t ) 0x20001F00 );
+    text = decode( record, length, length );
+    CHECK_STRING( text, "buffer at 0x20001f00\n" );
+    free( text );
+}
+
+static void test_levels_and_arrays( void )
+{
+    static const char fmt_info[]    = "Tx done %u\n";
+    static const char fmt_warning[] = "Rx timeout\n";
+    static const char fmt_error[]   = "CRC error on %s\n";
+    static const char msg_array[]   = "Packet content";
+    static const char msg_pack[]    = "";
+    uint8_t           stream[1024];
+    size_t            length = 0;
+    uint8_t           array[20];
+    char*             text;
+
+    for( size_t i = 0; i < sizeof( array ); i++ )
+    {
+        array[i] = ( uint8_t ) ( i * 13 );
+    }
+
+    length += encode( &stream[length], HAL_DBG_TRACE_DEFERRED_LEVEL_INFO, fmt_info, 12u );
+    length += encode( &stream[length], HAL_DBG_TRACE_DEFERRED_LEVEL_WARNING, fmt_warning );
+    length += encode( &stream[length], HAL_DBG_TRACE_DEFERRED_LEVEL_ERROR, fmt_error, "LoRa" );
+    length += hal_dbg_trace_deferred_encode_array( &stream[length], HAL_DBG_TRACE_DEFERRED_LEVEL_ARRAY, msg_array,
+                                                   array, sizeof( array ) );
+    trace_decoder_table_add( &table, ( uint32_t ) ( uintptr_t ) msg_array, msg_array );
+    length += hal_dbg_trace_deferred_encode_array( &stream[length], HAL_DBG_TRACE_DEFERRED_LEVEL_PACKARRAY, msg_pack,
+                                                   array, 3 );
+    trace_decoder_table_add( &table, ( uint32_t ) ( uintptr_t ) msg_pack, msg_pack );
+
+    static const char expected[] =
+        "INFO: Tx done 12\n"
+        "WARN: Rx timeout\n"
+        "ERROR: CRC error on LoRa\n"
+        "Packet content - (20 bytes):\n"
+        " 00 0D 1A 27 34 41 4E 5B 68 75 82 8F 9C A9 B6 C3\n"
+        " D0 DD EA F7\n"
+        "000D1A";
+
+    // Records split at any position must decode the same
+    for( size_t chunk_length = 1; chunk_length <= length; chunk_length++ )
+    {
+        text = decode( stream, length, chunk_length );
+        CHECK_STRING( text, expected );
+        free( text );
+    }
+}
+
+static void test_stream_resync( void )
+{
+    static const char fmt[] = "RX %d\n";
+    uint8_t           stream[256];
+    size_t            length = 0;
+    char*             text;
+
+    // Plain text, a byte that looks like a tag but starts no record, then records and a truncated one
+    memcpy( &stream[length], "boot\n", 5 );
+    length += 5;
+    stream[length++] = HAL_DBG_TRACE_DEFERRED_TAG | HAL_DBG_TRACE_DEFERRED_LEVEL_INFO;
+    length += encode( &stream[length], HAL_DBG_TRACE_DEFERRED_LEVEL_PRINTF, fmt, 1 );
+    memcpy( &stream[length], "text\n", 5 );
+    length += 5;
+    length += encode( &stream[length], HAL_DBG_TRACE_DEFERRED_LEVEL_PRINTF, fmt, -2 );
+
+    text = decode( stream, length, 1 );
+    CHECK( text[5] == ( char ) ( HAL_DBG_TRACE_DEFERRED_TAG | HAL_DBG_TRACE_DEFERRED_LEVEL_INFO ) );
+    CHECK_STRING( &text[6], "RX 1\ntext\nRX -2\n" );
+    CHECK( strncmp( text, "boot\n", 5 ) == 0 );
+    free( text );
+
+    // A record whose payload was cut because it did not fit prints the arguments it holds
+    static const char fmt_long[] = "%s|%d\n";
+    char              string[300];
+    uint8_t           record[HAL_DBG_TRACE_DEFERRED_RECORD_LENGTH_MAX];
+
+    memset( string, 'x', sizeof( string ) - 1 );
+    string[sizeof( string ) - 1] = '\0';
+    CHECK( encode( record, HAL_DBG_TRACE_DEFERRED_LEVEL_PRINTF, fmt_long, string, 3 ) ==
+           HAL_DBG_TRACE_DEFERRED_HEADER_LENGTH );
+    text = decode( record, HAL_DBG_TRACE_DEFERRED_HEADER_LENGTH, 1 );
+    CHECK_STRING( text, "" );
+    free( text );
+}
+
+static void test_bandwidth( void )
+{
+    static const char fmt[] = "Counter: %lu, RSSI: %d dBm, SNR: %d dB, size: %u\n";
+    uint8_t           record[HAL_DBG_TRACE_DEFERRED_RECORD_LENGTH_MAX];
+    char              text[256];
+
+    const uint16_t record_length = encode( record, HAL_DBG_TRACE_DEFERRED_LEVEL_INFO, fmt, 1234UL, -97, -3, 64u );
+    const int      text_length =
+        snprintf( text, sizeof( text ), "\x1B[0;32mINFO: Counter: %lu, RSSI: %d dBm, SNR: %d dB, size: %u\n\x1B[0m",
+                  1234UL, -97, -3, 64u );
+
+    // Header and four 32-bit arguments, against more than 60 characters of text
+    CHECK( record_length == ( HAL_DBG_TRACE_DEFERRED_HEADER_LENGTH + 16 ) );
+    CHECK( ( record_length * 3 ) < text_length );
+}
+
+static void test_table_text( void )
+{
+    trace_decoder_table_t written;
+    trace_decoder_table_t read;
+    char*                 text        = NULL;
+    size_t                text_length = 0;
+    FILE*                 file        = open_memstream( &text, &text_length );
+
+    trace_decoder_table_init( &written );
+    trace_decoder_table_init( &read );
+    trace_decoder_table_add( &written, 0x08004000, "\x1B[0;31mquote \" backslash \\ tab\t%d\r\n" );
+    trace_decoder_table_add( &written, 0x08001000, "" );
+    trace_decoder_table_add( &written, 0x08002000, "plain\n" );
+    trace_decoder_table_write( &written, file );
+    fclose( file );
+
+    file = fmemopen( text, text_length, "r" );
+    CHECK( trace_decoder_table_load_text( &read, file ) == 3 );
+    fclose( file );
+
+    CHECK( read.nb_entries == 3 );
+    for( size_t i = 0; i < written.nb_entries; i++ )
+    {
+        const char* fmt = trace_decoder_table_find( &read, written.entries[i].address );
+
+        CHECK( ( fmt != NULL ) && ( strcmp( fmt, written.entries[i].fmt ) == 0 ) );
+    }
+    CHECK( trace_decoder_table_find( &read, 0x08003000 ) == NULL );
+
+    free( text );
+    trace_decoder_table_free( &written );
+    trace_decoder_table_free( &read );
+}
+
+static void put_u16( uint8_t* buffer, uint16_t value )
+{
+    buffer[0] = ( uint8_t ) value;
+    buffer[1] = ( uint8_t ) ( value >> 8 );
+}
+
+static void put_u32( uint8_t* buffer, uint32_t value )
+{
+    put_u16( buffer, ( uint16_t ) value );
+    put_u16( &buffer[2], ( uint16_t ) ( value >> 16 ) );
+}
+
+static void put_section( uint8_t* header, uint32_t type, uint32_t address, uint32_t offset, uint32_t size,
+                         uint32_t link, uint32_t entry_size )
+{
+    put_u32( &header[4], type );
+    put_u32( &header[12], address );
+    put_u32( &header[16], offset );
+    put_u32( &header[20], size );
+    put_u32( &header[24], link );
+    put_u32( &header[36], entry_size );
+}
+
+static void put_symbol( uint8_t* symbol, uint32_t name, uint32_t value, uint32_t size, uint8_t type, uint16_t shndx )
+{
+    put_u32( &symbol[0], name );
+    put_u32( &symbol[4], value );
+    put_u32( &symbol[8], size );
+    symbol[12] = type;
+    put_u16( &symbol[14], shndx );
+}
+
+static void test_table_elf( void )
+{
+    // Minimal image: header, .rodata at 0x08010000, .strtab, .symtab and 4 section headers
+    static const char rodata[]  = "gcc %d\n\0clang %s\n\0other\0";
+    static const char strtab[]  = "\0hal_dbg_trace_fmt.12\0main.hal_dbg_trace_fmt\0other\0my_hal_dbg_trace_fmt\0";
+    uint8_t           image[512] = { 0x7F, 'E', 'L', 'F', 1, 1, 1 };
+    const uint32_t    rodata_offset = 64;
+    const uint32_t    strtab_offset = rodata_offset + sizeof( rodata );
+    const uint32_t    symtab_offset = 160;
+    const uint32_t    shdr_offset   = 256;
+    trace_decoder_table_t elf_table;
+
+    put_u32( &image[32], shdr_offset );
+    put_u16( &image[46], 40 );
+    put_u16( &image[48], 4 );
+    memcpy( &image[rodata_offset], rodata, sizeof( rodata ) );
+    memcpy( &image[strtab_offset], strtab, sizeof( strtab ) );
+
+    put_symbol( &image[symtab_offset + 16], 1, 0x08010000, 8, 1, 1 );
+    put_symbol( &image[symtab_offset + 32], 22, 0x08010008, 10, 1, 1 );
+    put_symbol( &image[symtab_offset + 48], 45, 0x08010012, 6, 1, 1 );
+    put_symbol( &image[symtab_offset + 64], 51, 0x08010012, 6, 1, 1 );
+    // Same name but a function, ignored
+    put_symbol( &image[symtab_offset + 80], 1, 0x08000101, 8, 2, 1 );
+
+    put_section( &image[shdr_offset + 40], 1, 0x08010000, rodata_offset, sizeof( rodata ), 0, 0 );
+    put_section( &image[shdr_offset + 80], 3, 0, strtab_offset, sizeof( strtab ), 0, 0 );
+    put_section( &image[shdr_offset + 120], 2, 0, symtab_offset, 96, 2, 16 );
+
+    trace_decoder_table_init( &elf_table );
+    CHECK( trace_decoder_table_load_elf( &elf_table, image, sizeof( image ) ) == 2 );
+    CHECK( elf_table.nb_entries == 2 );
+    CHECK( ( trace_decoder_table_find( &elf_table, 0x08010000 ) != NULL ) &&
+           ( strcmp( trace_decoder_table_find( &elf_table, 0x08010000 ), "gcc %d\n" ) == 0 ) );
+    CHECK( ( trace_decoder_table_find( &elf_table, 0x08010008 ) != NULL ) &&
+           ( strcmp( trace_decoder_table_find( &elf_table, 0x08010008 ), "clang %s\n" ) == 0 ) );
+    CHECK( trace_decoder_table_find( &elf_table, 0x08010012 ) == NULL );
+
+    // Not an ELF32 little endian image
+    image[4] = 2;
+    CHECK( trace_decoder_table_load_elf( &elf_table, image, sizeof( image ) ) == -1 );
+
+    trace_decoder_table_free( &elf_table );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+int main( void )
+{
+    trace_decoder_table_init( &table );
+
+    test_round_trip( );
+    test_levels_and_arrays( );
+    test_stream_resync( );
+    test_bandwidth( );
+    test_table_text( );
+    test_table_elf( );
+
+    trace_decoder_table_free( &table );
+
+    printf( "%u checks, %u failures\n", nb_checks, nb_failures );
+
+    return ( nb_failures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,805 @@
+/*!
+ * @file      trace_decoder.c
+ *
+ * @brief     Host decoder of the deferred debug trace records
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "trace_decoder.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#define TRACE_DECODER_COLOR_GREEN "\x1B[0;32m"
+#define TRACE_DECODER_COLOR_YELLOW "\x1B[0;33m"
+#define TRACE_DECODER_COLOR_RED "\x1B[0;31m"
+#define TRACE_DECODER_COLOR_DEFAULT "\x1B[0m"
+
+/**
+ * @brief Longest conversion specification rebuilt for the host printf
+ */
+#define TRACE_DECODER_SPEC_LENGTH_MAX 48
+
+/**
+ * @brief ELF32 layout - only what is needed to read the symbol table
+ */
+#define ELF32_EHDR_LENGTH 52
+#define ELF32_SHDR_LENGTH 40
+#define ELF32_SYM_LENGTH 16
+#define ELF_SHT_SYMTAB 2
+#define ELF_SHT_NOBITS 8
+#define ELF_STT_OBJECT 1
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief Payload being read
+ */
+typedef struct trace_decoder_payload_s
+{
+    const uint8_t* buffer;
+    size_t         length;
+    size_t         index;
+} trace_decoder_payload_t;
+
+/**
+ * @brief ELF32 section header fields in use
+ */
+typedef struct trace_decoder_elf_section_s
+{
+    uint32_t type;
+    uint32_t address;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t link;
+    uint32_t entry_size;
+} trace_decoder_elf_section_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Read a little endian integer from the payload
+ *
+ * @param [in,out] payload Payload being read
+ * @param [in] length Number of bytes, 4 or 8
+ * @param [out] value Integer value
+ *
+ * @returns true if the payload held the integer
+ */
+static bool trace_decoder_get_int( trace_decoder_payload_t* payload, size_t length, uint64_t* value );
+
+/**
+ * @brief Copy the width or the precision of a conversion specification, reading it from the payload if given as '*'
+ *
+ * @param [in,out] p Position in the format string
+ * @param [in,out] payload Payload being read
+ * @param [in,out] spec Specification being rebuilt
+ * @param [in,out] spec_length Specification length
+ *
+ * @returns true if the payload held the field value
+ */
+static bool trace_decoder_copy_field( const char** p, trace_decoder_payload_t* payload, char* spec,
+                                      size_t* spec_length );
+
+/**
+ * @brief Print a formatted message record
+ *
+ * @param [in] fmt Format string
+ * @param [in,out] payload Arguments of the format string
+ * @param [out] file Output
+ */
+static bool trace_decoder_copy_field( const char** p, trace_decoder_payload_t* payload, char* spec,
+                                      size_t* spec_length )
+{
+    uint64_t value;
+
+    if( **p == '*' )
+    {
+        if( trace_decoder_get_int( payload, 4, &value ) == false )
+        {
+            return false;
+        }
+        *spec_length += ( size_t ) sprintf( &spec[*spec_length], "%d", ( int32_t ) ( uint32_t ) value );
+        ( *p )++;
+    }
+
+    // Digits beyond the room left in the specification are dropped - no sensible format string has that many
+    for( ; ( **p >= '0' ) && ( **p <= '9' ); ( *p )++ )
+    {
+        if( *spec_length < ( TRACE_DECODER_SPEC_LENGTH_MAX / 2 ) )
+        {
+            spec[( *spec_length )++] = **p;
+        }
+    }
+
+    return true;
+}
+
+static void trace_decoder_print_formatted( const char* fmt, trace_decoder_payload_t* payload, FILE* file );
+
+/**
+ * @brief Tell whether a symbol holds a format string
+ *
+ * gcc names a function-scope static object "name.N", clang "function.name" - both are accepted.
+ *
+ * @param [in] name Symbol name
+ *
+ * @returns true if the symbol holds a format string
+ */
+static bool trace_decoder_is_fmt_symbol( const char* name );
+
+/**
+ * @brief Read an ELF32 section header
+ *
+ * @param [in] image Image content
+ * @param [in] size Image size in bytes
+ * @param [in] index Section index
+ * @param [out] section Section header
+ *
+ * @returns true if the section header is in the image
+ */
+static bool trace_decoder_elf_get_section( const uint8_t* image, size_t size, uint32_t index,
+                                           trace_decoder_elf_section_t* section );
+
+static uint16_t trace_decoder_get_u16( const uint8_t* buffer );
+
+static uint32_t trace_decoder_get_u32( const uint8_t* buffer );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void trace_decoder_table_init( trace_decoder_table_t* table )
+{
+    table->entries    = NULL;
+    table->nb_entries = 0;
+    table->capacity   = 0;
+}
+
+void trace_decoder_table_free( trace_decoder_table_t* table )
+{
+    for( size_t i = 0; i < table->nb_entries; i++ )
+    {
+        free( table->entries[i].fmt );
+    }
+    free( table->entries );
+    trace_decoder_table_init( table );
+}
+
+int trace_decoder_table_add( trace_decoder_table_t* table, uint32_t address, const char* fmt )
+{
+    size_t low  = 0;
+    size_t high = table->nb_entries;
+
+    // Kept sorted by address for the lookups
+    while( low < high )
+    {
+        const size_t middle = ( low + high ) / 2;
+
+        if( table->entries[middle].address < address )
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    char* copy = strdup( fmt );
+
+    if( copy == NULL )
+    {
+        return -1;
+    }
+
+    if( ( low < table->nb_entries ) && ( table->entries[low].address == address ) )
+    {
+        free( table->entries[low].fmt );
+        table->entries[low].fmt = copy;
+        return 0;
+    }
+
+    if( table->nb_entries == table->capacity )
+    {
+        const size_t           capacity = ( table->capacity == 0 ) ? 64 : ( table->capacity * 2 );
+        trace_decoder_entry_t* entries  = realloc( table->entries, capacity * sizeof( trace_decoder_entry_t ) );
+
+        if( entries == NULL )
+        {
+            free( copy );
+            return -1;
+        }
+        table->entries  = entries;
+        table->capacity = capacity;
+    }
+
+    memmove( &table->entries[low + 1], &table->entries[low],
+             ( table->nb_entries - low ) * sizeof( trace_decoder_entry_t ) );
+    table->entries[low].address = address;
+    table->entries[low].fmt     = copy;
+    table->nb_entries++;
+
+    return 0;
+}
+
+const char* trace_decoder_table_find( const trace_decoder_table_t* table, uint32_t address )
+{
+    size_t low  = 0;
+    size_t high = table->nb_entries;
+
+    while( low < high )
+    {
+        const size_t middle = ( low + high ) / 2;
+
+        if( table->entries[middle].address == address )
+        {
+            return table->entries[middle].fmt;
+        }
+        if( table->entries[middle].address < address )
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return NULL;
+}
+
+int trace_decoder_table_load_elf( trace_decoder_table_t* table, const uint8_t* image, size_t size )
+{
+    static const uint8_t magic[] = { 0x7F, 'E', 'L', 'F', 1 /* 32-bit */, 1 /* little endian */ };
+
+    if( ( size < ELF32_EHDR_LENGTH ) || ( memcmp( image, magic, sizeof( magic ) ) != 0 ) )
+    {
+        return -1;
+    }
+
+    const uint32_t nb_sections = trace_decoder_get_u16( &image[48] );
+    int            nb_loaded   = 0;
+
+    for( uint32_t i = 0; i < nb_sections; i++ )
+    {
+        trace_decoder_elf_section_t symtab;
+        trace_decoder_elf_section_t strtab;
+
+        if( trace_decoder_elf_get_section( image, size, i, &symtab ) == false )
+        {
+            return -1;
+        }
+        if( symtab.type != ELF_SHT_SYMTAB )
+        {
+            continue;
+        }
+        if( ( trace_decoder_elf_get_section( image, size, symtab.link, &strtab ) == false ) ||
+            ( symtab.entry_size < ELF32_SYM_LENGTH ) || ( ( ( uint64_t ) symtab.offset + symtab.size ) > size ) ||
+            ( ( ( uint64_t ) strtab.offset + strtab.size ) > size ) || ( strtab.size == 0 ) ||
+            ( image[strtab.offset + strtab.size - 1] != '\0' ) )
+        {
+            return -1;
+        }
+
+        for( uint32_t offset = 0; ( offset + ELF32_SYM_LENGTH ) <= symtab.size; offset += symtab.entry_size )
+        {
+            const uint8_t*              sym     = &image[symtab.offset + offset];
+            const uint32_t              name    = trace_decoder_get_u32( &sym[0] );
+            const uint32_t              value   = trace_decoder_get_u32( &sym[4] );
+            const uint32_t              length  = trace_decoder_get_u32( &sym[8] );
+            const uint16_t              shndx   = trace_decoder_get_u16( &sym[14] );
+            trace_decoder_elf_section_t section;
+
+            if( ( ( sym[12] & 0x0F ) != ELF_STT_OBJECT ) || ( name >= strtab.size ) || ( length == 0 ) ||
+                ( trace_decoder_is_fmt_symbol( ( const char* ) &image[strtab.offset + name] ) == false ) ||
+                ( trace_decoder_elf_get_section( image, size, shndx, &section ) == false ) ||
+                ( section.type == ELF_SHT_NOBITS ) || ( value < section.address ) ||
+                ( ( ( uint64_t ) value - section.address + length ) > section.size ) ||
+                ( ( ( uint64_t ) section.offset + section.size ) > size ) )
+            {
+                continue;
+            }
+
+            const char* fmt = ( const char* ) &image[section.offset + ( value - section.address )];
+
+            // The object is the array initialised by the string literal, null character included
+            if( ( memchr( fmt, '\0', length ) == NULL ) || ( trace_decoder_table_add( table, value, fmt ) != 0 ) )
+            {
+                continue;
+            }
+            nb_loaded++;
+        }
+    }
+
+    return nb_loaded;
+}
+
+int trace_decoder_table_load_text( trace_decoder_table_t* table, FILE* file )
+{
+    char line[4 * HAL_DBG_TRACE_DEFERRED_RECORD_LENGTH_MAX + 32];
+    int  nb_loaded = 0;
+
+    while( fgets( line, sizeof( line ), file ) != NULL )
+    {
+        char*               end;
+        const unsigned long address = strtoul( line, &end, 16 );
+
+        if( ( line[0] == '\n' ) || ( line[0] == '#' ) )
+        {
+            continue;
+        }
+        if( ( end == line ) || ( end[0] != ' ' ) || ( end[1] != '"' ) )
+        {
+            return -1;
+        }
+
+        // Unescape in place, the result is never longer than the escaped text
+        char* in  = &end[2];
+        char* out = in;
+
+        while( ( *in != '"' ) && ( *in != '\0' ) )
+        {
+            if( *in != '\\' )
+            {
+                *out++ = *in++;
+                continue;
+            }
+            in++;
+            switch( *in )
+            {
+            case 'n':
+                *out++ = '\n';
+                in++;
+                break;
+            case 'r':
+                *out++ = '\r';
+                in++;
+                break;
+            case 't':
+                *out++ = '\t';
+                in++;
+                break;
+            case 'x':
+            {
+                const char digits[3] = { in[1], ( in[1] != '\0' ) ? in[2] : '\0', '\0' };
+                char*      digits_end;
+
+                *out++ = ( char ) strtoul( digits, &digits_end, 16 );
+                in += 1 + ( digits_end - digits );
+                break;
+            }
+            case '\0':
+                break;
+            default:
+                *out++ = *in++;
+                break;
+            }
+        }
+        if( *in != '"' )
+        {
+            return -1;
+        }
+        *out = '\0';
+
+        if( trace_decoder_table_add( table, ( uint32_t ) address, &end[2] ) != 0 )
+        {
+            return -1;
+        }
+        nb_loaded++;
+    }
+
+    return nb_loaded;
+}
+
+void trace_decoder_table_write( const trace_decoder_table_t* table, FILE* file )
+{
+    for( size_t i = 0; i < table->nb_entries; i++ )
+    {
+        fprintf( file, "%08X \"", table->entries[i].address );
+        for( const char* p = table->entries[i].fmt; *p != '\0'; p++ )
+        {
+            const uint8_t c = ( uint8_t ) *p;
+
+            if( c == '\n' )
+            {
+                fputs( "\\n", file );
+            }
+            else if( c == '\r' )
+            {
+                fputs( "\\r", file );
+            }
+            else if( c == '\t' )
+            {
+                fputs( "\\t", file );
+            }
+            else if( ( c == '"' ) || ( c == '\\' ) )
+            {
+                fprintf( file, "\\%c", c );
+            }
+            else if( ( c < 0x20 ) || ( c >= 0x7F ) )
+            {
+                fprintf( file, "\\x%02X", c );
+            }
+            else
+            {
+                fputc( c, file );
+            }
+        }
+        fputs( "\"\n", file );
+    }
+}
+
+int trace_decoder_print_record( const trace_decoder_table_t* table, const uint8_t* record, bool color, FILE* file )
+{
+    const hal_dbg_trace_deferred_level_t level = ( hal_dbg_trace_deferred_level_t ) ( record[0] & 0x0F );
+    const char* fmt = trace_decoder_table_find( table, trace_decoder_get_u32( &record[1] ) );
+    trace_decoder_payload_t payload = {
+        .buffer = &record[HAL_DBG_TRACE_DEFERRED_HEADER_LENGTH],
+        .length = record[5],
+        .index  = 0,
+    };
+
+    if( fmt == NULL )
+    {
+        return -1;
+    }
+
+    // Same output as the macros of smtc_hal_dbg_trace.h in the text mode
+    switch( level )
+    {
+    case HAL_DBG_TRACE_DEFERRED_LEVEL_INFO:
+        fprintf( file, "%sINFO: ", color ? TRACE_DECODER_COLOR_GREEN : "" );
+        break;
+    case HAL_DBG_TRACE_DEFERRED_LEVEL_WARNING:
+        fprintf( file, "%sWARN: ", color ? TRACE_DECODER_COLOR_YELLOW : "" );
+        break;
+    case HAL_DBG_TRACE_DEFERRED_LEVEL_ERROR:
+        fprintf( file, "%sERROR: ", color ? TRACE_DECODER_COLOR_RED : "" );
+        break;
+    case HAL_DBG_TRACE_DEFERRED_LEVEL_ARRAY:
+        fprintf( file, "%s - (%zu bytes):\n", fmt, payload.length );
+        for( size_t i = 0; i < payload.length; i++ )
+        {
+            if( ( ( i % 16 ) == 0 ) && ( i > 0 ) )
+            {
+                fputs( "\n", file );
+            }
+            fprintf( file, " %02X", payload.buffer[i] );
+        }
+        fputs( "\n", file );
+        return 0;
+    case HAL_DBG_TRACE_DEFERRED_LEVEL_PACKARRAY:
+        for( size_t i = 0; i < payload.length; i++ )
+        {
+            fprintf( file, "%02X", payload.buffer[i] );
+        }
+        return 0;
+    default:
+        break;
+    }
+
+    trace_decoder_print_formatted( fmt, &payload, file );
+
+    if( ( color == true ) && ( level != HAL_DBG_TRACE_DEFERRED_LEVEL_PRINTF ) )
+    {
+        fputs( TRACE_DECODER_COLOR_DEFAULT, file );
+    }
+
+    return 0;
+}
+
+void trace_decoder_init( trace_decoder_t* decoder, const trace_decoder_table_t* table, bool color )
+{
+    decoder->table  = table;
+    decoder->color  = color;
+    decoder->length = 0;
+}
+
+void trace_decoder_feed( trace_decoder_t* decoder, const uint8_t* data, size_t length, FILE* file )
+{
+    for( size_t i = 0; i < length; i++ )
+    {
+        const uint8_t byte = data[i];
+
+        if( decoder->length == 0 )
+        {
+            if( ( ( byte & HAL_DBG_TRACE_DEFERRED_TAG_MASK ) == HAL_DBG_TRACE_DEFERRED_TAG ) &&
+                ( ( byte & 0x0F ) <= HAL_DBG_TRACE_DEFERRED_LEVEL_PACKARRAY ) )
+            {
+                decoder->record[decoder->length++] = byte;
+            }
+            else
+            {
+                fputc( byte, file );
+            }
+            continue;
+        }
+
+        decoder->record[decoder->length++] = byte;
+
+        if( decoder->length == HAL_DBG_TRACE_DEFERRED_HEADER_LENGTH )
+        {
+            if( trace_decoder_table_find( decoder->table, trace_decoder_get_u32( &decoder->record[1] ) ) == NULL )
+            {
+                uint8_t pending[HAL_DBG_TRACE_DEFERRED_HEADER_LENGTH - 1];
+
+                // Not a record after all: output the first byte as it is and look for a record in the others
+                fputc( decoder->record[0], file );
+                memcpy( pending, &decoder->record[1], sizeof( pending ) );
+                decoder->length = 0;
+                trace_decoder_feed( decoder, pending, sizeof( pending ), file );
+                continue;
+            }
+        }
+
+        if( ( decoder->length >= HAL_DBG_TRACE_DEFERRED_HEADER_LENGTH ) &&
+            ( decoder->length == ( HAL_DBG_TRACE_DEFERRED_HEADER_LENGTH + ( size_t ) decoder->record[5] ) ) )
+        {
+            trace_decoder_print_record( decoder->table, decoder->record, decoder->color, file );
+            decoder->length = 0;
+        }
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static bool trace_decoder_get_int( trace_decoder_payload_t* payload, size_t length, uint64_t* value )
+{
+    if( length > ( payload->length - payload->index ) )
+    {
+        return false;
+    }
+
+    *value = 0;
+    for( size_t i = 0; i < length; i++ )
+    {
+        *value |= ( uint64_t ) payload->buffer[payload->index + i] << ( 8 * i );
+    }
+    payload->index += length;
+
+    return true;
+}
+
+static void trace_decoder_print_formatted( const char* fmt, trace_decoder_payload_t* payload, FILE* file )
+{
+    // Mirror of hal_dbg_trace_deferred_encode: each specification is rebuilt without its length modifiers and printed
+    // with the host printf, on the argument read with the size the firmware used
+    for( const char* p = fmt; *p != '\0'; p++ )
+    {
+        char     spec[TRACE_DECODER_SPEC_LENGTH_MAX];
+        size_t   spec_length = 0;
+        uint8_t  nb_long     = 0;
+        uint64_t value;
+
+        if( *p != '%' )
+        {
+            fputc( *p, file );
+            continue;
+        }
+        if( *( ++p ) == '%' )
+        {
+            fputc( '%', file );
+            continue;
+        }
+
+        spec[spec_length++] = '%';
+        while( ( ( *p == '-' ) || ( *p == '+' ) || ( *p == ' ' ) || ( *p == '#' ) || ( *p == '0' ) ) &&
+               ( spec_length < 8 ) )
+        {
+            spec[spec_length++] = *p++;
+        }
+
+        if( trace_decoder_copy_field( &p, payload, spec, &spec_length ) == false )
+        {
+            return;
+        }
+        if( *p == '.' )
+        {
+            spec[spec_length++] = *p++;
+            if( trace_decoder_copy_field( &p, payload, spec, &spec_length ) == false )
+            {
+                return;
+            }
+        }
+
+        while( ( *p == 'h' ) || ( *p == 'l' ) || ( *p == 'L' ) || ( *p == 'j' ) || ( *p == 'z' ) || ( *p == 't' ) )
+        {
+            nb_long += ( *p == 'l' ) ? 1 : ( ( *p == 'j' ) ? 2 : 0 );
+            p++;
+        }
+
+        switch( *p )
+        {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+        case 'c':
+            if( nb_long >= 2 )
+            {
+                if( trace_decoder_get_int( payload, 8, &value ) == false )
+                {
+                    return;
+                }
+                spec[spec_length++] = 'l';
+                spec[spec_length++] = 'l';
+                spec[spec_length++] = *p;
+                spec[spec_length]   = '\0';
+                fprintf( file, spec, ( long long ) value );
+            }
+            else
+            {
+                if( trace_decoder_get_int( payload, 4, &value ) == false )
+                {
+                    return;
+                }
+                spec[spec_length++] = *p;
+                spec[spec_length]   = '\0';
+                fprintf( file, spec, ( int32_t ) ( uint32_t ) value );
+            }
+            break;
+        case 'p':
+            if( trace_decoder_get_int( payload, 4, &value ) == false )
+            {
+                return;
+            }
+            fprintf( file, "0x%x", ( uint32_t ) value );
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+        {
+            double real;
+
+            if( ( payload->length - payload->index ) < sizeof( real ) )
+            {
+                return;
+            }
+            memcpy( &real, &payload->buffer[payload->index], sizeof( real ) );
+            payload->index += sizeof( real );
+            spec[spec_length++] = *p;
+            spec[spec_length]   = '\0';
+            fprintf( file, spec, real );
+            break;
+        }
+        case 's':
+        {
+            const char*  string = ( const char* ) &payload->buffer[payload->index];
+            const size_t left   = payload->length - payload->index;
+
+            if( memchr( string, '\0', left ) == NULL )
+            {
+                return;
+            }
+            payload->index += strlen( string ) + 1;
+            spec[spec_length++] = 's';
+            spec[spec_length]   = '\0';
+            fprintf( file, spec, string );
+            break;
+        }
+        case 'n':
+            break;
+        case '\0':
+            return;
+        default:
+            break;
+        }
+    }
+}
+
+static bool trace_decoder_is_fmt_symbol( const char* name )
+{
+    const size_t length = strlen( HAL_DBG_TRACE_DEFERRED_FMT_SYMBOL );
+
+    for( const char* p = name; ( p = strstr( p, HAL_DBG_TRACE_DEFERRED_FMT_SYMBOL ) ) != NULL; p += length )
+    {
+        if( ( ( p == name ) || ( p[-1] == '.' ) ) && ( ( p[length] == '\0' ) || ( p[length] == '.' ) ) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool trace_decoder_elf_get_section( const uint8_t* image, size_t size, uint32_t index,
+                                           trace_decoder_elf_section_t* section )
+{
+    const uint32_t table       = trace_decoder_get_u32( &image[32] );
+    const uint32_t entry_size  = trace_decoder_get_u16( &image[46] );
+    const uint32_t nb_sections = trace_decoder_get_u16( &image[48] );
+    const uint64_t offset      = ( uint64_t ) table + ( uint64_t ) index * entry_size;
+
+    if( ( index >= nb_sections ) || ( entry_size < ELF32_SHDR_LENGTH ) || ( ( offset + ELF32_SHDR_LENGTH ) > size ) )
+    {
+        return false;
+    }
+
+    const uint8_t* header = &image[offset];
+
+    section->type       = trace_decoder_get_u32( &header[4] );
+    section->address    = trace_decoder_get_u32( &header[12] );
+    section->offset     = trace_decoder_get_u32( &header[16] );
+    section->size       = trace_decoder_get_u32( &header[20] );
+    section->link       = trace_decoder_get_u32( &header[24] );
+    section->entry_size = trace_decoder_get_u32( &header[36] );
+
+    return true;
+}
+
+static uint16_t trace_decoder_get_u16( const uint8_t* buffer )
+{
+    return ( uint16_t ) ( buffer[0] | ( buffer[1] << 8 ) );
+}
+
+static uint32_t trace_decoder_get_u32( const uint8_t* buffer )
+{
+    return ( uint32_t ) buffer[0] | ( ( uint32_t ) buffer[1] << 8 ) | ( ( uint32_t ) buffer[2] << 16 ) |
+           ( ( uint32_t ) buffer[3] << 24 );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,209 @@
+/*!
+ * @file      trace_decoder.h
+ *
+ * @brief     Host decoder of the deferred debug trace records
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TRACE_DECODER_H
+#define TRACE_DECODER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "smtc_hal_dbg_trace_deferred.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Format string of the firmware image
+ */
+typedef struct trace_decoder_entry_s
+{
+    uint32_t address;  //!< Address of the format string in the image
+    char*    fmt;      //!< Format string
+} trace_decoder_entry_t;
+
+/**
+ * @brief String table - format strings of a firmware image sorted by address
+ */
+typedef struct trace_decoder_table_s
+{
+    trace_decoder_entry_t* entries;
+    size_t                 nb_entries;
+    size_t                 capacity;
+} trace_decoder_table_t;
+
+/**
+ * @brief Decoder of a stream of records
+ */
+typedef struct trace_decoder_s
+{
+    const trace_decoder_table_t* table;
+    bool                         color;   //!< Print the levels with the terminal colors of the firmware
+    uint8_t                      record[HAL_DBG_TRACE_DEFERRED_RECORD_LENGTH_MAX];
+    size_t                       length;  //!< Number of bytes of the record received so far
+} trace_decoder_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Initialise an empty string table
+ *
+ * @param [out] table String table
+ */
+void trace_decoder_table_init( trace_decoder_table_t* table );
+
+/**
+ * @brief Free the memory of a string table
+ *
+ * @param [in,out] table String table
+ */
+void trace_decoder_table_free( trace_decoder_table_t* table );
+
+/**
+ * @brief Add a format string to a string table
+ *
+ * @param [in,out] table String table
+ * @param [in] address Address of the format string in the image
+ * @param [in] fmt Format string, copied
+ *
+ * @returns 0 on success, -1 if out of memory
+ */
+int trace_decoder_table_add( trace_decoder_table_t* table, uint32_t address, const char* fmt );
+
+/**
+ * @brief Find the format string at an address
+ *
+ * @param [in] table String table
+ * @param [in] address Address of the format string in the image
+ *
+ * @returns Format string, or NULL if there is none at this address
+ */
+const char* trace_decoder_table_find( const trace_decoder_table_t* table, uint32_t address );
+
+/**
+ * @brief Load the format strings of a 32-bit little endian ELF image - .elf or .axf
+ *
+ * The format strings are the objects named HAL_DBG_TRACE_DEFERRED_FMT_SYMBOL in the symbol table.
+ *
+ * @param [in,out] table String table
+ * @param [in] image Image content
+ * @param [in] size Image size in bytes
+ *
+ * @returns Number of format strings loaded, or -1 if the image cannot be parsed
+ */
+int trace_decoder_table_load_elf( trace_decoder_table_t* table, const uint8_t* image, size_t size );
+
+/**
+ * @brief Load a string table written by trace_decoder_table_write
+ *
+ * @param [in,out] table String table
+ * @param [in] file Text file
+ *
+ * @returns Number of format strings loaded, or -1 on a malformed line
+ */
+int trace_decoder_table_load_text( trace_decoder_table_t* table, FILE* file );
+
+/**
+ * @brief Write a string table as text, one "address escaped-format-string" line per entry
+ *
+ * @param [in] table String table
+ * @param [out] file Text file
+ */
+void trace_decoder_table_write( const trace_decoder_table_t* table, FILE* file );
+
+/**
+ * @brief Rebuild the text of a record
+ *
+ * @param [in] table String table
+ * @param [in] record Complete record
+ * @param [in] color Add the terminal colors of the firmware
+ * @param [out] file Output
+ *
+ * @returns 0 on success, -1 if the format string is not in the table
+ */
+int trace_decoder_print_record( const trace_decoder_table_t* table, const uint8_t* record, bool color, FILE* file );
+
+/**
+ * @brief Initialise a stream decoder
+ *
+ * @param [out] decoder Stream decoder
+ * @param [in] table String table
+ * @param [in] color Add the terminal colors of the firmware
+ */
+void trace_decoder_init( trace_decoder_t* decoder, const trace_decoder_table_t* table, bool color );
+
+/**
+ * @brief Decode a chunk of the captured stream
+ *
+ * Records may be split across chunks. Bytes that do not start a record with a known format string - plain text
+ * sent before the deferred mode was enabled for instance - are copied as they are.
+ *
+ * @param [in,out] decoder Stream decoder
+ * @param [in] data Captured bytes
+ * @param [in] length Number of bytes
+ * @param [out] file Output
+ */
+void trace_decoder_feed( trace_decoder_t* decoder, const uint8_t* data, size_t length, FILE* file );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // TRACE_DECODER_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -1,148 +1,219 @@
-#include "dht11.h"
+/**
+ * @file      dht11.c
+ *
+ * @brief     Non-blocking DHT11 temperature and humidity sensor driver implementation.
+ *
+ * Revised BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
 #include <stddef.h>
-#include "stm32l4xx_hal.h"
-#include <stdio.h>
-#include <stdint.h>
-#include "delay.h"
-#include "lorawan_commissioning.h"
-#include "lr1121_modem_board.h"
-#include "apps_utilities.h"
-#include "lr1121_modem_helper.h"
-#include "lr1121_modem_system_types.h"
-
-uint8_t Data[5];
-int flag=0;
-
-void DHT_GPIO_INPUT(void)
-{
-    GPIO_InitTypeDef GPIO_InitStructure;
-    GPIO_InitStructure.Pin=DHT11_PIN;
-    GPIO_InitStructure.Mode=GPIO_MODE_INPUT;
-    GPIO_InitStructure.Speed=GPIO_SPEED_FREQ_HIGH;
-    HAL_GPIO_Init(DHT11_IO,&GPIO_InitStructure);
-}
+#include "dht11.h"
+#include "smtc_hal.h"
+#include "stm32l4xx.h"
 
-void DHT_GPIO_OUTPUT(void)
-{
-    GPIO_InitTypeDef GPIO_InitStructure;
-    GPIO_InitStructure.Pin=DHT11_PIN;
-    GPIO_InitStructure.Mode=GPIO_MODE_OUTPUT_PP;
-    GPIO_InitStructure.Speed=GPIO_SPEED_FREQ_HIGH;
-    HAL_GPIO_Init(DHT11_IO,&GPIO_InitStructure);
-}
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
 
-//获取一个字节
-char DHT_Read_Byte(void)
+#if( DHT11_START_SIGNAL_MS < 18 )
+#error "DHT11_START_SIGNAL_MS must be at least 18 ms"
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief Reading states
+ */
+typedef enum dht11_state_e
 {
-	unsigned char i = 0;
-	unsigned char Read_Data = 0;
-	uint32_t timeout = 0;
-
-	for(i=0;i<8;i++) //1个数据就是1个字节byte，1个字节byte有8位bit
-	{
-		// 等待低电平结束，添加超时保护
-		timeout = 0;
-		while(HAL_GPIO_ReadPin(DHT11_IO, DHT11_PIN) == 0 && timeout < 100) 
-		{
-			delay_us(1);
-			timeout++;
-		}
-		if(timeout >= 100) return 0; // 超时返回0
-		
-		delay_us(30); //延迟30us是为了区别数据0和数据1，0只有26~28us
-
-		Read_Data <<= 1; //左移
-
-		if(HAL_GPIO_ReadPin(DHT11_IO, DHT11_PIN) == 1) //如果过了30us还是高电平的话就是数据1
-		{
-			Read_Data |= 1; //数据+1
-		}
-
-		// 等待高电平结束，添加超时保护
-		timeout = 0;
-		while(HAL_GPIO_ReadPin(DHT11_IO, DHT11_PIN) == 1 && timeout < 100) 
-		{
-			delay_us(1);
-			timeout++;
-		}
-		if(timeout >= 100) return 0; // 超时返回0
-	}
-
-	return Read_Data;
-}
+    DHT11_STATE_IDLE,          //!< No reading in progress
+    DHT11_STATE_START_SIGNAL,  //!< Data line driven low by the MCU
+    DHT11_STATE_CAPTURE,       //!< Data line released, sensor answer being timestamped
+} dht11_state_t;
 
-void DHT11_Start()
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static volatile dht11_state_t dht11_state = DHT11_STATE_IDLE;
+static timer_event_t          dht11_timer;
+static hal_gpio_irq_t         dht11_irq;
+static dht11_callback_t       dht11_callback;
+static void*                  dht11_callback_context;
+
+/**
+ * @brief Cycle counter value at each falling edge of the data line
+ */
+static volatile uint32_t dht11_edges_in_cycles[DHT11_NB_FALLING_EDGES];
+static volatile uint8_t  dht11_nb_edges;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Timer callback, ends the start signal or the capture
+ *
+ * @param [in] context Not used
+ */
+static void dht11_on_timer_event( void* context );
+
+/**
+ * @brief Data line EXTI callback, timestamps a falling edge
+ *
+ * @param [in] context Not used
+ */
+static void dht11_on_falling_edge( void* context );
+
+/**
+ * @brief Stop the capture, decode the frame and call the user callback
+ */
+static void dht11_complete( void );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+bool dht11_read( dht11_callback_t callback, void* context )
 {
-    uint32_t timeout = 0;
-    DHT_GPIO_OUTPUT();
-    HAL_GPIO_WritePin(DHT11_IO, DHT11_PIN, GPIO_PIN_SET);
-    HAL_GPIO_WritePin(DHT11_IO, DHT11_PIN, GPIO_PIN_RESET);
-    //HAL_Delay(20);
-    delay_ms(20);//拉低总线至少 18ms
-    HAL_GPIO_WritePin(DHT11_IO, DHT11_PIN, GPIO_PIN_SET);
-    delay_us(30);  // 等待30us
-    DHT_GPIO_INPUT();
-    
-    timeout = 0;
-    while(HAL_GPIO_ReadPin(DHT11_IO, DHT11_PIN) && (timeout < 100)) {  //等待DHT11响应低电平
-        delay_us(1);
-        timeout++;
-    }
-    if(timeout >= 100) return;  // 超时退出
-    
-    timeout = 0;
-    while(!HAL_GPIO_ReadPin(DHT11_IO, DHT11_PIN) && (timeout < 100)) { //等待DHT11拉高总线
-        delay_us(1);
-        timeout++;
-    }
-    if(timeout >= 100) return;  // 超时退出
-    
-    timeout = 0;
-    while(HAL_GPIO_ReadPin(DHT11_IO, DHT11_PIN) && (timeout < 100)) {  //等待DHT11拉低总线，开始传送数据
-        delay_us(1);
-        timeout++;
+    CRITICAL_SECTION_BEGIN( );
+    if( dht11_state != DHT11_STATE_IDLE )
+    {
+        CRITICAL_SECTION_END( );
+        return false;
     }
-    if(timeout >= 100) return;  // 超时退出
+    dht11_state = DHT11_STATE_START_SIGNAL;
+    CRITICAL_SECTION_END( );
+
+    dht11_callback         = callback;
+    dht11_callback_context = context;
+
+    hal_gpio_init_out( DHT11_PIN_NAME, 0 );
+
+    timer_init( &dht11_timer, dht11_on_timer_event );
+    timer_set_value( &dht11_timer, DHT11_START_SIGNAL_MS );
+    timer_start( &dht11_timer );
+
+    return true;
 }
 
-void DHT_Read()
+bool dht11_is_busy( void ) { return dht11_state != DHT11_STATE_IDLE; }
+
+bool dht11_is_capturing( void ) { return dht11_state == DHT11_STATE_CAPTURE; }
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void dht11_on_timer_event( void* context )
 {
-    uint8_t timeout_flag = 0;
-    uint32_t timeout = 0;
+    ( void ) context;
+
+    if( dht11_state == DHT11_STATE_START_SIGNAL )
+    {
+        // The cycle counter gives a sub-microsecond timestamp without dedicating a timer to the sensor
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 
-    HAL_DBG_TRACE_INFO("DHT11 read start\n");
+        dht11_nb_edges = 0;
+        dht11_state    = DHT11_STATE_CAPTURE;
 
-    for(int i = 0; i < 5; i++)
+        // Releasing the line lets the pull-up end the start signal
+        dht11_irq.context  = NULL;
+        dht11_irq.callback = dht11_on_falling_edge;
+        hal_gpio_init_in( DHT11_PIN_NAME, HAL_GPIO_PULL_MODE_UP, HAL_GPIO_IRQ_MODE_FALLING, &dht11_irq );
+
+        timer_set_value( &dht11_timer, DHT11_CAPTURE_TIMEOUT_MS );
+        timer_start( &dht11_timer );
+    }
+    else if( dht11_state == DHT11_STATE_CAPTURE )
     {
-        Data[i] = 0;
+        dht11_complete( );
     }
+}
 
-    DHT11_Start();
-    
-    // 检查是否超时退出
-    // 如果DHT11_Start正常完成，DHT11_IO的引脚应该是低电平
-    if(HAL_GPIO_ReadPin(DHT11_IO, DHT11_PIN) == 1)
+static void dht11_on_falling_edge( void* context )
+{
+    ( void ) context;
+
+    if( dht11_state != DHT11_STATE_CAPTURE )
     {
-        // 如果是高电平，可能是DHT11_Start中的某个超时保护触发了
-        return; // 直接返回，flag已经设置为0
+        return;
     }
-    
-    DHT_GPIO_INPUT();
 
-    for(int i = 0; i < 5; i++)
+    dht11_edges_in_cycles[dht11_nb_edges++] = DWT->CYCCNT;
+
+    if( dht11_nb_edges == DHT11_NB_FALLING_EDGES )
     {
-        Data[i] = DHT_Read_Byte();
+        timer_stop( &dht11_timer );
+        dht11_complete( );
     }
-    
-    // 校验和检查
-    if((Data[0]+Data[1]+Data[2]+Data[3]) == Data[4])
+}
+
+static void dht11_complete( void )
+{
+    const uint32_t  cycles_per_us = SystemCoreClock / 1000000;
+    uint32_t        edges_in_us[DHT11_NB_FALLING_EDGES];
+    dht11_reading_t reading = { 0 };
+    dht11_status_t  status;
+
+    hal_gpio_irq_deatach( &dht11_irq );
+    hal_gpio_init_in( DHT11_PIN_NAME, HAL_GPIO_PULL_MODE_UP, HAL_GPIO_IRQ_MODE_OFF, NULL );
+
+    // Timestamps are made relative to the first edge so that a cycle counter wrap-around does not matter
+    for( uint8_t i = 0; i < dht11_nb_edges; i++ )
     {
-        flag = 1; // 读取成功
-        HAL_DBG_TRACE_INFO("DHT11 read success\n");
+        edges_in_us[i] = ( dht11_edges_in_cycles[i] - dht11_edges_in_cycles[0] ) / cycles_per_us;
     }
-    else
+
+    status      = dht11_decode_falling_edges( edges_in_us, dht11_nb_edges, &reading );
+    dht11_state = DHT11_STATE_IDLE;
+
+    if( dht11_callback != NULL )
     {
-        flag = 0; // 读取失败
-        HAL_DBG_TRACE_INFO("DHT11 read failed\n");
+        dht11_callback( dht11_callback_context, status, &reading );
     }
 }
+
+/* --- EOF ------------------------------------------------------------------ */
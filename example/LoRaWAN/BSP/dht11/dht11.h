@@ -1,17 +1,134 @@
+/**
+ * @file      dht11.h
+ *
+ * @brief     DHT11 temperature and humidity sensor driver definition.
+ *
+ * Revised BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
 #ifndef DHT11_H
 #define DHT11_H
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
 #include <stdint.h>
 #include <stdbool.h>
-#include "stdio.h"
+#include "dht11_decoder.h"
 
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
 
-#define DHT11_IO        GPIOC
-#define DHT11_PIN       GPIO_PIN_10
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
 
+/**
+ * @brief Data line of the sensor
+ */
+#ifndef DHT11_PIN_NAME
+#define DHT11_PIN_NAME PC_10
+#endif
 
-void DHT11_Start(void);
-void DHT_Read(void);
+/**
+ * @brief Duration of the start signal, at least 18 ms according to the sensor datasheet
+ */
+#ifndef DHT11_START_SIGNAL_MS
+#define DHT11_START_SIGNAL_MS 20
+#endif
 
+/**
+ * @brief Maximum duration of the sensor answer; a complete frame lasts about 5 ms
+ */
+#ifndef DHT11_CAPTURE_TIMEOUT_MS
+#define DHT11_CAPTURE_TIMEOUT_MS 10
 #endif
 
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Callback called once a reading is over
+ *
+ * @remark Called from interrupt context
+ *
+ * @param [in] context Context given to dht11_read
+ * @param [in] status  Reading status
+ * @param [in] reading Reading, only valid if status is DHT11_STATUS_OK
+ */
+typedef void ( *dht11_callback_t )( void* context, dht11_status_t status, const dht11_reading_t* reading );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Start a reading of the sensor
+ *
+ * The function returns immediately: the start signal is timed by a software timer, then the falling edges of the
+ * sensor answer are timestamped in the EXTI handler of the data line. The MCU may sleep during the start signal, but
+ * must not enter stop mode while dht11_is_capturing returns true.
+ *
+ * @param [in] callback Callback called once the reading is over
+ * @param [in] context  Context passed to the callback
+ *
+ * @returns True if the reading is started, false if another reading is in progress
+ */
+bool dht11_read( dht11_callback_t callback, void* context );
+
+/**
+ * @brief Check if a reading is in progress
+ *
+ * @returns True if a reading is in progress
+ */
+bool dht11_is_busy( void );
+
+/**
+ * @brief Check if the sensor answer is being captured
+ *
+ * @returns True if the MCU has to stay out of stop mode
+ */
+bool dht11_is_capturing( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // DHT11_H
+
+/* --- EOF ------------------------------------------------------------------ */
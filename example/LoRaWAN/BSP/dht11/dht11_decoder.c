@@ -0,0 +1,114 @@
+/**
+ * @file      dht11_decoder.c
+ *
+ * @brief     DHT11 frame decoder implementation.
+ *
+ * Revised BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include "dht11_decoder.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+dht11_status_t dht11_decode_falling_edges( const uint32_t* edges_in_us, uint8_t nb_edges, dht11_reading_t* reading )
+{
+    uint8_t  bytes[DHT11_NB_BITS / 8] = { 0 };
+    uint32_t period_in_us;
+
+    if( nb_edges < DHT11_NB_FALLING_EDGES )
+    {
+        return DHT11_STATUS_MISSING_EDGES;
+    }
+    edges_in_us += nb_edges - DHT11_NB_FALLING_EDGES;
+
+    period_in_us = edges_in_us[1] - edges_in_us[0];
+    if( ( period_in_us < DHT11_RESPONSE_PERIOD_MIN_US ) || ( period_in_us > DHT11_RESPONSE_PERIOD_MAX_US ) )
+    {
+        return DHT11_STATUS_BAD_TIMING;
+    }
+
+    for( uint8_t bit = 0; bit < DHT11_NB_BITS; bit++ )
+    {
+        period_in_us = edges_in_us[bit + 2] - edges_in_us[bit + 1];
+        if( ( period_in_us < DHT11_BIT_PERIOD_MIN_US ) || ( period_in_us > DHT11_BIT_PERIOD_MAX_US ) )
+        {
+            return DHT11_STATUS_BAD_TIMING;
+        }
+        bytes[bit >> 3] = ( bytes[bit >> 3] << 1 ) | ( ( period_in_us > DHT11_BIT_PERIOD_THRESHOLD_US ) ? 1 : 0 );
+    }
+
+    if( ( uint8_t )( bytes[0] + bytes[1] + bytes[2] + bytes[3] ) != bytes[4] )
+    {
+        return DHT11_STATUS_BAD_CHECKSUM;
+    }
+
+    reading->humidity_int    = bytes[0];
+    reading->humidity_dec    = bytes[1];
+    reading->temperature_int = bytes[2];
+    reading->temperature_dec = bytes[3];
+
+    return DHT11_STATUS_OK;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,136 @@
+/**
+ * @file      dht11_decoder.h
+ *
+ * @brief     DHT11 frame decoder definition.
+ *
+ * Revised BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DHT11_DECODER_H
+#define DHT11_DECODER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Number of data bits sent by the sensor: humidity, temperature and checksum bytes
+ */
+#define DHT11_NB_BITS 40
+
+/**
+ * @brief Number of falling edges of a frame: response, start of each data bit and end of frame
+ */
+#define DHT11_NB_FALLING_EDGES ( DHT11_NB_BITS + 2 )
+
+/**
+ * @brief Accepted duration of the sensor response (80 us low, 80 us high), in us
+ */
+#define DHT11_RESPONSE_PERIOD_MIN_US 120
+#define DHT11_RESPONSE_PERIOD_MAX_US 220
+
+/**
+ * @brief Accepted duration of a data bit (50 us low, then 26-28 us high for a 0 or 70 us high for a 1), in us
+ */
+#define DHT11_BIT_PERIOD_MIN_US 60
+#define DHT11_BIT_PERIOD_MAX_US 160
+
+/**
+ * @brief Data bits lasting longer than this are 1, in us
+ */
+#define DHT11_BIT_PERIOD_THRESHOLD_US 100
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Outcome of a DHT11 reading
+ */
+typedef enum dht11_status_e
+{
+    DHT11_STATUS_OK,             //!< Reading is valid
+    DHT11_STATUS_MISSING_EDGES,  //!< The sensor did not answer, or the frame is incomplete
+    DHT11_STATUS_BAD_TIMING,     //!< A pulse is out of the sensor timing specification
+    DHT11_STATUS_BAD_CHECKSUM,   //!< The checksum byte does not match the data
+} dht11_status_t;
+
+/**
+ * @brief DHT11 reading
+ */
+typedef struct dht11_reading_s
+{
+    uint8_t humidity_int;     //!< Relative humidity, integral part [%]
+    uint8_t humidity_dec;     //!< Relative humidity, decimal part
+    uint8_t temperature_int;  //!< Temperature, integral part [degC]
+    uint8_t temperature_dec;  //!< Temperature, decimal part
+} dht11_reading_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Decode a DHT11 frame from the timestamps of the falling edges of the data line
+ *
+ * @remark Only the last DHT11_NB_FALLING_EDGES edges are used, so spurious edges before the sensor response are
+ *         ignored. Timestamps may wrap around.
+ *
+ * @param [in]  edges_in_us Timestamps of the falling edges, in us
+ * @param [in]  nb_edges    Number of timestamps
+ * @param [out] reading     Decoded reading, valid if DHT11_STATUS_OK is returned
+ *
+ * @returns Decoding status
+ */
+dht11_status_t dht11_decode_falling_edges( const uint32_t* edges_in_us, uint8_t nb_edges, dht11_reading_t* reading );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // DHT11_DECODER_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,308 @@
+/*!
+ * @file      test_dht11_decoder.c
+ *
+ * @brief     Unit tests of the DHT11 frame decoder
+ *
+ * Revised BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "dht11_decoder.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+#define CHECK( condition )                                                                  \
+    do                                                                                      \
+    {                                                                                       \
+        nb_checks++;                                                                        \
+        if( !( condition ) )                                                                \
+        {                                                                                   \
+            fprintf( stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition ); \
+            nb_failures++;                                                                  \
+        }                                                                                   \
+    } while( 0 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Nominal timings of the sensor datasheet, in us
+ */
+#define RESPONSE_PERIOD_US 160
+#define BIT_0_PERIOD_US 77
+#define BIT_1_PERIOD_US 120
+
+/**
+ * @brief Frame used by the tests: 55.0 %, 23.4 degC
+ */
+static const uint8_t frame_bytes[5] = { 55, 0, 23, 4, 82 };
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static unsigned int nb_checks;
+static unsigned int nb_failures;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/**
+ * @brief Build the falling edge timestamps of a frame
+ *
+ * @param [in]  bytes        Frame bytes, checksum included
+ * @param [in]  start_in_us  Timestamp of the response edge
+ * @param [in]  jitter_in_us Added to or removed from every other bit period
+ * @param [out] edges_in_us  Timestamps, DHT11_NB_FALLING_EDGES of them
+ */
+static void build_frame( const uint8_t bytes[5], uint32_t start_in_us, int32_t jitter_in_us, uint32_t* edges_in_us )
+{
+    uint32_t time_in_us = start_in_us;
+
+    edges_in_us[0] = time_in_us;
+    time_in_us += RESPONSE_PERIOD_US;
+    edges_in_us[1] = time_in_us;
+    for( uint8_t bit = 0; bit < DHT11_NB_BITS; bit++ )
+    {
+        const bool is_one = ( ( bytes[bit >> 3] >> ( 7 - ( bit & 7 ) ) ) & 1 ) != 0;
+
+        const int32_t jitter = ( ( bit & 1 ) != 0 ) ? jitter_in_us : -jitter_in_us;
+
+        time_in_us += ( is_one ? BIT_1_PERIOD_US : BIT_0_PERIOD_US ) + jitter;
+        edges_in_us[bit + 2] = time_in_us;
+    }
+}
+
+/**
+ * @brief Change the period between two edges, keeping the following periods
+ */
+static void set_period( uint32_t* edges_in_us, uint8_t index, uint32_t period_in_us )
+{
+    const uint32_t shift = period_in_us - ( edges_in_us[index] - edges_in_us[index - 1] );
+
+    for( uint8_t i = index; i < DHT11_NB_FALLING_EDGES; i++ )
+    {
+        edges_in_us[i] += shift;
+    }
+}
+
+/**
+ * @brief Get one of the data bytes of a reading, in frame order
+ */
+static uint8_t reading_byte( const dht11_reading_t* reading, uint8_t index )
+{
+    const uint8_t bytes[4] = { reading->humidity_int, reading->humidity_dec, reading->temperature_int,
+                               reading->temperature_dec };
+
+    return bytes[index];
+}
+
+static void test_valid_frame( void )
+{
+    uint32_t        edges_in_us[DHT11_NB_FALLING_EDGES + 1];
+    dht11_reading_t reading = { 0 };
+
+    build_frame( frame_bytes, 1000, 0, edges_in_us );
+    CHECK( dht11_decode_falling_edges( edges_in_us, DHT11_NB_FALLING_EDGES, &reading ) == DHT11_STATUS_OK );
+    CHECK( reading.humidity_int == 55 );
+    CHECK( reading.humidity_dec == 0 );
+    CHECK( reading.temperature_int == 23 );
+    CHECK( reading.temperature_dec == 4 );
+
+    // Jitter, and timestamps wrapping around
+    build_frame( frame_bytes, 0xFFFFFF00, 15, edges_in_us );
+    CHECK( dht11_decode_falling_edges( edges_in_us, DHT11_NB_FALLING_EDGES, &reading ) == DHT11_STATUS_OK );
+    CHECK( reading.temperature_int == 23 );
+
+    // A glitch before the response is ignored
+    build_frame( frame_bytes, 1000, 0, &edges_in_us[1] );
+    edges_in_us[0] = 990;
+    CHECK( dht11_decode_falling_edges( edges_in_us, DHT11_NB_FALLING_EDGES + 1, &reading ) == DHT11_STATUS_OK );
+    CHECK( reading.humidity_int == 55 );
+}
+
+static void test_response_timing( void )
+{
+    uint32_t        edges_in_us[DHT11_NB_FALLING_EDGES];
+    dht11_reading_t reading;
+    const struct
+    {
+        uint32_t       period_in_us;
+        dht11_status_t status;
+    } cases[] = {
+        { DHT11_RESPONSE_PERIOD_MIN_US - 1, DHT11_STATUS_BAD_TIMING },
+        { DHT11_RESPONSE_PERIOD_MIN_US, DHT11_STATUS_OK },
+        { DHT11_RESPONSE_PERIOD_MAX_US, DHT11_STATUS_OK },
+        { DHT11_RESPONSE_PERIOD_MAX_US + 1, DHT11_STATUS_BAD_TIMING },
+        { 20, DHT11_STATUS_BAD_TIMING },
+        { 1000, DHT11_STATUS_BAD_TIMING },
+    };
+
+    for( size_t i = 0; i < sizeof( cases ) / sizeof( cases[0] ); i++ )
+    {
+        build_frame( frame_bytes, 1000, 0, edges_in_us );
+        set_period( edges_in_us, 1, cases[i].period_in_us );
+        CHECK( dht11_decode_falling_edges( edges_in_us, DHT11_NB_FALLING_EDGES, &reading ) == cases[i].status );
+    }
+}
+
+static void test_bit_timing( void )
+{
+    uint32_t        edges_in_us[DHT11_NB_FALLING_EDGES];
+    dht11_reading_t reading;
+    const struct
+    {
+        uint32_t       period_in_us;
+        dht11_status_t status;
+    } cases[] = {
+        { DHT11_BIT_PERIOD_MIN_US - 1, DHT11_STATUS_BAD_TIMING },
+        { DHT11_BIT_PERIOD_MAX_US + 1, DHT11_STATUS_BAD_TIMING },
+        { 0, DHT11_STATUS_BAD_TIMING },
+        { 500, DHT11_STATUS_BAD_TIMING },
+    };
+
+    // Out of range on the first, a middle, and the last bit
+    const uint8_t edges[] = { 2, 21, DHT11_NB_FALLING_EDGES - 1 };
+
+    for( size_t e = 0; e < sizeof( edges ); e++ )
+    {
+        for( size_t i = 0; i < sizeof( cases ) / sizeof( cases[0] ); i++ )
+        {
+            build_frame( frame_bytes, 1000, 0, edges_in_us );
+            set_period( edges_in_us, edges[e], cases[i].period_in_us );
+            CHECK( dht11_decode_falling_edges( edges_in_us, DHT11_NB_FALLING_EDGES, &reading ) == cases[i].status );
+        }
+    }
+}
+
+static void test_bit_threshold( void )
+{
+    uint32_t        edges_in_us[DHT11_NB_FALLING_EDGES];
+    dht11_reading_t reading;
+    const uint8_t   zeros[5] = { 0 };
+
+    // The range limits and both sides of the threshold, on every bit
+    for( uint8_t bit = 0; bit < DHT11_NB_BITS - 8; bit++ )
+    {
+        uint8_t expected[5] = { 0 };
+
+        build_frame( zeros, 1000, 0, edges_in_us );
+        set_period( edges_in_us, bit + 2, DHT11_BIT_PERIOD_THRESHOLD_US );
+        CHECK( dht11_decode_falling_edges( edges_in_us, DHT11_NB_FALLING_EDGES, &reading ) == DHT11_STATUS_OK );
+
+        // A 1, with the checksum bit set accordingly
+        expected[bit >> 3] = 0x80 >> ( bit & 7 );
+        expected[4]        = 0x80 >> ( bit & 7 );
+        build_frame( expected, 1000, 0, edges_in_us );
+        set_period( edges_in_us, bit + 2, DHT11_BIT_PERIOD_THRESHOLD_US + 1 );
+        set_period( edges_in_us, 32 + ( bit & 7 ) + 2, DHT11_BIT_PERIOD_MAX_US );
+        CHECK( dht11_decode_falling_edges( edges_in_us, DHT11_NB_FALLING_EDGES, &reading ) == DHT11_STATUS_OK );
+        CHECK( reading_byte( &reading, bit >> 3 ) == expected[bit >> 3] );
+
+        // A threshold period with the checksum expecting a 1
+        build_frame( expected, 1000, 0, edges_in_us );
+        set_period( edges_in_us, bit + 2, DHT11_BIT_PERIOD_THRESHOLD_US );
+        CHECK( dht11_decode_falling_edges( edges_in_us, DHT11_NB_FALLING_EDGES, &reading ) ==
+               DHT11_STATUS_BAD_CHECKSUM );
+    }
+
+    build_frame( zeros, 1000, 0, edges_in_us );
+    set_period( edges_in_us, 2, DHT11_BIT_PERIOD_MIN_US );
+    CHECK( dht11_decode_falling_edges( edges_in_us, DHT11_NB_FALLING_EDGES, &reading ) == DHT11_STATUS_OK );
+}
+
+static void test_checksum( void )
+{
+    uint32_t        edges_in_us[DHT11_NB_FALLING_EDGES];
+    dht11_reading_t reading = { 0 };
+    uint8_t         bytes[5];
+
+    for( uint8_t i = 0; i < 5; i++ )
+    {
+        bytes[i] = frame_bytes[i];
+    }
+    bytes[4]++;
+    build_frame( bytes, 1000, 0, edges_in_us );
+    CHECK( dht11_decode_falling_edges( edges_in_us, DHT11_NB_FALLING_EDGES, &reading ) == DHT11_STATUS_BAD_CHECKSUM );
+    CHECK( reading.humidity_int == 0 );
+
+    // The checksum is the low byte of the sum
+    bytes[0] = 200;
+    bytes[1] = 0;
+    bytes[2] = 50;
+    bytes[3] = 10;
+    bytes[4] = ( uint8_t ) ( 200 + 50 + 10 );
+    build_frame( bytes, 1000, 0, edges_in_us );
+    CHECK( dht11_decode_falling_edges( edges_in_us, DHT11_NB_FALLING_EDGES, &reading ) == DHT11_STATUS_OK );
+    CHECK( reading.humidity_int == 200 );
+}
+
+static void test_truncated_capture( void )
+{
+    uint32_t        edges_in_us[DHT11_NB_FALLING_EDGES];
+    dht11_reading_t reading;
+
+    build_frame( frame_bytes, 1000, 0, edges_in_us );
+    for( uint8_t nb_edges = 0; nb_edges < DHT11_NB_FALLING_EDGES; nb_edges++ )
+    {
+        CHECK( dht11_decode_falling_edges( edges_in_us, nb_edges, &reading ) == DHT11_STATUS_MISSING_EDGES );
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+int main( void )
+{
+    test_valid_frame( );
+    test_response_timing( );
+    test_bit_timing( );
+    test_bit_threshold( );
+    test_checksum( );
+    test_truncated_capture( );
+
+    printf( "%u checks, %u failures\n", nb_checks, nb_failures );
+
+    return ( nb_failures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -6,7 +6,7 @@
 #include "lr1121_modem_helper.h"
 #include "lr1121_modem_system_types.h"
 #include "dht11.h"
-#include "delay.h"
+#include "sensor_sampling.h"
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE MACROS-----------------------------------------------------------
@@ -72,6 +72,11 @@
  */
 #define PERIODICAL_UPLINK_DELAY_S 300
 
+/**
+ * @brief Sensor sampling period in milliseconds
+ */
+#define SENSOR_SAMPLING_PERIOD_MS 60000
+
 #define EXTI_BUTTON PC_13
 
 /*!
@@ -96,6 +101,11 @@
  */
 #define LORAWAN_REGION_USED LR1121_LORAWAN_REGION_EU868
 
+/**
+ * @brief Size of the modem event handler table
+ */
+#define MODEM_EVENT_NB_TYPES ( LR1121_MODEM_LORAWAN_EVENT_REGIONAL_DUTY_CYCLE + 1 )
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE CONSTANTS -------------------------------------------------------
@@ -116,6 +126,23 @@ static const uint8_t user_app_key[16] = LORAWAN_APP_KEY;
  * --- PRIVATE TYPES -----------------------------------------------------------
  */
 
+/**
+ * @brief Modem event handler
+ *
+ * @param [in] context Modem context
+ * @param [in] event   Event read from the modem
+ */
+typedef void ( *modem_event_handler_t )( void* context, const lr1121_modem_event_fields_t* event );
+
+/**
+ * @brief Modem event handler table entry
+ */
+typedef struct modem_event_handler_entry_s
+{
+    const char*           name;     //!< Name printed on reception, NULL for events not handled
+    modem_event_handler_t handler;  //!< Handler, NULL for events that are only printed
+} modem_event_handler_entry_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE VARIABLES -------------------------------------------------------
@@ -131,13 +158,12 @@ static uint8_t chip_pin[4] = { 0 };
 
 extern lr1121_t lr1121;
 
-static volatile bool user_button_is_press = false;  // Flag indicating if the button is pressed
+static volatile bool user_button_is_press   = false;  // Flag indicating if the button is pressed
+static volatile bool modem_event_is_pending = false;  // Flag indicating if the modem has events to be read
 static uint16_t      uplink_counter       = 0;      // Counter for uplinks sent
 static uint16_t      confirmed_counter    = 0;      // Counter for confirmed uplinks
 static bool          uplink_sending       = false;  // Flag indicating an uplink is requested but not yet sent
 
-extern uint8_t Data[5];
-extern int flag;
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -163,11 +189,54 @@ static lr1121_modem_response_code_t send_frame( const uint8_t* tx_frame_buffer,
                                                 uint8_t port, const lr1121_modem_uplink_type_t tx_confirmed );
 
 /**
- * @brief Process received events
+ * @brief Modem event EXTI callback, defers the event processing to the main loop
+ *
+ * @param context Define by the user at the init
+ */
+static void modem_event_callback( void* context );
+
+/**
+ * @brief Read and dispatch all pending modem events
  *
+ * @remark Called from the main loop: the handlers use the modem SPI interface
  */
 static void event_process( void* context );
-void read_DHT11_data();
+
+/**
+ * @brief Modem event handlers
+ */
+static void on_modem_event_reset( void* context, const lr1121_modem_event_fields_t* event );
+static void on_modem_event_alarm( void* context, const lr1121_modem_event_fields_t* event );
+static void on_modem_event_joined( void* context, const lr1121_modem_event_fields_t* event );
+static void on_modem_event_tx_done( void* context, const lr1121_modem_event_fields_t* event );
+static void on_modem_event_down_data( void* context, const lr1121_modem_event_fields_t* event );
+
+/**
+ * @brief Serialize a 16-bit value in big endian
+ *
+ * @returns Pointer to the byte following the serialized value
+ */
+static uint8_t* serialize_uint16( uint8_t* buffer, uint16_t value );
+
+/**
+ * @brief Modem event handler table, indexed by event type
+ */
+static const modem_event_handler_entry_t modem_event_handlers[MODEM_EVENT_NB_TYPES] = {
+    [LR1121_MODEM_LORAWAN_EVENT_RESET]                             = { "RESET", on_modem_event_reset },
+    [LR1121_MODEM_LORAWAN_EVENT_ALARM]                             = { "ALARM", on_modem_event_alarm },
+    [LR1121_MODEM_LORAWAN_EVENT_JOINED]                            = { "JOINED", on_modem_event_joined },
+    [LR1121_MODEM_LORAWAN_EVENT_JOIN_FAIL]                         = { "JOINFAIL", NULL },
+    [LR1121_MODEM_LORAWAN_EVENT_TX_DONE]                           = { "TXDONE", on_modem_event_tx_done },
+    [LR1121_MODEM_LORAWAN_EVENT_DOWN_DATA]                         = { "DOWNDATA", on_modem_event_down_data },
+    [LR1121_MODEM_LORAWAN_EVENT_LINK_CHECK]                        = { "LINK_CHECK", NULL },
+    [LR1121_MODEM_LORAWAN_EVENT_LORAWAN_MAC_TIME]                  = { "LORAWAN MAC TIME", NULL },
+    [LR1121_MODEM_LORAWAN_EVENT_CLASS_B_PING_SLOT_INFO]            = { "CLASS_B_PING_SLOT_INFO", NULL },
+    [LR1121_MODEM_LORAWAN_EVENT_CLASS_B_STATUS]                    = { "CLASS_B_STATUS", NULL },
+    [LR1121_MODEM_LORAWAN_EVENT_NEW_MULTICAST_SESSION_CLASS_C]     = { "New MULTICAST CLASS_C", NULL },
+    [LR1121_MODEM_LORAWAN_EVENT_NEW_MULTICAST_SESSION_CLASS_B]     = { "New MULTICAST CLASS_B", NULL },
+    [LR1121_MODEM_LORAWAN_EVENT_NO_MORE_MULTICAST_SESSION_CLASS_C] = { "MULTICAST CLASS_C STOP", NULL },
+    [LR1121_MODEM_LORAWAN_EVENT_NO_MORE_MULTICAST_SESSION_CLASS_B] = { "MULTICAST CLASS_B STOP", NULL },
+};
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -198,8 +267,8 @@ int main( void )
     // Configure event callback on interrupt
     hal_gpio_irq_t event_callback = {
         .pin      = lr1121.event.pin,
-        .context  = &lr1121,        // context passed to the callback
-        .callback = event_process,  // callback called when event pin is triggered
+        .context  = NULL,                  // the modem events are read from the main loop
+        .callback = modem_event_callback,  // callback called when event pin is triggered
     };
     hal_gpio_init_in( lr1121.event.pin, HAL_GPIO_PULL_MODE_NONE, HAL_GPIO_IRQ_MODE_RISING, &event_callback );
 
@@ -214,8 +283,18 @@ int main( void )
     HAL_DBG_TRACE_MSG( "Initialization done\n\n" );
     lr1121_modem_system_reboot( &lr1121, false );
 
+    // Sample the sensors in the background, uplinks only serialize the stored samples
+    sensor_sampling_start( SENSOR_SAMPLING_PERIOD_MS );
+
     while( 1 )
     {
+        // Process modem events in thread context
+        if( modem_event_is_pending == true )
+        {
+            modem_event_is_pending = false;
+            event_process( &lr1121 );
+        }
+
         // Check button
         if( user_button_is_press == true )
         {
@@ -245,7 +324,8 @@ int main( void )
         }
 
         hal_mcu_disable_irq( );
-        if( ( user_button_is_press == false ) )
+        if( ( user_button_is_press == false ) && ( modem_event_is_pending == false ) &&
+            ( dht11_is_capturing( ) == false ) )
         {
             hal_watchdog_reload( );
             hal_mcu_set_sleep_for_ms( WATCHDOG_RELOAD_PERIOD_MS );
@@ -260,6 +340,13 @@ int main( void )
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
  */
 
+static void modem_event_callback( void* context )
+{
+    ( void ) context;  // The modem is read from the main loop
+
+    modem_event_is_pending = true;
+}
+
 static void event_process( void* context )
 {
     // Continue to read modem events until all of them have been processed.
@@ -271,159 +358,139 @@ static void event_process( void* context )
         rc_event = lr1121_modem_get_event( context, &current_event );
         if( rc_event == LR1121_MODEM_RESPONSE_CODE_OK )
         {
-            switch( current_event.event_type )
+            const modem_event_handler_entry_t* entry =
+                ( current_event.event_type < MODEM_EVENT_NB_TYPES ) ? &modem_event_handlers[current_event.event_type]
+                                                                    : NULL;
+
+            if( ( entry == NULL ) || ( entry->name == NULL ) )
             {
-            case LR1121_MODEM_LORAWAN_EVENT_RESET:
+                HAL_DBG_TRACE_INFO( "Event not handled 0x%02x\n", current_event.event_type );
+                continue;
+            }
+
+            HAL_DBG_TRACE_PRINTF( HAL_DBG_TRACE_COLOR_BLUE "Event received: %s\n\n" HAL_DBG_TRACE_COLOR_DEFAULT,
+                                  entry->name );
+            if( entry->handler != NULL )
+            {
+                entry->handler( context, &current_event );
+            }
+        }
+    } while( rc_event != LR1121_MODEM_RESPONSE_CODE_NO_EVENT );
+}
 
-                HAL_DBG_TRACE_MSG_COLOR( "Event received: RESET\n\n", HAL_DBG_TRACE_COLOR_BLUE );
+static void on_modem_event_reset( void* context, const lr1121_modem_event_fields_t* event )
+{
+    ( void ) event;
 
-                ASSERT_SMTC_MODEM_RC( lr1121_modem_system_cfg_lfclk( context, LR1121_MODEM_SYSTEM_LFCLK_XTAL, true ) );
-                ASSERT_SMTC_MODEM_RC( lr1121_modem_set_crystal_error( context, 50 ) );
-                get_and_print_crashlog( context );
+    ASSERT_SMTC_MODEM_RC( lr1121_modem_system_cfg_lfclk( context, LR1121_MODEM_SYSTEM_LFCLK_XTAL, true ) );
+    ASSERT_SMTC_MODEM_RC( lr1121_modem_set_crystal_error( context, 50 ) );
+    get_and_print_crashlog( context );
 #if( !USE_LR11XX_CREDENTIALS )
-                // Set user credentials
-                HAL_DBG_TRACE_INFO( "###### ===== LR1121 SET EUI and KEYS ==== ######\n\n" );
-                ASSERT_SMTC_MODEM_RC( lr1121_modem_set_dev_eui( context, user_dev_eui ) );
-                ASSERT_SMTC_MODEM_RC( lr1121_modem_set_join_eui( context, user_join_eui ) );
-                ASSERT_SMTC_MODEM_RC( lr1121_modem_set_app_key( context, user_app_key ) );
-                ASSERT_SMTC_MODEM_RC( lr1121_modem_set_nwk_key( context, user_nwk_key ) );
-                uint8_t tmp_pin[4] = { 0 };  // The chip_pin is not used if we use custom credentials
-                print_lorawan_credentials( user_dev_eui, user_join_eui, tmp_pin, USE_LR11XX_CREDENTIALS );
+    // Set user credentials
+    HAL_DBG_TRACE_INFO( "###### ===== LR1121 SET EUI and KEYS ==== ######\n\n" );
+    ASSERT_SMTC_MODEM_RC( lr1121_modem_set_dev_eui( context, user_dev_eui ) );
+    ASSERT_SMTC_MODEM_RC( lr1121_modem_set_join_eui( context, user_join_eui ) );
+    ASSERT_SMTC_MODEM_RC( lr1121_modem_set_app_key( context, user_app_key ) );
+    ASSERT_SMTC_MODEM_RC( lr1121_modem_set_nwk_key( context, user_nwk_key ) );
+    uint8_t tmp_pin[4] = { 0 };  // The chip_pin is not used if we use custom credentials
+    print_lorawan_credentials( user_dev_eui, user_join_eui, tmp_pin, USE_LR11XX_CREDENTIALS );
 #else
-                // Get internal credentials
-                uint8_t tmp_join_eui[8] = { 0 };
-                ASSERT_SMTC_MODEM_RC( lr1121_modem_system_read_uid( context, chip_eui ) );
-                ASSERT_SMTC_MODEM_RC( lr1121_modem_system_read_pin( context, chip_pin ) );
-                ASSERT_SMTC_MODEM_RC( lr1121_modem_get_join_eui( context, tmp_join_eui ) );
-                print_lorawan_credentials( chip_eui, tmp_join_eui, chip_pin, USE_LR11XX_CREDENTIALS );
+    // Get internal credentials
+    uint8_t tmp_join_eui[8] = { 0 };
+    ASSERT_SMTC_MODEM_RC( lr1121_modem_system_read_uid( context, chip_eui ) );
+    ASSERT_SMTC_MODEM_RC( lr1121_modem_system_read_pin( context, chip_pin ) );
+    ASSERT_SMTC_MODEM_RC( lr1121_modem_get_join_eui( context, tmp_join_eui ) );
+    print_lorawan_credentials( chip_eui, tmp_join_eui, chip_pin, USE_LR11XX_CREDENTIALS );
 #endif
 
-                // Set user region
-                ASSERT_SMTC_MODEM_RC( lr1121_modem_set_region( context, LORAWAN_REGION_USED ) );
-                print_lorawan_region( LORAWAN_REGION_USED );
-                // print user uplink delay
-				HAL_DBG_TRACE_INFO( "Periodical uplink (%d sec) \n\n\n", PERIODICAL_UPLINK_DELAY_S );
-                // Schedule a LoRaWAN network JoinRequest.
-                ASSERT_SMTC_MODEM_RC( lr1121_modem_join( context ) );
-                HAL_DBG_TRACE_INFO( "###### ===== JOINING ==== ######\n\n\n" );
-                break;
-
-            case LR1121_MODEM_LORAWAN_EVENT_ALARM:
-                HAL_DBG_TRACE_MSG_COLOR( "Event received: ALARM\n\n", HAL_DBG_TRACE_COLOR_BLUE );
-                // Send periodical uplink on port 101
-                send_uplinks_counter_on_port( 101 );
-                // Restart periodical uplink alarm
-                ASSERT_SMTC_MODEM_RC( lr1121_modem_set_alarm_timer( context, PERIODICAL_UPLINK_DELAY_S ) );
-                break;
-
-            case LR1121_MODEM_LORAWAN_EVENT_JOINED:
-                HAL_DBG_TRACE_MSG_COLOR( "Event received: JOINED\n", HAL_DBG_TRACE_COLOR_BLUE );
-                HAL_DBG_TRACE_INFO( "Modem is now joined \n\n" );
-
-                uint8_t adr_custom_list[16] = { 0 };
-                ASSERT_SMTC_MODEM_RC( lr1121_modem_set_adr_profile(
-                    context, LR1121_MODEM_ADR_PROFILE_NETWORK_SERVER_CONTROLLED, adr_custom_list ) );
-
-                // Send first periodical uplink on port 101
-                send_uplinks_counter_on_port( 101 );
-                // start periodical uplink alarm
-                ASSERT_SMTC_MODEM_RC( lr1121_modem_set_alarm_timer( context, PERIODICAL_UPLINK_DELAY_S ) );
-                break;
-
-            case LR1121_MODEM_LORAWAN_EVENT_TX_DONE:
-            {
-                const lr1121_modem_tx_done_event_t tx_done_event_data =
-                    ( lr1121_modem_tx_done_event_t )( current_event.data >> 8 );
-                HAL_DBG_TRACE_MSG_COLOR( "Event received: TXDONE\n\n", HAL_DBG_TRACE_COLOR_BLUE );
+    // Set user region
+    ASSERT_SMTC_MODEM_RC( lr1121_modem_set_region( context, LORAWAN_REGION_USED ) );
+    print_lorawan_region( LORAWAN_REGION_USED );
+    // print user uplink delay
+    HAL_DBG_TRACE_INFO( "Periodical uplink (%d sec) \n\n\n", PERIODICAL_UPLINK_DELAY_S );
+    // Schedule a LoRaWAN network JoinRequest.
+    ASSERT_SMTC_MODEM_RC( lr1121_modem_join( context ) );
+    HAL_DBG_TRACE_INFO( "###### ===== JOINING ==== ######\n\n\n" );
+}
 
-                HAL_DBG_TRACE_MSG( "TX DATA     : " );
+static void on_modem_event_alarm( void* context, const lr1121_modem_event_fields_t* event )
+{
+    ( void ) event;
 
-                switch( tx_done_event_data )
-                {
-                case LR1121_MODEM_TX_NOT_SENT:
-                {
-                    HAL_DBG_TRACE_PRINTF( " NOT SENT" );
-                    uplink_counter--;
-                    break;
-                }
-                case LR1121_MODEM_CONFIRMED_TX:
-                {
-                    HAL_DBG_TRACE_PRINTF( " CONFIRMED - ACK" );
-                    confirmed_counter++;
-                    break;
-                }
-                case LR1121_MODEM_UNCONFIRMED_TX:
-                {
-                    HAL_DBG_TRACE_MSG( " UNCONFIRMED\n\n" );
-                    break;
-                }
-                default:
-                {
-                    HAL_DBG_TRACE_PRINTF( " unknown value (%02x)\n\n", tx_done_event_data );
-                }
-                }
-                HAL_DBG_TRACE_MSG( "\n\n" );
+    // Send periodical uplink on port 101
+    send_uplinks_counter_on_port( 101 );
+    // Restart periodical uplink alarm
+    ASSERT_SMTC_MODEM_RC( lr1121_modem_set_alarm_timer( context, PERIODICAL_UPLINK_DELAY_S ) );
+}
 
-                HAL_DBG_TRACE_INFO( "Transmission done \n" );
-                uplink_sending = false;  // Reset flag indicating an uplink request has been processed
-                break;
-            }
+static void on_modem_event_joined( void* context, const lr1121_modem_event_fields_t* event )
+{
+    ( void ) event;
 
-            case LR1121_MODEM_LORAWAN_EVENT_DOWN_DATA:
-                HAL_DBG_TRACE_MSG_COLOR( "Event received: DOWNDATA\n\n", HAL_DBG_TRACE_COLOR_BLUE );
-                uint8_t rx_payload[LORAWAN_APP_DATA_MAX_SIZE] = { 0 };  // Buffer for rx payload
-                uint8_t rx_payload_size                       = 0;      // Size of the payload in the rx_payload buffer
-                lr1121_modem_downlink_metadata_t rx_metadata  = { 0 };  // Metadata of downlink
-                uint8_t                          rx_remaining = 0;      // Remaining downlink payload in modem
-                // Get downlink data
-                ASSERT_SMTC_MODEM_RC( lr1121_modem_get_downlink_data_size( context, &rx_payload_size, &rx_remaining ) );
-                ASSERT_SMTC_MODEM_RC( lr1121_modem_get_downlink_data( context, rx_payload, rx_payload_size ) );
-                ASSERT_SMTC_MODEM_RC( lr1121_modem_get_downlink_metadata( context, &rx_metadata ) );
-                HAL_DBG_TRACE_PRINTF( "Data received on port %u\n", rx_metadata.fport );
-                HAL_DBG_TRACE_ARRAY( "Received payload", rx_payload, rx_payload_size );
-                break;
-
-            case LR1121_MODEM_LORAWAN_EVENT_JOIN_FAIL:
-                HAL_DBG_TRACE_MSG_COLOR( "Event received: JOINFAIL\n\n", HAL_DBG_TRACE_COLOR_BLUE );
-                break;
-
-            case LR1121_MODEM_LORAWAN_EVENT_LINK_CHECK:
-                HAL_DBG_TRACE_MSG_COLOR( "Event received: LINK_CHECK\n\n", HAL_DBG_TRACE_COLOR_BLUE );
-                break;
-
-            case LR1121_MODEM_LORAWAN_EVENT_CLASS_B_PING_SLOT_INFO:
-                HAL_DBG_TRACE_MSG_COLOR( "Event received: CLASS_B_PING_SLOT_INFO\n\n", HAL_DBG_TRACE_COLOR_BLUE );
-                break;
-
-            case LR1121_MODEM_LORAWAN_EVENT_CLASS_B_STATUS:
-                HAL_DBG_TRACE_MSG_COLOR( "Event received: CLASS_B_STATUS\n\n", HAL_DBG_TRACE_COLOR_BLUE );
-                break;
-
-            case LR1121_MODEM_LORAWAN_EVENT_LORAWAN_MAC_TIME:
-                HAL_DBG_TRACE_MSG_COLOR( "Event received: LORAWAN MAC TIME\n\n", HAL_DBG_TRACE_COLOR_BLUE );
-                break;
-
-            case LR1121_MODEM_LORAWAN_EVENT_NEW_MULTICAST_SESSION_CLASS_C:
-                HAL_DBG_TRACE_MSG_COLOR( "Event received: MULTICAST CLASS_C STOP\n\n", HAL_DBG_TRACE_COLOR_BLUE );
-                break;
-
-            case LR1121_MODEM_LORAWAN_EVENT_NEW_MULTICAST_SESSION_CLASS_B:
-                HAL_DBG_TRACE_MSG_COLOR( "Event received: MULTICAST CLASS_B STOP\n\n", HAL_DBG_TRACE_COLOR_BLUE );
-                break;
-
-            case LR1121_MODEM_LORAWAN_EVENT_NO_MORE_MULTICAST_SESSION_CLASS_C:
-                HAL_DBG_TRACE_MSG_COLOR( "Event received: New MULTICAST CLASS_C\n\n", HAL_DBG_TRACE_COLOR_BLUE );
-                break;
-
-            case LR1121_MODEM_LORAWAN_EVENT_NO_MORE_MULTICAST_SESSION_CLASS_B:
-                HAL_DBG_TRACE_MSG_COLOR( "Event received: New MULTICAST CLASS_B\n\n", HAL_DBG_TRACE_COLOR_BLUE );
-                break;
-            default:
-                HAL_DBG_TRACE_INFO( "Event not handled 0x%02x\n", current_event.event_type );
-                break;
-            }
-        }
-    } while( rc_event != LR1121_MODEM_RESPONSE_CODE_NO_EVENT );
+    HAL_DBG_TRACE_INFO( "Modem is now joined \n\n" );
+
+    uint8_t adr_custom_list[16] = { 0 };
+    ASSERT_SMTC_MODEM_RC(
+        lr1121_modem_set_adr_profile( context, LR1121_MODEM_ADR_PROFILE_NETWORK_SERVER_CONTROLLED, adr_custom_list ) );
+
+    // Send first periodical uplink on port 101
+    send_uplinks_counter_on_port( 101 );
+    // start periodical uplink alarm
+    ASSERT_SMTC_MODEM_RC( lr1121_modem_set_alarm_timer( context, PERIODICAL_UPLINK_DELAY_S ) );
+}
+
+static void on_modem_event_tx_done( void* context, const lr1121_modem_event_fields_t* event )
+{
+    ( void ) context;
+
+    const lr1121_modem_tx_done_event_t tx_done_event_data = ( lr1121_modem_tx_done_event_t )( event->data >> 8 );
+
+    HAL_DBG_TRACE_MSG( "TX DATA     : " );
+
+    switch( tx_done_event_data )
+    {
+    case LR1121_MODEM_TX_NOT_SENT:
+    {
+        HAL_DBG_TRACE_PRINTF( " NOT SENT" );
+        uplink_counter--;
+        break;
+    }
+    case LR1121_MODEM_CONFIRMED_TX:
+    {
+        HAL_DBG_TRACE_PRINTF( " CONFIRMED - ACK" );
+        confirmed_counter++;
+        break;
+    }
+    case LR1121_MODEM_UNCONFIRMED_TX:
+    {
+        HAL_DBG_TRACE_MSG( " UNCONFIRMED\n\n" );
+        break;
+    }
+    default:
+    {
+        HAL_DBG_TRACE_PRINTF( " unknown value (%02x)\n\n", tx_done_event_data );
+    }
+    }
+    HAL_DBG_TRACE_MSG( "\n\n" );
+
+    HAL_DBG_TRACE_INFO( "Transmission done \n" );
+    uplink_sending = false;  // Reset flag indicating an uplink request has been processed
+}
+
+static void on_modem_event_down_data( void* context, const lr1121_modem_event_fields_t* event )
+{
+    ( void ) event;
+
+    uint8_t rx_payload[LORAWAN_APP_DATA_MAX_SIZE] = { 0 };  // Buffer for rx payload
+    uint8_t rx_payload_size                       = 0;      // Size of the payload in the rx_payload buffer
+    lr1121_modem_downlink_metadata_t rx_metadata  = { 0 };  // Metadata of downlink
+    uint8_t                          rx_remaining = 0;      // Remaining downlink payload in modem
+    // Get downlink data
+    ASSERT_SMTC_MODEM_RC( lr1121_modem_get_downlink_data_size( context, &rx_payload_size, &rx_remaining ) );
+    ASSERT_SMTC_MODEM_RC( lr1121_modem_get_downlink_data( context, rx_payload, rx_payload_size ) );
+    ASSERT_SMTC_MODEM_RC( lr1121_modem_get_downlink_metadata( context, &rx_metadata ) );
+    HAL_DBG_TRACE_PRINTF( "Data received on port %u\n", rx_metadata.fport );
+    HAL_DBG_TRACE_ARRAY( "Received payload", rx_payload, rx_payload_size );
 }
 
 static void user_button_callback( void* context )
@@ -442,20 +509,40 @@ static void user_button_callback( void* context )
 
 static void send_uplinks_counter_on_port( uint8_t port )
 {
-    read_DHT11_data();
-    // Send uplink and confirmed counter
-    uint8_t buff[6] = { 0 };
-    buff[0]         = ( uplink_counter >> 8 ) & 0xFF;
-    buff[1]         = ( uplink_counter & 0xFF );
-    buff[2] = Data[0];
-    buff[3] = Data[1];
-    buff[4] = Data[2];
-    buff[5] = Data[3];
-    ASSERT_SMTC_MODEM_RC( send_frame( buff, 6, port, true ) );
+    // Send uplink counter, the latest sensor sample and the aggregates of the stored samples
+    uint8_t            buff[19]  = { 0 };
+    uint8_t*           p         = buff;
+    sensor_sample_t    latest    = { 0 };
+    sensor_aggregate_t aggregate = { 0 };
+
+    sensor_sampling_get_latest( &latest );
+    sensor_sampling_get_aggregate( &aggregate );
+
+    p    = serialize_uint16( p, uplink_counter );
+    *p++ = latest.humidity_dpct / 10;
+    *p++ = latest.humidity_dpct % 10;
+    *p++ = ( uint8_t ) ( latest.temperature_dc / 10 );
+    *p++ = ( uint8_t ) ( latest.temperature_dc % 10 );
+    *p++ = aggregate.nb_samples;
+    p    = serialize_uint16( p, ( uint16_t ) aggregate.temperature_min_dc );
+    p    = serialize_uint16( p, ( uint16_t ) aggregate.temperature_max_dc );
+    p    = serialize_uint16( p, ( uint16_t ) aggregate.temperature_mean_dc );
+    p    = serialize_uint16( p, aggregate.humidity_min_dpct );
+    p    = serialize_uint16( p, aggregate.humidity_max_dpct );
+    p    = serialize_uint16( p, aggregate.humidity_mean_dpct );
+
+    ASSERT_SMTC_MODEM_RC( send_frame( buff, p - buff, port, true ) );
     uplink_counter++;  // Increment uplink counter
     uplink_sending = true;
 }
 
+static uint8_t* serialize_uint16( uint8_t* buffer, uint16_t value )
+{
+    *buffer++ = ( value >> 8 ) & 0xFF;
+    *buffer++ = value & 0xFF;
+    return buffer;
+}
+
 static lr1121_modem_response_code_t send_frame( const uint8_t* tx_frame_buffer, const uint8_t tx_frame_buffer_size,
                                                 uint8_t port, const lr1121_modem_uplink_type_t tx_confirmed )
 {
@@ -504,68 +591,4 @@ static lr1121_modem_response_code_t send_frame( const uint8_t* tx_frame_buffer,
     return modem_response_code;
 }
 
-void read_DHT11_data()
-{
-    uint8_t retry_count = 0;
-    const uint8_t max_retries = 3;
-
-    while(retry_count < max_retries && flag != 1)
-    {
-        DHT_Read();
-        if(flag != 1)
-        {
-            // 读取失败，等待短暂时间后重试
-            HAL_DBG_TRACE_MSG("read fail, retry...");
-            delay_ms(100);
-            retry_count++;
-        }
-    }
-    
-    if(flag == 1)
-    {
-        char temp_str[10], humi_str[10];
-        sprintf(temp_str, "%d.%d", Data[2], Data[3]);
-        sprintf(humi_str, "%d.%d", Data[0], Data[1]);
-        
-        HAL_DBG_TRACE_INFO("read ok! temp: %sC, humi: %s%%\n", temp_str, humi_str);
-
-        flag = 0;
-    }
-    else
-    {
-        HAL_DBG_TRACE_INFO("read fail, retry max times: %d\n", max_retries);
-    }
-}
-
-void my_test()
-{
-    uint8_t retry_count = 0;
-    const uint8_t max_retries = 3;
-
-    while(retry_count < max_retries && flag != 1)
-    {
-        DHT_Read();
-        if(flag != 1)
-        {
-            // 读取失败，等待短暂时间后重试
-            HAL_Delay(100);
-            retry_count++;
-        }
-    }
-      
-    if(flag == 1)
-    {
-        char temp_str[10], humi_str[10];
-        sprintf(temp_str, "%d.%d", Data[2], Data[3]);
-        sprintf(humi_str, "%d.%d", Data[0], Data[1]);
-        
-        HAL_DBG_TRACE_INFO("temp: %s, humi: %s\n", temp_str, humi_str);
-        flag = 0; // 重置flag
-    }
-    else
-    {
-        HAL_DBG_TRACE_INFO("read err\n");
-    }
-    HAL_Delay(2000);
-}
 /* --- EOF ------------------------------------------------------------------ */
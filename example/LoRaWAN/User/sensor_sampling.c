@@ -0,0 +1,259 @@
+/**
+ * @file      sensor_sampling.c
+ *
+ * @brief     Background sensor sampling implementation.
+ *
+ * Revised BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include "sensor_sampling.h"
+#include "smtc_hal.h"
+#include "dht11.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#if( SENSOR_SAMPLING_RING_SIZE == 0 ) || ( SENSOR_SAMPLING_RING_SIZE > 255 )
+#error "SENSOR_SAMPLING_RING_SIZE must be in [1, 255]"
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static timer_event_t   sampling_timer;
+static sensor_sample_t sampling_ring[SENSOR_SAMPLING_RING_SIZE];
+static uint8_t         sampling_ring_head       = 0;  // Index of the next sample to write
+static uint8_t         sampling_ring_nb_samples = 0;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Sampling timer callback, requests a new reading and rearms the timer
+ *
+ * @param [in] context Not used
+ */
+static void sampling_on_timer_event( void* context );
+
+/**
+ * @brief DHT11 reading callback, stores the reading in the ring
+ */
+static void sampling_on_dht11_reading( void* context, dht11_status_t status, const dht11_reading_t* reading );
+
+/**
+ * @brief Get the ring index of the n-th oldest sample
+ *
+ * @remark To be called in a critical section
+ */
+static uint8_t sampling_ring_index( uint8_t n );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void sensor_sampling_start( uint32_t period_ms )
+{
+    timer_stop( &sampling_timer );
+    timer_init( &sampling_timer, sampling_on_timer_event );
+    timer_set_value( &sampling_timer, period_ms );
+    sampling_on_timer_event( NULL );
+}
+
+void sensor_sampling_stop( void ) { timer_stop( &sampling_timer ); }
+
+void sensor_sampling_clear( void )
+{
+    CRITICAL_SECTION_BEGIN( );
+    sampling_ring_head       = 0;
+    sampling_ring_nb_samples = 0;
+    CRITICAL_SECTION_END( );
+}
+
+uint8_t sensor_sampling_get_nb_samples( void ) { return sampling_ring_nb_samples; }
+
+bool sensor_sampling_get_latest( sensor_sample_t* sample )
+{
+    bool is_available = false;
+
+    CRITICAL_SECTION_BEGIN( );
+    if( sampling_ring_nb_samples > 0 )
+    {
+        *sample      = sampling_ring[sampling_ring_index( sampling_ring_nb_samples - 1 )];
+        is_available = true;
+    }
+    CRITICAL_SECTION_END( );
+
+    return is_available;
+}
+
+uint8_t sensor_sampling_get_samples( sensor_sample_t* samples, uint8_t max_nb_samples )
+{
+    uint8_t nb_samples;
+    uint8_t first;
+
+    CRITICAL_SECTION_BEGIN( );
+    nb_samples = ( sampling_ring_nb_samples < max_nb_samples ) ? sampling_ring_nb_samples : max_nb_samples;
+    // Keep the most recent samples when the buffer is too small
+    first = sampling_ring_nb_samples - nb_samples;
+    for( uint8_t i = 0; i < nb_samples; i++ )
+    {
+        samples[i] = sampling_ring[sampling_ring_index( first + i )];
+    }
+    CRITICAL_SECTION_END( );
+
+    return nb_samples;
+}
+
+bool sensor_sampling_get_aggregate( sensor_aggregate_t* aggregate )
+{
+    int32_t  temperature_sum = 0;
+    uint32_t humidity_sum    = 0;
+
+    CRITICAL_SECTION_BEGIN( );
+    if( sampling_ring_nb_samples == 0 )
+    {
+        CRITICAL_SECTION_END( );
+        return false;
+    }
+
+    const sensor_sample_t* oldest = &sampling_ring[sampling_ring_index( 0 )];
+
+    aggregate->nb_samples         = sampling_ring_nb_samples;
+    aggregate->first_timestamp_ms = oldest->timestamp_ms;
+    aggregate->temperature_min_dc = oldest->temperature_dc;
+    aggregate->temperature_max_dc = oldest->temperature_dc;
+    aggregate->humidity_min_dpct  = oldest->humidity_dpct;
+    aggregate->humidity_max_dpct  = oldest->humidity_dpct;
+
+    for( uint8_t i = 0; i < sampling_ring_nb_samples; i++ )
+    {
+        const sensor_sample_t* sample = &sampling_ring[sampling_ring_index( i )];
+
+        if( sample->temperature_dc < aggregate->temperature_min_dc )
+        {
+            aggregate->temperature_min_dc = sample->temperature_dc;
+        }
+        if( sample->temperature_dc > aggregate->temperature_max_dc )
+        {
+            aggregate->temperature_max_dc = sample->temperature_dc;
+        }
+        if( sample->humidity_dpct < aggregate->humidity_min_dpct )
+        {
+            aggregate->humidity_min_dpct = sample->humidity_dpct;
+        }
+        if( sample->humidity_dpct > aggregate->humidity_max_dpct )
+        {
+            aggregate->humidity_max_dpct = sample->humidity_dpct;
+        }
+        temperature_sum += sample->temperature_dc;
+        humidity_sum += sample->humidity_dpct;
+        aggregate->last_timestamp_ms = sample->timestamp_ms;
+    }
+    CRITICAL_SECTION_END( );
+
+    // Round to nearest
+    const int32_t half_nb_samples = aggregate->nb_samples / 2;
+
+    temperature_sum += ( temperature_sum >= 0 ) ? half_nb_samples : -half_nb_samples;
+    aggregate->temperature_mean_dc = ( int16_t ) ( temperature_sum / aggregate->nb_samples );
+    aggregate->humidity_mean_dpct  = ( uint16_t ) ( ( humidity_sum + half_nb_samples ) / aggregate->nb_samples );
+
+    return true;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void sampling_on_timer_event( void* context )
+{
+    ( void ) context;
+
+    // A reading still in progress is simply not duplicated
+    dht11_read( sampling_on_dht11_reading, NULL );
+    timer_start( &sampling_timer );
+}
+
+static void sampling_on_dht11_reading( void* context, dht11_status_t status, const dht11_reading_t* reading )
+{
+    ( void ) context;
+
+    if( status != DHT11_STATUS_OK )
+    {
+        HAL_DBG_TRACE_WARNING( "DHT11 read fail, status: %d\n", status );
+        return;
+    }
+
+    sensor_sample_t sample = {
+        .timestamp_ms   = hal_rtc_get_time_ms( ),
+        .temperature_dc = ( int16_t ) ( reading->temperature_int * 10 + reading->temperature_dec ),
+        .humidity_dpct  = ( uint16_t ) ( reading->humidity_int * 10 + reading->humidity_dec ),
+    };
+
+    CRITICAL_SECTION_BEGIN( );
+    sampling_ring[sampling_ring_head] = sample;
+    sampling_ring_head                = ( sampling_ring_head + 1 ) % SENSOR_SAMPLING_RING_SIZE;
+    if( sampling_ring_nb_samples < SENSOR_SAMPLING_RING_SIZE )
+    {
+        sampling_ring_nb_samples++;
+    }
+    CRITICAL_SECTION_END( );
+
+    HAL_DBG_TRACE_INFO( "Sensor sample: temp: %d.%dC, humi: %d.%d%%\n", reading->temperature_int,
+                        reading->temperature_dec, reading->humidity_int, reading->humidity_dec );
+}
+
+static uint8_t sampling_ring_index( uint8_t n )
+{
+    return ( uint8_t ) ( ( sampling_ring_head + SENSOR_SAMPLING_RING_SIZE - sampling_ring_nb_samples + n ) %
+                         SENSOR_SAMPLING_RING_SIZE );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
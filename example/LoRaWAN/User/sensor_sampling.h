@@ -0,0 +1,160 @@
+/**
+ * @file      sensor_sampling.h
+ *
+ * @brief     Background sensor sampling definition.
+ *
+ * Revised BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SENSOR_SAMPLING_H
+#define SENSOR_SAMPLING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Number of samples kept; when the ring is full the oldest sample is overwritten
+ */
+#ifndef SENSOR_SAMPLING_RING_SIZE
+#define SENSOR_SAMPLING_RING_SIZE 8
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Timestamped sensor sample
+ */
+typedef struct sensor_sample_s
+{
+    uint32_t timestamp_ms;     //!< Sampling time, from hal_rtc_get_time_ms
+    int16_t  temperature_dc;   //!< Temperature [0.1 degC]
+    uint16_t humidity_dpct;    //!< Relative humidity [0.1 %]
+} sensor_sample_t;
+
+/**
+ * @brief Aggregates over the samples of the ring
+ */
+typedef struct sensor_aggregate_s
+{
+    uint8_t  nb_samples;          //!< Number of aggregated samples
+    uint32_t first_timestamp_ms;  //!< Timestamp of the oldest sample
+    uint32_t last_timestamp_ms;   //!< Timestamp of the latest sample
+    int16_t  temperature_min_dc;  //!< Minimum temperature [0.1 degC]
+    int16_t  temperature_max_dc;  //!< Maximum temperature [0.1 degC]
+    int16_t  temperature_mean_dc; //!< Mean temperature [0.1 degC]
+    uint16_t humidity_min_dpct;   //!< Minimum relative humidity [0.1 %]
+    uint16_t humidity_max_dpct;   //!< Maximum relative humidity [0.1 %]
+    uint16_t humidity_mean_dpct;  //!< Mean relative humidity [0.1 %]
+} sensor_aggregate_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Start sampling the sensors periodically in the background
+ *
+ * @remark The first sample is requested immediately
+ *
+ * @param [in] period_ms Sampling period in milliseconds
+ */
+void sensor_sampling_start( uint32_t period_ms );
+
+/**
+ * @brief Stop the periodic sampling; samples already stored are kept
+ */
+void sensor_sampling_stop( void );
+
+/**
+ * @brief Drop all stored samples
+ */
+void sensor_sampling_clear( void );
+
+/**
+ * @brief Get the number of stored samples
+ *
+ * @returns Number of samples, up to SENSOR_SAMPLING_RING_SIZE
+ */
+uint8_t sensor_sampling_get_nb_samples( void );
+
+/**
+ * @brief Get the latest sample
+ *
+ * @param [out] sample Latest sample
+ *
+ * @returns False if no sample is stored
+ */
+bool sensor_sampling_get_latest( sensor_sample_t* sample );
+
+/**
+ * @brief Copy the stored samples, oldest first
+ *
+ * @param [out] samples        Destination buffer
+ * @param [in]  max_nb_samples Size of the destination buffer, in samples
+ *
+ * @returns Number of copied samples
+ */
+uint8_t sensor_sampling_get_samples( sensor_sample_t* samples, uint8_t max_nb_samples );
+
+/**
+ * @brief Compute the minimum, maximum and mean of the stored samples
+ *
+ * @param [out] aggregate Aggregates
+ *
+ * @returns False if no sample is stored
+ */
+bool sensor_sampling_get_aggregate( sensor_aggregate_t* aggregate );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // SENSOR_SAMPLING_H
+
+/* --- EOF ------------------------------------------------------------------ */
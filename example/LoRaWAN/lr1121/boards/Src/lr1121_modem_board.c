@@ -89,6 +89,11 @@ static lr1121_modem_board_led_ctx_t lr1121_modem_board_leds[LR1121_EVK_LED_COUNT
                                                                                       { .timer_initialized = false },
                                                                                       { .timer_initialized = false } };
 
+/*!
+ * @brief Busy line interrupt, timestamping the end of the commands timed by the modem HAL
+ */
+static hal_gpio_irq_t lr1121_modem_board_busy_irq = { .callback = lr1121_modem_hal_on_busy_irq };
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -128,7 +133,11 @@ void lr1121_modem_board_init_io( const void* context )
 {
     hal_gpio_init_out( ( ( lr1121_t* ) context )->reset.pin, 1 );
     hal_gpio_init_out( ( ( lr1121_t* ) context )->nss.pin, 1 );
-    hal_gpio_init_in( ( ( lr1121_t* ) context )->busy.pin, HAL_GPIO_PULL_MODE_NONE, HAL_GPIO_IRQ_MODE_OFF, NULL );
+    /* The busy line stays masked until the modem HAL times a command or waits on it */
+    lr1121_modem_board_busy_irq.context = ( void* ) context;
+    hal_gpio_init_in( ( ( lr1121_t* ) context )->busy.pin, HAL_GPIO_PULL_MODE_NONE, HAL_GPIO_IRQ_MODE_RISING_FALLING,
+                      &lr1121_modem_board_busy_irq );
+    hal_gpio_irq_mask( ( ( lr1121_t* ) context )->busy.pin );
     hal_gpio_init_in( ( ( lr1121_t* ) context )->event.pin, HAL_GPIO_PULL_MODE_NONE, HAL_GPIO_IRQ_MODE_RISING,
                       &( ( lr1121_t* ) context )->event );
 }
@@ -43,6 +43,8 @@
 #include "lr1121_modem_hal.h"
 #include "lr1121_modem_system.h"
 #include "lr1121_modem_board.h"
+#include "smtc_busy_stats.h"
+#include "smtc_spi_crc.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -56,6 +58,27 @@
 
 #define LR1121_MODEM_RESET_TIMEOUT 3000
 
+/*!
+ * @brief Maximum time the modem-e may take to acknowledge or complete a command
+ */
+#ifndef LR1121_MODEM_HAL_BUSY_TIMEOUT_MS
+#define LR1121_MODEM_HAL_BUSY_TIMEOUT_MS 1000
+#endif
+
+/*!
+ * @brief Maximum time the modem-e may take to be ready for a new command
+ */
+#ifndef LR1121_MODEM_HAL_WAKEUP_TIMEOUT_MS
+#define LR1121_MODEM_HAL_WAKEUP_TIMEOUT_MS 10000
+#endif
+
+/*!
+ * @brief Maximum time the chip may stay busy in bootloader mode
+ */
+#ifndef LR1121_HAL_BUSY_TIMEOUT_MS
+#define LR1121_HAL_BUSY_TIMEOUT_MS 5000
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
@@ -76,6 +99,36 @@ static bool lr1121_modem_reset_timeout = false;
  */
 static timer_event_t lr1121_modem_reset_timeout_timer;
 
+/*!
+ * @brief Busy time statistics
+ */
+static smtc_busy_stats_t lr1121_modem_hal_busy_stats;
+
+/*!
+ * @brief Opcode of the command being timed
+ */
+static uint16_t lr1121_modem_hal_busy_opcode = SMTC_BUSY_STATS_OPCODE_NONE;
+
+/*!
+ * @brief Time NSS was released after the command being timed
+ */
+static uint32_t lr1121_modem_hal_busy_start_us;
+
+/*!
+ * @brief Time of the busy falling edge ending the command being timed
+ */
+static volatile uint32_t lr1121_modem_hal_busy_end_us;
+
+/*!
+ * @brief A command is being timed
+ */
+static volatile bool lr1121_modem_hal_busy_is_timing = false;
+
+/*!
+ * @brief The busy falling edge ending the command being timed has been timestamped
+ */
+static volatile bool lr1121_modem_hal_busy_has_ended = false;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -111,6 +164,36 @@ static lr1121_modem_hal_status_t lr1121_modem_hal_wait_on_busy( const void* cont
  */
 static lr1121_modem_hal_status_t lr1121_modem_hal_wait_on_unbusy( const void* context, uint32_t timeout_ms );
 
+/*!
+ * @brief Function to wait until the busy line reaches a given state, sleeping until one of its edges
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] state Expected busy line state
+ * @param [in] timeout_ms timeout in millisec before leave the function
+ *
+ * @returns true if the state was reached before the timeout
+ */
+static bool lr1121_modem_hal_wait_on_busy_state( const void* context, uint32_t state, uint32_t timeout_ms );
+
+/*!
+ * @brief Start timing a command, right before NSS is released after it
+ *
+ * @remark The busy line is unmasked until the end of the command, so that its falling edge is timestamped
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] command Command buffer
+ * @param [in] command_length Command length in bytes
+ */
+static void lr1121_modem_hal_start_busy_timing( const void* context, const uint8_t* command,
+                                               const uint16_t command_length );
+
+/*!
+ * @brief Record the busy time of the command being timed, once the busy line is back to low
+ *
+ * @param [in] context Chip implementation context
+ */
+static void lr1121_modem_hal_stop_busy_timing( const void* context );
+
 /*!
  * @brief Function executed on lr1121 modem-e reset timeout event
  */
@@ -133,32 +216,27 @@ lr1121_modem_hal_status_t lr1121_modem_hal_write( const void* context, const uin
     {
         uint8_t                   crc          = 0;
         uint8_t                   crc_received = 0;
+        uint8_t                   response[2];
         lr1121_modem_hal_status_t status;
 
         /* NSS low */
         hal_gpio_set_value( ( ( lr1121_t* ) context )->nss.pin, 0 );
 
-        /* Send CMD */
-        for( uint16_t i = 0; i < command_length; i++ )
-        {
-            hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, command[i] );
-        }
-        /* Send Data */
-        for( uint16_t i = 0; i < data_length; i++ )
-        {
-            hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, data[i] );
-        }
-        /* Compute and send CRC */
-        crc = lr1121_modem_compute_crc( 0xFF, command, command_length );
-        crc = lr1121_modem_compute_crc( crc, data, data_length );
+        /* Send CMD and Data, computing the CRC while they are clocked out */
+        crc = hal_spi_transfer_crc( ( ( lr1121_t* ) context )->spi_id, command, NULL, command_length,
+                                    smtc_spi_crc_update_byte, SMTC_SPI_CRC_INITIAL_VALUE );
+        crc = hal_spi_transfer_crc( ( ( lr1121_t* ) context )->spi_id, data, NULL, data_length,
+                                    smtc_spi_crc_update_byte, crc );
         /* Send CRC */
-        hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, crc );
+        hal_spi_transfer( ( ( lr1121_t* ) context )->spi_id, &crc, NULL, 1 );
+
+        lr1121_modem_hal_start_busy_timing( context, command, command_length );
 
         /* NSS high */
         hal_gpio_set_value( ( ( lr1121_t* ) context )->nss.pin, 1 );
 
-        /* Wait on busy pin up to 1000 ms */
-        if( lr1121_modem_hal_wait_on_busy( context, 1000 ) != LR1121_MODEM_HAL_STATUS_OK )
+        /* Wait on busy pin up to LR1121_MODEM_HAL_BUSY_TIMEOUT_MS */
+        if( lr1121_modem_hal_wait_on_busy( context, LR1121_MODEM_HAL_BUSY_TIMEOUT_MS ) != LR1121_MODEM_HAL_STATUS_OK )
         {
             return LR1121_MODEM_HAL_STATUS_BUSY_TIMEOUT;
         }
@@ -168,11 +246,12 @@ lr1121_modem_hal_status_t lr1121_modem_hal_write( const void* context, const uin
         /* NSS low */
         hal_gpio_set_value( ( ( lr1121_t* ) context )->nss.pin, 0 );
 
-        /* read RC */
-        status       = ( lr1121_modem_hal_status_t ) hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, 0 );
-        crc_received = hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, 0 );
+        /* read RC and CRC */
+        hal_spi_transfer( ( ( lr1121_t* ) context )->spi_id, NULL, response, 2 );
+        status       = ( lr1121_modem_hal_status_t ) response[0];
+        crc_received = response[1];
         /* Compute response crc */
-        crc = lr1121_modem_compute_crc( 0xFF, ( uint8_t* ) &status, 1 );
+        crc = smtc_spi_crc_update_byte( SMTC_SPI_CRC_INITIAL_VALUE, response[0] );
 
         /* NSS high */
         hal_gpio_set_value( ( ( lr1121_t* ) context )->nss.pin, 1 );
@@ -183,11 +262,12 @@ lr1121_modem_hal_status_t lr1121_modem_hal_write( const void* context, const uin
             status = LR1121_MODEM_HAL_STATUS_BAD_FRAME;
         }
 
-        /* Wait on busy pin up to 1000 ms */
-        if( lr1121_modem_hal_wait_on_unbusy( context, 1000 ) != LR1121_MODEM_HAL_STATUS_OK )
+        /* Wait on busy pin up to LR1121_MODEM_HAL_BUSY_TIMEOUT_MS */
+        if( lr1121_modem_hal_wait_on_unbusy( context, LR1121_MODEM_HAL_BUSY_TIMEOUT_MS ) != LR1121_MODEM_HAL_STATUS_OK )
         {
             return LR1121_MODEM_HAL_STATUS_BUSY_TIMEOUT;
         }
+        lr1121_modem_hal_stop_busy_timing( context );
 
         return status;
     }
@@ -207,21 +287,13 @@ lr1121_modem_hal_status_t lr1121_modem_hal_write_without_rc( const void* context
         /* NSS low */
         hal_gpio_set_value( ( ( lr1121_t* ) context )->nss.pin, 0 );
 
-        /* Send CMD */
-        for( uint16_t i = 0; i < command_length; i++ )
-        {
-            hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, command[i] );
-        }
-        /* Send Data */
-        for( uint16_t i = 0; i < data_length; i++ )
-        {
-            hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, data[i] );
-        }
-        /* Compute and send CRC */
-        crc = lr1121_modem_compute_crc( 0xFF, command, command_length );
-        crc = lr1121_modem_compute_crc( crc, data, data_length );
+        /* Send CMD and Data, computing the CRC while they are clocked out */
+        crc = hal_spi_transfer_crc( ( ( lr1121_t* ) context )->spi_id, command, NULL, command_length,
+                                    smtc_spi_crc_update_byte, SMTC_SPI_CRC_INITIAL_VALUE );
+        crc = hal_spi_transfer_crc( ( ( lr1121_t* ) context )->spi_id, data, NULL, data_length,
+                                    smtc_spi_crc_update_byte, crc );
         /* Send CRC */
-        hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, crc );
+        hal_spi_transfer( ( ( lr1121_t* ) context )->spi_id, &crc, NULL, 1 );
 
         /* NSS high */
         hal_gpio_set_value( ( ( lr1121_t* ) context )->nss.pin, 1 );
@@ -245,21 +317,19 @@ lr1121_modem_hal_status_t lr1121_modem_hal_read( const void* context, const uint
         /* NSS low */
         hal_gpio_set_value( ( ( lr1121_t* ) context )->nss.pin, 0 );
 
-        /* Send CMD */
-        for( uint16_t i = 0; i < command_length; i++ )
-        {
-            hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, command[i] );
-        }
-        /* Compute and send CRC */
-        crc = lr1121_modem_compute_crc( 0xFF, command, command_length );
+        /* Send CMD, computing the CRC while it is clocked out */
+        crc = hal_spi_transfer_crc( ( ( lr1121_t* ) context )->spi_id, command, NULL, command_length,
+                                    smtc_spi_crc_update_byte, SMTC_SPI_CRC_INITIAL_VALUE );
         /* Send CRC */
-        hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, crc );
+        hal_spi_transfer( ( ( lr1121_t* ) context )->spi_id, &crc, NULL, 1 );
+
+        lr1121_modem_hal_start_busy_timing( context, command, command_length );
 
         /* NSS high */
         hal_gpio_set_value( ( ( lr1121_t* ) context )->nss.pin, 1 );
 
-        /* Wait on busy pin up to 1000 ms */
-        if( lr1121_modem_hal_wait_on_busy( context, 1000 ) != LR1121_MODEM_HAL_STATUS_OK )
+        /* Wait on busy pin up to LR1121_MODEM_HAL_BUSY_TIMEOUT_MS */
+        if( lr1121_modem_hal_wait_on_busy( context, LR1121_MODEM_HAL_BUSY_TIMEOUT_MS ) != LR1121_MODEM_HAL_STATUS_OK )
         {
             return LR1121_MODEM_HAL_STATUS_BUSY_TIMEOUT;
         }
@@ -271,12 +341,12 @@ lr1121_modem_hal_status_t lr1121_modem_hal_read( const void* context, const uint
 
         /* read RC */
         status = ( lr1121_modem_hal_status_t ) hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, 0 );
+        crc    = smtc_spi_crc_update_byte( SMTC_SPI_CRC_INITIAL_VALUE, ( uint8_t ) status );
         if( status == LR1121_MODEM_HAL_STATUS_OK )
         {
-            for( uint16_t i = 0; i < data_length; i++ )
-            {
-                data[i] = hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, 0 );
-            }
+            /* Read data, computing the response CRC while it is clocked in */
+            crc = hal_spi_transfer_crc( ( ( lr1121_t* ) context )->spi_id, NULL, data, data_length,
+                                        smtc_spi_crc_update_byte, crc );
         }
 
         crc_received = hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, 0 );
@@ -284,18 +354,12 @@ lr1121_modem_hal_status_t lr1121_modem_hal_read( const void* context, const uint
         /* NSS high */
         hal_gpio_set_value( ( ( lr1121_t* ) context )->nss.pin, 1 );
 
-        /* Wait on busy pin up to 1000 ms */
-        if( lr1121_modem_hal_wait_on_unbusy( context, 1000 ) != LR1121_MODEM_HAL_STATUS_OK )
+        /* Wait on busy pin up to LR1121_MODEM_HAL_BUSY_TIMEOUT_MS */
+        if( lr1121_modem_hal_wait_on_unbusy( context, LR1121_MODEM_HAL_BUSY_TIMEOUT_MS ) != LR1121_MODEM_HAL_STATUS_OK )
         {
             return LR1121_MODEM_HAL_STATUS_BUSY_TIMEOUT;
         }
-
-        /* Compute response crc */
-        crc = lr1121_modem_compute_crc( 0xFF, ( uint8_t* ) &status, 1 );
-        if( status == LR1121_MODEM_HAL_STATUS_OK )
-        {
-            crc = lr1121_modem_compute_crc( crc, data, data_length );
-        }
+        lr1121_modem_hal_stop_busy_timing( context );
 
         if( crc != crc_received )
         {
@@ -357,13 +421,15 @@ void lr1121_modem_hal_enter_dfu( const void* context )
     /* wait 250ms */
     HAL_Delay( 250 );
 
-    /* reinit dio0 */
-    hal_gpio_init_in( ( ( lr1121_t* ) context )->busy.pin, HAL_GPIO_PULL_MODE_NONE, HAL_GPIO_IRQ_MODE_OFF, NULL );
+    /* reinit dio0 - the busy callback attached by lr1121_modem_board_init_io stays in place */
+    hal_gpio_init_in( ( ( lr1121_t* ) context )->busy.pin, HAL_GPIO_PULL_MODE_NONE, HAL_GPIO_IRQ_MODE_RISING_FALLING,
+                      NULL );
+    hal_gpio_irq_mask( ( ( lr1121_t* ) context )->busy.pin );
 }
 
 lr1121_modem_hal_status_t lr1121_modem_hal_wakeup( const void* context )
 {
-    if( lr1121_modem_hal_wait_on_busy( context, 10000 ) == LR1121_MODEM_HAL_STATUS_OK )
+    if( lr1121_modem_hal_wait_on_busy( context, LR1121_MODEM_HAL_WAKEUP_TIMEOUT_MS ) == LR1121_MODEM_HAL_STATUS_OK )
     {
         /* Wakeup radio */
         hal_gpio_set_value( ( ( lr1121_t* ) context )->nss.pin, 0 );
@@ -374,8 +440,8 @@ lr1121_modem_hal_status_t lr1121_modem_hal_wakeup( const void* context )
         return LR1121_MODEM_HAL_STATUS_BUSY_TIMEOUT;
     }
 
-    /* Wait on busy pin for 1000 ms */
-    return lr1121_modem_hal_wait_on_unbusy( context, 1000 );
+    /* Wait on busy pin up to LR1121_MODEM_HAL_BUSY_TIMEOUT_MS */
+    return lr1121_modem_hal_wait_on_unbusy( context, LR1121_MODEM_HAL_BUSY_TIMEOUT_MS );
 }
 
 /*!
@@ -388,17 +454,15 @@ lr1121_hal_status_t lr1121_hal_write( const void* context, const uint8_t* comman
     if( lr1121_hal_wakeup( context ) == LR1121_HAL_STATUS_OK )
     {
         hal_gpio_set_value( ( ( lr1121_t* ) context )->nss.pin, 0 );
-        for( uint16_t i = 0; i < command_length; i++ )
-        {
-            hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, command[i] );
-        }
-        for( uint16_t i = 0; i < data_length; i++ )
-        {
-            hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, data[i] );
-        }
+        hal_spi_transfer( ( ( lr1121_t* ) context )->spi_id, command, NULL, command_length );
+        hal_spi_transfer( ( ( lr1121_t* ) context )->spi_id, data, NULL, data_length );
+        lr1121_modem_hal_start_busy_timing( context, command, command_length );
         hal_gpio_set_value( ( ( lr1121_t* ) context )->nss.pin, 1 );
 
-        return lr1121_hal_wait_on_busy( context, 5000 );
+        const lr1121_hal_status_t status = lr1121_hal_wait_on_busy( context, LR1121_HAL_BUSY_TIMEOUT_MS );
+        lr1121_modem_hal_stop_busy_timing( context );
+
+        return status;
     }
     return LR1121_HAL_STATUS_ERROR;
 }
@@ -410,14 +474,12 @@ lr1121_hal_status_t lr1121_hal_read( const void* context, const uint8_t* command
     {
         hal_gpio_set_value( ( ( lr1121_t* ) context )->nss.pin, 0 );
 
-        for( uint16_t i = 0; i < command_length; i++ )
-        {
-            hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, command[i] );
-        }
+        hal_spi_transfer( ( ( lr1121_t* ) context )->spi_id, command, NULL, command_length );
 
+        lr1121_modem_hal_start_busy_timing( context, command, command_length );
         hal_gpio_set_value( ( ( lr1121_t* ) context )->nss.pin, 1 );
 
-        if( lr1121_hal_wait_on_busy( context, 5000 ) != LR1121_HAL_STATUS_OK )
+        if( lr1121_hal_wait_on_busy( context, LR1121_HAL_BUSY_TIMEOUT_MS ) != LR1121_HAL_STATUS_OK )
         {
             return LR1121_HAL_STATUS_ERROR;
         }
@@ -427,14 +489,15 @@ lr1121_hal_status_t lr1121_hal_read( const void* context, const uint8_t* command
 
         hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, 0 );
 
-        for( uint16_t i = 0; i < data_length; i++ )
-        {
-            data[i] = hal_spi_in_out( ( ( lr1121_t* ) context )->spi_id, 0 );
-        }
+        hal_spi_transfer( ( ( lr1121_t* ) context )->spi_id, NULL, data, data_length );
 
         hal_gpio_set_value( ( ( lr1121_t* ) context )->nss.pin, 1 );
 
-        return lr1121_hal_wait_on_busy( context, 5000 );
+        /* The command ended with the busy falling edge preceding the response */
+        const lr1121_hal_status_t status = lr1121_hal_wait_on_busy( context, LR1121_HAL_BUSY_TIMEOUT_MS );
+        lr1121_modem_hal_stop_busy_timing( context );
+
+        return status;
     }
     return LR1121_HAL_STATUS_ERROR;
 }
@@ -445,8 +508,8 @@ lr1121_hal_status_t lr1121_hal_wakeup( const void* context )
     hal_gpio_set_value( ( ( lr1121_t* ) context )->nss.pin, 0 );
     hal_gpio_set_value( ( ( lr1121_t* ) context )->nss.pin, 1 );
 
-    /* Wait on busy pin for 5000 ms */
-    return lr1121_hal_wait_on_busy( context, 5000 );
+    /* Wait on busy pin up to LR1121_HAL_BUSY_TIMEOUT_MS */
+    return lr1121_hal_wait_on_busy( context, LR1121_HAL_BUSY_TIMEOUT_MS );
 }
 
 lr1121_hal_status_t lr1121_hal_reset( const void* context )
@@ -462,6 +525,20 @@ uint32_t lr1121_hal_get_time_in_s( void ) { return hal_rtc_get_time_s( ); }
 
 uint32_t lr1121_hal_get_time_in_ms( void ) { return hal_rtc_get_time_ms( ); }
 
+void lr1121_modem_hal_on_busy_irq( void* context )
+{
+    if( ( lr1121_modem_hal_busy_is_timing == true ) && ( lr1121_modem_hal_busy_has_ended == false ) &&
+        ( hal_gpio_get_value( ( ( lr1121_t* ) context )->busy.pin ) == 0 ) )
+    {
+        lr1121_modem_hal_busy_end_us    = hal_mcu_get_time_in_us( );
+        lr1121_modem_hal_busy_has_ended = true;
+    }
+}
+
+const smtc_busy_stats_t* lr1121_modem_hal_get_busy_stats( void ) { return &lr1121_modem_hal_busy_stats; }
+
+void lr1121_modem_hal_reset_busy_stats( void ) { smtc_busy_stats_reset( &lr1121_modem_hal_busy_stats ); }
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
@@ -471,66 +548,106 @@ static void on_lr1121_modem_reset_timeout_event( void* context ) { lr1121_modem_
 
 static lr1121_hal_status_t lr1121_hal_wait_on_busy( const void* context, uint32_t timeout_ms )
 {
-#if 0
-    while( hal_gpio_get_value( ( ( lr1121_t* ) context )->busy.pin ) == 1 )
-    {
-        ;
-    }
-#else
-    uint32_t start = hal_rtc_get_time_ms( );
-    while( hal_gpio_get_value( ( ( lr1121_t* ) context )->busy.pin ) == 1 )
-    {
-        if( ( int32_t )( hal_rtc_get_time_ms( ) - start ) > ( int32_t ) timeout_ms )
-        {
-            return LR1121_HAL_STATUS_ERROR;
-        }
-    }
-#endif
-    return LR1121_HAL_STATUS_OK;
+    return ( lr1121_modem_hal_wait_on_busy_state( context, 0, timeout_ms ) == true ) ? LR1121_HAL_STATUS_OK
+                                                                                      : LR1121_HAL_STATUS_ERROR;
 }
 
 static lr1121_modem_hal_status_t lr1121_modem_hal_wait_on_busy( const void* context, uint32_t timeout_ms )
 {
-#if 0
-    while( hal_gpio_get_value( ( ( lr1121_t* ) context )->busy.pin ) == 0 )
+    return ( lr1121_modem_hal_wait_on_busy_state( context, 1, timeout_ms ) == true ) ? LR1121_MODEM_HAL_STATUS_OK
+                                                                                      : LR1121_MODEM_HAL_STATUS_ERROR;
+}
+
+static lr1121_modem_hal_status_t lr1121_modem_hal_wait_on_unbusy( const void* context, uint32_t timeout_ms )
+{
+    return ( lr1121_modem_hal_wait_on_busy_state( context, 0, timeout_ms ) == true ) ? LR1121_MODEM_HAL_STATUS_OK
+                                                                                      : LR1121_MODEM_HAL_STATUS_ERROR;
+}
+
+static bool lr1121_modem_hal_wait_on_busy_state( const void* context, uint32_t state, uint32_t timeout_ms )
+{
+    const hal_gpio_pin_names_t busy = ( ( lr1121_t* ) context )->busy.pin;
+
+    if( hal_gpio_get_value( busy ) == state )
     {
-        ;
+        return true;
     }
-#else
-    uint32_t start   = hal_rtc_get_time_ms( );
-    uint32_t current = 0;
-    while( hal_gpio_get_value( ( ( lr1121_t* ) context )->busy.pin ) == 0 )
+
+    /* From an interrupt handler, e.g. a modem event callback, the busy EXTI has no higher priority and could not wake
+     * the core up: poll the line instead */
+    const bool     is_sleep_allowed = ( __get_IPSR( ) == 0 ) ? true : false;
+    const uint32_t start_ms         = hal_rtc_get_time_ms( );
+    bool           is_reached       = false;
+
+    if( ( is_sleep_allowed == true ) && ( lr1121_modem_hal_busy_is_timing == false ) )
     {
-        current = hal_rtc_get_time_ms( );
-        if( ( int32_t )( current - start ) > ( int32_t ) timeout_ms )
+        hal_gpio_irq_unmask( busy );
+    }
+
+    while( is_reached == false )
+    {
+        if( ( int32_t )( hal_rtc_get_time_ms( ) - start_ms ) > ( int32_t ) timeout_ms )
         {
-            return LR1121_MODEM_HAL_STATUS_ERROR;
+            hal_gpio_irq_mask( busy );
+            lr1121_modem_hal_busy_is_timing = false;
+            smtc_busy_stats_record_timeout( &lr1121_modem_hal_busy_stats );
+            return false;
+        }
+
+        if( is_sleep_allowed == true )
+        {
+            /* Both busy edges are routed to the EXTI, which together with the 1 ms HAL tick ends the sleep. The line
+             * is sampled with interrupts masked so that an edge occurring between the check and WFI still wakes the
+             * core up */
+            __disable_irq( );
+            is_reached = ( hal_gpio_get_value( busy ) == state ) ? true : false;
+            if( is_reached == false )
+            {
+                __WFI( );
+            }
+            __enable_irq( );
+        }
+        else
+        {
+            is_reached = ( hal_gpio_get_value( busy ) == state ) ? true : false;
         }
     }
-#endif
-    return LR1121_MODEM_HAL_STATUS_OK;
-}
 
-static lr1121_modem_hal_status_t lr1121_modem_hal_wait_on_unbusy( const void* context, uint32_t timeout_ms )
-{
-#if 0
-    while( hal_gpio_get_value( ( ( lr1121_t* ) context )->busy.pin ) == 1 )
+    /* Left unmasked until the end of the command being timed */
+    if( lr1121_modem_hal_busy_is_timing == false )
     {
-        ;
+        hal_gpio_irq_mask( busy );
     }
-#else
-    uint32_t start   = hal_rtc_get_time_ms( );
-    uint32_t current = 0;
-    while( hal_gpio_get_value( ( ( lr1121_t* ) context )->busy.pin ) == 1 )
+
+    return true;
+}
+
+static void lr1121_modem_hal_start_busy_timing( const void* context, const uint8_t* command,
+                                               const uint16_t command_length )
+{
+    lr1121_modem_hal_busy_opcode    = smtc_busy_stats_get_opcode( command, command_length );
+    lr1121_modem_hal_busy_has_ended = false;
+    lr1121_modem_hal_busy_is_timing = true;
+
+    /* The command cannot end before NSS is released, so the first falling edge seen from now on ends it */
+    hal_gpio_irq_unmask( ( ( lr1121_t* ) context )->busy.pin );
+    lr1121_modem_hal_busy_start_us = hal_mcu_get_time_in_us( );
+}
+
+static void lr1121_modem_hal_stop_busy_timing( const void* context )
+{
+    hal_gpio_irq_mask( ( ( lr1121_t* ) context )->busy.pin );
+
+    if( lr1121_modem_hal_busy_is_timing == true )
     {
-        current = hal_rtc_get_time_ms( );
-        if( ( int32_t )( current - start ) > ( int32_t ) timeout_ms )
-        {
-            return LR1121_MODEM_HAL_STATUS_ERROR;
-        }
+        /* Without a timestamped edge, the busy interrupt could not preempt the caller: the line was polled instead */
+        const uint32_t end_us = ( lr1121_modem_hal_busy_has_ended == true ) ? lr1121_modem_hal_busy_end_us
+                                                                            : hal_mcu_get_time_in_us( );
+
+        lr1121_modem_hal_busy_is_timing = false;
+        smtc_busy_stats_record( &lr1121_modem_hal_busy_stats, lr1121_modem_hal_busy_opcode,
+                                end_us - lr1121_modem_hal_busy_start_us );
     }
-#endif
-    return LR1121_MODEM_HAL_STATUS_OK;
 }
 
 /* --- EOF ------------------------------------------------------------------ */
@@ -48,6 +48,7 @@ extern "C" {
 #include <stdint.h>
 #include <stdbool.h>
 #include "lr1121_modem_common.h"
+#include "smtc_busy_stats.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -220,6 +221,25 @@ void lr1121_modem_hal_enter_dfu( const void* context );
  */
 lr1121_modem_hal_status_t lr1121_modem_hal_wakeup( const void* context );
 
+/*!
+ * Busy line interrupt callback, timestamping the busy falling edge that ends the command being timed
+ *
+ * @param [in] context Radio implementation parameters
+ */
+void lr1121_modem_hal_on_busy_irq( void* context );
+
+/*!
+ * Get the busy time statistics, each command being timed from NSS release to the busy falling edge ending it
+ *
+ * @returns Pointer to the statistics table
+ */
+const smtc_busy_stats_t* lr1121_modem_hal_get_busy_stats( void );
+
+/*!
+ * Clear the busy time statistics
+ */
+void lr1121_modem_hal_reset_busy_stats( void );
+
 #ifdef __cplusplus
 }
 #endif
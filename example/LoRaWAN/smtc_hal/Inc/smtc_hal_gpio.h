@@ -166,6 +166,22 @@ void hal_gpio_irq_enable( void );
  */
 void hal_gpio_irq_disable( void );
 
+/**
+ * @brief Unmasks the interrupt line of a pin initialized with an IRQ mode
+ *
+ * @remark Edges that occurred while the line was masked are discarded
+ *
+ * @param [in] pin MCU pin
+ */
+void hal_gpio_irq_unmask( const hal_gpio_pin_names_t pin );
+
+/**
+ * @brief Masks the interrupt line of a pin - its edges no longer raise an IRQ
+ *
+ * @param [in] pin MCU pin
+ */
+void hal_gpio_irq_mask( const hal_gpio_pin_names_t pin );
+
 /**
  * @brief Sets MCU pin to given value
  *
@@ -143,6 +143,15 @@ void hal_mcu_set_sleep_for_s( const int32_t seconds );
  */
 void hal_mcu_wait_us( const int32_t microseconds );
 
+/**
+ * @brief Get the time elapsed since the HAL tick start with a microsecond resolution
+ *
+ * @remark Intended for short interval measurements as the value wraps around after about 71 minutes
+ *
+ * @returns Time in microseconds
+ */
+uint32_t hal_mcu_get_time_in_us( void );
+
 /**
  * @brief Get Vref intern from the MCU in mV
  *
@@ -188,6 +188,13 @@ uint32_t hal_rtc_get_timer_elapsed_value( void );
  */
 uint32_t hal_rtc_get_timer_value( void );
 
+/**
+ * @brief Get the RTC timer value, without truncation to 32 bits
+ *
+ * @returns RTC Timer value, in ticks since 01/01/2000
+ */
+uint64_t hal_rtc_get_timer_value_64( void );
+
 /**
  * @brief Converts time in ms to time in ticks
  *
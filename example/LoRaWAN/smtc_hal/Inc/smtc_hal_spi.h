@@ -59,6 +59,11 @@ extern "C" {
  * --- PUBLIC TYPES ------------------------------------------------------------
  */
 
+/**
+ * @brief Function folding one byte into a running CRC
+ */
+typedef uint8_t ( *hal_spi_crc_update_t )( uint8_t crc, uint8_t data );
+
 /**
  *  @brief SPI structure
  */
@@ -107,6 +112,33 @@ void hal_spi_deinit( const uint32_t id );
  */
 uint16_t hal_spi_in_out( const uint32_t id, const uint16_t out_data );
 
+/**
+ * @brief Sends and receives a buffer, keeping the SPI FIFO filled so that bytes are clocked back to back
+ *
+ * @param [in]  id       SPI interface id [1:N]
+ * @param [in]  out_data Buffer to be sent - NULL to send 0x00 bytes
+ * @param [out] in_data  Buffer receiving the data - NULL to discard it
+ * @param [in]  length   Number of bytes to exchange
+ */
+void hal_spi_transfer( const uint32_t id, const uint8_t* out_data, uint8_t* in_data, const uint16_t length );
+
+/**
+ * @brief Same as hal_spi_transfer, folding the transferred bytes into a CRC while the SPI shifts them
+ *
+ * @remark The sent bytes are folded if out_data is given, the received ones otherwise
+ *
+ * @param [in]  id         SPI interface id [1:N]
+ * @param [in]  out_data   Buffer to be sent - NULL to send 0x00 bytes
+ * @param [out] in_data    Buffer receiving the data - NULL to discard it
+ * @param [in]  length     Number of bytes to exchange
+ * @param [in]  crc_update CRC byte update function
+ * @param [in]  crc        Current CRC value
+ *
+ * @returns Updated CRC value
+ */
+uint8_t hal_spi_transfer_crc( const uint32_t id, const uint8_t* out_data, uint8_t* in_data, const uint16_t length,
+                              const hal_spi_crc_update_t crc_update, uint8_t crc );
+
 #ifdef __cplusplus
 }
 #endif
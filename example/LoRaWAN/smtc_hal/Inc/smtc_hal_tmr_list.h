@@ -53,6 +53,24 @@ extern "C" {
  * --- PUBLIC CONSTANTS --------------------------------------------------------
  */
 
+/**
+ * @brief Maximum number of timers started at the same time
+ */
+#ifndef TIMER_LIST_MAX_NB_TIMERS
+#define TIMER_LIST_MAX_NB_TIMERS 16
+#endif
+
+/**
+ * @brief Timers expiring up to this number of RTC ticks after the RTC alarm are run on the same wakeup
+ *
+ * @remark The default only runs the timers already due, so that no timer expires early. A non-zero value trades that
+ *         accuracy for fewer wakeups: keep it below the RTC minimum timeout, so that a timer restarted from its
+ *         callback is not run again on the same wakeup
+ */
+#ifndef TIMER_LIST_COALESCING_SLACK_IN_TICKS
+#define TIMER_LIST_COALESCING_SLACK_IN_TICKS 0
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC TYPES ------------------------------------------------------------
@@ -63,13 +81,12 @@ extern "C" {
  */
 typedef struct timer_event_s
 {
-    uint32_t timestamp;                   //! Current timer value
+    uint64_t deadline;                    //! Expiry time, in absolute RTC ticks
     uint32_t reload_value;                //! Timer delay value
     bool     is_started;                  //! Is the timer currently running
-    bool     is_next_2_expire;            //! Is the next timer to expire
+    uint8_t  heap_index;                  //! Position in the timer queue while the timer is running
     void ( *callback )( void* context );  //! Timer IRQ callback function
-    void*                 context;        //! User defined data object pointer to pass back
-    struct timer_event_s* next;           //! Pointer to the next Timer object.
+    void* context;                        //! User defined data object pointer to pass back
 } timer_event_t;
 
 /**
@@ -122,8 +139,11 @@ bool is_timer_running( void );
  * @brief Starts and adds the timer object to the list of timer events
  *
  * @param [in] obj Structure containing the timer object parameters
+ *
+ * @returns status  returns the timer activity status [true: Started,
+ *                                                    false: NULL object or TIMER_LIST_MAX_NB_TIMERS already started]
  */
-void timer_start( timer_event_t* obj );
+bool timer_start( timer_event_t* obj );
 
 /**
  * @brief Checks if the provided timer is running
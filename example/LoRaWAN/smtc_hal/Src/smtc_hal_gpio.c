@@ -170,6 +170,20 @@ void hal_gpio_irq_disable( void )
     HAL_NVIC_DisableIRQ( EXTI15_10_IRQn );
 }
 
+void hal_gpio_irq_unmask( const hal_gpio_pin_names_t pin )
+{
+    const uint32_t exti_line = 1 << ( pin & 0x0F );
+
+    /* Drop an edge latched while the line was masked */
+    __HAL_GPIO_EXTI_CLEAR_IT( exti_line );
+    SET_BIT( EXTI->IMR1, exti_line );
+}
+
+void hal_gpio_irq_mask( const hal_gpio_pin_names_t pin )
+{
+    CLEAR_BIT( EXTI->IMR1, 1 << ( pin & 0x0F ) );
+}
+
 /**
 * @brief MCU pin state control
 */
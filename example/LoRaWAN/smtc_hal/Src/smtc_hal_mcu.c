@@ -278,6 +278,29 @@ void hal_mcu_wait_us( const int32_t microseconds )
     }
 }
 
+uint32_t hal_mcu_get_time_in_us( void )
+{
+    uint32_t tick_ms;
+    uint32_t tick_value;
+    bool     is_tick_pending;
+
+    do
+    {
+        tick_ms         = HAL_GetTick( );
+        tick_value      = SysTick->VAL;
+        is_tick_pending = ( ( SCB->ICSR & SCB_ICSR_PENDSTSET_Msk ) != 0 ) ? true : false;
+    } while( tick_ms != HAL_GetTick( ) );
+
+    if( is_tick_pending == true )
+    {
+        // Called with interrupts masked after a reload: account for the tick not yet handled
+        tick_ms++;
+        tick_value = SysTick->VAL;
+    }
+
+    return ( tick_ms * 1000 ) + ( ( SysTick->LOAD - tick_value ) / ( SystemCoreClock / 1000000 ) );
+}
+
 void hal_mcu_init_software_watchdog( uint32_t value )
 {
 #if HAL_USE_WATCHDOG == HAL_FEATURE_ON
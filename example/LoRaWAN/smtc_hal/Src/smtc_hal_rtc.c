@@ -71,9 +71,14 @@
 #define USEC_NUMBER 1000000U
 #define MSEC_NUMBER ( USEC_NUMBER / 1000 )
 
-#define COMMON_FACTOR 3U
-#define CONV_NUMER ( MSEC_NUMBER >> COMMON_FACTOR )
-#define CONV_DENOM ( 1U << ( N_PREDIV_S - COMMON_FACTOR ) )
+/* milliseconds / 1000 as a multiplication and a shift, exact for any 32-bit value */
+#define MSEC_2_SEC_MUL ( 274877907ULL )
+#define MSEC_2_SEC_SHIFT 38U
+
+/* ( milliseconds << N_PREDIV_S ) / 1000 as a multiplication and a shift, exact below 1000 ms */
+#define MSEC_2_SUBSEC_TICK_SHIFT 20U
+#define MSEC_2_SUBSEC_TICK_MUL \
+    ( ( ( 1UL << ( MSEC_2_SUBSEC_TICK_SHIFT + N_PREDIV_S ) ) + MSEC_NUMBER - 1U ) / MSEC_NUMBER )
 
 /*!
  * @brief Days, Hours, Minutes and seconds
@@ -97,11 +102,25 @@
  */
 #define DIVC( X, N ) ( ( ( X ) + ( N ) -1 ) / ( N ) )
 
+/*!
+ * @brief Extracts a BCD field of a calendar register, in binary
+ */
+#define RTC_REG_BCD2BIN( REG, MSK, POS ) ( ( uint32_t ) __LL_RTC_CONVERT_BCD2BIN( ( ( REG ) & ( MSK ) ) >> ( POS ) ) )
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
  */
 
+/*!
+ * @brief Timestamp of the last midnight, cached as long as the RTC date does not change
+ */
+typedef struct rtc_midnight_s
+{
+    uint32_t date_register;       // RTC_DR value the timestamp was computed for - 0 if none
+    uint64_t timestamp_in_ticks;  // Timestamp of 00:00:00 on that date
+} rtc_midnight_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE VARIABLES -------------------------------------------------------
@@ -114,6 +133,11 @@ hal_rtc_t hal_rtc;
  */
 static RTC_AlarmTypeDef rtc_alarm;
 
+/*!
+ * @brief Last midnight timestamp
+ */
+static rtc_midnight_t rtc_midnight = { .date_register = 0, .timestamp_in_ticks = 0 };
+
 /*!
  * @brief Number of days in each month on a normal year
  */
@@ -164,6 +188,27 @@ static uint32_t hal_rtc_get_calendar_time( uint16_t* milliseconds );
  */
 static uint64_t rtc_get_timestamp_in_ticks( RTC_DateTypeDef* date, RTC_TimeTypeDef* time );
 
+/*!
+ * @brief Get current full resolution RTC timestamp in ticks, from the RTC registers
+ *
+ * @remark Unlike rtc_get_timestamp_in_ticks, there is no calendar conversion: the date only changes once a day, so the
+ *         timestamp of the last midnight is cached
+ *
+ * @returns timestamp_in_ticks Current timestamp in ticks
+ */
+static uint64_t rtc_get_timestamp_in_ticks_fast( void );
+
+/*!
+ * @brief Get the number of days elapsed since 01/01/2000
+ *
+ * @param [in] year  Year, from 0 (2000)
+ * @param [in] month Month, from 1 (January)
+ * @param [in] date  Day of the month, from 1
+ *
+ * @returns Number of days elapsed since 01/01/2000
+ */
+static uint32_t rtc_get_days_since_2000( uint32_t year, uint32_t month, uint32_t date );
+
 void hal_rtc_init( void )
 {
     RTC_TimeTypeDef time;
@@ -355,36 +400,29 @@ void hal_rtc_start_alarm( uint32_t timeout )
 
 uint32_t hal_rtc_get_timer_value( void )
 {
-    RTC_TimeTypeDef time;
-    RTC_DateTypeDef date;
-
-    uint32_t timestamp_value = ( uint32_t ) rtc_get_timestamp_in_ticks( &date, &time );
+    uint32_t timestamp_value = ( uint32_t ) rtc_get_timestamp_in_ticks_fast( );
 
     return ( timestamp_value );
 }
 
+uint64_t hal_rtc_get_timer_value_64( void ) { return rtc_get_timestamp_in_ticks_fast( ); }
+
 uint32_t hal_rtc_get_timer_elapsed_value( void )
 {
-    RTC_TimeTypeDef time;
-    RTC_DateTypeDef date;
-
-    uint32_t timestamp_value = ( uint32_t ) rtc_get_timestamp_in_ticks( &date, &time );
+    uint32_t timestamp_value = ( uint32_t ) rtc_get_timestamp_in_ticks_fast( );
 
     return ( ( uint32_t )( timestamp_value - hal_rtc.context.time_ref_in_ticks ) );
 }
 
 void hal_rtc_delay_in_ms( const uint32_t milliseconds )
 {
-    RTC_TimeTypeDef time;
-    RTC_DateTypeDef date;
-
     uint64_t delay_in_ticks     = 0;
-    uint64_t ref_delay_in_ticks = rtc_get_timestamp_in_ticks( &date, &time );
+    uint64_t ref_delay_in_ticks = rtc_get_timestamp_in_ticks_fast( );
 
     delay_in_ticks = hal_rtc_ms_2_tick( milliseconds );
 
     /* Wait delay ms */
-    while( ( ( rtc_get_timestamp_in_ticks( &date, &time ) - ref_delay_in_ticks ) ) < delay_in_ticks )
+    while( ( ( rtc_get_timestamp_in_ticks_fast( ) - ref_delay_in_ticks ) ) < delay_in_ticks )
     {
         __NOP( );
     }
@@ -418,7 +456,10 @@ uint32_t hal_rtc_get_time_ref_in_ticks( void ) { return hal_rtc.context.time_ref
 
 uint32_t hal_rtc_ms_2_tick( const uint32_t milliseconds )
 {
-    return ( uint32_t )( ( ( ( uint64_t ) milliseconds ) * CONV_DENOM ) / CONV_NUMER );
+    uint32_t seconds    = ( uint32_t )( ( milliseconds * MSEC_2_SEC_MUL ) >> MSEC_2_SEC_SHIFT );
+    uint32_t local_msec = milliseconds - ( seconds * 1000 );
+
+    return ( seconds << N_PREDIV_S ) + ( ( local_msec * MSEC_2_SUBSEC_TICK_MUL ) >> MSEC_2_SUBSEC_TICK_SHIFT );
 }
 
 uint32_t hal_rtc_tick_2_ms( const uint32_t tick )
@@ -449,11 +490,9 @@ static uint32_t hal_rtc_s_2_wakeup_timer_tick( const uint32_t seconds )
 
 static uint32_t hal_rtc_get_calendar_time( uint16_t* milliseconds )
 {
-    RTC_TimeTypeDef time;
-    RTC_DateTypeDef date;
-    uint32_t        ticks;
+    uint32_t ticks;
 
-    uint64_t timestamp_in_ticks = rtc_get_timestamp_in_ticks( &date, &time );
+    uint64_t timestamp_in_ticks = rtc_get_timestamp_in_ticks_fast( );
 
     uint32_t seconds = ( uint32_t )( timestamp_in_ticks >> N_PREDIV_S );
 
@@ -498,7 +537,6 @@ void HAL_RTC_AlarmAEventCallback( RTC_HandleTypeDef* hrtc ) { timer_irq_handler(
 static uint64_t rtc_get_timestamp_in_ticks( RTC_DateTypeDef* date, RTC_TimeTypeDef* time )
 {
     uint64_t timestamp_in_ticks = 0;
-    uint32_t correction;
     uint32_t seconds;
 
     /* Make sure it is correct due to asynchronous nature of RTC */
@@ -512,14 +550,7 @@ static uint64_t rtc_get_timestamp_in_ticks( RTC_DateTypeDef* date, RTC_TimeTypeD
     } while( ssr != RTC->SSR );
 
     /* Calculate amount of elapsed days since 01/01/2000 */
-    seconds = DIVC( ( DAYS_IN_YEAR * 3 + DAYS_IN_LEAP_YEAR ) * date->Year, 4 );
-
-    correction = ( ( date->Year % 4 ) == 0 ) ? DAYS_IN_MONTH_CORRECTION_LEAP : DAYS_IN_MONTH_CORRECTION_NORM;
-
-    seconds +=
-        ( DIVC( ( date->Month - 1 ) * ( 30 + 31 ), 2 ) - ( ( ( correction >> ( ( date->Month - 1 ) * 2 ) ) & 0x03 ) ) );
-
-    seconds += ( date->Date - 1 );
+    seconds = rtc_get_days_since_2000( date->Year, date->Month, date->Date );
 
     /* Convert from days to seconds */
     seconds *= SECONDS_IN_1DAY;
@@ -532,6 +563,60 @@ static uint64_t rtc_get_timestamp_in_ticks( RTC_DateTypeDef* date, RTC_TimeTypeD
     return timestamp_in_ticks;
 }
 
+static uint64_t rtc_get_timestamp_in_ticks_fast( void )
+{
+    uint32_t tr;
+    uint32_t dr;
+    uint32_t seconds;
+    uint64_t midnight_in_ticks;
+
+    /* Make sure it is correct due to asynchronous nature of RTC */
+    volatile uint32_t ssr;
+
+    do
+    {
+        ssr = RTC->SSR;
+        tr  = RTC->TR;
+        dr  = RTC->DR;
+    } while( ssr != RTC->SSR );
+
+    CRITICAL_SECTION_BEGIN( );
+    if( dr != rtc_midnight.date_register )
+    {
+        seconds = rtc_get_days_since_2000( RTC_REG_BCD2BIN( dr, RTC_DR_YT | RTC_DR_YU, RTC_DR_YU_Pos ),
+                                           RTC_REG_BCD2BIN( dr, RTC_DR_MT | RTC_DR_MU, RTC_DR_MU_Pos ),
+                                           RTC_REG_BCD2BIN( dr, RTC_DR_DT | RTC_DR_DU, RTC_DR_DU_Pos ) ) *
+                  SECONDS_IN_1DAY;
+
+        rtc_midnight.date_register      = dr;
+        rtc_midnight.timestamp_in_ticks = ( ( uint64_t ) seconds ) << N_PREDIV_S;
+    }
+    midnight_in_ticks = rtc_midnight.timestamp_in_ticks;
+    CRITICAL_SECTION_END( );
+
+    seconds = ( RTC_REG_BCD2BIN( tr, RTC_TR_HT | RTC_TR_HU, RTC_TR_HU_Pos ) * SECONDS_IN_1HOUR ) +
+              ( RTC_REG_BCD2BIN( tr, RTC_TR_MNT | RTC_TR_MNU, RTC_TR_MNU_Pos ) * SECONDS_IN_1MINUTE ) +
+              RTC_REG_BCD2BIN( tr, RTC_TR_ST | RTC_TR_SU, RTC_TR_SU_Pos );
+
+    return midnight_in_ticks + ( ( ( uint64_t ) seconds ) << N_PREDIV_S ) + ( PREDIV_S - ( ssr & RTC_SSR_SS ) );
+}
+
+static uint32_t rtc_get_days_since_2000( uint32_t year, uint32_t month, uint32_t date )
+{
+    uint32_t days;
+    uint32_t correction;
+
+    days = DIVC( ( DAYS_IN_YEAR * 3 + DAYS_IN_LEAP_YEAR ) * year, 4 );
+
+    correction = ( ( year % 4 ) == 0 ) ? DAYS_IN_MONTH_CORRECTION_LEAP : DAYS_IN_MONTH_CORRECTION_NORM;
+
+    days += ( DIVC( ( month - 1 ) * ( 30 + 31 ), 2 ) - ( ( ( correction >> ( ( month - 1 ) * 2 ) ) & 0x03 ) ) );
+
+    days += ( date - 1 );
+
+    return days;
+}
+
 void RTC_WKUP_IRQHandler( void ) { HAL_RTCEx_WakeUpTimerIRQHandler( &hal_rtc.handle ); }
 
 void HAL_RTC_MspInit( RTC_HandleTypeDef* rtc_handle )
@@ -53,6 +53,13 @@
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
 
+/**
+ * @brief Maximum number of bytes in flight during a buffer transfer
+ *
+ * @remark Bounded by the 4-byte RX FIFO, so that it cannot overflow whatever the interrupt latency
+ */
+#define HAL_SPI_FIFO_DEPTH 4
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
@@ -152,6 +159,56 @@ uint16_t hal_spi_in_out( const uint32_t id, const uint16_t out_data )
     return LL_SPI_ReceiveData8( hal_spi[local_id].interface );
 }
 
+void hal_spi_transfer( const uint32_t id, const uint8_t* out_data, uint8_t* in_data, const uint16_t length )
+{
+    hal_spi_transfer_crc( id, out_data, in_data, length, NULL, 0 );
+}
+
+uint8_t hal_spi_transfer_crc( const uint32_t id, const uint8_t* out_data, uint8_t* in_data, const uint16_t length,
+                              const hal_spi_crc_update_t crc_update, uint8_t crc )
+{
+    assert_param( ( id > 0 ) && ( ( id - 1 ) < sizeof( hal_spi ) ) );
+    SPI_TypeDef* spi      = hal_spi[id - 1].interface;
+    uint16_t     tx_count = 0;
+    uint16_t     rx_count = 0;
+
+    while( rx_count < length )
+    {
+        if( ( tx_count < length ) && ( ( tx_count - rx_count ) < HAL_SPI_FIFO_DEPTH ) &&
+            ( LL_SPI_IsActiveFlag_TXE( spi ) != 0 ) )
+        {
+            const uint8_t data = ( out_data != NULL ) ? out_data[tx_count] : 0x00;
+
+            LL_SPI_TransmitData8( spi, data );
+            tx_count++;
+
+            /* Done while the byte is being shifted out */
+            if( ( crc_update != NULL ) && ( out_data != NULL ) )
+            {
+                crc = crc_update( crc, data );
+            }
+        }
+
+        if( LL_SPI_IsActiveFlag_RXNE( spi ) != 0 )
+        {
+            const uint8_t data = LL_SPI_ReceiveData8( spi );
+
+            if( in_data != NULL )
+            {
+                in_data[rx_count] = data;
+            }
+            rx_count++;
+
+            if( ( crc_update != NULL ) && ( out_data == NULL ) )
+            {
+                crc = crc_update( crc, data );
+            }
+        }
+    }
+
+    return crc;
+}
+
 void HAL_SPI_MspInit( SPI_HandleTypeDef* spiHandle )
 {
     if( spiHandle->Instance == hal_spi[0].interface )
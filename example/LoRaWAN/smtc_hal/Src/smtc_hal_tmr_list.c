@@ -69,6 +69,17 @@
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
 
+#if( TIMER_LIST_MAX_NB_TIMERS < 1 ) || ( TIMER_LIST_MAX_NB_TIMERS > 255 )
+#error "TIMER_LIST_MAX_NB_TIMERS must be in [1, 255]"
+#endif
+
+/*!
+ * @brief Longest RTC alarm delay - the alarm date computation only handles a day change
+ *
+ * @remark A timer expiring later gets intermediate wakeups
+ */
+#define TIMER_MAX_ALARM_DELAY_IN_MS ( 24U * 3600U * 1000U )
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
@@ -80,9 +91,16 @@
  */
 
 /*!
- * @brief Timers list head pointer
+ * @brief Running timers, as a binary min-heap on their deadline
+ *
+ * @remark timer_heap[0] is the next timer to expire
+ */
+static timer_event_t* timer_heap[TIMER_LIST_MAX_NB_TIMERS];
+
+/*!
+ * @brief Number of running timers
  */
-static timer_event_t* timer_list_head = NULL;
+static uint8_t timer_heap_size = 0;
 
 /*
  * -----------------------------------------------------------------------------
@@ -90,41 +108,47 @@ static timer_event_t* timer_list_head = NULL;
  */
 
 /*!
- * @brief Adds or replace the head timer of the list.
+ * @brief Adds a timer to the queue
  *
- * @remark The list is automatically sorted. The list head always contains the
- *         next timer to expire.
+ * @param [in]  obj Timer object to be added to the queue
+ */
+static void timer_heap_push( timer_event_t* obj );
+
+/*!
+ * @brief Removes a timer from the queue
  *
- * @param [in]  obj Timer object to be become the new head
- * @param [in]  remainingTime Remaining time of the previous head to be replaced
+ * @param [in]  index Position of the timer in the queue
  */
-static void timer_insert_new_head_timer( timer_event_t* obj );
+static void timer_heap_remove( uint8_t index );
 
 /*!
- * @brief Adds a timer to the list.
+ * @brief Moves a timer towards the top of the queue until its parent expires first
  *
- * @remark The list is automatically sorted. The list head always contains the
- *         next timer to expire.
+ * @param [in]  index Position of the timer in the queue
+ */
+static void timer_heap_sift_up( uint8_t index );
+
+/*!
+ * @brief Moves a timer towards the bottom of the queue until it expires before its children
  *
- * @param [in]  obj Timer object to be added to the list
- * @param [in]  remainingTime Remaining time of the running head after which the object may be added
+ * @param [in]  index Position of the timer in the queue
  */
-static void timer_insert_timer( timer_event_t* obj );
+static void timer_heap_sift_down( uint8_t index );
 
 /*!
- * @brief Sets a timeout with the duration "timestamp"
+ * @brief Stores a timer at a position of the queue
  *
- * @param [in] timestamp Delay duration
+ * @param [in]  index Position in the queue
+ * @param [in]  obj Timer object
  */
-static void timer_set_timeout( timer_event_t* obj );
+static void timer_heap_set( uint8_t index, timer_event_t* obj );
 
 /*!
- * @brief Check if the Object to be added is not already in the list
+ * @brief Programs the RTC alarm at the deadline of a timer
  *
- * @param [in] timestamp Delay duration
- * @returns true (the object is already in the list) or false
+ * @param [in] obj Timer object
  */
-static bool timer_exists( timer_event_t* obj );
+static void timer_set_timeout( timer_event_t* obj );
 
 /*
  * -----------------------------------------------------------------------------
@@ -133,156 +157,75 @@ static bool timer_exists( timer_event_t* obj );
 
 void timer_init( timer_event_t* obj, void ( *callback )( void* context ) )
 {
-    obj->timestamp        = 0;
-    obj->reload_value     = 0;
-    obj->is_started       = false;
-    obj->is_next_2_expire = false;
-    obj->callback         = callback;
-    obj->context          = NULL;
-    obj->next             = NULL;
+    obj->deadline     = 0;
+    obj->reload_value = 0;
+    obj->is_started   = false;
+    obj->heap_index   = 0;
+    obj->callback     = callback;
+    obj->context      = NULL;
 }
 
 void timer_set_context( timer_event_t* obj, void* context ) { obj->context = context; }
 
-void timer_start( timer_event_t* obj )
+bool timer_start( timer_event_t* obj )
 {
-    uint32_t elapsed_time = 0;
-
     CRITICAL_SECTION_BEGIN( );
 
-    if( ( obj == NULL ) || ( timer_exists( obj ) == true ) )
+    if( obj == NULL )
     {
         CRITICAL_SECTION_END( );
-        return;
+        return false;
     }
 
-    obj->timestamp        = obj->reload_value;
-    obj->is_started       = true;
-    obj->is_next_2_expire = false;
-
-    if( timer_list_head == NULL )
+    if( obj->is_started == true )
     {
-        hal_rtc_set_time_ref_in_ticks( );
-        /* Inserts a timer at time now + obj->timestamp */
-        timer_insert_new_head_timer( obj );
-    }
-    else
-    {
-        elapsed_time = hal_rtc_get_timer_elapsed_value( );
-        obj->timestamp += elapsed_time;
-
-        if( obj->timestamp < timer_list_head->timestamp )
-        {
-            timer_insert_new_head_timer( obj );
-        }
-        else
-        {
-            timer_insert_timer( obj );
-        }
+        CRITICAL_SECTION_END( );
+        return true;
     }
-    CRITICAL_SECTION_END( );
-}
 
-bool is_timer_running( void )
-{
-    if( timer_list_head == NULL )
+    /* The timer queue is full - leave the running timers untouched */
+    if( timer_heap_size >= TIMER_LIST_MAX_NB_TIMERS )
     {
+        CRITICAL_SECTION_END( );
         return false;
     }
-    else
-    {
-        return true;
-    }
-}
-
-static void timer_insert_timer( timer_event_t* obj )
-{
-    timer_event_t* cur  = timer_list_head;
-    timer_event_t* next = timer_list_head->next;
 
-    while( cur->next != NULL )
-    {
-        if( obj->timestamp > next->timestamp )
-        {
-            cur  = next;
-            next = next->next;
-        }
-        else
-        {
-            cur->next = obj;
-            obj->next = next;
-            return;
-        }
-    }
-    cur->next = obj;
-    obj->next = NULL;
-}
+    obj->deadline   = hal_rtc_get_timer_value_64( ) + obj->reload_value;
+    obj->is_started = true;
 
-static void timer_insert_new_head_timer( timer_event_t* obj )
-{
-    timer_event_t* cur = timer_list_head;
+    timer_heap_push( obj );
 
-    if( cur != NULL )
+    if( timer_heap[0] == obj )
     {
-        cur->is_next_2_expire = false;
+        timer_set_timeout( obj );
     }
-
-    obj->next       = cur;
-    timer_list_head = obj;
-    timer_set_timeout( timer_list_head );
+    CRITICAL_SECTION_END( );
+    return true;
 }
 
+bool is_timer_running( void ) { return timer_heap_size != 0; }
+
 bool timer_is_started( timer_event_t* obj ) { return obj->is_started; }
 
 void timer_irq_handler( void )
 {
     timer_event_t* cur;
-    timer_event_t* next;
-
-    uint32_t old           = hal_rtc_get_time_ref_in_ticks( );
-    uint32_t now           = hal_rtc_set_time_ref_in_ticks( );
-    uint32_t delta_context = now - old;  // intentional wrap around
-
-    /* Update timeStamp based upon new Time Reference
-       because delta context should never exceed 2^32 */
-    if( timer_list_head != NULL )
-    {
-        for( cur = timer_list_head; cur->next != NULL; cur = cur->next )
-        {
-            next = cur->next;
-            if( next->timestamp > delta_context )
-            {
-                next->timestamp -= delta_context;
-            }
-            else
-            {
-                next->timestamp = 0;
-            }
-        }
-    }
 
-    /* Execute immediately the alarm callback */
-    if( timer_list_head != NULL )
-    {
-        cur             = timer_list_head;
-        timer_list_head = timer_list_head->next;
-        cur->is_started = false;
-        execute_callback( cur->callback, cur->context );
-    }
+    /* Run all the timers expiring before the coalescing horizon, earliest first */
+    const uint64_t horizon = hal_rtc_get_timer_value_64( ) + TIMER_LIST_COALESCING_SLACK_IN_TICKS;
 
-    /* Remove all the expired object from the list */
-    while( ( timer_list_head != NULL ) && ( timer_list_head->timestamp < hal_rtc_get_timer_elapsed_value( ) ) )
+    while( ( timer_heap_size != 0 ) && ( timer_heap[0]->deadline <= horizon ) )
     {
-        cur             = timer_list_head;
-        timer_list_head = timer_list_head->next;
+        cur = timer_heap[0];
+        timer_heap_remove( 0 );
         cur->is_started = false;
         execute_callback( cur->callback, cur->context );
     }
 
-    /* Start the next timer_list_head if it exists AND NOT running */
-    if( ( timer_list_head != NULL ) && ( timer_list_head->is_next_2_expire == false ) )
+    /* Wake up for the next timer - this also covers an alarm clamped before a far deadline */
+    if( timer_heap_size != 0 )
     {
-        timer_set_timeout( timer_list_head );
+        timer_set_timeout( timer_heap[0] );
     }
 }
 
@@ -290,93 +233,33 @@ void timer_stop( timer_event_t* obj )
 {
     CRITICAL_SECTION_BEGIN( );
 
-    timer_event_t* prev = timer_list_head;
-    timer_event_t* cur  = timer_list_head;
-
-    /* List is empty or the obj to stop does not exist */
-    if( ( timer_list_head == NULL ) || ( obj == NULL ) )
+    /* The obj to stop is not running */
+    if( ( obj == NULL ) || ( obj->is_started == false ) )
     {
         CRITICAL_SECTION_END( );
         return;
     }
 
+    const bool is_next_to_expire = ( obj->heap_index == 0 );
+
     obj->is_started = false;
+    timer_heap_remove( obj->heap_index );
 
-    if( timer_list_head == obj )  // Stop the Head
+    if( timer_heap_size == 0 )
     {
-        if( timer_list_head->is_next_2_expire == true )  // The head is already running
-        {
-            timer_list_head->is_next_2_expire = false;
-            if( timer_list_head->next != NULL )
-            {
-                timer_list_head = timer_list_head->next;
-                timer_set_timeout( timer_list_head );
-            }
-            else
-            {
-                hal_rtc_stop_alarm( );
-                timer_list_head = NULL;
-            }
-        }
-        else  // Stop the head before it is started
-        {
-            if( timer_list_head->next != NULL )
-            {
-                timer_list_head = timer_list_head->next;
-            }
-            else
-            {
-                timer_list_head = NULL;
-            }
-        }
+        hal_rtc_stop_alarm( );
     }
-    else  // Stop an object within the list
+    else if( is_next_to_expire == true )
     {
-        while( cur != NULL )
-        {
-            if( cur == obj )
-            {
-                if( cur->next != NULL )
-                {
-                    cur        = cur->next;
-                    prev->next = cur;
-                }
-                else
-                {
-                    cur        = NULL;
-                    prev->next = cur;
-                }
-                break;
-            }
-            else
-            {
-                prev = cur;
-                cur  = cur->next;
-            }
-        }
+        timer_set_timeout( timer_heap[0] );
     }
     CRITICAL_SECTION_END( );
 }
 
-static bool timer_exists( timer_event_t* obj )
-{
-    timer_event_t* cur = timer_list_head;
-
-    while( cur != NULL )
-    {
-        if( cur == obj )
-        {
-            return true;
-        }
-        cur = cur->next;
-    }
-    return false;
-}
-
 void timer_reset( timer_event_t* obj )
 {
     timer_stop( obj );
-    timer_start( obj );
+    ( void ) timer_start( obj );
 }
 
 void timer_set_value( timer_event_t* obj, uint32_t value )
@@ -393,7 +276,6 @@ void timer_set_value( timer_event_t* obj, uint32_t value )
         ticks = min_value;
     }
 
-    obj->timestamp    = ticks;
     obj->reload_value = ticks;
 }
 
@@ -410,19 +292,6 @@ timer_time_t timer_get_elapsed_time( timer_time_t past )
     return hal_rtc_tick_2_ms( nowInTicks - pastInTicks );
 }
 
-static void timer_set_timeout( timer_event_t* obj )
-{
-    int32_t min_ticks     = hal_rtc_get_minimum_timeout( );
-    obj->is_next_2_expire = true;
-
-    /* In case deadline too soon */
-    if( obj->timestamp < ( hal_rtc_get_timer_elapsed_value( ) + min_ticks ) )
-    {
-        obj->timestamp = hal_rtc_get_timer_elapsed_value( ) + min_ticks;
-    }
-    hal_rtc_start_alarm( obj->timestamp );
-}
-
 timer_time_t timer_temp_compensation( timer_time_t period, float temperature )
 {
     return hal_rtc_temp_compensation( period, temperature );
@@ -433,4 +302,98 @@ timer_time_t timer_temp_compensation( timer_time_t period, float temperature )
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
  */
 
+static void timer_heap_push( timer_event_t* obj )
+{
+    const uint8_t index = timer_heap_size++;
+
+    timer_heap_set( index, obj );
+    timer_heap_sift_up( index );
+}
+
+static void timer_heap_remove( uint8_t index )
+{
+    const uint8_t last = --timer_heap_size;
+
+    if( index != last )
+    {
+        timer_heap_set( index, timer_heap[last] );
+        timer_heap_sift_down( index );
+        timer_heap_sift_up( index );
+    }
+}
+
+static void timer_heap_sift_up( uint8_t index )
+{
+    timer_event_t* obj = timer_heap[index];
+
+    while( index > 0 )
+    {
+        const uint8_t parent = ( index - 1 ) >> 1;
+
+        if( timer_heap[parent]->deadline <= obj->deadline )
+        {
+            break;
+        }
+        timer_heap_set( index, timer_heap[parent] );
+        index = parent;
+    }
+    timer_heap_set( index, obj );
+}
+
+static void timer_heap_sift_down( uint8_t index )
+{
+    timer_event_t* obj = timer_heap[index];
+
+    while( true )
+    {
+        const uint16_t left  = ( ( uint16_t ) index << 1 ) + 1;
+        const uint16_t right = left + 1;
+        uint16_t       child;
+
+        if( left >= timer_heap_size )
+        {
+            break;
+        }
+        child = ( ( right < timer_heap_size ) && ( timer_heap[right]->deadline < timer_heap[left]->deadline ) )
+                    ? right
+                    : left;
+        if( obj->deadline <= timer_heap[child]->deadline )
+        {
+            break;
+        }
+        timer_heap_set( index, timer_heap[child] );
+        index = ( uint8_t ) child;
+    }
+    timer_heap_set( index, obj );
+}
+
+static void timer_heap_set( uint8_t index, timer_event_t* obj )
+{
+    timer_heap[index] = obj;
+    obj->heap_index   = index;
+}
+
+static void timer_set_timeout( timer_event_t* obj )
+{
+    /* The alarm is relative to the time reference: rebuild the reference on 64 bits from a later read */
+    const uint32_t ref_in_ticks    = hal_rtc_set_time_ref_in_ticks( );
+    const uint64_t now_in_ticks    = hal_rtc_get_timer_value_64( );
+    const uint64_t ref_64_in_ticks = now_in_ticks - ( uint32_t )( ( uint32_t ) now_in_ticks - ref_in_ticks );
+    const uint64_t max_in_ticks    = hal_rtc_ms_2_tick( TIMER_MAX_ALARM_DELAY_IN_MS );
+    uint64_t       deadline        = obj->deadline;
+
+    /* In case deadline too soon */
+    if( deadline < ( now_in_ticks + hal_rtc_get_minimum_timeout( ) ) )
+    {
+        deadline = now_in_ticks + hal_rtc_get_minimum_timeout( );
+    }
+
+    /* In case deadline too far - the IRQ handler programs the remaining time */
+    if( ( deadline - ref_64_in_ticks ) > max_in_ticks )
+    {
+        deadline = ref_64_in_ticks + max_in_ticks;
+    }
+    hal_rtc_start_alarm( ( uint32_t )( deadline - ref_64_in_ticks ) );
+}
+
 /* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,385 @@
+/*!
+ * @file      test_smtc_hal_rtc.c
+ *
+ * @brief     Unit tests of the RTC time base, against simulated RTC registers
+ *
+ * Revised BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "stm32l4xx_hal.h"
+
+/*
+ * The RTC registers are simulated: smtc_hal_rtc.c is built in this file, after RTC is redirected to the simulated
+ * registers, so that its static functions can be compared directly
+ */
+extern RTC_TypeDef sim_rtc_registers;
+#undef RTC
+#define RTC ( &sim_rtc_registers )
+
+#include "smtc_hal_rtc.c"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+#define CHECK( condition )                                                                  \
+    do                                                                                      \
+    {                                                                                       \
+        nb_checks++;                                                                        \
+        if( !( condition ) )                                                                \
+        {                                                                                   \
+            fprintf( stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition ); \
+            nb_failures++;                                                                  \
+        }                                                                                   \
+    } while( 0 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*!
+ * @brief Simulated time span: the RTC calendar covers 2000 to 2099
+ */
+#define SIM_NB_DAYS ( 100U * 365U + 25U )
+
+#define TICKS_IN_1SECOND ( ( uint64_t ) PREDIV_S + 1U )
+#define TICKS_IN_1DAY ( TICKS_IN_1SECOND * SECONDS_IN_1DAY )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static unsigned int nb_checks;
+static unsigned int nb_failures;
+
+RTC_TypeDef sim_rtc_registers;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static uint32_t bin_2_bcd( uint32_t value ) { return ( ( value / 10 ) << 4 ) | ( value % 10 ); }
+
+static uint8_t bcd_2_bin( uint32_t value ) { return ( uint8_t ) ( ( ( value >> 4 ) * 10 ) + ( value & 0x0F ) ); }
+
+/*!
+ * @brief Set the simulated calendar registers, from a number of ticks since 01/01/2000 00:00:00
+ */
+static void sim_set_ticks( uint64_t ticks )
+{
+    uint32_t days    = ( uint32_t ) ( ticks / TICKS_IN_1DAY );
+    uint32_t seconds = ( uint32_t ) ( ( ticks % TICKS_IN_1DAY ) / TICKS_IN_1SECOND );
+    uint32_t year    = 0;
+    uint32_t month   = 0;
+
+    while( days >= ( ( ( year % 4 ) == 0 ) ? DAYS_IN_LEAP_YEAR : DAYS_IN_YEAR ) )
+    {
+        days -= ( ( year % 4 ) == 0 ) ? DAYS_IN_LEAP_YEAR : DAYS_IN_YEAR;
+        year++;
+    }
+    while( days >= ( ( ( year % 4 ) == 0 ) ? days_in_month_leap_year[month] : days_in_month[month] ) )
+    {
+        days -= ( ( year % 4 ) == 0 ) ? days_in_month_leap_year[month] : days_in_month[month];
+        month++;
+    }
+
+    sim_rtc_registers.DR = ( bin_2_bcd( year ) << RTC_DR_YU_Pos ) | ( ( ( days % 7 ) + 1 ) << RTC_DR_WDU_Pos ) |
+                           ( bin_2_bcd( month + 1 ) << RTC_DR_MU_Pos ) | ( bin_2_bcd( days + 1 ) << RTC_DR_DU_Pos );
+    sim_rtc_registers.TR = ( bin_2_bcd( seconds / SECONDS_IN_1HOUR ) << RTC_TR_HU_Pos ) |
+                           ( bin_2_bcd( ( seconds / SECONDS_IN_1MINUTE ) % MINUTES_IN_1HOUR ) << RTC_TR_MNU_Pos ) |
+                           ( bin_2_bcd( seconds % SECONDS_IN_1MINUTE ) << RTC_TR_SU_Pos );
+    // The sub-second register counts down, and reloads when a second elapses
+    sim_rtc_registers.SSR = PREDIV_S - ( uint32_t ) ( ticks % TICKS_IN_1SECOND );
+}
+
+/*!
+ * @brief Calendar conversion used before the fast path, kept as a reference
+ */
+static uint64_t ref_get_timestamp_in_ticks( void )
+{
+    RTC_DateTypeDef   date;
+    RTC_TimeTypeDef   time;
+    uint32_t          correction;
+    uint32_t          seconds;
+    volatile uint32_t ssr;
+
+    do
+    {
+        ssr = RTC->SSR;
+        HAL_RTC_GetDate( &hal_rtc.handle, &date, RTC_FORMAT_BIN );
+        HAL_RTC_GetTime( &hal_rtc.handle, &time, RTC_FORMAT_BIN );
+    } while( ssr != RTC->SSR );
+
+    seconds    = DIVC( ( DAYS_IN_YEAR * 3 + DAYS_IN_LEAP_YEAR ) * date.Year, 4 );
+    correction = ( ( date.Year % 4 ) == 0 ) ? DAYS_IN_MONTH_CORRECTION_LEAP : DAYS_IN_MONTH_CORRECTION_NORM;
+    seconds +=
+        ( DIVC( ( date.Month - 1 ) * ( 30 + 31 ), 2 ) - ( ( ( correction >> ( ( date.Month - 1 ) * 2 ) ) & 0x03 ) ) );
+    seconds += ( date.Date - 1 );
+    seconds *= SECONDS_IN_1DAY;
+    seconds += ( ( uint32_t ) time.Seconds + ( ( uint32_t ) time.Minutes * SECONDS_IN_1MINUTE ) +
+                 ( ( uint32_t ) time.Hours * SECONDS_IN_1HOUR ) );
+
+    return ( ( ( uint64_t ) seconds ) << N_PREDIV_S ) + ( PREDIV_S - time.SubSeconds );
+}
+
+/*!
+ * @brief Milliseconds to ticks conversion used before the reciprocal multiplication, kept as a reference
+ */
+static uint32_t ref_ms_2_tick( uint32_t milliseconds )
+{
+    return ( uint32_t ) ( ( ( uint64_t ) milliseconds * ( 1U << N_PREDIV_S ) ) / MSEC_NUMBER );
+}
+
+/*!
+ * @brief Check all the timestamp paths at a given time
+ */
+static void check_timestamp( uint64_t ticks )
+{
+    RTC_DateTypeDef date;
+    RTC_TimeTypeDef time;
+
+    sim_set_ticks( ticks );
+
+    CHECK( rtc_get_timestamp_in_ticks_fast( ) == ticks );
+    CHECK( rtc_midnight.date_register == sim_rtc_registers.DR );
+    CHECK( rtc_midnight.timestamp_in_ticks == ticks - ( ticks % TICKS_IN_1DAY ) );
+    CHECK( ref_get_timestamp_in_ticks( ) == ticks );
+    CHECK( rtc_get_timestamp_in_ticks( &date, &time ) == ticks );
+    CHECK( hal_rtc_get_timer_value_64( ) == ticks );
+    CHECK( hal_rtc_get_timer_value( ) == ( uint32_t ) ticks );
+}
+
+/*!
+ * @brief Read the time tick by tick across a boundary, checking the fast path never jumps
+ */
+static void check_boundary( uint64_t boundary_in_ticks )
+{
+    const uint64_t first_in_ticks = boundary_in_ticks - 2 * TICKS_IN_1SECOND;
+    const uint64_t last_in_ticks  = boundary_in_ticks + 2 * TICKS_IN_1SECOND;
+    uint64_t       previous;
+
+    sim_set_ticks( first_in_ticks );
+    previous = rtc_get_timestamp_in_ticks_fast( );
+    for( uint64_t ticks = first_in_ticks + 1; ticks < last_in_ticks; ticks++ )
+    {
+        sim_set_ticks( ticks );
+
+        const uint64_t current = rtc_get_timestamp_in_ticks_fast( );
+
+        CHECK( current == previous + 1 );
+        CHECK( current == ref_get_timestamp_in_ticks( ) );
+        previous = current;
+    }
+}
+
+static uint64_t days_since_2000_in_ticks( uint32_t year, uint32_t month, uint32_t date )
+{
+    uint32_t days = 0;
+
+    for( uint32_t y = 0; y < year; y++ )
+    {
+        days += ( ( y % 4 ) == 0 ) ? DAYS_IN_LEAP_YEAR : DAYS_IN_YEAR;
+    }
+    for( uint32_t m = 1; m < month; m++ )
+    {
+        days += ( ( year % 4 ) == 0 ) ? days_in_month_leap_year[m - 1] : days_in_month[m - 1];
+    }
+    return ( days + date - 1 ) * TICKS_IN_1DAY;
+}
+
+static void test_midnight_rollover( void )
+{
+    // The cached midnight is invalidated when the date register changes
+    check_boundary( TICKS_IN_1DAY );
+    check_boundary( 1234 * TICKS_IN_1DAY );
+
+    const uint64_t noon = 10 * TICKS_IN_1DAY + TICKS_IN_1DAY / 2;
+
+    sim_set_ticks( noon );
+    CHECK( rtc_get_timestamp_in_ticks_fast( ) == noon );
+    sim_set_ticks( noon + TICKS_IN_1DAY );
+    CHECK( rtc_get_timestamp_in_ticks_fast( ) == noon + TICKS_IN_1DAY );
+    // Going back in time, for example when the calendar is set, is also caught
+    sim_set_ticks( noon );
+    CHECK( rtc_get_timestamp_in_ticks_fast( ) == noon );
+}
+
+static void test_month_rollover( void )
+{
+    for( uint32_t month = 2; month <= 12; month++ )
+    {
+        check_boundary( days_since_2000_in_ticks( 1, month, 1 ) );
+    }
+
+    // Leap years, and the end of the years
+    check_boundary( days_since_2000_in_ticks( 0, 2, 29 ) );
+    check_boundary( days_since_2000_in_ticks( 0, 3, 1 ) );
+    check_boundary( days_since_2000_in_ticks( 24, 2, 29 ) );
+    check_boundary( days_since_2000_in_ticks( 23, 3, 1 ) );
+    check_boundary( days_since_2000_in_ticks( 1, 1, 1 ) );
+    check_boundary( days_since_2000_in_ticks( 99, 1, 1 ) );
+    check_timestamp( days_since_2000_in_ticks( 99, 12, 31 ) + TICKS_IN_1DAY - 1 );
+}
+
+static void test_ssr_underflow( void )
+{
+    // The sub-second register wraps from 0 to PREDIV_S as the seconds field increments
+    for( uint32_t second = 0; second < SECONDS_IN_1DAY; second += 997 )
+    {
+        check_boundary( 42 * TICKS_IN_1DAY + second * TICKS_IN_1SECOND );
+    }
+    check_boundary( 42 * TICKS_IN_1DAY + ( SECONDS_IN_1DAY - 1 ) * TICKS_IN_1SECOND );
+}
+
+static void test_32bit_wraparound( void )
+{
+    const uint64_t wrap_in_ticks = 1ULL << 32;
+
+    check_boundary( wrap_in_ticks );
+
+    sim_set_ticks( wrap_in_ticks - 10 );
+    hal_rtc.context.time_ref_in_ticks = hal_rtc_get_timer_value( );
+    sim_set_ticks( wrap_in_ticks + 10 );
+    CHECK( hal_rtc_get_timer_value( ) == 10 );
+    CHECK( hal_rtc_get_timer_value_64( ) == wrap_in_ticks + 10 );
+    CHECK( hal_rtc_get_timer_elapsed_value( ) == 20 );
+}
+
+static void test_fuzz( void )
+{
+    srand( 22 );
+    for( unsigned int i = 0; i < 200000; i++ )
+    {
+        const uint64_t ticks = ( ( ( uint64_t ) rand( ) << 31 ) ^ ( uint64_t ) rand( ) );
+
+        check_timestamp( ticks % ( SIM_NB_DAYS * TICKS_IN_1DAY ) );
+    }
+}
+
+static void test_ms_2_tick( void )
+{
+    uint32_t nb_mismatches = 0;
+    uint32_t milliseconds  = 0;
+
+    // Exhaustive: the reciprocal multiplication must match the division for every 32-bit value
+    do
+    {
+        if( hal_rtc_ms_2_tick( milliseconds ) != ref_ms_2_tick( milliseconds ) )
+        {
+            nb_mismatches++;
+        }
+    } while( ++milliseconds != 0 );
+    CHECK( nb_mismatches == 0 );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- SIMULATED HAL -----------------------------------------------------------
+ */
+
+HAL_StatusTypeDef HAL_RTC_GetTime( RTC_HandleTypeDef* hrtc, RTC_TimeTypeDef* sTime, uint32_t Format )
+{
+    const uint32_t tr = RTC->TR & RTC_TR_RESERVED_MASK;
+
+
+    sTime->SubSeconds = RTC->SSR;
+    sTime->Hours      = bcd_2_bin( ( tr & ( RTC_TR_HT | RTC_TR_HU ) ) >> RTC_TR_HU_Pos );
+    sTime->Minutes    = bcd_2_bin( ( tr & ( RTC_TR_MNT | RTC_TR_MNU ) ) >> RTC_TR_MNU_Pos );
+    sTime->Seconds    = bcd_2_bin( ( tr & ( RTC_TR_ST | RTC_TR_SU ) ) >> RTC_TR_SU_Pos );
+    sTime->TimeFormat = ( uint8_t ) ( ( tr & RTC_TR_PM ) >> RTC_TR_PM_Pos );
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_GetDate( RTC_HandleTypeDef* hrtc, RTC_DateTypeDef* sDate, uint32_t Format )
+{
+    const uint32_t dr = RTC->DR & RTC_DR_RESERVED_MASK;
+
+
+    sDate->Year    = bcd_2_bin( ( dr & ( RTC_DR_YT | RTC_DR_YU ) ) >> RTC_DR_YU_Pos );
+    sDate->Month   = bcd_2_bin( ( dr & ( RTC_DR_MT | RTC_DR_MU ) ) >> RTC_DR_MU_Pos );
+    sDate->Date    = bcd_2_bin( ( dr & ( RTC_DR_DT | RTC_DR_DU ) ) >> RTC_DR_DU_Pos );
+    sDate->WeekDay = ( uint8_t ) ( ( dr & RTC_DR_WDU ) >> RTC_DR_WDU_Pos );
+    return HAL_OK;
+}
+
+/* Not used by the tests, only needed to link smtc_hal_rtc.c */
+HAL_StatusTypeDef HAL_RTC_Init( RTC_HandleTypeDef* hrtc ) { return HAL_OK; }
+HAL_StatusTypeDef HAL_RTC_SetTime( RTC_HandleTypeDef* hrtc, RTC_TimeTypeDef* sTime, uint32_t Format ) { return HAL_OK; }
+HAL_StatusTypeDef HAL_RTC_SetDate( RTC_HandleTypeDef* hrtc, RTC_DateTypeDef* sDate, uint32_t Format ) { return HAL_OK; }
+HAL_StatusTypeDef HAL_RTC_SetAlarm_IT( RTC_HandleTypeDef* hrtc, RTC_AlarmTypeDef* sAlarm, uint32_t Format )
+{
+    return HAL_OK;
+}
+HAL_StatusTypeDef HAL_RTC_DeactivateAlarm( RTC_HandleTypeDef* hrtc, uint32_t Alarm ) { return HAL_OK; }
+HAL_StatusTypeDef HAL_RTCEx_EnableBypassShadow( RTC_HandleTypeDef* hrtc ) { return HAL_OK; }
+HAL_StatusTypeDef HAL_RTCEx_SetWakeUpTimer_IT( RTC_HandleTypeDef* hrtc, uint32_t WakeUpCounter, uint32_t WakeUpClock )
+{
+    return HAL_OK;
+}
+HAL_StatusTypeDef HAL_RTCEx_DeactivateWakeUpTimer( RTC_HandleTypeDef* hrtc ) { return HAL_OK; }
+void              HAL_RTCEx_WakeUpTimerIRQHandler( RTC_HandleTypeDef* hrtc ) {}
+void              HAL_NVIC_SetPriority( IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority ) {}
+void              HAL_NVIC_EnableIRQ( IRQn_Type IRQn ) {}
+void              HAL_NVIC_DisableIRQ( IRQn_Type IRQn ) {}
+void              timer_irq_handler( void ) {}
+
+void hal_mcu_critical_section_begin( uint32_t* mask ) { *mask = 0; }
+void hal_mcu_critical_section_end( uint32_t* mask ) { ( void ) mask; }
+void hal_mcu_panic( void ) { nb_failures++; }
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+int main( void )
+{
+    hal_rtc.handle.Instance = RTC;
+
+    test_midnight_rollover( );
+    test_month_rollover( );
+    test_ssr_underflow( );
+    test_32bit_wraparound( );
+    test_fuzz( );
+    test_ms_2_tick( );
+
+    printf( "%u checks, %u failures\n", nb_checks, nb_failures );
+
+    return ( nb_failures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
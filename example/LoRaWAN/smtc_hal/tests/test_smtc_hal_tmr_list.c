@@ -0,0 +1,484 @@
+/*!
+ * @file      test_smtc_hal_tmr_list.c
+ *
+ * @brief     Unit tests of the software timer list, against a simulated RTC
+ *
+ * Revised BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "smtc_hal_mcu.h"
+#include "smtc_hal_rtc.h"
+#include "smtc_hal_tmr_list.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+#define CHECK( condition )                                                                  \
+    do                                                                                      \
+    {                                                                                       \
+        nb_checks++;                                                                        \
+        if( !( condition ) )                                                                \
+        {                                                                                   \
+            fprintf( stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition ); \
+            nb_failures++;                                                                  \
+        }                                                                                   \
+    } while( 0 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*!
+ * @brief Simulated RTC minimum alarm delay, in ticks
+ */
+#define SIM_MIN_TIMEOUT_IN_TICKS 3U
+
+/*!
+ * @brief Maximum number of logged timer expiries
+ */
+#define LOG_MAX_NB_EVENTS 256
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*!
+ * @brief Timer under test
+ */
+typedef struct test_timer_s
+{
+    timer_event_t timer;
+    unsigned int  id;
+    bool          restart;  // Restart the timer from its callback
+} test_timer_t;
+
+/*!
+ * @brief Logged timer expiry
+ */
+typedef struct log_event_s
+{
+    unsigned int id;
+    uint64_t     time_in_ticks;
+    unsigned int wakeup;
+} log_event_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static unsigned int nb_checks;
+static unsigned int nb_failures;
+
+/*!
+ * @brief Simulated RTC
+ */
+static struct
+{
+    uint64_t     now_in_ticks;        // Current time
+    uint32_t     ticks_per_read;      // Time elapsed at each read of the timer value
+    uint64_t     time_ref_in_ticks;   // Time reference the alarm is relative to
+    bool         alarm_is_armed;      //
+    uint64_t     alarm_in_ticks;      // Alarm time
+    uint64_t     wakeup_in_ticks;     // Time of the last alarm fired
+    uint32_t     alarm_timeout;       // Last timeout given to hal_rtc_start_alarm
+    unsigned int nb_wakeups;          // Number of alarms fired
+    unsigned int nb_panics;           //
+    int          critical_nesting;    // Critical section nesting level
+} sim;
+
+static log_event_t  log_events[LOG_MAX_NB_EVENTS];
+static unsigned int log_nb_events;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void sim_reset( uint64_t now_in_ticks )
+{
+    sim.now_in_ticks      = now_in_ticks;
+    sim.ticks_per_read    = 0;
+    sim.time_ref_in_ticks = now_in_ticks;
+    sim.alarm_is_armed    = false;
+    sim.alarm_in_ticks    = 0;
+    sim.wakeup_in_ticks   = 0;
+    sim.alarm_timeout     = 0;
+    sim.nb_wakeups        = 0;
+    sim.nb_panics         = 0;
+    sim.critical_nesting  = 0;
+    log_nb_events         = 0;
+}
+
+/*!
+ * @brief Fire the RTC alarms up to a time, then set the time
+ */
+static void sim_run_until( uint64_t time_in_ticks )
+{
+    while( ( sim.alarm_is_armed == true ) && ( sim.alarm_in_ticks <= time_in_ticks ) )
+    {
+        sim.now_in_ticks    = sim.alarm_in_ticks;
+        sim.wakeup_in_ticks = sim.alarm_in_ticks;
+        sim.alarm_is_armed  = false;
+        sim.nb_wakeups++;
+        timer_irq_handler( );
+    }
+    if( sim.now_in_ticks < time_in_ticks )
+    {
+        sim.now_in_ticks = time_in_ticks;
+    }
+}
+
+static void test_timer_callback( void* context )
+{
+    test_timer_t* obj = ( test_timer_t* ) context;
+
+    if( log_nb_events < LOG_MAX_NB_EVENTS )
+    {
+        log_events[log_nb_events].id            = obj->id;
+        log_events[log_nb_events].time_in_ticks = sim.wakeup_in_ticks;
+        log_events[log_nb_events].wakeup        = sim.nb_wakeups;
+        log_nb_events++;
+    }
+    if( obj->restart == true )
+    {
+        timer_start( &obj->timer );
+    }
+}
+
+static void test_timer_init( test_timer_t* obj, unsigned int id, uint32_t ms )
+{
+    obj->id      = id;
+    obj->restart = false;
+    timer_init( &obj->timer, test_timer_callback );
+    timer_set_context( &obj->timer, obj );
+    timer_set_value( &obj->timer, ms );
+}
+
+static void test_insert_remove_rearm( void )
+{
+    test_timer_t a;
+    test_timer_t b;
+    test_timer_t c;
+
+    sim_reset( 1000 );
+    test_timer_init( &a, 1, 100 );
+    test_timer_init( &b, 2, 50 );
+    test_timer_init( &c, 3, 200 );
+
+    timer_start( &a.timer );
+    CHECK( sim.alarm_is_armed && ( sim.alarm_in_ticks == a.timer.deadline ) );
+    timer_start( &b.timer );
+    CHECK( sim.alarm_in_ticks == b.timer.deadline );
+    timer_start( &c.timer );
+    CHECK( sim.alarm_in_ticks == b.timer.deadline );
+    CHECK( is_timer_running( ) );
+
+    // Starting a running timer again does not move it
+    const uint64_t c_deadline = c.timer.deadline;
+    sim_run_until( 1010 );
+    timer_start( &c.timer );
+    CHECK( c.timer.deadline == c_deadline );
+
+    // Removing the next timer to expire moves the alarm to the following one
+    timer_stop( &b.timer );
+    CHECK( !timer_is_started( &b.timer ) );
+    CHECK( sim.alarm_in_ticks == a.timer.deadline );
+
+    // Removing a timer which is not next does not touch the alarm
+    timer_stop( &c.timer );
+    CHECK( sim.alarm_in_ticks == a.timer.deadline );
+    timer_start( &c.timer );
+
+    // Periodic re-arm from the callback
+    a.restart = true;
+    sim_run_until( 1220 );
+    CHECK( log_nb_events == 3 );
+    CHECK( ( log_events[0].id == 1 ) && ( log_events[0].time_in_ticks == 1000 + a.timer.reload_value ) );
+    CHECK( ( log_events[1].id == 1 ) && ( log_events[1].time_in_ticks == 1000 + 2 * a.timer.reload_value ) );
+    CHECK( ( log_events[2].id == 3 ) && ( log_events[2].time_in_ticks == c.timer.deadline ) );
+    CHECK( !timer_is_started( &c.timer ) );
+
+    // timer_reset restarts from now
+    timer_reset( &a.timer );
+    CHECK( a.timer.deadline == sim.now_in_ticks + a.timer.reload_value );
+    CHECK( sim.alarm_in_ticks == a.timer.deadline );
+
+    // Removing the last timer stops the alarm
+    a.restart = false;
+    timer_stop( &a.timer );
+    CHECK( !is_timer_running( ) );
+    CHECK( !sim.alarm_is_armed );
+    CHECK( sim.critical_nesting == 0 );
+}
+
+static void test_coalescing( void )
+{
+    test_timer_t timers[5];
+    const uint32_t delays_in_ms[5] = { 100, 100, 100, 103, 100 };
+
+    sim_reset( 0 );
+    for( unsigned int i = 0; i < 5; i++ )
+    {
+        test_timer_init( &timers[i], i, delays_in_ms[i] );
+    }
+    // 100 ms is 102 ticks and 103 ms 105 ticks, beyond the slack
+    timers[4].timer.reload_value = 102 + TIMER_LIST_COALESCING_SLACK_IN_TICKS;
+    for( unsigned int i = 0; i < 5; i++ )
+    {
+        timer_start( &timers[i].timer );
+    }
+
+    sim_run_until( 200 );
+
+    // The timers expiring within the slack of the first one run on the same wakeup, earliest first
+    CHECK( log_nb_events == 5 );
+    CHECK( sim.nb_wakeups == 2 );
+    for( unsigned int i = 0; i < log_nb_events; i++ )
+    {
+        const unsigned int id = log_events[i].id;
+
+        CHECK( log_events[i].wakeup == ( ( id == 3 ) ? 2U : 1U ) );
+        if( i > 0 )
+        {
+            CHECK( timers[log_events[i - 1].id].timer.deadline <= timers[id].timer.deadline );
+        }
+    }
+    CHECK( log_events[4].id == 3 );
+    CHECK( log_events[4].time_in_ticks == timers[3].timer.deadline );
+}
+
+static void test_wraparound( void )
+{
+    test_timer_t timers[3];
+
+    // Start right before the 32-bit tick counter wraps, with time flowing between reads
+    sim_reset( 0xFFFFFF00ULL );
+    sim.ticks_per_read = 1;
+
+    test_timer_init( &timers[0], 0, 100 );
+    test_timer_init( &timers[1], 1, 1000 );
+    test_timer_init( &timers[2], 2, 10000 );
+    for( unsigned int i = 0; i < 3; i++ )
+    {
+        timer_start( &timers[i].timer );
+        CHECK( timers[i].timer.deadline > 0xFFFFFF00ULL );
+    }
+    CHECK( timers[1].timer.deadline > 0x100000000ULL );
+
+    sim_run_until( 0x100000000ULL + 20000 );
+
+    // Each alarm lands on the 64-bit deadline even though the alarm reference is a 32-bit tick count
+    CHECK( log_nb_events == 3 );
+    for( unsigned int i = 0; i < log_nb_events; i++ )
+    {
+        CHECK( log_events[i].id == i );
+        CHECK( log_events[i].time_in_ticks == timers[i].timer.deadline );
+    }
+    CHECK( !is_timer_running( ) );
+}
+
+static void test_long_delay( void )
+{
+    test_timer_t   timer;
+    const uint64_t max_alarm_in_ticks = ( 24ULL * 3600 * 1000 * 1024 ) / 1000;
+
+    sim_reset( 0 );
+    test_timer_init( &timer, 0, 3 * 24 * 3600 * 1000 );
+    timer_start( &timer.timer );
+    CHECK( sim.alarm_timeout <= max_alarm_in_ticks );
+
+    // A timer beyond the 24 h alarm range gets intermediate wakeups and still expires on time
+    sim_run_until( timer.timer.deadline );
+    CHECK( log_nb_events == 1 );
+    CHECK( log_events[0].time_in_ticks == timer.timer.deadline );
+    CHECK( sim.nb_wakeups == 3 );
+}
+
+static void test_heap_overflow( void )
+{
+    test_timer_t timers[TIMER_LIST_MAX_NB_TIMERS + 1];
+
+    sim_reset( 0 );
+    for( unsigned int i = 0; i <= TIMER_LIST_MAX_NB_TIMERS; i++ )
+    {
+        // Decreasing delays, so that every insertion sifts up to the top of the heap
+        test_timer_init( &timers[i], i, 1000 - i * 10 );
+    }
+    for( unsigned int i = 0; i < TIMER_LIST_MAX_NB_TIMERS; i++ )
+    {
+        CHECK( timer_start( &timers[i].timer ) );
+    }
+
+    // One timer too many is refused without panicking
+    CHECK( !timer_start( &timers[TIMER_LIST_MAX_NB_TIMERS].timer ) );
+    CHECK( sim.nb_panics == 0 );
+    CHECK( !timer_is_started( &timers[TIMER_LIST_MAX_NB_TIMERS].timer ) );
+    CHECK( sim.critical_nesting == 0 );
+
+    // The queue is unaffected: all the started timers expire, in deadline order
+    sim_run_until( 2000 );
+    CHECK( log_nb_events == TIMER_LIST_MAX_NB_TIMERS );
+    for( unsigned int i = 0; i < log_nb_events; i++ )
+    {
+        CHECK( log_events[i].id == TIMER_LIST_MAX_NB_TIMERS - 1 - i );
+    }
+
+    // Slots are available again
+    CHECK( timer_start( &timers[TIMER_LIST_MAX_NB_TIMERS].timer ) );
+    timer_stop( &timers[TIMER_LIST_MAX_NB_TIMERS].timer );
+}
+
+static void test_random_order( void )
+{
+    test_timer_t timers[TIMER_LIST_MAX_NB_TIMERS];
+
+    srand( 21 );
+    for( unsigned int round = 0; round < 1000; round++ )
+    {
+        sim_reset( ( uint64_t ) rand( ) << 8 );
+        for( unsigned int i = 0; i < TIMER_LIST_MAX_NB_TIMERS; i++ )
+        {
+            test_timer_init( &timers[i], i, 1 + ( rand( ) % 5000 ) );
+            timer_start( &timers[i].timer );
+        }
+        for( unsigned int i = 0; i < TIMER_LIST_MAX_NB_TIMERS / 2; i++ )
+        {
+            timer_stop( &timers[rand( ) % TIMER_LIST_MAX_NB_TIMERS].timer );
+        }
+
+        unsigned int nb_started = 0;
+        for( unsigned int i = 0; i < TIMER_LIST_MAX_NB_TIMERS; i++ )
+        {
+            nb_started += timer_is_started( &timers[i].timer ) ? 1 : 0;
+        }
+
+        sim_run_until( sim.now_in_ticks + 10000 );
+
+        CHECK( log_nb_events == nb_started );
+        for( unsigned int i = 0; i < log_nb_events; i++ )
+        {
+            const timer_event_t* timer = &timers[log_events[i].id].timer;
+
+            // Never earlier than the coalescing slack, and late only when the RTC cannot wake up in time
+            CHECK( log_events[i].time_in_ticks + TIMER_LIST_COALESCING_SLACK_IN_TICKS >= timer->deadline );
+            CHECK( log_events[i].time_in_ticks < timer->deadline + SIM_MIN_TIMEOUT_IN_TICKS );
+            if( i > 0 )
+            {
+                CHECK( timers[log_events[i - 1].id].timer.deadline <= timer->deadline );
+            }
+        }
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- SIMULATED HAL -----------------------------------------------------------
+ */
+
+void hal_mcu_critical_section_begin( uint32_t* mask )
+{
+    *mask = 0;
+    sim.critical_nesting++;
+}
+
+void hal_mcu_critical_section_end( uint32_t* mask )
+{
+    ( void ) mask;
+    sim.critical_nesting--;
+}
+
+void hal_mcu_panic( void ) { sim.nb_panics++; }
+
+uint64_t hal_rtc_get_timer_value_64( void )
+{
+    sim.now_in_ticks += sim.ticks_per_read;
+    return sim.now_in_ticks;
+}
+
+uint32_t hal_rtc_get_timer_value( void ) { return ( uint32_t ) hal_rtc_get_timer_value_64( ); }
+
+uint32_t hal_rtc_set_time_ref_in_ticks( void )
+{
+    sim.time_ref_in_ticks = hal_rtc_get_timer_value_64( );
+    return ( uint32_t ) sim.time_ref_in_ticks;
+}
+
+void hal_rtc_start_alarm( uint32_t timeout )
+{
+    sim.alarm_is_armed = true;
+    sim.alarm_timeout  = timeout;
+    sim.alarm_in_ticks = sim.time_ref_in_ticks + timeout;
+}
+
+void hal_rtc_stop_alarm( void ) { sim.alarm_is_armed = false; }
+
+uint32_t hal_rtc_get_minimum_timeout( void ) { return SIM_MIN_TIMEOUT_IN_TICKS; }
+
+uint32_t hal_rtc_ms_2_tick( const uint32_t milliseconds )
+{
+    return ( uint32_t ) ( ( ( uint64_t ) milliseconds << 10 ) / 1000 );
+}
+
+uint32_t hal_rtc_tick_2_ms( const uint32_t tick ) { return ( uint32_t ) ( ( ( uint64_t ) tick * 1000 ) >> 10 ); }
+
+uint32_t hal_rtc_temp_compensation( uint32_t period, float temperature )
+{
+    ( void ) temperature;
+    return period;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+int main( void )
+{
+    test_insert_remove_rearm( );
+    test_coalescing( );
+    test_wraparound( );
+    test_long_delay( );
+    test_heap_overflow( );
+    test_random_order( );
+
+    printf( "%u checks, %u failures\n", nb_checks, nb_failures );
+
+    return ( nb_failures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -73,6 +73,11 @@ extern "C" {
 #define HAL_HW_DEBUG_PROBE                          HAL_FEATURE_OFF
 
 #define HAL_USE_PRINTF_UART                         HAL_FEATURE_ON
+
+/* Baud rate of the UART receiving the printf output */
+#ifndef HAL_PRINTF_UART_BAUDRATE
+#define HAL_PRINTF_UART_BAUDRATE                    115200
+#endif // HAL_PRINTF_UART_BAUDRATE
 #define HAL_PRINT_BUFFER_SIZE                       255
 
 /* HAL_FEATURE_OFF to not use watchdog */
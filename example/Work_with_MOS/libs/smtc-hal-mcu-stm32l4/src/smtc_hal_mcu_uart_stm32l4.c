@@ -43,6 +43,7 @@
 #include "stm32l4xx_ll_usart.h"
 #include "stm32l4xx_ll_gpio.h"
 #include "stm32l4xx_ll_bus.h"
+#include "stm32l4xx_ll_dma.h"
 #include <stddef.h>
 #include <stdbool.h>
 
@@ -58,6 +59,20 @@
 #define SMTC_HAL_MCU_UART_STM32L4_N_INSTANCES_MAX 1
 #endif
 
+/**
+ * @brief NVIC priority of the DMA transmission channel interrupt
+ *
+ * @remark Transmissions are not time critical, the interrupt is kept below the radio-related ones
+ */
+#ifndef SMTC_HAL_MCU_UART_STM32L4_DMA_IRQ_PRIORITY
+#define SMTC_HAL_MCU_UART_STM32L4_DMA_IRQ_PRIORITY 14
+#endif
+
+/**
+ * @brief Get the DMA interrupt flags of a channel, shifted to the channel 1 position
+ */
+#define SMTC_HAL_MCU_UART_STM32L4_DMA_FLAGS( dma, channel ) ( ( ( dma )->ISR >> ( ( channel ) * 4U ) ) & 0x0FU )
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE CONSTANTS -------------------------------------------------------
@@ -73,9 +88,15 @@
  */
 struct smtc_hal_mcu_uart_inst_s
 {
-    bool           is_cfged;
-    USART_TypeDef* usart;
-    void ( *callback_rx )( uint8_t data );
+    bool                              is_cfged;
+    USART_TypeDef*                    usart;
+    void                              ( *callback_rx )( uint8_t data );
+    DMA_TypeDef*                      dma;  //!< DMA used for asynchronous transmissions - NULL if none is available
+    uint32_t                          tx_channel;
+    IRQn_Type                         tx_irq_number;
+    volatile bool                     is_busy;
+    smtc_hal_mcu_uart_done_callback_t callback_tx;
+    void*                             callback_tx_context;
 };
 
 /*
@@ -110,6 +131,22 @@ static struct smtc_hal_mcu_uart_inst_s* smtc_hal_mcu_uart_stm32l4_get_free_slot(
  */
 static bool smtc_hal_mcu_uart_stm32l4_is_real_inst( smtc_hal_mcu_uart_inst_t inst );
 
+/**
+ * @brief Get the DMA transmission channel attached to a UART peripheral and configure it
+ *
+ * @remark The instance is left without DMA if no channel is available for the peripheral
+ *
+ * @param [in] inst UART instance
+ */
+static void smtc_hal_mcu_uart_stm32l4_dma_init( smtc_hal_mcu_uart_inst_t inst );
+
+/**
+ * @brief Complete the ongoing asynchronous transmission if the DMA transmission channel is done with it
+ *
+ * @param [in] inst UART instance
+ */
+static void smtc_hal_mcu_uart_stm32l4_dma_complete( smtc_hal_mcu_uart_inst_t inst );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -178,6 +215,8 @@ smtc_hal_mcu_status_t smtc_hal_mcu_uart_init( const smtc_hal_mcu_uart_cfg_t
 
     LL_USART_EnableIT_RXNE( uart_cfg_slot->usart );
 
+    smtc_hal_mcu_uart_stm32l4_dma_init( uart_cfg_slot );
+
     uart_cfg_slot->is_cfged = true;
 
     *inst = uart_cfg_slot;
@@ -199,6 +238,14 @@ smtc_hal_mcu_status_t smtc_hal_mcu_uart_deinit( smtc_hal_mcu_uart_inst_t* inst )
         return SMTC_HAL_MCU_STATUS_NOT_INIT;
     }
 
+    if( inst_local->dma != NULL )
+    {
+        NVIC_DisableIRQ( inst_local->tx_irq_number );
+        LL_DMA_DisableChannel( inst_local->dma, inst_local->tx_channel );
+        LL_USART_DisableDMAReq_TX( inst_local->usart );
+        inst_local->is_busy = false;
+    }
+
     LL_USART_Disable( inst_local->usart );
     while( LL_USART_IsEnabled( inst_local->usart ) != 0 )
     {
@@ -244,6 +291,12 @@ smtc_hal_mcu_status_t smtc_hal_mcu_uart_send( smtc_hal_mcu_uart_inst_t inst, con
         return SMTC_HAL_MCU_STATUS_OK;
     }
 
+    // Bytes must not be interleaved with the ones of an asynchronous transmission
+    while( inst->is_busy == true )
+    {
+        smtc_hal_mcu_uart_poll( inst );
+    }
+
     while( data_remaining > 0 )
     {
         while( !LL_USART_IsActiveFlag_TXE( inst->usart ) )
@@ -272,6 +325,60 @@ smtc_hal_mcu_status_t smtc_hal_mcu_uart_receive( smtc_hal_mcu_uart_inst_t inst,
     return SMTC_HAL_MCU_STATUS_OK;
 }
 
+smtc_hal_mcu_status_t smtc_hal_mcu_uart_send_async( smtc_hal_mcu_uart_inst_t inst, const uint8_t* buffer,
+                                                    unsigned int length, smtc_hal_mcu_uart_done_callback_t callback,
+                                                    void* context )
+{
+    if( smtc_hal_mcu_uart_stm32l4_is_real_inst( inst ) == false )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( inst->is_cfged == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    if( ( inst->dma == NULL ) || ( buffer == NULL ) || ( length == 0 ) || ( length > UINT16_MAX ) )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( inst->is_busy == true )
+    {
+        return SMTC_HAL_MCU_STATUS_ERROR;
+    }
+
+    inst->is_busy             = true;
+    inst->callback_tx         = callback;
+    inst->callback_tx_context = context;
+
+    WRITE_REG( inst->dma->IFCR, DMA_IFCR_CGIF1 << ( inst->tx_channel * 4U ) );
+
+    LL_DMA_SetMemoryAddress( inst->dma, inst->tx_channel, ( uint32_t ) buffer );
+    LL_DMA_SetDataLength( inst->dma, inst->tx_channel, length );
+
+    LL_DMA_EnableChannel( inst->dma, inst->tx_channel );
+    LL_USART_EnableDMAReq_TX( inst->usart );
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+bool smtc_hal_mcu_uart_is_busy( smtc_hal_mcu_uart_inst_t inst ) { return inst->is_busy; }
+
+void smtc_hal_mcu_uart_poll( smtc_hal_mcu_uart_inst_t inst )
+{
+    if( ( inst->dma == NULL ) || ( inst->is_busy == false ) )
+    {
+        return;
+    }
+
+    // Keep the interrupt from completing the same transmission concurrently
+    NVIC_DisableIRQ( inst->tx_irq_number );
+    smtc_hal_mcu_uart_stm32l4_dma_complete( inst );
+    NVIC_EnableIRQ( inst->tx_irq_number );
+}
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
@@ -303,6 +410,61 @@ static bool smtc_hal_mcu_uart_stm32l4_is_real_inst( smtc_hal_mcu_uart_inst_t ins
     return false;
 }
 
+static void smtc_hal_mcu_uart_stm32l4_dma_init( smtc_hal_mcu_uart_inst_t inst )
+{
+    inst->dma     = NULL;
+    inst->is_busy = false;
+
+    if( inst->usart == USART2 )
+    {
+        LL_AHB1_GRP1_EnableClock( LL_AHB1_GRP1_PERIPH_DMA1 );
+
+        inst->dma           = DMA1;
+        inst->tx_channel    = LL_DMA_CHANNEL_7;
+        inst->tx_irq_number = DMA1_Channel7_IRQn;
+        LL_DMA_SetPeriphRequest( inst->dma, inst->tx_channel, LL_DMA_REQUEST_2 );
+    }
+    else
+    {
+        return;
+    }
+
+    // Lowest channel priority, the radio SPI transfers go first
+    LL_DMA_ConfigTransfer( inst->dma, inst->tx_channel,
+                           LL_DMA_DIRECTION_MEMORY_TO_PERIPH | LL_DMA_PRIORITY_LOW | LL_DMA_MODE_NORMAL |
+                               LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT | LL_DMA_PDATAALIGN_BYTE |
+                               LL_DMA_MDATAALIGN_BYTE );
+    LL_DMA_SetPeriphAddress( inst->dma, inst->tx_channel,
+                             LL_USART_DMA_GetRegAddr( inst->usart, LL_USART_DMA_REG_DATA_TRANSMIT ) );
+    LL_DMA_EnableIT_TC( inst->dma, inst->tx_channel );
+    LL_DMA_EnableIT_TE( inst->dma, inst->tx_channel );
+
+    NVIC_SetPriority( inst->tx_irq_number, SMTC_HAL_MCU_UART_STM32L4_DMA_IRQ_PRIORITY );
+    NVIC_EnableIRQ( inst->tx_irq_number );
+}
+
+static void smtc_hal_mcu_uart_stm32l4_dma_complete( smtc_hal_mcu_uart_inst_t inst )
+{
+    const uint32_t flags = SMTC_HAL_MCU_UART_STM32L4_DMA_FLAGS( inst->dma, inst->tx_channel );
+
+    if( ( flags & ( DMA_ISR_TCIF1 | DMA_ISR_TEIF1 ) ) == 0 )
+    {
+        return;
+    }
+
+    LL_USART_DisableDMAReq_TX( inst->usart );
+    LL_DMA_DisableChannel( inst->dma, inst->tx_channel );
+    WRITE_REG( inst->dma->IFCR, DMA_IFCR_CGIF1 << ( inst->tx_channel * 4U ) );
+
+    inst->is_busy = false;
+
+    // The callback is allowed to start the next transmission
+    if( inst->callback_tx != NULL )
+    {
+        inst->callback_tx( inst->callback_tx_context );
+    }
+}
+
 void USART2_IRQHandler( void )
 {
     /* Check RXNE flag value in ISR register */
@@ -326,4 +488,16 @@ void USART2_IRQHandler( void )
     }
 }
 
+void DMA1_Channel7_IRQHandler( void )
+{
+    for( int i = 0; i < SMTC_HAL_MCU_UART_STM32L4_N_INSTANCES_MAX; i++ )
+    {
+        if( ( uart_inst_array[i].dma == DMA1 ) && ( uart_inst_array[i].tx_channel == LL_DMA_CHANNEL_7 ) )
+        {
+            smtc_hal_mcu_uart_stm32l4_dma_complete( &uart_inst_array[i] );
+            break;
+        }
+    }
+}
+
 /* --- EOF ------------------------------------------------------------------ */
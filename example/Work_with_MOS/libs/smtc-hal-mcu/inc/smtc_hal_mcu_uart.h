@@ -46,6 +46,7 @@ extern "C" {
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "smtc_hal_mcu_status.h"
 
 /*
@@ -86,6 +87,15 @@ typedef struct smtc_hal_mcu_uart_cfg_app_s
     void ( *callback_rx )( uint8_t data );
 } smtc_hal_mcu_uart_cfg_app_t;
 
+/**
+ * @brief UART asynchronous transmission completion callback definition
+ *
+ * @remark Called from interrupt context, or from @ref smtc_hal_mcu_uart_poll
+ *
+ * @param [in] context Context given when the transmission was started
+ */
+typedef void ( *smtc_hal_mcu_uart_done_callback_t )( void* context );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
@@ -152,6 +162,49 @@ smtc_hal_mcu_status_t smtc_hal_mcu_uart_send( smtc_hal_mcu_uart_inst_t uart, con
  */
 smtc_hal_mcu_status_t smtc_hal_mcu_uart_receive( smtc_hal_mcu_uart_inst_t uart, uint8_t* buffer, unsigned int length );
 
+/**
+ * @brief Start sending bytes over a UART peripheral
+ *
+ * @remark The function returns as soon as the transmission is started. @p buffer must remain valid until @p callback
+ * is called.
+ *
+ * @param [in] uart UART instance
+ * @param [in] buffer Pointer to input buffer. It is up to the caller to ensure @p buffer is at least @p length byte
+ * long
+ * @param [in] length Number of bytes to send - 65535 at most
+ * @param [in] callback Function called once all bytes are handed over to the peripheral - can be NULL
+ * @param [in] context Context given back to @p callback
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK The transmission has been started
+ * @retval SMTC_HAL_MCU_STATUS_BAD_PARAMETERS The operation failed because at least one parameter is incorrect - or
+ * the peripheral does not support asynchronous transmissions
+ * @retval SMTC_HAL_MCU_STATUS_NOT_INIT The operation failed as the @p uart is not initialised
+ * @retval SMTC_HAL_MCU_STATUS_ERROR The operation failed because a transmission is ongoing
+ */
+smtc_hal_mcu_status_t smtc_hal_mcu_uart_send_async( smtc_hal_mcu_uart_inst_t uart, const uint8_t* buffer,
+                                                    unsigned int length, smtc_hal_mcu_uart_done_callback_t callback,
+                                                    void* context );
+
+/**
+ * @brief Check whether an asynchronous transmission is ongoing on a UART peripheral
+ *
+ * @param [in] uart UART instance
+ *
+ * @retval true A transmission started with @ref smtc_hal_mcu_uart_send_async is ongoing
+ * @retval false No transmission is ongoing
+ */
+bool smtc_hal_mcu_uart_is_busy( smtc_hal_mcu_uart_inst_t uart );
+
+/**
+ * @brief Complete the ongoing asynchronous transmission if the peripheral is done with it
+ *
+ * @remark To be called in a loop where the completion interrupt cannot run, e.g. from a fault handler. The completion
+ * callback is called from this function in that case.
+ *
+ * @param [in] uart UART instance
+ */
+void smtc_hal_mcu_uart_poll( smtc_hal_mcu_uart_inst_t uart );
+
 #ifdef __cplusplus
 }
 #endif
@@ -104,11 +104,12 @@ $(TOP_DIR)/lr11xx/common/apps_version.c \
 $(TOP_DIR)/common/src/smtc_hal_dbg_trace.c \
 $(TOP_DIR)/common/src/common_version.c \
 $(TOP_DIR)/common/src/smtc_shield_pinout_mapping.c \
-$(TOP_DIR)/common/src/uart_init.c \
+$(TOP_DIR)/../common/src/uart_init.c \
 
 C_INCLUDES +=  \
 -I$(TOP_DIR)/lr11xx/common \
--I$(TOP_DIR)/common/inc
+-I$(TOP_DIR)/common/inc \
+-I$(TOP_DIR)/../common/inc
 
 ifneq (,$(findstring LR1110,$(RADIO_SHIELD)))
 TRX_IS_GEOLOCATION_CAPABLE = true
@@ -160,7 +160,7 @@ lr11xx_hal_status_t lr11xx_hal_read( const void* context, const uint8_t* command
     smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
 
 #if defined( USE_LR11XX_CRC_OVER_SPI )
-    uint8_t crc_computed = lr11xx_hal_compute_crc( 0xFF, &dummy, 1 );
+    uint8_t crc_computed = lr11xx_hal_compute_crc( 0xFF, &dummy_byte_rx, 1 );
     crc_computed         = lr11xx_hal_compute_crc( crc_computed, data, data_length );
     if( crc_rx != crc_computed )
     {
@@ -188,7 +188,7 @@ lr11xx_hal_status_t lr11xx_hal_direct_read( const void* radio, uint8_t* data, co
 #if defined( USE_LR11XX_CRC_OVER_SPI )
     // check crc value
     uint8_t crc_computed = lr11xx_hal_compute_crc( 0xFF, data, data_length );
-    if( rx_crc != crc_computed )
+    if( crc_rx != crc_computed )
     {
         return LR11XX_HAL_STATUS_ERROR;
     }
@@ -0,0 +1,155 @@
+/*!
+ * @file      smtc_busy_stats.h
+ *
+ * @brief     Per-opcode statistics of the time a radio stays busy after its commands
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMTC_BUSY_STATS_H
+#define SMTC_BUSY_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Number of opcodes that can be tracked - must be a power of two
+ */
+#ifndef SMTC_BUSY_STATS_OPCODES_MAX
+#define SMTC_BUSY_STATS_OPCODES_MAX ( 32 )
+#endif
+
+/**
+ * @brief Opcode value used when no command has been sent yet, or for a direct read
+ */
+#define SMTC_BUSY_STATS_OPCODE_NONE ( 0xFFFF )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Busy time statistics of one opcode
+ */
+typedef struct smtc_busy_stats_entry_s
+{
+    uint16_t opcode;    //!< Opcode of the command that made the chip busy
+    uint32_t count;     //!< Number of commands timed - 0 for an unused entry
+    uint32_t min_us;    //!< Shortest busy time in microseconds
+    uint32_t max_us;    //!< Longest busy time in microseconds
+    uint32_t total_us;  //!< Sum of the busy times in microseconds
+} smtc_busy_stats_entry_t;
+
+/**
+ * @brief Busy time statistics table
+ *
+ * Entries are placed by hashing the opcode, so that the lookup done after each command does not scan the table.
+ */
+typedef struct smtc_busy_stats_s
+{
+    smtc_busy_stats_entry_t entries[SMTC_BUSY_STATS_OPCODES_MAX];
+    uint32_t                      nb_dropped;   //!< Busy times not recorded because the table is full
+    uint32_t                      nb_timeouts;  //!< Busy waits aborted on timeout
+} smtc_busy_stats_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Clear all the statistics
+ *
+ * @param [out] stats Statistics table
+ */
+void smtc_busy_stats_reset( smtc_busy_stats_t* stats );
+
+/**
+ * @brief Get the opcode of a command
+ *
+ * @param [in] command Command buffer
+ * @param [in] command_length Command length in bytes
+ *
+ * @returns Opcode, or SMTC_BUSY_STATS_OPCODE_NONE if the command is shorter than an opcode
+ */
+uint16_t smtc_busy_stats_get_opcode( const uint8_t* command, uint16_t command_length );
+
+/**
+ * @brief Record the time the chip stayed busy after a command
+ *
+ * @param [in,out] stats Statistics table
+ * @param [in] opcode Opcode of the command that made the chip busy
+ * @param [in] duration_us Busy time in microseconds
+ */
+void smtc_busy_stats_record( smtc_busy_stats_t* stats, uint16_t opcode, uint32_t duration_us );
+
+/**
+ * @brief Record a busy wait aborted on timeout
+ *
+ * @param [in,out] stats Statistics table
+ */
+void smtc_busy_stats_record_timeout( smtc_busy_stats_t* stats );
+
+/**
+ * @brief Get the statistics of an opcode
+ *
+ * @param [in] stats Statistics table
+ * @param [in] opcode Opcode to look for
+ *
+ * @returns Pointer to the opcode statistics, or NULL if nothing was recorded for it
+ */
+const smtc_busy_stats_entry_t* smtc_busy_stats_get( const smtc_busy_stats_t* stats,
+                                                                uint16_t                       opcode );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // SMTC_BUSY_STATS_H
+
+/* --- EOF ------------------------------------------------------------------ */
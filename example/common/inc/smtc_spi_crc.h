@@ -1,10 +1,10 @@
 /*!
- * @file      uart_init.h
+ * @file      smtc_spi_crc.h
  *
- * @brief     UART initialization helper functions
+ * @brief     CRC8 protecting the SPI frames of the LR11xx radios
  *
  * The Clear BSD License
- * Copyright Semtech Corporation 2023. All rights reserved.
+ * Copyright Semtech Corporation 2024. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted (subject to the limitations in the disclaimer
@@ -32,8 +32,8 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef UART_INIT_H
-#define UART_INIT_H
+#ifndef SMTC_SPI_CRC_H
+#define SMTC_SPI_CRC_H
 
 #ifdef __cplusplus
 extern "C" {
@@ -45,8 +45,6 @@ extern "C" {
  */
 
 #include <stdint.h>
-#include <stdarg.h>
-#include "smtc_hal_mcu_uart.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -58,6 +56,11 @@ extern "C" {
  * --- PUBLIC CONSTANTS --------------------------------------------------------
  */
 
+/**
+ * @brief Initial value of the CRC computed over a SPI frame
+ */
+#define SMTC_SPI_CRC_INITIAL_VALUE ( 0xFF )
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC TYPES ------------------------------------------------------------
@@ -69,29 +72,30 @@ extern "C" {
  */
 
 /**
- * @brief Initialise UART peripheral
+ * @brief Fold a buffer into a CRC
  *
- * @see uart_init_with_rx_callback
+ * @param [in] crc Current CRC value - SMTC_SPI_CRC_INITIAL_VALUE to start a new computation
+ * @param [in] buffer Buffer to fold in
+ * @param [in] length Length of the buffer
+ *
+ * @returns Updated CRC value
  */
-void uart_init( void );
+uint8_t smtc_spi_crc_update( uint8_t crc, const uint8_t* buffer, uint16_t length );
 
 /**
- * @brief Initialize UART peripheral with RX callback for interrupt-based reception
- *
- * Calling with callback_tx:=NULL is equivalent to uart_init() call.
+ * @brief Fold one byte into a CRC, so that the CRC can be computed while the bytes are clocked out
  *
- * @param[in] callback_rx The callback called when one byte is received.
+ * @param [in] crc Current CRC value - SMTC_SPI_CRC_INITIAL_VALUE to start a new computation
+ * @param [in] data Byte to fold in
  *
- * @see uart_init
+ * @returns Updated CRC value
  */
-void uart_init_with_rx_callback( void ( *callback_rx )( uint8_t data ) );
-
-void vprint( const char* fmt, va_list argp );
+uint8_t smtc_spi_crc_update_byte( uint8_t crc, uint8_t data );
 
 #ifdef __cplusplus
 }
 #endif
 
-#endif  // UART_INIT_H
+#endif  // SMTC_SPI_CRC_H
 
 /* --- EOF ------------------------------------------------------------------ */
@@ -86,8 +86,41 @@ void uart_init( void );
  */
 void uart_init_with_rx_callback( void ( *callback_rx )( uint8_t data ) );
 
+/**
+ * @brief Format a message and queue it for transmission
+ *
+ * @remark The message is sent in the background. It is dropped if there is not enough room left to queue it whole.
+ * Not to be called from interrupt context.
+ *
+ * @param[in] fmt Format string
+ * @param[in] argp Arguments of the format string
+ */
 void vprint( const char* fmt, va_list argp );
 
+/**
+ * @brief Queue raw bytes for transmission
+ *
+ * @remark Same queueing rules as vprint: the bytes are sent in the background, or dropped all together.
+ *
+ * @param[in] data Bytes to send
+ * @param[in] length Number of bytes
+ */
+void uart_write( const uint8_t* data, uint32_t length );
+
+/**
+ * @brief Send all the queued messages before returning
+ *
+ * @remark Works with interrupts disabled, e.g. from a fault handler
+ */
+void uart_flush( void );
+
+/**
+ * @brief Get the number of messages dropped because the transmission queue was full
+ *
+ * @returns Number of messages dropped
+ */
+uint32_t uart_get_nb_dropped( void );
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,10 +1,10 @@
 /*!
- * @file      uart_init.c
+ * @file      smtc_busy_stats.c
  *
- * @brief     UART init helper functions implementation
+ * @brief     Per-opcode statistics of the time a radio stays busy after its commands
  *
  * The Clear BSD License
- * Copyright Semtech Corporation 2023. All rights reserved.
+ * Copyright Semtech Corporation 2024. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted (subject to the limitations in the disclaimer
@@ -36,12 +36,10 @@
  * -----------------------------------------------------------------------------
  * --- DEPENDENCIES ------------------------------------------------------------
  */
+
 #include <stddef.h>
 #include <string.h>
-#include <stdio.h>
-#include "uart_init.h"
-#include "stm32l4xx.h"
-#include "smtc_hal_mcu_uart_stm32l4.h"
+#include "smtc_busy_stats.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -53,6 +51,10 @@
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
 
+#if( ( SMTC_BUSY_STATS_OPCODES_MAX & ( SMTC_BUSY_STATS_OPCODES_MAX - 1 ) ) != 0 )
+#error "SMTC_BUSY_STATS_OPCODES_MAX must be a power of two"
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
@@ -63,42 +65,83 @@
  * --- PRIVATE VARIABLES -------------------------------------------------------
  */
 
-static smtc_hal_mcu_uart_inst_t inst_uart = NULL;
-
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
  */
 
 /**
- * @brief Base function to initialize UART peripheral
+ * @brief Find the entry of an opcode, or the free entry where it can be inserted
+ *
+ * @param [in] stats Statistics table
+ * @param [in] opcode Opcode to look for
  *
- * @param callback_rx The callback called on RX byte reception. Can be NULL
+ * @returns Index of the entry, or SMTC_BUSY_STATS_OPCODES_MAX if the opcode is absent and the table is full
  */
-void uart_init_base( void ( *callback_rx )( uint8_t data ) );
+static uint16_t smtc_busy_stats_find( const smtc_busy_stats_t* stats, uint16_t opcode );
 
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
  */
 
-void uart_init( void )
+void smtc_busy_stats_reset( smtc_busy_stats_t* stats ) { memset( stats, 0, sizeof( *stats ) ); }
+
+uint16_t smtc_busy_stats_get_opcode( const uint8_t* command, uint16_t command_length )
 {
-    uart_init_base( NULL );
+    if( ( command == NULL ) || ( command_length < 2 ) )
+    {
+        return SMTC_BUSY_STATS_OPCODE_NONE;
+    }
+
+    return ( uint16_t ) ( ( ( uint16_t ) command[0] << 8 ) | command[1] );
 }
 
-void uart_init_with_rx_callback( void ( *callback_rx )( uint8_t data ) )
+void smtc_busy_stats_record( smtc_busy_stats_t* stats, uint16_t opcode, uint32_t duration_us )
 {
-    uart_init_base( callback_rx );
+    const uint16_t index = smtc_busy_stats_find( stats, opcode );
+
+    if( index == SMTC_BUSY_STATS_OPCODES_MAX )
+    {
+        stats->nb_dropped++;
+        return;
+    }
+
+    smtc_busy_stats_entry_t* entry = &stats->entries[index];
+
+    if( entry->count == 0 )
+    {
+        entry->opcode   = opcode;
+        entry->min_us   = duration_us;
+        entry->max_us   = duration_us;
+        entry->total_us = 0;
+    }
+    else if( duration_us < entry->min_us )
+    {
+        entry->min_us = duration_us;
+    }
+    else if( duration_us > entry->max_us )
+    {
+        entry->max_us = duration_us;
+    }
+
+    entry->count++;
+    entry->total_us += duration_us;
 }
 
-void vprint( const char* fmt, va_list argp )
+void smtc_busy_stats_record_timeout( smtc_busy_stats_t* stats ) { stats->nb_timeouts++; }
+
+const smtc_busy_stats_entry_t* smtc_busy_stats_get( const smtc_busy_stats_t* stats,
+                                                                uint16_t                       opcode )
 {
-    char string[255];
-    if( 0 < vsprintf( string, fmt, argp ) )  // build string
+    const uint16_t index = smtc_busy_stats_find( stats, opcode );
+
+    if( ( index == SMTC_BUSY_STATS_OPCODES_MAX ) || ( stats->entries[index].count == 0 ) )
     {
-        smtc_hal_mcu_uart_send( inst_uart, ( uint8_t* ) string, strlen( string ) );
+        return NULL;
     }
+
+    return &stats->entries[index];
 }
 
 /*
@@ -106,16 +149,25 @@ void vprint( const char* fmt, va_list argp )
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
  */
 
-void uart_init_base( void ( *callback_rx )( uint8_t data ) )
+static uint16_t smtc_busy_stats_find( const smtc_busy_stats_t* stats, uint16_t opcode )
 {
-    const struct smtc_hal_mcu_uart_cfg_s cfg_uart = {
-        .usart = USART2,
-    };
-    const smtc_hal_mcu_uart_cfg_app_t uart_cfg_app = {
-        .baudrate    = 115200,
-        .callback_rx = callback_rx,
-    };
-    smtc_hal_mcu_uart_init( ( const smtc_hal_mcu_uart_cfg_t ) &cfg_uart, &uart_cfg_app, &inst_uart );
+    // Opcodes share few values in their upper byte, fold it on the lower one before masking
+    uint16_t index = ( uint16_t ) ( ( opcode ^ ( opcode >> 8 ) ) & ( SMTC_BUSY_STATS_OPCODES_MAX - 1 ) );
+
+    // Linear probing, entries are never removed so that the first free slot ends the search
+    for( uint16_t i = 0; i < SMTC_BUSY_STATS_OPCODES_MAX; i++ )
+    {
+        const smtc_busy_stats_entry_t* entry = &stats->entries[index];
+
+        if( ( entry->count == 0 ) || ( entry->opcode == opcode ) )
+        {
+            return index;
+        }
+
+        index = ( index + 1 ) & ( SMTC_BUSY_STATS_OPCODES_MAX - 1 );
+    }
+
+    return SMTC_BUSY_STATS_OPCODES_MAX;
 }
 
 /* --- EOF ------------------------------------------------------------------ */
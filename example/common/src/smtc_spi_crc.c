@@ -1,10 +1,10 @@
 /*!
- * @file      uart_init.c
+ * @file      smtc_spi_crc.c
  *
- * @brief     UART init helper functions implementation
+ * @brief     CRC8 protecting the SPI frames of the LR11xx radios
  *
  * The Clear BSD License
- * Copyright Semtech Corporation 2023. All rights reserved.
+ * Copyright Semtech Corporation 2024. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted (subject to the limitations in the disclaimer
@@ -36,12 +36,8 @@
  * -----------------------------------------------------------------------------
  * --- DEPENDENCIES ------------------------------------------------------------
  */
-#include <stddef.h>
-#include <string.h>
-#include <stdio.h>
-#include "uart_init.h"
-#include "stm32l4xx.h"
-#include "smtc_hal_mcu_uart_stm32l4.h"
+
+#include "smtc_spi_crc.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -53,6 +49,15 @@
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
 
+/**
+ * @brief CRC of every nibble value, processed LSB first with the reflected polynomial 0x65
+ *
+ * Two lookups per byte - 16 bytes of flash instead of 256 for a byte-wide table
+ */
+static const uint8_t smtc_spi_crc_table[16] = {
+    0x00, 0x27, 0x4E, 0x69, 0x57, 0x70, 0x19, 0x3E, 0x65, 0x42, 0x2B, 0x0C, 0x32, 0x15, 0x7C, 0x5B,
+};
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
@@ -63,42 +68,33 @@
  * --- PRIVATE VARIABLES -------------------------------------------------------
  */
 
-static smtc_hal_mcu_uart_inst_t inst_uart = NULL;
-
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
  */
 
-/**
- * @brief Base function to initialize UART peripheral
- *
- * @param callback_rx The callback called on RX byte reception. Can be NULL
- */
-void uart_init_base( void ( *callback_rx )( uint8_t data ) );
-
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
  */
 
-void uart_init( void )
+uint8_t smtc_spi_crc_update( uint8_t crc, const uint8_t* buffer, uint16_t length )
 {
-    uart_init_base( NULL );
-}
+    for( uint16_t i = 0; i < length; i++ )
+    {
+        crc = smtc_spi_crc_update_byte( crc, buffer[i] );
+    }
 
-void uart_init_with_rx_callback( void ( *callback_rx )( uint8_t data ) )
-{
-    uart_init_base( callback_rx );
+    return crc;
 }
 
-void vprint( const char* fmt, va_list argp )
+uint8_t smtc_spi_crc_update_byte( uint8_t crc, uint8_t data )
 {
-    char string[255];
-    if( 0 < vsprintf( string, fmt, argp ) )  // build string
-    {
-        smtc_hal_mcu_uart_send( inst_uart, ( uint8_t* ) string, strlen( string ) );
-    }
+    crc ^= data;
+    crc = ( crc >> 4 ) ^ smtc_spi_crc_table[crc & 0x0F];
+    crc = ( crc >> 4 ) ^ smtc_spi_crc_table[crc & 0x0F];
+
+    return crc;
 }
 
 /*
@@ -106,16 +102,4 @@ void vprint( const char* fmt, va_list argp )
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
  */
 
-void uart_init_base( void ( *callback_rx )( uint8_t data ) )
-{
-    const struct smtc_hal_mcu_uart_cfg_s cfg_uart = {
-        .usart = USART2,
-    };
-    const smtc_hal_mcu_uart_cfg_app_t uart_cfg_app = {
-        .baudrate    = 921600,
-        .callback_rx = callback_rx,
-    };
-    smtc_hal_mcu_uart_init( ( const smtc_hal_mcu_uart_cfg_t ) &cfg_uart, &uart_cfg_app, &inst_uart );
-}
-
 /* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,307 @@
+/*!
+ * @file      uart_init.c
+ *
+ * @brief     UART init helper functions implementation
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2023. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include "uart_init.h"
+#include "smtc_hal_options.h"
+#include "stm32l4xx.h"
+#include "smtc_hal_mcu_uart_stm32l4.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/**
+ * @brief Size of the buffer holding the formatted messages waiting to be sent - must be a power of two
+ */
+#ifndef UART_INIT_TX_FIFO_SIZE
+#define UART_INIT_TX_FIFO_SIZE 2048
+#endif
+
+/**
+ * @brief Maximum length of a formatted message - longer ones are truncated
+ */
+#ifndef UART_INIT_MSG_LENGTH_MAX
+#define UART_INIT_MSG_LENGTH_MAX 255
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#if( ( UART_INIT_TX_FIFO_SIZE & ( UART_INIT_TX_FIFO_SIZE - 1 ) ) != 0 )
+#error "UART_INIT_TX_FIFO_SIZE must be a power of two"
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static smtc_hal_mcu_uart_inst_t inst_uart = NULL;
+
+/**
+ * @brief Messages waiting to be sent
+ *
+ * Single producer - vprint and uart_write, from thread mode - and single consumer - the transmission, started either
+ * by the producer when the UART is idle or by the completion of the previous chunk. Indexes are free running, each side
+ * only writes its own one.
+ */
+static struct
+{
+    uint8_t           buffer[UART_INIT_TX_FIFO_SIZE];
+    volatile uint32_t head;        //!< Next byte to write - only written by the producer
+    volatile uint32_t tail;        //!< Next byte to send - only written by the consumer
+    volatile uint32_t chunk;       //!< Number of bytes being sent from tail
+    volatile uint32_t nb_dropped;  //!< Messages dropped because the buffer was full
+} tx_fifo;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Base function to initialize UART peripheral
+ *
+ * @param callback_rx The callback called on RX byte reception. Can be NULL
+ */
+void uart_init_base( void ( *callback_rx )( uint8_t data ) );
+
+/**
+ * @brief Queue a message whole, or drop it if there is not enough room left, and start the transmission if idle
+ *
+ * @param[in] data Message
+ * @param[in] length Message length in bytes
+ */
+static void uart_tx_fifo_push( const uint8_t* data, uint32_t length );
+
+/**
+ * @brief Send the next contiguous chunk of pending bytes, if any
+ *
+ * @remark Must only be called while no transmission is ongoing
+ */
+static void uart_tx_fifo_send_next( void );
+
+/**
+ * @brief Transmission completion callback - release the chunk sent and start the next one
+ *
+ * @param[in] context Unused
+ */
+static void uart_tx_fifo_on_sent( void* context );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void uart_init( void )
+{
+    uart_init_base( NULL );
+}
+
+void uart_init_with_rx_callback( void ( *callback_rx )( uint8_t data ) )
+{
+    uart_init_base( callback_rx );
+}
+
+void vprint( const char* fmt, va_list argp )
+{
+    char string[UART_INIT_MSG_LENGTH_MAX + 1];
+    int  length = vsnprintf( string, sizeof( string ), fmt, argp );
+
+    if( length <= 0 )
+    {
+        return;
+    }
+
+    if( length > UART_INIT_MSG_LENGTH_MAX )
+    {
+        length = UART_INIT_MSG_LENGTH_MAX;
+    }
+
+    uart_tx_fifo_push( ( const uint8_t* ) string, ( uint32_t ) length );
+}
+
+void uart_write( const uint8_t* data, uint32_t length )
+{
+    if( length == 0 )
+    {
+        return;
+    }
+
+    uart_tx_fifo_push( data, length );
+}
+
+void uart_flush( void )
+{
+    if( inst_uart == NULL )
+    {
+        return;
+    }
+
+    // Polled, so that it also works from a fault handler where the DMA interrupt cannot preempt
+    while( ( smtc_hal_mcu_uart_is_busy( inst_uart ) == true ) || ( tx_fifo.tail != tx_fifo.head ) )
+    {
+        if( smtc_hal_mcu_uart_is_busy( inst_uart ) == false )
+        {
+            uart_tx_fifo_send_next( );
+        }
+        smtc_hal_mcu_uart_poll( inst_uart );
+    }
+}
+
+uint32_t uart_get_nb_dropped( void ) { return tx_fifo.nb_dropped; }
+
+/**
+ * @brief Hard fault handler - get the pending messages out before halting, they usually tell what led to the fault
+ */
+void HardFault_Handler( void )
+{
+    uart_flush( );
+
+    while( 1 )
+    {
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+void uart_init_base( void ( *callback_rx )( uint8_t data ) )
+{
+    const struct smtc_hal_mcu_uart_cfg_s cfg_uart = {
+        .usart = USART2,
+    };
+    const smtc_hal_mcu_uart_cfg_app_t uart_cfg_app = {
+        .baudrate    = HAL_PRINTF_UART_BAUDRATE,
+        .callback_rx = callback_rx,
+    };
+    smtc_hal_mcu_uart_init( ( const smtc_hal_mcu_uart_cfg_t ) &cfg_uart, &uart_cfg_app, &inst_uart );
+}
+
+static void uart_tx_fifo_push( const uint8_t* data, uint32_t length )
+{
+    if( inst_uart == NULL )
+    {
+        return;
+    }
+
+    const uint32_t head = tx_fifo.head;
+
+    // A message is sent whole or not at all, so that the output never shows a partial line
+    if( length > ( UART_INIT_TX_FIFO_SIZE - ( head - tx_fifo.tail ) ) )
+    {
+        tx_fifo.nb_dropped++;
+        return;
+    }
+
+    const uint32_t index = head & ( UART_INIT_TX_FIFO_SIZE - 1 );
+    uint32_t       first = UART_INIT_TX_FIFO_SIZE - index;
+
+    if( first > length )
+    {
+        first = length;
+    }
+
+    memcpy( &tx_fifo.buffer[index], data, first );
+    memcpy( &tx_fifo.buffer[0], &data[first], length - first );
+
+    // The bytes must be in the buffer before the index that publishes them
+    __DMB( );
+    tx_fifo.head = head + length;
+
+    // The completion interrupt only runs while a transmission is ongoing, so it cannot race with this start
+    if( smtc_hal_mcu_uart_is_busy( inst_uart ) == false )
+    {
+        uart_tx_fifo_send_next( );
+    }
+}
+
+static void uart_tx_fifo_send_next( void )
+{
+    const uint32_t tail    = tx_fifo.tail;
+    const uint32_t pending = tx_fifo.head - tail;
+
+    if( pending == 0 )
+    {
+        return;
+    }
+
+    // The DMA reads a contiguous area, a wrapped message is sent in two chunks
+    const uint32_t index = tail & ( UART_INIT_TX_FIFO_SIZE - 1 );
+    uint32_t       chunk = UART_INIT_TX_FIFO_SIZE - index;
+
+    if( chunk > pending )
+    {
+        chunk = pending;
+    }
+
+    tx_fifo.chunk = chunk;
+    if( smtc_hal_mcu_uart_send_async( inst_uart, &tx_fifo.buffer[index], chunk, uart_tx_fifo_on_sent, NULL ) !=
+        SMTC_HAL_MCU_STATUS_OK )
+    {
+        // No asynchronous transmission on this peripheral, fall back to polling
+        tx_fifo.chunk = 0;
+        smtc_hal_mcu_uart_send( inst_uart, &tx_fifo.buffer[index], chunk );
+        tx_fifo.tail = tail + chunk;
+        uart_tx_fifo_send_next( );
+    }
+}
+
+static void uart_tx_fifo_on_sent( void* context )
+{
+    tx_fifo.tail += tx_fifo.chunk;
+    tx_fifo.chunk = 0;
+
+    uart_tx_fifo_send_next( );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,194 @@
+/*!
+ * @file      test_smtc_busy_stats.c
+ *
+ * @brief     Unit tests of the per-opcode busy time statistics
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "smtc_busy_stats.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+#define CHECK( condition )                                                                  \
+    do                                                                                      \
+    {                                                                                       \
+        nb_checks++;                                                                        \
+        if( !( condition ) )                                                                \
+        {                                                                                   \
+            fprintf( stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition ); \
+            nb_failures++;                                                                  \
+        }                                                                                   \
+    } while( 0 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static unsigned int nb_checks;
+static unsigned int nb_failures;
+
+static smtc_busy_stats_t stats;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void test_get_opcode( void )
+{
+    const uint8_t command[] = { 0x02, 0x0A, 0x00, 0x01 };
+
+    CHECK( smtc_busy_stats_get_opcode( command, sizeof( command ) ) == 0x020A );
+    CHECK( smtc_busy_stats_get_opcode( command, 1 ) == SMTC_BUSY_STATS_OPCODE_NONE );
+    CHECK( smtc_busy_stats_get_opcode( NULL, 2 ) == SMTC_BUSY_STATS_OPCODE_NONE );
+}
+
+static void test_empty( void )
+{
+    smtc_busy_stats_reset( &stats );
+
+    CHECK( smtc_busy_stats_get( &stats, 0x020A ) == NULL );
+    CHECK( stats.nb_dropped == 0 );
+    CHECK( stats.nb_timeouts == 0 );
+}
+
+static void test_min_max_total( void )
+{
+    smtc_busy_stats_reset( &stats );
+    smtc_busy_stats_record( &stats, 0x020A, 150 );
+    smtc_busy_stats_record( &stats, 0x020A, 90 );
+    smtc_busy_stats_record( &stats, 0x020A, 400 );
+    smtc_busy_stats_record( &stats, 0x020A, 120 );
+
+    const smtc_busy_stats_entry_t* entry = smtc_busy_stats_get( &stats, 0x020A );
+
+    CHECK( entry != NULL );
+    if( entry != NULL )
+    {
+        CHECK( entry->opcode == 0x020A );
+        CHECK( entry->count == 4 );
+        CHECK( entry->min_us == 90 );
+        CHECK( entry->max_us == 400 );
+        CHECK( entry->total_us == 760 );
+    }
+}
+
+static void test_opcodes_are_separated( void )
+{
+    smtc_busy_stats_reset( &stats );
+    smtc_busy_stats_record( &stats, 0x020A, 10 );
+    smtc_busy_stats_record( &stats, 0x0119, 20 );
+    smtc_busy_stats_record( &stats, SMTC_BUSY_STATS_OPCODE_NONE, 30 );
+
+    CHECK( smtc_busy_stats_get( &stats, 0x020A )->total_us == 10 );
+    CHECK( smtc_busy_stats_get( &stats, 0x0119 )->total_us == 20 );
+    CHECK( smtc_busy_stats_get( &stats, SMTC_BUSY_STATS_OPCODE_NONE )->total_us == 30 );
+    CHECK( smtc_busy_stats_get( &stats, 0x0201 ) == NULL );
+}
+
+static void test_colliding_opcodes( void )
+{
+    // 0x0100 and 0x0001 share the same hash
+    smtc_busy_stats_reset( &stats );
+    smtc_busy_stats_record( &stats, 0x0100, 5 );
+    smtc_busy_stats_record( &stats, 0x0001, 7 );
+    smtc_busy_stats_record( &stats, 0x0100, 5 );
+
+    CHECK( smtc_busy_stats_get( &stats, 0x0100 )->count == 2 );
+    CHECK( smtc_busy_stats_get( &stats, 0x0001 )->count == 1 );
+}
+
+static void test_full_table( void )
+{
+    smtc_busy_stats_reset( &stats );
+    for( uint16_t i = 0; i < SMTC_BUSY_STATS_OPCODES_MAX; i++ )
+    {
+        smtc_busy_stats_record( &stats, 0x0200 + i, i );
+    }
+
+    smtc_busy_stats_record( &stats, 0x0300, 1 );
+    smtc_busy_stats_record( &stats, 0x0200, 1 );
+
+    CHECK( stats.nb_dropped == 1 );
+    CHECK( smtc_busy_stats_get( &stats, 0x0300 ) == NULL );
+    CHECK( smtc_busy_stats_get( &stats, 0x0200 )->count == 2 );
+
+    for( uint16_t i = 0; i < SMTC_BUSY_STATS_OPCODES_MAX; i++ )
+    {
+        CHECK( smtc_busy_stats_get( &stats, 0x0200 + i ) != NULL );
+    }
+}
+
+static void test_timeout_and_reset( void )
+{
+    smtc_busy_stats_reset( &stats );
+    smtc_busy_stats_record( &stats, 0x020A, 10 );
+    smtc_busy_stats_record_timeout( &stats );
+
+    CHECK( stats.nb_timeouts == 1 );
+
+    smtc_busy_stats_reset( &stats );
+
+    CHECK( stats.nb_timeouts == 0 );
+    CHECK( smtc_busy_stats_get( &stats, 0x020A ) == NULL );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+int main( void )
+{
+    test_get_opcode( );
+    test_empty( );
+    test_min_max_total( );
+    test_opcodes_are_separated( );
+    test_colliding_opcodes( );
+    test_full_table( );
+    test_timeout_and_reset( );
+
+    printf( "%u checks, %u failures\n", nb_checks, nb_failures );
+
+    return ( nb_failures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,184 @@
+/*!
+ * @file      test_smtc_spi_crc.c
+ *
+ * @brief     Unit tests of the SPI frame CRC8
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "smtc_spi_crc.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+#define CHECK( condition )                                                                  \
+    do                                                                                      \
+    {                                                                                       \
+        nb_checks++;                                                                        \
+        if( !( condition ) )                                                                \
+        {                                                                                   \
+            fprintf( stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition ); \
+            nb_failures++;                                                                  \
+        }                                                                                   \
+    } while( 0 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static unsigned int nb_checks;
+static unsigned int nb_failures;
+
+static uint8_t buffer[1024];
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/**
+ * @brief Reference bit-by-bit computation, as done by lr11xx_hal_compute_crc
+ */
+static uint8_t bitwise_crc_update( uint8_t crc, const uint8_t* data, uint16_t length )
+{
+    for( uint16_t i = 0; i < length; i++ )
+    {
+        uint8_t extract = data[i];
+
+        for( uint8_t j = 8; j > 0; j-- )
+        {
+            const uint8_t sum = ( crc ^ extract ) & 0x01;
+
+            crc >>= 1;
+            if( sum != 0 )
+            {
+                crc ^= 0x65;
+            }
+            extract >>= 1;
+        }
+    }
+
+    return crc;
+}
+
+static void test_golden_vectors( void )
+{
+    const uint8_t check[]   = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    const uint8_t command[] = { 0x01, 0x00 };
+
+    CHECK( smtc_spi_crc_update( SMTC_SPI_CRC_INITIAL_VALUE, check, sizeof( check ) ) == 0x18 );
+    CHECK( smtc_spi_crc_update( SMTC_SPI_CRC_INITIAL_VALUE, command, sizeof( command ) ) == 0x2C );
+    CHECK( smtc_spi_crc_update( SMTC_SPI_CRC_INITIAL_VALUE, NULL, 0 ) == SMTC_SPI_CRC_INITIAL_VALUE );
+}
+
+static void test_all_bytes_match_bitwise( void )
+{
+    unsigned int nb_mismatches = 0;
+
+    for( uint16_t crc = 0; crc < 256; crc++ )
+    {
+        for( uint16_t data = 0; data < 256; data++ )
+        {
+            const uint8_t byte = ( uint8_t ) data;
+
+            if( smtc_spi_crc_update_byte( ( uint8_t ) crc, byte ) != bitwise_crc_update( ( uint8_t ) crc, &byte, 1 ) )
+            {
+                nb_mismatches++;
+            }
+        }
+    }
+
+    CHECK( nb_mismatches == 0 );
+}
+
+static void test_buffers_match_bitwise( void )
+{
+    for( uint16_t length = 0; length <= sizeof( buffer ); length += 31 )
+    {
+        CHECK( smtc_spi_crc_update( SMTC_SPI_CRC_INITIAL_VALUE, buffer, length ) ==
+               bitwise_crc_update( SMTC_SPI_CRC_INITIAL_VALUE, buffer, length ) );
+    }
+}
+
+static void test_streaming( void )
+{
+    const uint8_t expected = bitwise_crc_update( SMTC_SPI_CRC_INITIAL_VALUE, buffer, sizeof( buffer ) );
+    uint8_t       crc      = SMTC_SPI_CRC_INITIAL_VALUE;
+
+    // Folding a frame byte by byte, as it is clocked out, gives the same CRC as over the whole frame
+    for( uint16_t i = 0; i < sizeof( buffer ); i++ )
+    {
+        crc = smtc_spi_crc_update_byte( crc, buffer[i] );
+    }
+
+    CHECK( crc == expected );
+
+    // Command and data folded separately
+    crc = smtc_spi_crc_update( SMTC_SPI_CRC_INITIAL_VALUE, buffer, 4 );
+    crc = smtc_spi_crc_update( crc, &buffer[4], sizeof( buffer ) - 4 );
+
+    CHECK( crc == expected );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+int main( void )
+{
+    uint32_t seed = 0x12345678;
+
+    for( uint16_t i = 0; i < sizeof( buffer ); i++ )
+    {
+        seed      = seed * 1103515245 + 12345;
+        buffer[i] = ( uint8_t ) ( seed >> 16 );
+    }
+
+    test_golden_vectors( );
+    test_all_bytes_match_bitwise( );
+    test_buffers_match_bitwise( );
+    test_streaming( );
+
+    printf( "%u checks, %u failures\n", nb_checks, nb_failures );
+
+    return ( nb_failures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* --- EOF ------------------------------------------------------------------ */